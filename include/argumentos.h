@@ -0,0 +1,76 @@
+#pragma once
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "kernels.h"
+#include "reglas.h"
+
+// Este archivo contiene las definiciones y prototipos para interpretar los argumentos de la línea de comandos (dimensiones, semilla, motor, etc.), tanto para el modo interactivo como para el modo sin interfaz.
+
+// Valores por defecto de las opciones que no tienen una macro propia en otro módulo.
+#define GENERACIONES_DEFECTO 1000
+#define FOTOGRAMAS_POR_SEGUNDO_DEFECTO 60
+#define PROCESOS_MAXIMOS 256
+
+// Motores disponibles para calcular las generaciones.
+typedef enum {
+    MOTOR_CUADRICULA = 0,   // Cuadrícula toroidal de tamaño fijo (ver game.c)
+    MOTOR_DISPERSO,         // Plano ilimitado formado por sectores (ver disperso.c)
+    MOTOR_HASHLIFE,         // Plano ilimitado con HashLife (ver hashlife.c)
+    NUM_TIPOS_MOTOR
+} TipoMotor;
+
+// Canales por los que los procesos de --procesos intercambian las filas de los bordes de sus franjas (ver franjas.c).
+typedef enum {
+    TRANSPORTE_MEMORIA = 0, // Memoria compartida entre los procesos (buzones con contadores atómicos)
+    TRANSPORTE_SOCKET,      // Sockets de dominio Unix entre procesos vecinos
+    NUM_TIPOS_TRANSPORTE
+} TipoTransporte;
+
+// Definición de la estructura con las opciones del programa.
+typedef struct {
+    bool sinInterfaz;           // Ejecuta la simulación sin ncurses y muestra solo el resumen final
+    bool mostrarAyuda;          // Muestra la ayuda y termina
+    bool desacoplado;           // Calcula las generaciones en un hilo separado del dibujo (modo interactivo)
+    bool detenerPeriodo;        // Detiene la simulación sin interfaz cuando la cuadrícula se vuelve estable u oscilante
+    unsigned fotogramasPorSegundo; // Cuadros por segundo del dibujo cuando la simulación corre en un hilo separado
+    uint32_t ancho;       // Dimensiones de la cuadrícula (o del rectángulo inicial, en los motores ilimitados)
+    uint32_t alto;
+    uint64_t semilla;           // Semilla de la configuración inicial (por defecto, la hora actual)
+    unsigned porcentaje;        // Porcentaje de células vivas iniciales
+    uint64_t generaciones;      // Número de generaciones a calcular (solo en el modo sin interfaz)
+    TipoMotor motor;            // Motor de cálculo
+    unsigned numHilos;          // Número de hilos (0 = todos los núcleos disponibles)
+    TipoKernel kernel;          // Implementación del kernel de cálculo
+    const char* patron;         // Archivo RLE o de texto plano con la configuración inicial (NULL = configuración aleatoria)
+    const char* guardar;        // Archivo donde se guarda la última generación (NULL = no se guarda; en el modo interactivo, un nombre según la generación)
+    const char* reanudar;       // Instantánea desde la que se reanuda la simulación (NULL = se comienza desde la generación 0)
+    const char* instantanea;    // Archivo donde se escriben las instantáneas en el modo sin interfaz (NULL = no se escriben)
+    uint64_t intervaloInstantaneas; // Generaciones entre instantáneas (0 = solo al terminar)
+    const char* regla;          // Regla B/S ya validada (NULL = la del patrón o la instantánea, o REGLA_CONWAY)
+    const char* metricas;       // Archivo donde se escriben las métricas de rendimiento (.json/.jsonl = JSON Lines, otra extensión = CSV; NULL = no se escriben)
+    uint64_t numSopas;          // Número de sopas del censo (0 = sin censo; ver censo.c)
+    unsigned generacionesPorPasada; // Generaciones por pasada del bloqueo temporal en el modo sin interfaz (1 = sin bloqueo temporal; ver avanzarCuadricula)
+    unsigned numProcesos;       // Procesos entre los que se reparte la cuadrícula por franjas de filas (0 = un solo proceso; ver franjas.c)
+    TipoTransporte transporte;  // Canal por el que los procesos intercambian las filas de los bordes
+    const char* grabar;         // Archivo donde se graban todas las generaciones calculadas (NULL = no se graban; ver grabacion.c)
+    uint64_t intervaloClaves;   // Generaciones entre dos claves de la grabación
+    const char* reproducir;     // Grabación que se reproduce en lugar de calcular una simulación (NULL = ninguna)
+    const char* servidor;       // Dirección donde se envían las generaciones a los espectadores, sin interfaz (NULL = sin servidor; ver servidor.c)
+    const char* conectar;       // Dirección del servidor cuyas generaciones se muestran en lugar de calcular una simulación (NULL = ninguno)
+    int velocidad;              // ms entre generaciones del servidor (0 = sin pausas)
+} Opciones;
+
+// PROTOTIPOS DE FUNCIONES PARA INTERPRETAR LOS ARGUMENTOS
+
+// Función para interpretar los argumentos de la línea de comandos, completando las opciones no indicadas con sus valores por defecto. Retorna false (tras mostrar el error en stderr) si algún argumento no es válido.
+bool analizarArgumentos(int argc, char* argv[], Opciones* opciones);
+
+// Función para mostrar la ayuda con las opciones disponibles.
+void mostrarAyuda(FILE* salida, const char* programa);
+
+// Función para obtener el nombre de un motor (por ejemplo, "disperso").
+const char* obtenerNombreMotor(TipoMotor motor);
+
+// Función para obtener el nombre de un transporte (por ejemplo, "socket").
+const char* obtenerNombreTransporte(TipoTransporte transporte);
@@ -0,0 +1,54 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "argumentos.h"
+#include "game.h"
+
+// Este archivo contiene las definiciones y prototipos del censo de sopas: muchas cuadrículas pequeñas con configuraciones aleatorias independientes (sopas), calculadas en paralelo hasta que se vuelven estables u oscilantes, con un resumen estadístico de sus resultados.
+
+// Número de intervalos del histograma de generaciones hasta estabilizar (el intervalo i cuenta las sopas que se estabilizaron en [2^(i-1), 2^i), y el 0 las que ya eran periódicas desde el inicio).
+#define NUM_INTERVALOS_ESTABILIZACION 65
+
+// Definición de la configuración de un censo.
+typedef struct {
+    uint64_t numSopas;              // Número de sopas a calcular
+    uint32_t ancho;           // Dimensiones de cada sopa (cuadrícula toroidal)
+    uint32_t alto;
+    uint64_t semilla;               // Semilla del censo: la sopa i usa la semilla obtenerSemillaSopa(semilla, i)
+    unsigned porcentaje;            // Porcentaje de células vivas iniciales de cada sopa
+    uint64_t generacionesMaximas;   // Generaciones tras las que se abandona una sopa que aún no es periódica
+    unsigned numHilos;              // Número de hilos (0 = todos los núcleos disponibles)
+    TipoKernel kernel;              // Implementación del kernel de cálculo
+    const Regla* regla;             // Regla de todas las sopas (NULL = B3/S23)
+} ConfiguracionCenso;
+
+// Definición del resumen de un censo. No depende del número de hilos ni del orden en que se calcularon las sopas.
+typedef struct {
+    uint64_t numSopas;              // Sopas calculadas
+    uint64_t estabilizadas;         // Sopas que se volvieron estables u oscilantes (con un período de hasta LONGITUD_HISTORIAL_HASH)
+    uint64_t extintas;              // Sopas estabilizadas sin células vivas
+    uint64_t periodos[LONGITUD_HISTORIAL_HASH + 1];                 // Número de sopas con cada período (el índice 0 cuenta las que no se estabilizaron)
+    uint64_t intervalosEstabilizacion[NUM_INTERVALOS_ESTABILIZACION]; // Histograma de generaciones hasta estabilizar, en intervalos de potencias de 2
+    uint64_t estabilizacionMinima;  // Generaciones hasta estabilizar (primera generación del ciclo), entre las sopas estabilizadas
+    uint64_t estabilizacionMaxima;
+    uint64_t sumaEstabilizacion;
+    uint64_t poblacionMinima;       // Población final, entre todas las sopas
+    uint64_t poblacionMaxima;
+    uint64_t sumaPoblacion;
+    uint64_t sopaMasLonga;          // Índice de la sopa estabilizada que más tardó en estabilizarse (la de menor índice, si hay empates)
+    uint64_t generacionesCalculadas; // Total de generaciones calculadas entre todas las sopas
+    unsigned numHilos;              // Hilos usados
+    TipoKernel kernel;              // Kernel usado
+    double segundos;                // Tiempo de cálculo del censo
+} ResumenCenso;
+
+// PROTOTIPOS DE FUNCIONES PARA CALCULAR UN CENSO DE SOPAS
+
+// Función para obtener la semilla de la sopa indice de un censo (la salida indice del generador SplitMix64 iniciado con la semilla del censo). La sopa se puede reproducir con crearCuadriculaConRegla y esa semilla.
+uint64_t obtenerSemillaSopa(uint64_t semilla, uint64_t indice);
+
+// Función para calcular las sopas de un censo repartidas entre los hilos (con robo de trabajo) y completar su resumen. Retorna false si no se pudieron crear los hilos o las cuadrículas.
+bool calcularCenso(const ConfiguracionCenso* configuracion, ResumenCenso* resumen);
+
+// Función para ejecutar el censo indicado en las opciones (--censo) y mostrar su resumen en stdout. Retorna el código de salida del programa (0 si no hubo errores).
+int ejecutarCenso(const Opciones* opciones);
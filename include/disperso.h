@@ -0,0 +1,59 @@
+#pragma once
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "hilos.h"
+#include "game.h"
+
+// Este archivo contiene las definiciones y prototipos del universo disperso: una alternativa a Cuadricula sin dimensiones fijas, formada por sectores empaquetados de LADO_SECTOR x LADO_SECTOR células que se crean cuando las células vivas se acercan a ellos y se liberan cuando quedan vacíos.
+// NOTA: A diferencia de Cuadricula, el universo disperso es un plano ilimitado (sin wrapping toroidal), con coordenadas de 64 bits con signo. La memoria usada depende del número de sectores ocupados y no del área que abarcan las células vivas.
+
+// Lado (en células) de cada sector: una palabra de 64 bits por fila.
+#define LADO_SECTOR 64
+
+// Estructura opaca que representa el universo disperso (su contenido se define en disperso.c).
+typedef struct UniversoDisperso UniversoDisperso;
+
+// PROTOTIPOS DE FUNCIONES PARA MANEJAR EL UNIVERSO DISPERSO
+
+// Función para crear un nuevo universo con ~20% de células vivas iniciales (aleatorias) en el rectángulo [0, ancho) x [0, alto). Con ancho o alto 0, el universo comienza vacío.
+UniversoDisperso* crearUniversoDisperso(uint64_t ancho, uint64_t alto);
+
+// Función para crear un nuevo universo con ~porcentaje% de células vivas iniciales en el rectángulo [0, ancho) x [0, alto), generadas a partir de una semilla (con la misma semilla, el rectángulo coincide con la cuadrícula de crearCuadriculaConSemilla).
+UniversoDisperso* crearUniversoDispersoConSemilla(uint64_t ancho, uint64_t alto, uint64_t semilla, unsigned porcentaje);
+
+// Función para crear un nuevo universo con las células vivas de una cuadrícula (la célula (x, y) de la cuadrícula pasa a ser la célula (x, y) del universo; el universo comienza en la generación 0). Retorna NULL si no hay memoria suficiente.
+UniversoDisperso* crearUniversoDispersoDesdeCuadricula(Cuadricula* cuadricula);
+
+// Función para liberar la memoria asignada a un universo.
+void liberarUniversoDisperso(UniversoDisperso* universo);
+
+// Función para calcular la siguiente generación del universo según su regla (B3/S23 por defecto). Retorna false si no hay memoria suficiente (en ese caso, el universo no cambia).
+bool calcularUniversoDispersoSiguiente(UniversoDisperso* universo);
+
+// Función para configurar el número de hilos con que se calcula cada generación (0 = todos los núcleos disponibles, 1 = sin hilos adicionales). Retorna false si no se pudo crear el pool.
+bool configurarHilosUniversoDisperso(UniversoDisperso* universo, unsigned numHilos);
+
+// Función para cambiar la regla B/S con que se calculan las generaciones. Retorna false (sin cambiarla) si la regla es NULL o hace nacer células sin vecinas (B0), que llenarían el plano ilimitado.
+bool configurarReglaUniversoDisperso(UniversoDisperso* universo, const Regla* regla);
+
+// Función para establecer el estado de una célula. Retorna false si no hay memoria suficiente.
+bool establecerCelulaDisperso(UniversoDisperso* universo, int64_t x, int64_t y, bool viva);
+
+// Función para obtener el estado de una célula específica del universo.
+bool obtenerEstadoCelulaDisperso(UniversoDisperso* universo, int64_t x, int64_t y);
+
+// Función para contar el número de células vivas alrededor de una célula específica.
+unsigned short contarVecinasVivasDisperso(UniversoDisperso* universo, int64_t x, int64_t y);
+
+// Función para obtener el número de generación actual.
+uint64_t obtenerNumGeneracionDisperso(UniversoDisperso* universo);
+
+// Función para contar las células vivas del universo.
+uint64_t contarPoblacionDisperso(UniversoDisperso* universo);
+
+// Función para obtener el número de sectores reservados actualmente.
+size_t obtenerNumSectoresDisperso(UniversoDisperso* universo);
+
+// Función para restablecer el universo a su estado inicial (con el porcentaje de células vivas y el rectángulo indicados al crearlo; la configuración continúa la secuencia aleatoria de la semilla).
+void reiniciarUniversoDisperso(UniversoDisperso* universo);
@@ -0,0 +1,46 @@
+#pragma once
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "game.h"
+
+// Este archivo contiene las definiciones y prototipos de los fotogramas (copias de una generación de la cuadrícula, listas para dibujar) y del buffer triple que permite pasarlos sin bloqueos del hilo de simulación al hilo de dibujo.
+
+// Puntero a la primera palabra de la fila y de un fotograma.
+#define FILA_FOTOGRAMA(fotograma, y) ((fotograma)->celulas + (size_t)(y) * (fotograma)->palabrasEntreFilas)
+
+// Definición de un fotograma: las células de una generación, empaquetadas igual que en la cuadrícula (bit b de la palabra p = célula p * 64 + b).
+typedef struct {
+    uint32_t ancho;
+    uint32_t alto;
+    uint64_t numGeneracion;         // Generación que contiene el fotograma
+    size_t palabrasEntreFilas;      // Distancia (en palabras) entre el inicio de dos filas consecutivas
+    uint64_t* celulas;              // Primera palabra de la fila 0 (los bits sobrantes de la última palabra de cada fila están en 0)
+} Fotograma;
+
+// Estructura opaca que representa el buffer triple (su contenido se define en fotogramas.c).
+typedef struct BufferTriple BufferTriple;
+
+// PROTOTIPOS DE FUNCIONES PARA MANEJAR LOS FOTOGRAMAS
+
+// Función para obtener un fotograma que apunta (sin copiar) a la generación actual de la cuadrícula. Deja de ser válido al calcular la siguiente generación.
+Fotograma obtenerVistaCuadricula(Cuadricula* cuadricula);
+
+// Función para copiar la generación actual de la cuadrícula en un fotograma de las mismas dimensiones.
+void capturarFotograma(Fotograma* destino, Cuadricula* cuadricula);
+
+// Función para crear un buffer triple con fotogramas de las dimensiones indicadas.
+BufferTriple* crearBufferTriple(uint32_t ancho, uint32_t alto);
+
+// Función para liberar la memoria asignada a un buffer triple.
+void liberarBufferTriple(BufferTriple* buffer);
+
+// Función (solo para el hilo que escribe) para obtener el fotograma donde se escribe la siguiente generación.
+Fotograma* obtenerFotogramaEscritura(BufferTriple* buffer);
+
+// Función (solo para el hilo que escribe) para publicar el fotograma de escritura como el más reciente. El siguiente fotograma de escritura es otro.
+void publicarFotograma(BufferTriple* buffer);
+
+// Función (solo para el hilo que lee) para obtener el fotograma publicado más reciente. Si nuevo no es NULL, indica si cambió desde la llamada anterior.
+// NOTA: El fotograma retornado no se modifica hasta la siguiente llamada, aunque el hilo que escribe publique otros mientras tanto.
+const Fotograma* obtenerUltimoFotograma(BufferTriple* buffer, bool* nuevo);
@@ -0,0 +1,40 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "argumentos.h"
+#include "game.h"
+
+// Este archivo contiene las definiciones y prototipos para calcular una sola cuadrícula toroidal repartida entre varios procesos del mismo equipo: cada proceso calcula una franja de filas y, en cada generación, intercambia con sus vecinos solo las filas de los bordes.
+
+// Definición de la configuración de un cálculo por franjas.
+typedef struct {
+    unsigned numProcesos;           // Procesos entre los que se reparten las filas (de 1 a alto)
+    TipoTransporte transporte;      // Canal por el que se intercambian las filas de los bordes
+    uint32_t ancho;                 // Dimensiones de la cuadrícula completa
+    uint32_t alto;
+    uint64_t semilla;               // Semilla de la configuración inicial (la misma que con crearCuadriculaConSemilla)
+    unsigned porcentaje;            // Porcentaje de células vivas iniciales
+    uint64_t generaciones;          // Generaciones a calcular
+    unsigned numHilos;              // Hilos de cada proceso (0 = todos los núcleos disponibles)
+    TipoKernel kernel;              // Implementación del kernel de cálculo
+    const Regla* regla;             // Regla de la cuadrícula (NULL = B3/S23)
+} ConfiguracionFranjas;
+
+// Definición del resumen de un cálculo por franjas. La población y el hash son los de la cuadrícula completa, iguales a los de un solo proceso.
+typedef struct {
+    uint64_t poblacion;             // Población final
+    uint64_t hash;                  // Hash de la última generación (el de obtenerHashCuadricula)
+    uint32_t filasMinimas;          // Filas de la franja más baja y de la más alta
+    uint32_t filasMaximas;
+    TipoKernel kernel;              // Kernel usado
+    double segundos;                // Tiempo de cálculo del proceso más lento
+    double segundosEspera;          // Tiempo máximo que un proceso esperó las filas de sus vecinos
+} ResumenFranjas;
+
+// PROTOTIPOS DE FUNCIONES PARA CALCULAR UNA CUADRÍCULA POR FRANJAS
+
+// Función para calcular las generaciones de una cuadrícula repartida en franjas entre varios procesos hijos y completar su resumen. Retorna false si no se pudieron crear los procesos, los canales o las cuadrículas, o si algún proceso falló.
+bool calcularFranjas(const ConfiguracionFranjas* configuracion, ResumenFranjas* resumen);
+
+// Función para ejecutar el cálculo por franjas indicado en las opciones (--procesos) y mostrar su resumen en stdout. Retorna el código de salida del programa (0 si no hubo errores).
+int ejecutarFranjas(const Opciones* opciones);
@@ -1,44 +1,211 @@
 #pragma once
 #include <stdlib.h>
+#include <stddef.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include "hilos.h"
+#include "kernels.h"
+#include "memoria.h"
 
 // Este archivo contiene las definiciones y prototipos necesarios para implementar la lógica del Juego de la Vida de Conway, incluyendo la representación de la cuadrícula, las reglas del juego y la evolución de las generaciones.
 
 // Usamos macros para definir las dimensiones de la cuadrícula.
 #define ANCHO_CUADRICULA 200
 #define ALTO_CUADRICULA 50
-#define PORCENTAJE_CELULAS_VIVAS_INICIAL(porcentaje) ((rand() % 100) < porcentaje)
+// Dimensión máxima de la cuadrícula (en cada eje). Las coordenadas caben en 32 bits sin signo y en enteros con signo de 64 bits, y los índices y tamaños se calculan con size_t, por lo que las cuadrículas de miles de millones de células no desbordan.
+#define DIMENSION_MAXIMA INT32_MAX
+#define PORCENTAJE_CELULAS_VIVAS_DEFECTO 20
+#define PORCENTAJE_CELULAS_VIVAS_INICIAL(estadoAleatorio, porcentaje) ((generarAleatorio(estadoAleatorio) % 100) < (porcentaje))
+
+// Macros para la representación empaquetada de las células: cada fila se guarda como un arreglo de palabras de 64 bits, donde el bit 'b' de la palabra 'p' corresponde a la célula en la columna (p * 64 + b).
+#define BITS_POR_PALABRA 64
+#define PALABRAS_POR_FILA(ancho) (((size_t)(ancho) + BITS_POR_PALABRA - 1) / BITS_POR_PALABRA)
+
+// Macros para la disposición de cada generación en memoria: un único bloque contiguo, alineado a la línea de caché, con un borde "fantasma" de una fila arriba y abajo y de una palabra a la izquierda y a la derecha de cada fila.
+#define BYTES_LINEA_CACHE 64
+#define PALABRAS_LINEA_CACHE (BYTES_LINEA_CACHE / sizeof(uint64_t))
+// Dimensiones de cada tesela: la cuadrícula se divide en teselas de FILAS_POR_TESELA filas por PALABRAS_POR_TESELA palabras (1024 células), y solo se recalculan las que pueden cambiar. Cada fila de teselas forma una banda de trabajo para los hilos.
+#define FILAS_POR_TESELA 16
+#define PALABRAS_POR_TESELA 16
+// Lado (en teselas) de cada bloque del bloqueo temporal, y máximo de generaciones por pasada (el halo horizontal de cada bloque es de una palabra, que se invalida a razón de una célula por generación).
+#define TESELAS_POR_BLOQUE 4
+#define GENERACIONES_POR_PASADA_MAXIMA 64
+
+// Número de generaciones recientes cuyo hash se guarda para detectar oscilaciones (el período máximo que se puede detectar).
+#define LONGITUD_HISTORIAL_HASH 128
+
+// Puntero a la primera palabra de datos de la fila y (se admiten y = -1 y y = alto para acceder a las filas fantasma).
+#define FILA_CUADRICULA(buffer, palabrasEntreFilas, y) ((buffer) + ((ptrdiff_t)(y) + 1) * (ptrdiff_t)(palabrasEntreFilas) + 1)
+
+// Definición del historial de hashes de las últimas generaciones, usado para detectar configuraciones estables u oscilantes.
+typedef struct {
+    uint64_t hashes[LONGITUD_HISTORIAL_HASH];       // Anillo con los hashes de las últimas generaciones
+    uint64_t generaciones[LONGITUD_HISTORIAL_HASH]; // Número de generación de cada hash
+    size_t numEntradas;                             // Entradas ocupadas del anillo
+    size_t siguiente;                               // Posición donde se guarda el siguiente hash
+    uint64_t periodo;                               // Período detectado (1 = estable; 0 = aún no se detectó)
+    uint64_t inicioPeriodo;                         // Primera generación que se repite con ese período
+} HistorialHash;
 
 // Definición de la estructura para representar el estado del juego (que corresponde a una cuadrícula de células vivas y muertas).
 typedef struct {
-    unsigned short ancho;
-    unsigned short alto;
-    uint64_t numGeneracion; // Número de generación actual
-    bool **genActual;       // Generación actual
-    bool **genSiguiente;    // Generación siguiente
-    // NOTA: Definimos punteros dobles para representar matrices de booleanos con el estado actual y siguiente de cada célula. Usamos punteros para permitir la asignación dinámica de memoria.
+    uint32_t ancho;
+    uint32_t alto;
+    uint64_t numGeneracion;     // Número de generación actual
+    size_t palabrasPorFila;     // Número de palabras de 64 bits con células de cada fila
+    size_t palabrasEntreFilas;  // Distancia (en palabras) entre el inicio de dos filas consecutivas, incluyendo el borde fantasma y el relleno de alineación
+    BloqueMemoria memoria;      // Bloque único que contiene ambas generaciones (con páginas grandes, si es posible)
+    uint64_t *genActual;        // Generación actual (64 células por palabra)
+    uint64_t *genSiguiente;     // Generación siguiente (64 células por palabra)
+    PoolHilos *pool;            // Pool de hilos para calcular las generaciones en paralelo (NULL = un solo hilo)
+    Regla regla;                // Regla B/S con que se calculan las generaciones, ya compilada (B3/S23 por defecto)
+    TipoKernel tipoKernel;      // Implementación del kernel de cálculo (escalar, SSE2, AVX2 o AVX-512)
+    KernelFila calcularFila;    // Función del kernel de cálculo seleccionado (especializado para la regla)
+    size_t filasTeselas;        // Número de filas de teselas
+    size_t columnasTeselas;     // Número de columnas de teselas
+    uint8_t *teselasCambiadas;  // Mapa de teselas que cambiaron en la última generación (1 = cambió)
+    uint8_t *teselasActivas;    // Mapa de teselas que se recalculan en la generación en curso
+    bool seguimientoTeselas;    // Indica si se omiten las teselas que no pueden cambiar (true por defecto)
+    uint64_t estadoAleatorio;   // Estado del generador de números aleatorios (a partir de la semilla indicada al crear la cuadrícula)
+    unsigned porcentajeInicial; // Porcentaje de células vivas al crear o reiniciar la cuadrícula
+    uint64_t hash;              // Hash de la generación actual (suma de los hashes de sus palabras), válido solo si hashValido
+    bool hashValido;            // Indica si hash corresponde a la generación actual (se invalida al modificar células fuera del cálculo)
+    bool deteccionPeriodo;      // Indica si se mantiene el hash y el historial para detectar oscilaciones (false por defecto)
+    uint64_t *deltasHash;       // Cambio del hash en cada banda de teselas durante la generación en curso
+    HistorialHash historial;    // Hashes de las últimas generaciones
+    ContadorCambios contarCambios; // Función que cuenta los nacimientos y las muertes de una fila (con POPCNT, si el procesador la soporta)
+    bool conteoCambios;         // Indica si se cuentan los nacimientos y las muertes de cada generación (false por defecto)
+    uint64_t nacimientos;       // Células que nacieron en la última generación (solo con conteoCambios)
+    uint64_t muertes;           // Células que murieron en la última generación (solo con conteoCambios)
+    bool cambiosValidos;        // Indica si nacimientos y muertes corresponden a la generación actual
+    uint64_t poblacion;         // Población de la generación actual, válida solo si poblacionValida (con conteoCambios se mantiene de forma incremental)
+    bool poblacionValida;       // Indica si poblacion corresponde a la generación actual
+    uint64_t *nacimientosBanda; // Nacimientos en cada banda de teselas durante la generación en curso
+    uint64_t *muertesBanda;     // Muertes en cada banda de teselas durante la generación en curso
+    unsigned generacionesPorPasada; // Generaciones que avanzarCuadricula calcula en cada pasada por los bloques (1 = sin bloqueo temporal)
+    BloqueMemoria memoriaBloques; // Buffer de cada hilo para el bloqueo temporal (se reserva en la primera pasada)
+    // NOTA: Cada generación es un bloque contiguo de (alto + 2) filas de palabrasEntreFilas palabras. El borde fantasma replica las filas y columnas opuestas (wrapping toroidal) y se actualiza una vez por generación, de modo que el cálculo no necesita operaciones de módulo. Fuera del cálculo de una generación, los bits sobrantes de la última palabra de cada fila se mantienen en 0.
 } Cuadricula;
 
+// Tipo de las funciones que llama calcularCuadriculaSiguienteConBordes cuando las filas de los bordes de la generación siguiente ya están calculadas (ver obtenerFilaSiguienteCuadricula).
+typedef void (*FuncionBordesCalculados)(void* contexto, Cuadricula* cuadricula);
+
 // PROTOTIPOS DE FUNCIONES PARA MANEJAR LA CUADRÍCULA Y LA LÓGICA DEL JUEGO
 
-// Función para crear una nueva cuadrícula con las dimensiones especificadas y ~20% de células vivas iniciales (aleatorias).
-Cuadricula* crearCuadricula(unsigned short ancho, unsigned short alto);
+// Función para crear una nueva cuadrícula con las dimensiones especificadas y ~20% de células vivas iniciales (aleatorias, con una semilla distinta en cada ejecución).
+Cuadricula* crearCuadricula(uint32_t ancho, uint32_t alto);
+
+// Función para crear una nueva cuadrícula con las dimensiones especificadas y ~porcentaje% de células vivas iniciales, generadas a partir de una semilla (la misma semilla produce siempre la misma cuadrícula).
+Cuadricula* crearCuadriculaConSemilla(uint32_t ancho, uint32_t alto, uint64_t semilla, unsigned porcentaje);
+
+// Función para crear una nueva cuadrícula como crearCuadriculaConSemilla, que calcula las generaciones con la regla indicada (NULL = B3/S23; ver compilarRegla en reglas.h).
+Cuadricula* crearCuadriculaConRegla(uint32_t ancho, uint32_t alto, uint64_t semilla, unsigned porcentaje, const Regla* regla);
+
+// Función para crear una nueva cuadrícula como crearCuadriculaConRegla, que calcula las generaciones con numHilos hilos (ver configurarHilosCuadricula). El pool se crea antes de llenar la cuadrícula, por lo que las bandas se llenan en paralelo y cada hilo es el primero en tocar la memoria de las suyas (en un sistema NUMA, la memoria queda en su nodo).
+Cuadricula* crearCuadriculaConHilos(uint32_t ancho, uint32_t alto, uint64_t semilla, unsigned porcentaje, const Regla* regla, unsigned numHilos);
 
 // Función para liberar la memoria asignada a una cuadrícula.
 void liberarCuadricula(Cuadricula* cuadricula);
 
-// Función para calcular la siguiente generación de la cuadrícula según las reglas del Juego de la Vida.
+// Función para calcular la siguiente generación de la cuadrícula según su regla (B3/S23 por defecto).
 void calcularCuadriculaSiguiente(Cuadricula* cuadricula);
 
+// Función para calcular la siguiente generación como calcularCuadriculaSiguiente, llamando a bordesCalculados (si no es NULL) en cuanto están calculadas las bandas de teselas de las primeras y las últimas filasBorde filas, antes de calcular el resto. Permite enviar las filas de los bordes mientras se calcula el interior (ver franjas.c).
+void calcularCuadriculaSiguienteConBordes(Cuadricula* cuadricula, uint32_t filasBorde, FuncionBordesCalculados bordesCalculados, void* contexto);
+
+// Función para obtener, durante calcularCuadriculaSiguienteConBordes, la fila y de la generación que se está calculando (al llamar a bordesCalculados solo están completas las filas de los bordes). Retorna NULL si la fila no existe.
+const uint64_t* obtenerFilaSiguienteCuadricula(Cuadricula* cuadricula, uint32_t y);
+
+// Función para avanzar la cuadrícula el número de generaciones indicado, con el mismo resultado que llamar a calcularCuadriculaSiguiente esas veces. Con más de una generación por pasada (ver configurarGeneracionesPorPasada), y sin detección de períodos ni conteo de cambios, las calcula por bloques que caben en la caché.
+void avanzarCuadricula(Cuadricula* cuadricula, uint64_t generaciones);
+
+// Función para configurar cuántas generaciones calcula avanzarCuadricula en cada pasada por los bloques de la cuadrícula (1 = sin bloqueo temporal, por defecto). Más generaciones por pasada reducen el tráfico con la memoria principal, a cambio de recalcular halos más grandes. Retorna false si el valor no está en [1, GENERACIONES_POR_PASADA_MAXIMA].
+bool configurarGeneracionesPorPasada(Cuadricula* cuadricula, unsigned generaciones);
+
+// Función para configurar el número de hilos con que se calcula cada generación (0 = todos los núcleos disponibles, 1 = sin hilos adicionales). Si cambia el número de hilos, las generaciones se copian a memoria tocada primero por el hilo que calcula cada banda. Retorna false si no se pudo crear el pool.
+bool configurarHilosCuadricula(Cuadricula* cuadricula, unsigned numHilos);
+
+// Función para seleccionar la implementación del kernel de cálculo (KERNEL_AUTOMATICO = la mejor disponible). Retorna false si el procesador no la soporta.
+bool seleccionarKernelCuadricula(Cuadricula* cuadricula, TipoKernel tipo);
+
+// Función para cambiar la regla con que se calculan las generaciones (se conserva la implementación del kernel). Retorna false si la regla es NULL.
+bool configurarReglaCuadricula(Cuadricula* cuadricula, const Regla* regla);
+
+// Función para obtener la regla con que se calculan las generaciones.
+const Regla* obtenerReglaCuadricula(Cuadricula* cuadricula);
+
+// Función para activar o desactivar el seguimiento de teselas activas (si está desactivado, todas las teselas se recalculan en cada generación).
+void configurarSeguimientoTeselas(Cuadricula* cuadricula, bool activar);
+
+// Función para obtener el número de teselas que cambiaron en la última generación.
+size_t contarTeselasCambiadas(Cuadricula* cuadricula);
+
+// Función para calcular la siguiente generación célula por célula, usando contarVecinasVivas (implementación de referencia, más lenta).
+void calcularCuadriculaSiguienteReferencia(Cuadricula* cuadricula);
+
 // Función para obtener el estado de una célula específica en la cuadrícula.
-bool obtenerEstadoCelula(Cuadricula* cuadricula, unsigned short x, unsigned short y);
+bool obtenerEstadoCelula(Cuadricula* cuadricula, uint32_t x, uint32_t y);
+
+// Función para obtener el hash de 64 bits de la generación actual (dos generaciones con las mismas células tienen el mismo hash). Con la detección de períodos activada, se mantiene de forma incremental a partir de las teselas que cambian; si no, se calcula completo.
+uint64_t obtenerHashCuadricula(Cuadricula* cuadricula);
+
+// Función para calcular la parte del hash de una generación que corresponde a su fila y (palabrasPorFila palabras, sin bits sobrantes). El hash de la generación (obtenerHashCuadricula) es la suma de los de todas sus filas, por lo que se puede calcular por partes.
+uint64_t calcularHashFila(const uint64_t* palabras, size_t palabrasPorFila, uint64_t y);
+
+// Función para activar o desactivar la detección de configuraciones estables u oscilantes (se guarda el hash de las últimas LONGITUD_HISTORIAL_HASH generaciones).
+void configurarDeteccionPeriodo(Cuadricula* cuadricula, bool activar);
+
+// Función para saber si la cuadrícula se volvió estable (período 1) u oscilante, a partir de las generaciones calculadas desde que se activó la detección (o desde la última modificación de células). Si es así, retorna true e indica el período y la primera generación del ciclo.
+bool obtenerPeriodoCuadricula(Cuadricula* cuadricula, uint64_t* periodo, uint64_t* inicio);
+
+// Función para activar o desactivar el conteo de nacimientos y muertes de cada generación (solo se recorren las teselas que cambiaron). Con el conteo activado, la población también se mantiene de forma incremental.
+void configurarConteoCambios(Cuadricula* cuadricula, bool activar);
+
+// Función para obtener los nacimientos y las muertes de la última generación calculada. Retorna false si el conteo no está activado o si las células se modificaron fuera del cálculo desde entonces.
+bool obtenerCambiosCuadricula(Cuadricula* cuadricula, uint64_t* nacimientos, uint64_t* muertes);
+
+// Función para establecer el estado de una célula específica en la cuadrícula. Retorna false si las coordenadas están fuera de la cuadrícula.
+bool establecerEstadoCelula(Cuadricula* cuadricula, uint32_t x, uint32_t y, bool viva);
+
+// Función para establecer el estado de las células (x, y) a (x + longitud - 1, y), recortando el tramo al ancho de la cuadrícula.
+void establecerTramoCelulas(Cuadricula* cuadricula, uint32_t x, uint32_t y, size_t longitud, bool viva);
+
+// Función para cambiar la semilla y el porcentaje de células vivas de las configuraciones aleatorias que genera reiniciarCuadricula.
+void configurarRellenoCuadricula(Cuadricula* cuadricula, uint64_t semilla, unsigned porcentaje);
+
+// Función para reemplazar la fila y de la generación actual por palabras empaquetadas (palabrasPorFila palabras; los bits posteriores al ancho se ignoran).
+void establecerFilaCuadricula(Cuadricula* cuadricula, uint32_t y, const uint64_t* palabras);
+
+// Función para dejar todas las células muertas y reiniciar el número de generación (por ejemplo, antes de cargar un patrón).
+void limpiarCuadricula(Cuadricula* cuadricula);
+
+// Función para obtener, sin copiarla, la fila y de la generación actual, empaquetada en palabras de 64 bits (bit b de la palabra p = célula p * 64 + b; los bits sobrantes de la última palabra están en 0). Retorna NULL si la fila no existe.
+// NOTA: El puntero deja de ser válido al calcular la siguiente generación (los buffers se intercambian).
+const uint64_t* obtenerFilaCuadricula(Cuadricula* cuadricula, uint32_t y);
+
+// Función para copiar las células de la región de anchoRegion x altoRegion células con esquina en (x, y) de la generación actual, empaquetadas como en obtenerFilaCuadricula: la fila j de la región empieza en destino + j * palabrasEntreFilasDestino y ocupa PALABRAS_POR_FILA(anchoRegion) palabras (los bits sobrantes de su última palabra quedan en 0). Retorna false si la región no está dentro de la cuadrícula o palabrasEntreFilasDestino es menor que el ancho de la región.
+bool leerRegionCuadricula(Cuadricula* cuadricula, uint32_t x, uint32_t y, uint32_t anchoRegion, uint32_t altoRegion, uint64_t* destino, size_t palabrasEntreFilasDestino);
+
+// Función para reemplazar las células de la región de anchoRegion x altoRegion células con esquina en (x, y) de la generación actual por las de origen, empaquetadas como en leerRegionCuadricula (los bits posteriores al ancho de la región se ignoran). Retorna false si la región no está dentro de la cuadrícula o palabrasEntreFilasOrigen es menor que el ancho de la región.
+bool escribirRegionCuadricula(Cuadricula* cuadricula, uint32_t x, uint32_t y, uint32_t anchoRegion, uint32_t altoRegion, const uint64_t* origen, size_t palabrasEntreFilasOrigen);
+
+// Función para contar las células vivas de la región de anchoRegion x altoRegion células con esquina en (x, y) de la generación actual, recortando la región a la cuadrícula.
+uint64_t contarPoblacionRegion(Cuadricula* cuadricula, uint32_t x, uint32_t y, uint32_t anchoRegion, uint32_t altoRegion);
 
 // Función para contar el número de células vivas alrededor de una célula específica.
-unsigned short contarVecinasVivas(Cuadricula* cuadricula, unsigned short x, unsigned short y);
+unsigned short contarVecinasVivas(Cuadricula* cuadricula, uint32_t x, uint32_t y);
 
 // Función para obtener el número de generación actual.
 uint64_t obtenerNumGeneracion(Cuadricula* cuadricula);
 
-// Función para restablecer la cuadrícula a un estado inicial (con ~20% de células vivas).
+// Función para contar las células vivas de la generación actual (con el conteo de cambios activado, no recorre la cuadrícula salvo que las células se hayan modificado fuera del cálculo).
+uint64_t contarPoblacion(Cuadricula* cuadricula);
+
+// Función para restablecer la cuadrícula a un estado inicial (con el porcentaje de células vivas indicado al crearla; la configuración continúa la secuencia aleatoria de la semilla).
 void reiniciarCuadricula(Cuadricula* cuadricula);
+
+// Función para generar la fila y de una configuración aleatoria de ancho células por fila, con ~porcentaje% de células vivas (PALABRAS_POR_FILA(ancho) palabras). Con estadoInicial = semilla, es la fila y de crearCuadriculaConSemilla con esa semilla, por lo que cualquier parte de la cuadrícula se puede generar por separado.
+void generarFilaAleatoria(uint64_t estadoInicial, uint32_t ancho, uint64_t y, unsigned porcentaje, uint64_t* palabras);
+
+// Función para obtener el siguiente número pseudoaleatorio (SplitMix64) a partir del estado del generador, que avanza en cada llamada.
+uint64_t generarAleatorio(uint64_t* estado);
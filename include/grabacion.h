@@ -0,0 +1,74 @@
+#pragma once
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "game.h"
+#include "fotogramas.h"
+
+// Este archivo contiene las definiciones y prototipos de las grabaciones: archivos con todas las generaciones de una simulación, guardadas como diferencias (XOR) con la generación anterior, con generaciones completas (claves) cada cierto intervalo y un índice de claves para saltar a cualquier generación.
+
+// Generaciones entre dos claves de una grabación, si no se indica otro intervalo (--claves).
+#define INTERVALO_CLAVES_DEFECTO 256
+// Generaciones copiadas que pueden esperar a ser escritas; si el disco es más lento, la simulación espera (una grabación no puede omitir generaciones).
+#define FOTOGRAMAS_COLA_GRABACION 8
+
+// Definición de la información de una grabación.
+typedef struct {
+    uint32_t ancho;                         // Dimensiones de la cuadrícula
+    uint32_t alto;
+    uint64_t primeraGeneracion;             // Primera y última generación grabadas
+    uint64_t ultimaGeneracion;
+    uint64_t intervaloClaves;               // Generaciones entre dos claves
+    uint64_t numClaves;                     // Claves guardadas (la primera generación siempre es una clave)
+    uint64_t bytes;                         // Tamaño del archivo
+    bool indiceReconstruido;                // La grabación no se cerró (por ejemplo, porque el programa terminó antes) y el índice se reconstruyó recorriendo el archivo
+    char regla[LONGITUD_MAXIMA_REGLA];      // Regla con que se calculó la simulación
+} InfoGrabacion;
+
+// Estructura opaca que representa una grabación en curso, con el hilo que la escribe en segundo plano (su contenido se define en grabacion.c).
+typedef struct Grabador Grabador;
+
+// Estructura opaca que representa una grabación abierta para reproducirla (su contenido se define en grabacion.c).
+typedef struct Reproduccion Reproduccion;
+
+// PROTOTIPOS DE FUNCIONES PARA CODIFICAR DIFERENCIAS ENTRE GENERACIONES
+
+// Función para codificar la diferencia (XOR) entre dos generaciones de totalPalabras palabras, con las filas una tras otra (anterior NULL = una generación vacía, es decir, la generación completa), en el buffer *datos de *capacidad bytes, que se agranda si hace falta (puede empezar en NULL y 0). Retorna los bytes codificados, o SIZE_MAX si no hay memoria suficiente.
+size_t codificarDiferenciaPalabras(const uint64_t* actual, const uint64_t* anterior, size_t totalPalabras, uint8_t** datos, size_t* capacidad);
+
+// Función para verificar que bytesDatos bytes de datos sean una diferencia codificada de exactamente totalPalabras palabras. Retorna false si están incompletos o no son válidos.
+bool validarDiferenciaPalabras(const uint8_t* datos, size_t bytesDatos, size_t totalPalabras);
+
+// Función para aplicar una diferencia codificada (ya validada con validarDiferenciaPalabras) a una generación de totalPalabras palabras, combinándola con XOR.
+void aplicarDiferenciaPalabras(uint64_t* celulas, size_t totalPalabras, const uint8_t* datos, size_t bytesDatos);
+
+// PROTOTIPOS DE FUNCIONES PARA GRABAR UNA SIMULACIÓN
+
+// Función para crear el archivo ruta, grabar la generación actual de la cuadrícula como primera clave (con la regla de la cuadrícula) e iniciar el hilo que escribe las generaciones siguientes, con una clave cada intervaloClaves generaciones (0 = INTERVALO_CLAVES_DEFECTO). Retorna NULL si no se pudo crear el archivo o el hilo.
+Grabador* crearGrabador(Cuadricula* cuadricula, const char* ruta, uint64_t intervaloClaves);
+
+// Función para copiar la generación actual de la cuadrícula y pedir que se grabe en segundo plano. Solo espera si hay FOTOGRAMAS_COLA_GRABACION generaciones pendientes. Retorna false (sin grabarla) si no es la generación siguiente a la última grabada (por ejemplo, tras reiniciar la cuadrícula) o si falló alguna escritura; en ese caso la grabación termina en la última generación grabada.
+bool registrarGeneracionGrabacion(Grabador* grabador, Cuadricula* cuadricula);
+
+// Función para esperar a que se escriban las generaciones pendientes, escribir el índice de claves, cerrar el archivo y liberar los recursos. Si info no es NULL, se completa con la información de la grabación. Retorna false si falló alguna escritura.
+bool finalizarGrabador(Grabador* grabador, InfoGrabacion* info);
+
+// PROTOTIPOS DE FUNCIONES PARA REPRODUCIR UNA GRABACIÓN
+
+// Función para abrir una grabación y ubicarse en su primera generación. Si info no es NULL, se completa con la información de la grabación. Retorna NULL si el archivo no existe, no es una grabación válida o no hay memoria suficiente.
+Reproduccion* abrirReproduccion(const char* ruta, InfoGrabacion* info);
+
+// Función para obtener el fotograma con la generación actual de la reproducción (válido hasta la siguiente llamada que cambie de generación).
+const Fotograma* obtenerFotogramaReproduccion(Reproduccion* reproduccion);
+
+// Función para ir a una generación cualquiera, partiendo de la clave más cercana anterior (o de la generación actual, si está más cerca). Retorna false si la generación no está grabada o los datos de algún registro están dañados (en ese caso, la reproducción queda en la última generación que se pudo reconstruir).
+bool irAGeneracionReproduccion(Reproduccion* reproduccion, uint64_t numGeneracion);
+
+// Función para avanzar (direccion > 0) o retroceder (direccion < 0) una generación. Retorna false si no hay más generaciones en esa dirección o sus datos están dañados.
+bool avanzarReproduccion(Reproduccion* reproduccion, int direccion);
+
+// Función para ir a la clave siguiente (direccion > 0) o a la anterior a la generación actual (direccion < 0). Retorna false si no hay más claves en esa dirección.
+bool irAClaveReproduccion(Reproduccion* reproduccion, int direccion);
+
+// Función para cerrar una grabación abierta y liberar sus recursos.
+void cerrarReproduccion(Reproduccion* reproduccion);
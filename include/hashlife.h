@@ -0,0 +1,58 @@
+#pragma once
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "game.h"
+
+// Este archivo contiene las definiciones y prototipos del motor HashLife: una alternativa a Cuadricula que representa el universo como un quadtree con nodos canónicos (hash-consing) y resultados memorizados, lo que permite avanzar 2^k generaciones de una sola vez.
+// NOTA: A diferencia de Cuadricula, el universo de HashLife es un plano ilimitado (sin wrapping toroidal), con coordenadas de 64 bits con signo.
+
+// Límite de nodos por defecto antes de recolectar los nodos que ya no se usan (~64 MB).
+#define LIMITE_NODOS_HASHLIFE_DEFECTO (1u << 20)
+
+// Exponente máximo para avanzarPotenciaHashLife (2^60 generaciones por salto), para que las coordenadas del universo quepan en 64 bits.
+#define EXPONENTE_MAXIMO_HASHLIFE 60
+
+// Estructura opaca que representa el universo de HashLife (su contenido se define en hashlife.c).
+typedef struct UniversoHashLife UniversoHashLife;
+
+// PROTOTIPOS DE FUNCIONES PARA MANEJAR EL UNIVERSO DE HASHLIFE
+
+// Función para crear un universo vacío. limiteNodos indica cuántos nodos se conservan antes de recolectar los que ya no se usan (0 = LIMITE_NODOS_HASHLIFE_DEFECTO).
+UniversoHashLife* crearUniversoHashLife(size_t limiteNodos);
+
+// Función para crear un universo con las células vivas de la generación actual de una cuadrícula (la célula (x, y) de la cuadrícula pasa a la posición (x, y) del universo).
+UniversoHashLife* crearUniversoHashLifeDesdeCuadricula(Cuadricula* cuadricula, size_t limiteNodos);
+
+// Función para liberar la memoria asignada a un universo.
+void liberarUniversoHashLife(UniversoHashLife* universo);
+
+// Función para establecer el estado de una célula. Retorna false si no hay memoria suficiente o la coordenada está fuera del rango del universo (ver limiteCoordenadasAlcanzadoHashLife).
+bool establecerCelulaHashLife(UniversoHashLife* universo, int64_t x, int64_t y, bool viva);
+
+// Función para obtener el estado de una célula.
+bool obtenerEstadoCelulaHashLife(UniversoHashLife* universo, int64_t x, int64_t y);
+
+// Función para avanzar 2^exponente generaciones de una sola vez (exponente <= EXPONENTE_MAXIMO_HASHLIFE). Retorna false si no hay memoria suficiente o el patrón saldría del rango de coordenadas (ver limiteCoordenadasAlcanzadoHashLife).
+bool avanzarPotenciaHashLife(UniversoHashLife* universo, unsigned exponente);
+
+// Función para avanzar un número arbitrario de generaciones, descomponiéndolo en saltos de potencias de 2. Retorna false si no hay memoria suficiente o el patrón saldría del rango de coordenadas (ver limiteCoordenadasAlcanzadoHashLife).
+bool avanzarGeneracionesHashLife(UniversoHashLife* universo, uint64_t generaciones);
+
+// Función para obtener el número de generación actual.
+uint64_t obtenerNumGeneracionHashLife(UniversoHashLife* universo);
+
+// Función para contar las células vivas del universo.
+uint64_t contarPoblacionHashLife(UniversoHashLife* universo);
+
+// Función para cambiar el límite de nodos antes de recolectar los que ya no se usan (0 = LIMITE_NODOS_HASHLIFE_DEFECTO).
+void configurarLimiteNodosHashLife(UniversoHashLife* universo, size_t limiteNodos);
+
+// Función para cambiar la regla B/S con que se calculan las generaciones (B3/S23 por defecto). Retorna false (sin cambiarla) si la regla es NULL o hace nacer células sin vecinas (B0), que llenarían el plano ilimitado.
+bool configurarReglaHashLife(UniversoHashLife* universo, const Regla* regla);
+
+// Función para saber si la última operación que falló lo hizo porque el patrón saldría del rango de coordenadas de 64 bits (y no por falta de memoria).
+bool limiteCoordenadasAlcanzadoHashLife(UniversoHashLife* universo);
+
+// Función para obtener el número de nodos almacenados actualmente.
+size_t obtenerNumNodosHashLife(UniversoHashLife* universo);
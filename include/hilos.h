@@ -0,0 +1,28 @@
+#pragma once
+#include <stddef.h>
+#include <stdbool.h>
+
+// Este archivo contiene las definiciones y prototipos de un pool de hilos persistente, que reparte tareas numeradas entre sus hilos mediante robo de trabajo (work-stealing).
+
+// Tipo de las funciones que ejecuta el pool: reciben el contexto compartido, el índice de la tarea y el índice del hilo que la ejecuta (0 es el hilo que llamó a ejecutarEnParalelo).
+typedef void (*FuncionTarea)(void* contexto, size_t tarea, unsigned hilo);
+
+// Estructura opaca que representa el pool de hilos (su contenido se define en hilos.c).
+typedef struct PoolHilos PoolHilos;
+
+// PROTOTIPOS DE FUNCIONES PARA MANEJAR EL POOL DE HILOS
+
+// Función para crear un pool con el número de hilos indicado (incluyendo al hilo que llama). Si numHilos es 0, se usa el número de núcleos disponibles.
+PoolHilos* crearPoolHilos(unsigned numHilos);
+
+// Función para detener los hilos del pool y liberar sus recursos.
+void liberarPoolHilos(PoolHilos* pool);
+
+// Función para obtener el número de hilos del pool (incluyendo al hilo que llama).
+unsigned obtenerNumHilosPool(const PoolHilos* pool);
+
+// Función para ejecutar las tareas [0, numTareas) repartidas entre los hilos del pool. Retorna cuando todas las tareas han terminado (barrera).
+void ejecutarEnParalelo(PoolHilos* pool, size_t numTareas, FuncionTarea funcion, void* contexto);
+
+// Función para obtener el número de núcleos disponibles para el proceso (los de su afinidad en Linux, o los del sistema).
+unsigned detectarNumNucleos(void);
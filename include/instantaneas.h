@@ -0,0 +1,43 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "game.h"
+#include "fotogramas.h"
+#include "patrones.h"
+
+// Este archivo contiene las definiciones y prototipos de las instantáneas: archivos binarios con una generación completa de la cuadrícula (dimensiones, número de generación, regla y células empaquetadas), para guardar una simulación larga y reanudarla más tarde.
+
+// Definición de la información de una instantánea leída.
+typedef struct {
+    unsigned ancho;                         // Dimensiones de la cuadrícula
+    unsigned alto;
+    uint64_t numGeneracion;                 // Generación guardada
+    bool comprimida;                        // Indica si se omitieron los bloques vacíos
+    char regla[LONGITUD_MAXIMA_REGLA];      // Regla con que se calculó la simulación
+} InfoInstantanea;
+
+// Estructura opaca que representa el hilo que escribe las instantáneas en segundo plano (su contenido se define en instantaneas.c).
+typedef struct EscritorInstantaneas EscritorInstantaneas;
+
+// PROTOTIPOS DE FUNCIONES PARA GUARDAR Y CARGAR INSTANTÁNEAS
+
+// Función para guardar un fotograma en una instantánea, con la regla indicada (NULL = REGLA_CONWAY). Los bloques vacíos se omiten si así el archivo es más pequeño. El archivo se reemplaza de forma atómica (nunca queda una instantánea a medio escribir). Retorna false si no se pudo escribir.
+bool guardarInstantanea(const Fotograma* fotograma, const char* ruta, const char* regla);
+
+// Función para crear una cuadrícula a partir de una instantánea, en la generación guardada y con la regla guardada (B3/S23 si no es una regla B/S válida). Si info no es NULL, se completa con la información de la instantánea. Retorna NULL si el archivo no existe, no es una instantánea válida (o está dañada) o no hay memoria suficiente.
+Cuadricula* cargarInstantanea(const char* ruta, InfoInstantanea* info);
+
+// Función para crear un hilo que escribe en segundo plano las instantáneas de una cuadrícula de las dimensiones indicadas en el archivo ruta, con la regla indicada (NULL = REGLA_CONWAY). Retorna NULL si no se pudo crear el hilo.
+EscritorInstantaneas* crearEscritorInstantaneas(uint32_t ancho, uint32_t alto, const char* ruta, const char* regla);
+
+// Función para copiar la generación actual de la cuadrícula y pedir que se escriba en segundo plano (no espera a la escritura). Si aún no se escribió la instantánea anterior, se reemplaza por esta.
+void solicitarInstantanea(EscritorInstantaneas* escritor, Cuadricula* cuadricula);
+
+// Función para esperar a que se escriban las instantáneas pedidas. Retorna false si alguna no se pudo escribir.
+bool esperarInstantaneas(EscritorInstantaneas* escritor);
+
+// Función para obtener el número de instantáneas escritas hasta el momento.
+uint64_t contarInstantaneasEscritas(EscritorInstantaneas* escritor);
+
+// Función para esperar las instantáneas pendientes, detener el hilo y liberar sus recursos.
+void liberarEscritorInstantaneas(EscritorInstantaneas* escritor);
@@ -3,6 +3,8 @@
 #include <stdint.h>
 #include <ncurses.h>
 #include "game.h"
+#include "fotogramas.h"
+#include "metricas.h"
 
 // Este archivo contiene las definiciones y prototipos necesarios para implementar la interfaz de usuario del Juego de la Vida de Conway, utilizando la biblioteca ncurses para la representación visual en la terminal.
 
@@ -11,6 +13,46 @@
 #define VELOCIDAD_MINIMA 1000   // Velocidad más lenta (1 s entre generaciones)
 #define VELOCIDAD_DEFECTO 200   // Velocidad por defecto (5 generaciones por segundo)
 #define VELOCIDAD_PASO 50       // Paso de ajuste de velocidad (-/+ 50 ms al aumentar o disminuir)
+#define VELOCIDAD_LIBRE 0       // Sin pausas entre generaciones (solo con el hilo de simulación separado)
+
+// Nivel de zoom máximo de la vista (cada punto braille representa 2^(NIVEL_MAXIMO_VISTA - 1) x 2^(NIVEL_MAXIMO_VISTA - 1) células).
+#define NIVEL_MAXIMO_VISTA 24
+
+// Definición de la vista de la cuadrícula: la región que se dibuja en la ventana y su nivel de detalle.
+typedef struct {
+    int64_t x;          // Columna de la célula en la esquina superior izquierda de la vista
+    int64_t y;          // Fila de la célula en la esquina superior izquierda de la vista
+    int nivel;          // Nivel de zoom: 0 = un carácter por célula; n > 0 = un carácter braille de 2x4 puntos, cada uno con el resumen de un bloque de 2^(n-1) x 2^(n-1) células
+    int columnas;       // Caracteres dibujados en el último cuadro
+    int filas;
+} Vista;
+
+// Definición del estado de una reproducción (ver grabacion.c) que se muestra en el panel inferior.
+typedef struct {
+    uint64_t numGeneracion;         // Generación mostrada
+    uint64_t primeraGeneracion;     // Primera y última generación grabadas
+    uint64_t ultimaGeneracion;
+    uint64_t intervaloClaves;       // Generaciones entre dos claves
+    uint64_t numClaves;             // Claves de la grabación
+    uint64_t bytes;                 // Tamaño del archivo
+    bool indiceReconstruido;        // El índice se reconstruyó porque la grabación no se cerró
+    int velocidad;                  // ms entre generaciones (VELOCIDAD_LIBRE = sin pausas)
+    bool enReproduccion;            // Indica si la reproducción avanza sola (true) o está en pausa (false)
+    bool haciaAtras;                // Indica si la reproducción avanza hacia las generaciones anteriores
+    const char* destino;            // Generación que se está escribiendo para saltar a ella (NULL = ninguna)
+} EstadoReproduccion;
+
+// Definición del estado de un espectador conectado a un servidor (ver servidor.c) que se muestra en el panel inferior.
+typedef struct {
+    const char* direccion;          // Dirección del servidor
+    uint64_t numGeneracion;         // Generación mostrada
+    int velocidad;                  // ms entre generaciones del servidor (VELOCIDAD_LIBRE = sin pausas)
+    bool conectado;                 // false = el servidor terminó o se perdió la conexión
+    uint64_t fotogramas;            // Generaciones recibidas (0 = aún no se recibió ninguna)
+    uint64_t claves;                // Generaciones recibidas completas
+    uint64_t saltadas;              // Generaciones que el servidor no envió a este espectador
+    uint64_t bytes;                 // Bytes recibidos
+} EstadoEspectador;
 
 // Función para inicializar la interfaz de usuario (a través de una ventana de ncurses).
 void inicializarInterfaz(void);
@@ -24,11 +66,29 @@ WINDOW* crearVentana(void);
 // Función para eliminar una ventana de ncurses y liberar sus recursos.
 void cerrarVentana(WINDOW* ventana);
 
-// Función para dibujar la cuadrícula en la ventana de ncurses.
-void dibujarCuadricula(WINDOW* ventana, Cuadricula* cuadricula);
+// Función para dibujar la región de la cuadrícula indicada por la vista en la ventana de ncurses (NULL = la esquina superior izquierda, sin zoom).
+void dibujarCuadricula(WINDOW* ventana, Cuadricula* cuadricula, Vista* vista);
+
+// Función para dibujar la región de un fotograma (una generación de la cuadrícula) indicada por la vista en la ventana de ncurses. La posición y el nivel de la vista se ajustan para que no salgan de la cuadrícula, y se actualizan sus columnas y filas dibujadas.
+void dibujarFotograma(WINDOW* ventana, const Fotograma* fotograma, Vista* vista);
+
+// Función para desplazar la vista un cuarto del área visible en la dirección indicada (-1, 0 o 1 en cada eje).
+void desplazarVista(Vista* vista, int direccionX, int direccionY);
+
+// Función para cambiar el nivel de zoom de la vista (delta > 0 = alejar), manteniendo el centro del área visible.
+void cambiarNivelVista(Vista* vista, int delta);
+
+// Función para mostrar el panel de estado y controles en la ventana de ncurses, incluyendo la regla con que se calculan las generaciones (NULL = REGLA_CONWAY) y la posición y escala de la vista (NULL = sin vista).
+void mostrarPanelEstado(WINDOW* ventana, uint64_t numGeneracion, int velocidadEvolucion, bool programaEnEjecucion, const char* regla, const Vista* vista);
+
+// Función para mostrar el resumen de las métricas (generaciones y células por segundo, población, nacimientos, muertes y tiempos de cada fase) en el panel inferior. Si resumen es NULL, indica que aún se está midiendo el primer intervalo.
+void mostrarPanelMetricas(WINDOW* ventana, const ResumenMetricas* resumen);
+
+// Función para mostrar el panel inferior de una reproducción: su estado (generación, velocidad y dirección), la regla (NULL = REGLA_CONWAY) y la vista (NULL = sin vista), la información de la grabación y los controles.
+void mostrarPanelReproduccion(WINDOW* ventana, const EstadoReproduccion* estado, const char* regla, const Vista* vista);
 
-// Función para mostrar el panel de estado y controles en la ventana de ncurses.
-void mostrarPanelEstado(WINDOW* ventana, uint64_t numGeneracion, int velocidadEvolucion, bool programaEnEjecucion);
+// Función para mostrar el panel inferior de un espectador: su estado (generación, velocidad del servidor y conexión), la regla (NULL = REGLA_CONWAY) y la vista (NULL = sin vista), lo recibido del servidor y los controles.
+void mostrarPanelEspectador(WINDOW* ventana, const EstadoEspectador* estado, const char* regla, const Vista* vista);
 
 // Función para actualizar la ventana de ncurses para reflejar los cambios realizados en el buffer.
 void actualizarVentana(WINDOW* ventana);
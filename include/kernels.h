@@ -0,0 +1,41 @@
+#pragma once
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "reglas.h"
+
+// Este archivo contiene las definiciones y prototipos de los kernels que calculan la siguiente generación de una fila empaquetada, en versión escalar y vectorial (SIMD).
+
+// Implementaciones disponibles del kernel de cálculo.
+typedef enum {
+    KERNEL_AUTOMATICO = 0,  // La mejor implementación soportada por el procesador (detectada una sola vez)
+    KERNEL_ESCALAR,         // Palabras de 64 bits (referencia; disponible en todas las plataformas)
+    KERNEL_SSE2,            // Vectores de 128 bits (2 palabras por instrucción)
+    KERNEL_AVX2,            // Vectores de 256 bits (4 palabras por instrucción)
+    KERNEL_AVX512,          // Vectores de 512 bits (8 palabras por instrucción)
+    NUM_TIPOS_KERNEL
+} TipoKernel;
+
+// Tipo de las funciones que calculan las palabras [0, numPalabras) de una fila de la generación siguiente, a partir de la fila superior, actual e inferior, según la regla (ver reglas.h). Retornan el OR de (siguiente ^ actual) de todas las palabras calculadas (distinto de 0 si alguna célula cambió).
+// NOTA: Las tres filas de entrada deben tener palabras válidas en los índices -1 y numPalabras (el borde fantasma o las palabras vecinas).
+typedef uint64_t (*KernelFila)(uint64_t* siguiente, const uint64_t* arriba, const uint64_t* actual, const uint64_t* abajo, size_t numPalabras, const Regla* regla);
+
+// Tipo de las funciones que suman a nacimientos y muertes los bits que aparecen (0 -> 1) y desaparecen (1 -> 0) entre las palabras [0, numPalabras) de anterior y siguiente.
+typedef void (*ContadorCambios)(const uint64_t* anterior, const uint64_t* siguiente, size_t numPalabras, uint64_t* nacimientos, uint64_t* muertes);
+
+// PROTOTIPOS DE FUNCIONES PARA SELECCIONAR EL KERNEL
+
+// Función para detectar (una sola vez, mediante CPUID) la mejor implementación soportada por el procesador.
+TipoKernel detectarMejorKernel(void);
+
+// Función para saber si el procesador soporta una implementación.
+bool kernelDisponible(TipoKernel tipo);
+
+// Función para obtener la función de una implementación para una regla (NULL si el procesador no la soporta). KERNEL_AUTOMATICO retorna la mejor disponible. La regla de Conway (o NULL) usa kernels especializados; el kernel retornado debe llamarse siempre con esa misma regla.
+KernelFila obtenerKernelFila(TipoKernel tipo, const Regla* regla);
+
+// Función para obtener el contador de cambios más rápido soportado por el procesador (con la instrucción POPCNT, si existe).
+ContadorCambios obtenerContadorCambios(void);
+
+// Función para obtener el nombre de una implementación (por ejemplo, "avx2").
+const char* obtenerNombreKernel(TipoKernel tipo);
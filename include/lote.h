@@ -0,0 +1,11 @@
+#pragma once
+#include "argumentos.h"
+#include "game.h"
+
+// Este archivo contiene los prototipos del modo sin interfaz: calcula un número fijo de generaciones sin usar ncurses y muestra un resumen con la población final y el rendimiento.
+
+// Función para crear la cuadrícula inicial de las opciones (también la usa el servidor, ver servidor.c): desde la instantánea de --reanudar, el patrón de --patron (centrado en una cuadrícula de al menos --ancho x --alto) o una configuración aleatoria, con la regla de --regla si se indicó. Muestra en stdout el archivo leído. Retorna NULL (tras mostrar el error en stderr) si no se pudo crear.
+Cuadricula* crearCuadriculaInicial(const Opciones* opciones);
+
+// Función para ejecutar la simulación sin interfaz con las opciones indicadas. Retorna el código de salida del programa (0 si no hubo errores).
+int ejecutarLote(const Opciones* opciones);
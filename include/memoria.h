@@ -0,0 +1,35 @@
+#pragma once
+#include <stddef.h>
+#include <stdbool.h>
+
+// Este archivo contiene las definiciones y prototipos para reservar los bloques grandes de memoria (las generaciones de la cuadrícula y los fotogramas) con páginas grandes, que reducen los fallos de la TLB al recorrer cuadrículas de miles de millones de células.
+
+// Tamaño de una página grande (en bytes). Los bloques más pequeños se reservan con aligned_alloc.
+#define TAMANO_PAGINA_GRANDE ((size_t)2 * 1024 * 1024)
+
+// Tipos de páginas con que se puede reservar un bloque.
+typedef enum {
+    PAGINAS_NORMALES = 0,       // Páginas del tamaño base del sistema
+    PAGINAS_TRANSPARENTES,      // Páginas grandes transparentes (el núcleo agrupa las páginas del bloque, madvise(MADV_HUGEPAGE))
+    PAGINAS_GRANDES,            // Páginas grandes explícitas (mmap con MAP_HUGETLB, si el sistema tiene páginas reservadas)
+    NUM_TIPOS_PAGINAS
+} TipoPaginas;
+
+// Definición de un bloque de memoria reservado con reservarBloqueMemoria.
+typedef struct {
+    void* direccion;            // Inicio del bloque (alineado a la línea de caché, o a TAMANO_PAGINA_GRANDE si se proyectó con mmap)
+    size_t bytes;               // Bytes reservados (los pedidos, redondeados al tamaño de página si se proyectó con mmap)
+    bool proyectado;            // Indica si el bloque se reservó con mmap (y no con aligned_alloc)
+    TipoPaginas paginas;        // Tipo de páginas del bloque
+} BloqueMemoria;
+
+// PROTOTIPOS DE FUNCIONES PARA RESERVAR BLOQUES DE MEMORIA
+
+// Función para reservar un bloque de al menos bytes bytes, con todas sus palabras en 0. Los bloques de TAMANO_PAGINA_GRANDE bytes o más se proyectan con mmap (con páginas grandes explícitas o, si no hay, transparentes) y sus páginas no se tocan hasta que se escriben por primera vez, por lo que el primer hilo que escribe cada página decide en qué nodo NUMA queda. Retorna false si no hay memoria suficiente.
+bool reservarBloqueMemoria(BloqueMemoria* bloque, size_t bytes);
+
+// Función para liberar un bloque reservado con reservarBloqueMemoria (se admite un bloque vacío).
+void liberarBloqueMemoria(BloqueMemoria* bloque);
+
+// Función para obtener el nombre de un tipo de páginas (por ejemplo, "transparentes").
+const char* obtenerNombrePaginas(TipoPaginas paginas);
@@ -0,0 +1,88 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "game.h"
+
+// Este archivo contiene las definiciones y prototipos de las métricas de rendimiento: tiempos de cada fase del bucle principal (mínimo, promedio y p99), generaciones y células por segundo, población, nacimientos y muertes, resumidos por intervalos y exportados opcionalmente como líneas CSV o JSON.
+
+// Duración (en segundos) de cada intervalo de las métricas: el resumen se actualiza y se escribe una línea al terminar cada intervalo.
+#define INTERVALO_METRICAS 1.0
+
+// Fases medidas del bucle principal.
+typedef enum {
+    FASE_ENTRADA = 0,   // Lectura y procesamiento del teclado
+    FASE_CALCULO,       // Cálculo de una generación (calcularCuadriculaSiguiente)
+    FASE_DIBUJO,        // Dibujo de la cuadrícula y del panel en el buffer de ncurses
+    FASE_REFRESCO,      // Envío del buffer a la terminal (wrefresh)
+    NUM_FASES_METRICAS
+} FaseMetricas;
+
+// Formatos del archivo de métricas.
+typedef enum {
+    FORMATO_METRICAS_CSV = 0,   // Una fila por intervalo, con una cabecera con los nombres de las columnas
+    FORMATO_METRICAS_JSON       // Un objeto JSON por línea (JSON Lines)
+} FormatoMetricas;
+
+// Definición de los tiempos de una fase en un intervalo (en microsegundos).
+typedef struct {
+    uint64_t muestras;          // Veces que se ejecutó la fase
+    double minimo;
+    double promedio;
+    double p99;                 // Percentil 99 (con un error relativo de hasta 1/16, ver metricas.c)
+    double maximo;
+} TiemposFase;
+
+// Definición del resumen de un intervalo de las métricas.
+typedef struct {
+    double tiempo;                      // Segundos desde la creación de las métricas hasta el final del intervalo
+    double duracion;                    // Duración del intervalo (en segundos)
+    uint64_t numGeneracion;             // Última generación registrada
+    uint64_t generaciones;              // Generaciones calculadas en el intervalo
+    double generacionesPorSegundo;
+    double celulasPorSegundo;
+    uint64_t poblacion;                 // Población de la última generación registrada
+    double nacimientosPorGeneracion;    // Promedio del intervalo
+    double muertesPorGeneracion;        // Promedio del intervalo
+    TiemposFase fases[NUM_FASES_METRICAS];
+} ResumenMetricas;
+
+// Estructura opaca que representa las métricas (su contenido se define en metricas.c).
+typedef struct Metricas Metricas;
+
+// PROTOTIPOS DE FUNCIONES PARA REGISTRAR Y EXPORTAR MÉTRICAS
+
+// Función para crear las métricas de una simulación de celulasPorGeneracion células. Si ruta no es NULL, se escribe una línea por intervalo en ese archivo con el formato indicado. Retorna NULL si no se pudo crear el archivo o no hay memoria suficiente.
+Metricas* crearMetricas(uint64_t celulasPorGeneracion, const char* ruta, FormatoMetricas formato);
+
+// Función para cerrar el intervalo en curso (escribiendo su línea) y el archivo de métricas. Retorna false si alguna línea no se pudo escribir. Después solo se puede llamar a liberarMetricas.
+bool finalizarMetricas(Metricas* metricas);
+
+// Función para liberar las métricas (si no se finalizaron, se finalizan antes).
+void liberarMetricas(Metricas* metricas);
+
+// Función para obtener el instante actual (en nanosegundos, de un reloj monótono), que marca el inicio de una fase.
+uint64_t obtenerInstanteMetricas(void);
+
+// Función para registrar una fase que empezó en el instante inicio y termina ahora. Se puede llamar desde varios hilos. Si metricas es NULL, no hace nada.
+void registrarFase(Metricas* metricas, FaseMetricas fase, uint64_t inicio);
+
+// Función para registrar una generación calculada, con su población y sus nacimientos y muertes. Se puede llamar desde varios hilos. Si metricas es NULL, no hace nada.
+void registrarGeneracionMetricas(Metricas* metricas, uint64_t numGeneracion, uint64_t poblacion, uint64_t nacimientos, uint64_t muertes);
+
+// Función para registrar la generación actual de una cuadrícula, con su población y, si el conteo de cambios está activado (ver configurarConteoCambios), sus nacimientos y muertes. Si metricas es NULL, no hace nada.
+void registrarGeneracionCuadricula(Metricas* metricas, Cuadricula* cuadricula);
+
+// Función para cerrar el intervalo en curso si ya pasaron INTERVALO_METRICAS segundos, actualizando el resumen y escribiendo su línea. Retorna true si se cerró un intervalo.
+bool actualizarMetricas(Metricas* metricas);
+
+// Función para obtener el resumen del último intervalo cerrado. Retorna false si aún no se cerró ninguno.
+bool obtenerResumenMetricas(Metricas* metricas, ResumenMetricas* resumen);
+
+// Función para obtener los tiempos de una fase desde la creación de las métricas (todos los intervalos).
+TiemposFase obtenerTiemposTotalesFase(Metricas* metricas, FaseMetricas fase);
+
+// Función para obtener el formato de métricas que corresponde a la extensión de un archivo (.json o .jsonl = JSON; cualquier otra = CSV).
+FormatoMetricas obtenerFormatoMetricasPorExtension(const char* ruta);
+
+// Función para obtener el nombre de una fase (por ejemplo, "calculo").
+const char* obtenerNombreFase(FaseMetricas fase);
@@ -0,0 +1,35 @@
+#pragma once
+#include <stdbool.h>
+#include "game.h"
+#include "fotogramas.h"
+#include "reglas.h"
+
+// Este archivo contiene las definiciones y prototipos para leer y escribir patrones en los formatos estándar RLE (.rle) y texto plano (.cells).
+
+// Formatos de archivo de patrones.
+typedef enum {
+    FORMATO_RLE = 0,        // Run Length Encoded: "x = ancho, y = alto, rule = B3/S23" seguido de tramos como "3o2b$"
+    FORMATO_TEXTO_PLANO     // Plaintext (.cells): una línea por fila, con 'O' para las células vivas y '.' para las muertas
+} FormatoPatron;
+
+// Definición de la información de un patrón leído.
+typedef struct {
+    FormatoPatron formato;
+    unsigned ancho;                         // Dimensiones del patrón
+    unsigned alto;
+    char regla[LONGITUD_MAXIMA_REGLA];      // Regla indicada en el patrón (REGLA_CONWAY si no indica ninguna)
+} InfoPatron;
+
+// PROTOTIPOS DE FUNCIONES PARA LEER Y ESCRIBIR PATRONES
+
+// Función para crear una cuadrícula con el patrón de un archivo (RLE o texto plano, detectado por su contenido), centrado en la cuadrícula, que calcula las generaciones con la regla del patrón (B3/S23 si no indica una regla B/S válida). La cuadrícula mide al menos anchoMinimo x altoMinimo, o más si el patrón es más grande. Si info no es NULL, se completa con la información del patrón. Retorna NULL si el archivo no existe, no es válido o no cabe en una cuadrícula.
+Cuadricula* crearCuadriculaDesdePatron(const char* ruta, uint32_t anchoMinimo, uint32_t altoMinimo, InfoPatron* info);
+
+// Función para reemplazar las células de una cuadrícula por el patrón de un archivo, centrado, y reiniciar el número de generación (la regla de la cuadrícula no cambia). Retorna false (sin modificar la cuadrícula) si el archivo no es válido o el patrón no cabe en la cuadrícula.
+bool cargarPatronEnCuadricula(Cuadricula* cuadricula, const char* ruta, InfoPatron* info);
+
+// Función para guardar un fotograma (por ejemplo, la vista de una cuadrícula) en un archivo, con la regla indicada (NULL = REGLA_CONWAY). Retorna false si no se pudo escribir el archivo.
+bool guardarPatron(const Fotograma* fotograma, const char* ruta, FormatoPatron formato, const char* regla);
+
+// Función para elegir el formato según la extensión del archivo (".cells" o ".txt" = texto plano; cualquier otra = RLE).
+FormatoPatron obtenerFormatoPorExtension(const char* ruta);
@@ -0,0 +1,40 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+// Este archivo contiene las definiciones y prototipos de las reglas "life-like" (totalísticas externas) en notación B/S, como B3/S23 (Conway), B36/S23 (HighLife) o B3678/S34678 (Day & Night), compiladas una sola vez en una tabla de transición que usan los kernels de cálculo.
+
+// Regla del Juego de la Vida de Conway, en notación B/S (la regla por defecto).
+#define REGLA_CONWAY "B3/S23"
+// Longitud máxima (incluyendo el '\0') del texto de una regla.
+#define LONGITUD_MAXIMA_REGLA 64
+// Número de valores posibles de vecinas vivas (0 a 8).
+#define NUM_VALORES_VECINAS 9
+// Número de máscaras de la tabla de transición compilada (ver compilarRegla en reglas.c).
+#define NUM_MASCARAS_REGLA 18
+
+// Definición de una regla compilada.
+typedef struct {
+    uint16_t nacimiento;                        // Bit n = una célula muerta con n vecinas vivas nace
+    uint16_t supervivencia;                     // Bit n = una célula viva con n vecinas vivas sobrevive
+    bool esConway;                              // Indica si es B3/S23 (los kernels usan entonces su versión especializada)
+    uint64_t mascaras[NUM_MASCARAS_REGLA];      // Tabla de transición compilada: cada entrada es 0 o ~0, para aplicarla bit a bit a 64 células a la vez
+    char texto[LONGITUD_MAXIMA_REGLA];          // Regla en notación B/S canónica (por ejemplo, "B36/S23")
+} Regla;
+
+// PROTOTIPOS DE FUNCIONES PARA INTERPRETAR Y COMPILAR REGLAS
+
+// Función para interpretar una regla en notación B/S ("B36/S23"), con las partes invertidas ("S23/B36") o en la notación antigua S/B ("23/36"), y compilar su tabla de transición. Retorna false (sin modificar regla) si el texto no es una regla válida.
+bool compilarRegla(const char* texto, Regla* regla);
+
+// Función para obtener la regla de Conway (B3/S23) ya compilada.
+const Regla* obtenerReglaConway(void);
+
+// Función para saber si una regla en notación B/S (o la notación antigua S/B, como "23/3") corresponde al Juego de la Vida de Conway.
+bool esReglaConway(const char* texto);
+
+// Función para saber si con la regla nacen células sin vecinas vivas (B0). Estas reglas llenan el espacio vacío, por lo que solo se pueden calcular en la cuadrícula toroidal.
+bool reglaNaceSinVecinas(const Regla* regla);
+
+// Función para obtener el estado siguiente de una célula según la regla, a partir de su estado y del número de vecinas vivas (0 a 8).
+bool aplicarRegla(const Regla* regla, bool viva, unsigned vecinasVivas);
@@ -0,0 +1,91 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "argumentos.h"
+#include "game.h"
+#include "fotogramas.h"
+
+// Este archivo contiene las definiciones y prototipos del servidor de fotogramas: una sola simulación que envía cada generación, como diferencia con la anterior, a varios espectadores conectados por un socket local (de dominio Unix o TCP en la interfaz de loopback).
+
+// Espectadores conectados a la vez; las conexiones siguientes se rechazan.
+#define ESPECTADORES_MAXIMOS 64
+// Valor máximo de --velocidad (en ms entre generaciones).
+#define ESPERA_MAXIMA_SERVIDOR 60000
+
+// Definición de una dirección del servidor: "[localhost|127.0.0.1]:PUERTO" es un puerto TCP de la interfaz de loopback; cualquier otro texto es la ruta de un socket de dominio Unix.
+typedef struct {
+    bool tcp;                   // true = TCP en 127.0.0.1; false = socket de dominio Unix
+    uint16_t puerto;            // Puerto TCP (solo si tcp)
+    const char* ruta;           // Ruta del socket (solo si no es tcp; apunta al texto interpretado)
+} DireccionServidor;
+
+// Definición del resumen de un servidor, desde que se creó.
+typedef struct {
+    uint64_t conexiones;        // Espectadores que se conectaron
+    uint64_t rechazados;        // Conexiones rechazadas por haber ESPECTADORES_MAXIMOS espectadores
+    unsigned espectadores;      // Espectadores conectados en este momento
+    uint64_t fotogramas;        // Generaciones publicadas
+    uint64_t diferencias;       // Mensajes con la diferencia con la generación anterior
+    uint64_t claves;            // Mensajes con una generación completa
+    uint64_t omitidos;          // Generaciones que no se enviaron a un espectador porque aún no terminaba de recibir la anterior
+    uint64_t bytes;             // Bytes enviados a todos los espectadores
+} ResumenServidor;
+
+// Definición del estado de una conexión con el servidor, visto por el espectador.
+typedef struct {
+    uint32_t ancho;             // Dimensiones de la cuadrícula del servidor
+    uint32_t alto;
+    char regla[LONGITUD_MAXIMA_REGLA]; // Regla con que se calcula la simulación
+    bool conectada;             // false = el servidor cerró la conexión o envió datos no válidos
+    int velocidad;              // ms entre generaciones del servidor (0 = sin pausas)
+    uint64_t fotogramas;        // Generaciones recibidas
+    uint64_t claves;            // Generaciones recibidas completas (la primera y las que siguen a un atraso)
+    uint64_t saltadas;          // Generaciones que no se recibieron: el servidor envía como mucho --fps por segundo, y ninguna a un espectador atrasado
+    uint64_t bytes;             // Bytes recibidos
+} EstadoConexion;
+
+// Estructura opaca que representa un servidor con sus espectadores (su contenido se define en servidor.c).
+typedef struct Servidor Servidor;
+
+// Estructura opaca que representa la conexión de un espectador con un servidor (su contenido se define en servidor.c).
+typedef struct Conexion Conexion;
+
+// Función para interpretar una dirección del servidor. Retorna false si no es válida (un puerto fuera de rango, un equipo que no es local o una ruta vacía o demasiado larga).
+bool interpretarDireccionServidor(const char* texto, DireccionServidor* direccion);
+
+// PROTOTIPOS DE FUNCIONES PARA ENVIAR FOTOGRAMAS
+
+// Función para crear un servidor en la dirección indicada para una cuadrícula de ancho x alto calculada con la regla indicada. Una ruta de un socket de un servidor que ya no existe se reemplaza. Retorna NULL (tras mostrar el error en stderr) si la dirección no es válida o está en uso.
+Servidor* crearServidor(const char* direccion, uint32_t ancho, uint32_t alto, const char* regla);
+
+// Función para enviar un fotograma (con las filas una tras otra, como los del buffer triple) a todos los espectadores, sin bloquear: cada uno recibe la diferencia con el fotograma anterior o, si se atrasó, la generación completa. A un espectador que aún no terminó de recibir el mensaje anterior no se le envía nada.
+void publicarFotogramaServidor(Servidor* servidor, const Fotograma* fotograma, int velocidad);
+
+// Función para aceptar conexiones, continuar los envíos pendientes y cerrar las conexiones terminadas, esperando eventos hasta esperaMaxima ms. Un espectador atrasado que termina de recibir recibe enseguida la última generación completa.
+void atenderServidor(Servidor* servidor, int esperaMaxima);
+
+// Función para obtener el resumen del servidor.
+void obtenerResumenServidor(const Servidor* servidor, ResumenServidor* resumen);
+
+// Función para avisar a los espectadores que la simulación terminó, cerrar sus conexiones y el servidor (eliminando la ruta del socket) y liberar sus recursos.
+void cerrarServidor(Servidor* servidor);
+
+// Función para ejecutar la simulación indicada en las opciones como servidor (--servidor) hasta recibir SIGINT o SIGTERM, y mostrar su resumen en stdout. Retorna el código de salida del programa (0 si no hubo errores).
+int ejecutarServidor(const Opciones* opciones);
+
+// PROTOTIPOS DE FUNCIONES PARA RECIBIR FOTOGRAMAS
+
+// Función para conectarse a un servidor y recibir la presentación (dimensiones y regla). Retorna NULL (tras mostrar el error en stderr) si no se pudo conectar o el servidor no es compatible.
+Conexion* conectarServidor(const char* direccion);
+
+// Función para recibir, sin bloquear, los mensajes disponibles y aplicarlos a la generación de la conexión. Si nuevo no es NULL, indica si cambió la generación. Retorna false si la conexión se cerró (ya no se reciben más mensajes).
+bool recibirConexion(Conexion* conexion, bool* nuevo);
+
+// Función para obtener el fotograma con la última generación recibida (NULL si aún no se recibió ninguna).
+const Fotograma* obtenerFotogramaConexion(const Conexion* conexion);
+
+// Función para obtener el estado de la conexión.
+void obtenerEstadoConexion(const Conexion* conexion, EstadoConexion* estado);
+
+// Función para cerrar la conexión y liberar sus recursos.
+void cerrarConexion(Conexion* conexion);
@@ -0,0 +1,37 @@
+#pragma once
+#include <stdbool.h>
+#include "game.h"
+#include "fotogramas.h"
+#include "metricas.h"
+#include "grabacion.h"
+
+// Este archivo contiene los prototipos del hilo de simulación: calcula las generaciones de una cuadrícula por su cuenta (sin esperar al dibujo) y publica cada generación completa en un buffer triple.
+
+// Estructura opaca que representa la simulación (su contenido se define en simulacion.c).
+typedef struct Simulacion Simulacion;
+
+// PROTOTIPOS DE FUNCIONES PARA MANEJAR LA SIMULACIÓN
+
+// Función para iniciar el hilo de simulación sobre una cuadrícula (en pausa). Desde este momento, la cuadrícula solo debe usarse a través de la simulación. velocidad indica los ms entre generaciones (0 = sin pausas). Si metricas no es NULL, el hilo registra en ellas el tiempo de cálculo de cada generación y sus cambios. Si grabador no es NULL, el hilo graba cada generación calculada hasta que se reinicie la cuadrícula (el grabador no se finaliza).
+Simulacion* iniciarSimulacion(Cuadricula* cuadricula, int velocidad, Metricas* metricas, Grabador* grabador);
+
+// Función para detener el hilo de simulación y liberar sus recursos (la cuadrícula no se libera).
+void detenerSimulacion(Simulacion* simulacion);
+
+// Función para alternar entre ejecución y pausa.
+void alternarEjecucionSimulacion(Simulacion* simulacion);
+
+// Función para saber si la simulación está en ejecución.
+bool simulacionEnEjecucion(Simulacion* simulacion);
+
+// Función para avanzar una generación (solo si la simulación está en pausa).
+void avanzarGeneracionSimulacion(Simulacion* simulacion);
+
+// Función para restablecer la cuadrícula a un estado inicial y poner la simulación en pausa.
+void reiniciarSimulacion(Simulacion* simulacion);
+
+// Función para cambiar los ms entre generaciones (0 = sin pausas).
+void configurarVelocidadSimulacion(Simulacion* simulacion, int velocidad);
+
+// Función (solo para el hilo de dibujo) para obtener la última generación completa. Si nuevo no es NULL, indica si cambió desde la llamada anterior.
+const Fotograma* obtenerUltimoFotogramaSimulacion(Simulacion* simulacion, bool* nuevo);
@@ -0,0 +1,68 @@
+#pragma once
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Este archivo contiene la interfaz pública de la biblioteca del Juego de la Vida (libvida.a y libvida.so, con make biblioteca), para incrustar el simulador en otros programas. No depende de los demás encabezados del proyecto: la cuadrícula se maneja a través de un puntero opaco.
+
+// Versión de la interfaz: cambia si alguna función cambia de firma o de comportamiento.
+#define VERSION_INTERFAZ_VIDA 1
+
+// Las células se entregan empaquetadas en palabras de 64 bits: el bit b de la palabra p de una fila corresponde a la célula en la columna (p * 64 + b).
+#define BITS_POR_PALABRA_VIDA 64
+#define PALABRAS_POR_FILA_VIDA(ancho) (((size_t)(ancho) + BITS_POR_PALABRA_VIDA - 1) / BITS_POR_PALABRA_VIDA)
+
+// En la biblioteca compartida solo se exportan las funciones de este archivo (los demás módulos se compilan con visibilidad oculta).
+#if defined(__GNUC__)
+#define FUNCION_VIDA __attribute__((visibility("default")))
+#else
+#define FUNCION_VIDA
+#endif
+
+// Estructura opaca que representa una cuadrícula toroidal con sus dos generaciones (su contenido se define en vida.c).
+// NOTA: Cada Vida se puede usar desde un solo hilo a la vez; dos Vida distintas son independientes.
+typedef struct Vida Vida;
+
+// PROTOTIPOS DE FUNCIONES PARA CREAR Y AVANZAR UNA CUADRÍCULA
+
+// Función para crear una cuadrícula de ancho x alto células con ~porcentaje% de células vivas, generadas a partir de una semilla (la misma semilla produce siempre la misma cuadrícula; 0% = vacía), que calcula las generaciones con la regla indicada (notación B/S; NULL = B3/S23) y numHilos hilos (0 = todos los núcleos disponibles). Retorna NULL si las dimensiones, el porcentaje o la regla no son válidos, o si no hay memoria suficiente.
+FUNCION_VIDA Vida* crearVida(uint32_t ancho, uint32_t alto, uint64_t semilla, unsigned porcentaje, const char* regla, unsigned numHilos);
+
+// Función para liberar la memoria asignada a una cuadrícula.
+FUNCION_VIDA void liberarVida(Vida* vida);
+
+// Función para avanzar la cuadrícula n generaciones en una sola llamada (con bloqueo temporal, si se configuró con configurarPasadaVida). Retorna el número de generación alcanzado.
+FUNCION_VIDA uint64_t avanzarN(Vida* vida, uint64_t n);
+
+// Función para configurar cuántas generaciones calcula avanzarN en cada pasada por los bloques de la cuadrícula (1 = sin bloqueo temporal, por defecto; como máximo 64). Retorna false si el valor no es válido.
+FUNCION_VIDA bool configurarPasadaVida(Vida* vida, unsigned generaciones);
+
+// Función para dejar todas las células muertas y reiniciar el número de generación (por ejemplo, antes de escribir un patrón con escribirRegionVida).
+FUNCION_VIDA void limpiarVida(Vida* vida);
+
+// PROTOTIPOS DE FUNCIONES PARA CONSULTAR Y MODIFICAR LAS CÉLULAS
+
+// Función para obtener las dimensiones de la cuadrícula (ancho y alto pueden ser NULL).
+FUNCION_VIDA void obtenerDimensionesVida(const Vida* vida, uint32_t* ancho, uint32_t* alto);
+
+// Función para obtener el número de generación actual.
+FUNCION_VIDA uint64_t obtenerGeneracionVida(const Vida* vida);
+
+// Función para obtener, sin copiarlas, las células de la generación actual: la fila y empieza en el puntero retornado + y * palabrasEntreFilas y ocupa PALABRAS_POR_FILA_VIDA(ancho) palabras (los bits sobrantes de la última palabra están en 0). Retorna NULL si vida es NULL.
+// NOTA: El puntero deja de ser válido al avanzar la cuadrícula (las generaciones se intercambian), y las células no se deben modificar a través de él (ver escribirRegionVida).
+FUNCION_VIDA const uint64_t* obtenerCelulasVida(const Vida* vida, size_t* palabrasEntreFilas);
+
+// Función para copiar las células de la región de anchoRegion x altoRegion células con esquina en (x, y): la fila j de la región se escribe en destino + j * palabrasEntreFilas, empaquetada a partir de la columna x (PALABRAS_POR_FILA_VIDA(anchoRegion) palabras, con los bits sobrantes en 0). Retorna false si la región no está dentro de la cuadrícula o palabrasEntreFilas es menor que el ancho de la región.
+FUNCION_VIDA bool leerRegionVida(Vida* vida, uint32_t x, uint32_t y, uint32_t anchoRegion, uint32_t altoRegion, uint64_t* destino, size_t palabrasEntreFilas);
+
+// Función para reemplazar las células de la región de anchoRegion x altoRegion células con esquina en (x, y) por las de origen, empaquetadas como en leerRegionVida (los bits posteriores al ancho de la región se ignoran). Retorna false si la región no está dentro de la cuadrícula o palabrasEntreFilas es menor que el ancho de la región.
+FUNCION_VIDA bool escribirRegionVida(Vida* vida, uint32_t x, uint32_t y, uint32_t anchoRegion, uint32_t altoRegion, const uint64_t* origen, size_t palabrasEntreFilas);
+
+// Función para contar las células vivas de la generación actual.
+FUNCION_VIDA uint64_t contarPoblacionVida(Vida* vida);
+
+// Función para contar las células vivas de la región de anchoRegion x altoRegion células con esquina en (x, y), recortando la región a la cuadrícula.
+FUNCION_VIDA uint64_t contarPoblacionRegionVida(Vida* vida, uint32_t x, uint32_t y, uint32_t anchoRegion, uint32_t altoRegion);
+
+// Función para obtener el hash de 64 bits de la generación actual (dos generaciones con las mismas células tienen el mismo hash; es el mismo que muestra el modo sin interfaz).
+FUNCION_VIDA uint64_t obtenerHashVida(Vida* vida);
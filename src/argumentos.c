@@ -0,0 +1,353 @@
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <getopt.h>
+#include "../include/argumentos.h"
+#include "../include/game.h"
+#include "../include/grabacion.h"
+#include "../include/servidor.h"
+
+//  ================================================
+//  Conway's Game of Life - Argumentos
+//  ================================================
+//  Este módulo interpreta los argumentos de la línea de comandos mediante getopt_long, validando cada valor antes de iniciar el programa.
+
+// Nombres de los motores, en el orden de TipoMotor.
+static const char* const NOMBRES_MOTOR[NUM_TIPOS_MOTOR] = {"cuadricula", "disperso", "hashlife"};
+
+// Nombres de los transportes, en el orden de TipoTransporte.
+static const char* const NOMBRES_TRANSPORTE[NUM_TIPOS_TRANSPORTE] = {"memoria", "socket"};
+
+// Identificadores de las opciones largas (a partir de 256, para no confundirlos con las opciones cortas).
+enum {
+    OPCION_SIN_INTERFAZ = 256,
+    OPCION_ANCHO,
+    OPCION_ALTO,
+    OPCION_SEMILLA,
+    OPCION_RELLENO,
+    OPCION_GENERACIONES,
+    OPCION_MOTOR,
+    OPCION_HILOS,
+    OPCION_KERNEL,
+    OPCION_DESACOPLADO,
+    OPCION_FPS,
+    OPCION_PATRON,
+    OPCION_GUARDAR,
+    OPCION_REANUDAR,
+    OPCION_INSTANTANEA,
+    OPCION_CADA,
+    OPCION_DETENER_PERIODO,
+    OPCION_REGLA,
+    OPCION_CENSO,
+    OPCION_METRICAS,
+    OPCION_PASADA,
+    OPCION_PROCESOS,
+    OPCION_TRANSPORTE,
+    OPCION_GRABAR,
+    OPCION_CLAVES,
+    OPCION_REPRODUCIR,
+    OPCION_SERVIDOR,
+    OPCION_CONECTAR,
+    OPCION_VELOCIDAD
+};
+
+// Función para convertir un texto en un número entero sin signo dentro del rango [minimo, maximo]. Retorna false si el texto no es un número válido.
+static bool leerNumero(const char* texto, uint64_t minimo, uint64_t maximo, uint64_t* valor) {
+    if (texto == NULL || *texto < '0' || *texto > '9') {
+        return false;
+    }
+    char* fin;
+    errno = 0;
+    unsigned long long numero = strtoull(texto, &fin, 10);
+    if (errno != 0 || *fin != '\0' || numero < minimo || numero > maximo) {
+        return false;
+    }
+    *valor = (uint64_t)numero;
+    return true;
+}
+
+// Función para interpretar los argumentos de la línea de comandos, completando las opciones no indicadas con sus valores por defecto. Retorna false (tras mostrar el error en stderr) si algún argumento no es válido.
+bool analizarArgumentos(int argc, char* argv[], Opciones* opciones) {
+    // Valores por defecto (los mismos que usa el modo interactivo).
+    opciones->sinInterfaz = false;
+    opciones->mostrarAyuda = false;
+    opciones->desacoplado = false;
+    opciones->detenerPeriodo = false;
+    opciones->fotogramasPorSegundo = FOTOGRAMAS_POR_SEGUNDO_DEFECTO;
+    opciones->ancho = ANCHO_CUADRICULA;
+    opciones->alto = ALTO_CUADRICULA;
+    opciones->semilla = (uint64_t)time(NULL);
+    opciones->porcentaje = PORCENTAJE_CELULAS_VIVAS_DEFECTO;
+    opciones->generaciones = GENERACIONES_DEFECTO;
+    opciones->motor = MOTOR_CUADRICULA;
+    opciones->numHilos = 1;
+    opciones->kernel = KERNEL_AUTOMATICO;
+    opciones->patron = NULL;
+    opciones->guardar = NULL;
+    opciones->reanudar = NULL;
+    opciones->instantanea = NULL;
+    opciones->intervaloInstantaneas = 0;
+    opciones->regla = NULL;
+    opciones->metricas = NULL;
+    opciones->numSopas = 0;
+    opciones->generacionesPorPasada = 1;
+    opciones->numProcesos = 0;
+    opciones->transporte = TRANSPORTE_MEMORIA;
+    opciones->grabar = NULL;
+    opciones->intervaloClaves = INTERVALO_CLAVES_DEFECTO;
+    opciones->reproducir = NULL;
+    opciones->servidor = NULL;
+    opciones->conectar = NULL;
+    opciones->velocidad = 0;
+
+    static const struct option opcionesLargas[] = {
+        {"sin-interfaz", no_argument, NULL, OPCION_SIN_INTERFAZ},
+        {"ancho", required_argument, NULL, OPCION_ANCHO},
+        {"alto", required_argument, NULL, OPCION_ALTO},
+        {"semilla", required_argument, NULL, OPCION_SEMILLA},
+        {"relleno", required_argument, NULL, OPCION_RELLENO},
+        {"generaciones", required_argument, NULL, OPCION_GENERACIONES},
+        {"motor", required_argument, NULL, OPCION_MOTOR},
+        {"hilos", required_argument, NULL, OPCION_HILOS},
+        {"kernel", required_argument, NULL, OPCION_KERNEL},
+        {"desacoplado", no_argument, NULL, OPCION_DESACOPLADO},
+        {"fps", required_argument, NULL, OPCION_FPS},
+        {"patron", required_argument, NULL, OPCION_PATRON},
+        {"guardar", required_argument, NULL, OPCION_GUARDAR},
+        {"reanudar", required_argument, NULL, OPCION_REANUDAR},
+        {"instantanea", required_argument, NULL, OPCION_INSTANTANEA},
+        {"cada", required_argument, NULL, OPCION_CADA},
+        {"detener-periodo", no_argument, NULL, OPCION_DETENER_PERIODO},
+        {"regla", required_argument, NULL, OPCION_REGLA},
+        {"censo", required_argument, NULL, OPCION_CENSO},
+        {"metricas", required_argument, NULL, OPCION_METRICAS},
+        {"pasada", required_argument, NULL, OPCION_PASADA},
+        {"procesos", required_argument, NULL, OPCION_PROCESOS},
+        {"transporte", required_argument, NULL, OPCION_TRANSPORTE},
+        {"grabar", required_argument, NULL, OPCION_GRABAR},
+        {"claves", required_argument, NULL, OPCION_CLAVES},
+        {"reproducir", required_argument, NULL, OPCION_REPRODUCIR},
+        {"servidor", required_argument, NULL, OPCION_SERVIDOR},
+        {"conectar", required_argument, NULL, OPCION_CONECTAR},
+        {"velocidad", required_argument, NULL, OPCION_VELOCIDAD},
+        {"ayuda", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+
+    int opcion, indice = 0;
+    uint64_t valor = 0;
+    bool valido = true;
+    bool hilosIndicados = false;
+    optind = 1;
+    while (valido && (opcion = getopt_long(argc, argv, "h", opcionesLargas, &indice)) != -1) {
+        switch (opcion) {
+            case 'h':
+                opciones->mostrarAyuda = true;
+                break;
+            case OPCION_SIN_INTERFAZ:
+                opciones->sinInterfaz = true;
+                break;
+            case OPCION_DESACOPLADO:
+                opciones->desacoplado = true;
+                break;
+            case OPCION_DETENER_PERIODO:
+                opciones->detenerPeriodo = true;
+                break;
+            case OPCION_FPS:
+                valido = leerNumero(optarg, 1, 1000, &valor);
+                opciones->fotogramasPorSegundo = (unsigned)valor;
+                break;
+            case OPCION_PATRON:
+                opciones->patron = optarg;
+                break;
+            case OPCION_GUARDAR:
+                opciones->guardar = optarg;
+                break;
+            case OPCION_REANUDAR:
+                opciones->reanudar = optarg;
+                break;
+            case OPCION_INSTANTANEA:
+                opciones->instantanea = optarg;
+                break;
+            case OPCION_METRICAS:
+                opciones->metricas = optarg;
+                break;
+            case OPCION_GRABAR:
+                opciones->grabar = optarg;
+                break;
+            case OPCION_CLAVES:
+                valido = leerNumero(optarg, 1, UINT32_MAX, &opciones->intervaloClaves);
+                break;
+            case OPCION_REPRODUCIR:
+                opciones->reproducir = optarg;
+                break;
+            case OPCION_SERVIDOR:
+            case OPCION_CONECTAR: {
+                DireccionServidor direccion;
+                valido = interpretarDireccionServidor(optarg, &direccion);
+                if (opcion == OPCION_SERVIDOR) {
+                    opciones->servidor = optarg;
+                } else {
+                    opciones->conectar = optarg;
+                }
+                break;
+            }
+            case OPCION_VELOCIDAD:
+                valido = leerNumero(optarg, 0, ESPERA_MAXIMA_SERVIDOR, &valor);
+                opciones->velocidad = (int)valor;
+                break;
+            case OPCION_REGLA: {
+                Regla regla;
+                valido = compilarRegla(optarg, &regla);
+                opciones->regla = optarg;
+                break;
+            }
+            case OPCION_CENSO:
+                valido = leerNumero(optarg, 1, UINT64_MAX, &opciones->numSopas);
+                break;
+            case OPCION_PASADA:
+                valido = leerNumero(optarg, 1, GENERACIONES_POR_PASADA_MAXIMA, &valor);
+                opciones->generacionesPorPasada = (unsigned)valor;
+                break;
+            case OPCION_PROCESOS:
+                valido = leerNumero(optarg, 1, PROCESOS_MAXIMOS, &valor);
+                opciones->numProcesos = (unsigned)valor;
+                break;
+            case OPCION_TRANSPORTE:
+                valido = false;
+                for (int transporte = 0; transporte < NUM_TIPOS_TRANSPORTE; transporte++) {
+                    if (strcmp(optarg, NOMBRES_TRANSPORTE[transporte]) == 0) {
+                        opciones->transporte = (TipoTransporte)transporte;
+                        valido = true;
+                    }
+                }
+                break;
+            case OPCION_CADA:
+                valido = leerNumero(optarg, 0, UINT64_MAX, &opciones->intervaloInstantaneas);
+                break;
+            case OPCION_ANCHO:
+                valido = leerNumero(optarg, 1, DIMENSION_MAXIMA, &valor);
+                opciones->ancho = (uint32_t)valor;
+                break;
+            case OPCION_ALTO:
+                valido = leerNumero(optarg, 1, DIMENSION_MAXIMA, &valor);
+                opciones->alto = (uint32_t)valor;
+                break;
+            case OPCION_SEMILLA:
+                valido = leerNumero(optarg, 0, UINT64_MAX, &opciones->semilla);
+                break;
+            case OPCION_RELLENO:
+                valido = leerNumero(optarg, 0, 100, &valor);
+                opciones->porcentaje = (unsigned)valor;
+                break;
+            case OPCION_GENERACIONES:
+                valido = leerNumero(optarg, 0, UINT64_MAX, &opciones->generaciones);
+                break;
+            case OPCION_HILOS:
+                valido = leerNumero(optarg, 0, UINT16_MAX, &valor);
+                opciones->numHilos = (unsigned)valor;
+                hilosIndicados = true;
+                break;
+            case OPCION_MOTOR:
+                valido = false;
+                for (int motor = 0; motor < NUM_TIPOS_MOTOR; motor++) {
+                    if (strcmp(optarg, NOMBRES_MOTOR[motor]) == 0) {
+                        opciones->motor = (TipoMotor)motor;
+                        valido = true;
+                    }
+                }
+                break;
+            case OPCION_KERNEL:
+                valido = false;
+                for (int kernel = 0; kernel < NUM_TIPOS_KERNEL; kernel++) {
+                    if (strcmp(optarg, obtenerNombreKernel((TipoKernel)kernel)) == 0) {
+                        opciones->kernel = (TipoKernel)kernel;
+                        valido = true;
+                    }
+                }
+                break;
+            default:
+                // getopt_long ya mostró el error (opción desconocida o sin valor).
+                return false;
+        }
+        if (!valido) {
+            fprintf(stderr, "%s: valor no válido para la opción '--%s': '%s'\n", argv[0], opcionesLargas[indice].name, optarg);
+        }
+    }
+    if (valido && optind < argc) {
+        fprintf(stderr, "%s: argumento no reconocido: '%s'\n", argv[0], argv[optind]);
+        valido = false;
+    }
+    // El censo reparte sopas independientes entre los hilos, por lo que usa todos los núcleos salvo que se indique --hilos.
+    if (opciones->numSopas > 0 && !hilosIndicados) {
+        opciones->numHilos = 0;
+    }
+    return valido;
+}
+
+// Función para mostrar la ayuda con las opciones disponibles.
+void mostrarAyuda(FILE* salida, const char* programa) {
+    fprintf(salida,
+        "Uso: %s [opciones]\n"
+        "\n"
+        "Opciones:\n"
+        "  --sin-interfaz        Ejecuta la simulación sin ncurses y muestra solo el resumen final\n"
+        "  --ancho N             Ancho de la cuadrícula (por defecto %d)\n"
+        "  --alto N              Alto de la cuadrícula (por defecto %d)\n"
+        "  --semilla N           Semilla de la configuración inicial (por defecto, la hora actual)\n"
+        "  --relleno P           Porcentaje de células vivas iniciales, de 0 a 100 (por defecto %d)\n"
+        "  --generaciones N      Generaciones a calcular en el modo sin interfaz (por defecto %d)\n"
+        "  --motor M             cuadricula, disperso o hashlife (por defecto cuadricula)\n"
+        "  --hilos N             Número de hilos de los motores cuadricula y disperso; 0 usa todos los núcleos (por defecto 1)\n"
+        "  --kernel K            automatico, escalar, sse2, avx2 o avx512, para el motor cuadricula (por defecto automatico)\n"
+        "  --desacoplado         Calcula las generaciones en un hilo separado del dibujo (modo interactivo)\n"
+        "  --fps N               Cuadros por segundo del dibujo con --desacoplado, o generaciones enviadas por segundo con --servidor,\n"
+        "                        de 1 a 1000 (por defecto %d)\n"
+        "  --patron ARCHIVO      Configuración inicial desde un patrón RLE o de texto plano (.cells), centrado en la cuadrícula\n"
+        "  --guardar ARCHIVO     Guarda la última generación (modo sin interfaz) o la actual con [G] (modo interactivo);\n"
+        "                        .cells o .txt = texto plano, cualquier otra extensión = RLE\n"
+        "  --reanudar ARCHIVO    Reanuda la simulación desde una instantánea (dimensiones y generación incluidas)\n"
+        "  --instantanea ARCHIVO Escribe instantáneas de la simulación en el modo sin interfaz, en segundo plano\n"
+        "  --cada N              Generaciones entre instantáneas; 0 = solo al terminar (por defecto 0)\n"
+        "  --detener-periodo     Termina la simulación sin interfaz cuando la cuadrícula se vuelve estable u oscilante\n"
+        "  --regla B/S           Regla life-like, como B36/S23 o B3678/S34678 (por defecto, la del patrón o la instantánea, o %s);\n"
+        "                        las reglas con B0 solo se pueden calcular con el motor cuadricula\n"
+        "  --metricas ARCHIVO    Escribe cada segundo los tiempos de cada fase (mínimo, promedio y p99), las generaciones y células\n"
+        "                        por segundo, la población y los nacimientos y muertes por generación; .json o .jsonl = JSON Lines,\n"
+        "                        cualquier otra extensión = CSV (motor cuadricula; el modo interactivo las muestra en el panel)\n"
+        "  --pasada K            Generaciones que el motor cuadricula calcula en cada pasada por bloques que caben en la caché\n"
+        "                        (bloqueo temporal), de 1 a %d; sin --metricas ni --detener-periodo (por defecto 1)\n"
+        "  --censo N             Calcula N sopas aleatorias de --ancho x --alto en paralelo (sin interfaz), cada una hasta que se\n"
+        "                        vuelve estable u oscilante o hasta --generaciones, y muestra sus estadísticas; usa todos los núcleos\n"
+        "                        salvo que se indique --hilos\n"
+        "  --procesos N          Reparte la cuadrícula (sin interfaz) entre N procesos, de 1 a %d, cada uno con una franja de filas y\n"
+        "                        --hilos hilos, que intercambian en cada generación solo las filas de los bordes con sus vecinos\n"
+        "  --transporte T        memoria o socket: canal por el que los procesos de --procesos intercambian los bordes (por defecto memoria)\n"
+        "  --grabar ARCHIVO      Graba todas las generaciones calculadas por el motor cuadricula, como diferencias con la anterior,\n"
+        "                        escritas en segundo plano (modo sin interfaz e interactivo)\n"
+        "  --claves N            Generaciones entre las generaciones completas (claves) de --grabar, de 1 a %u (por defecto %d)\n"
+        "  --reproducir ARCHIVO  Reproduce una grabación en la interfaz, hacia adelante o hacia atrás y saltando a cualquier generación;\n"
+        "                        con --sin-interfaz, salta a la generación --generaciones y muestra su población y hash\n",
+        programa, ANCHO_CUADRICULA, ALTO_CUADRICULA, PORCENTAJE_CELULAS_VIVAS_DEFECTO, GENERACIONES_DEFECTO, FOTOGRAMAS_POR_SEGUNDO_DEFECTO, REGLA_CONWAY,
+        GENERACIONES_POR_PASADA_MAXIMA, PROCESOS_MAXIMOS, (unsigned)UINT32_MAX, INTERVALO_CLAVES_DEFECTO);
+    // La ayuda se escribe en dos partes: ISO C solo garantiza literales de hasta 4095 caracteres.
+    fprintf(salida,
+        "  --servidor DIRECCION  Calcula la simulación sin interfaz hasta Ctrl+C y envía sus generaciones, como diferencias con la\n"
+        "                        anterior, a hasta %d espectadores; DIRECCION es [localhost]:PUERTO (TCP solo en 127.0.0.1) o la\n"
+        "                        ruta de un socket de dominio Unix\n"
+        "  --conectar DIRECCION  Muestra en la interfaz las generaciones de un servidor (--servidor) en lugar de calcularlas\n"
+        "  --velocidad MS        ms entre generaciones con --servidor, de 0 a %d; 0 = sin pausas (por defecto 0)\n"
+        "  -h, --ayuda           Muestra esta ayuda\n",
+        ESPECTADORES_MAXIMOS, ESPERA_MAXIMA_SERVIDOR);
+}
+
+// Función para obtener el nombre de un motor (por ejemplo, "disperso").
+const char* obtenerNombreMotor(TipoMotor motor) {
+    return (motor < NUM_TIPOS_MOTOR) ? NOMBRES_MOTOR[motor] : "desconocido";
+}
+
+// Función para obtener el nombre de un transporte (por ejemplo, "socket").
+const char* obtenerNombreTransporte(TipoTransporte transporte) {
+    return (transporte < NUM_TIPOS_TRANSPORTE) ? NOMBRES_TRANSPORTE[transporte] : "desconocido";
+}
@@ -0,0 +1,577 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../include/game.h"
+#include "../include/disperso.h"
+#include "../include/hashlife.h"
+#include "../include/franjas.h"
+
+//  ================================================
+//  Conway's Game of Life - Banco de Pruebas
+//  ================================================
+//  Este programa (make bench) comprueba que todas las implementaciones del cálculo dan el mismo resultado y mide su rendimiento, para comparar
+//  los números entre versiones antes de publicar una nueva.
+//
+//  CARACTERÍSTICAS PRINCIPALES:
+//  1. Conformidad:
+//      - Cada implementación (cada kernel disponible, sin seguimiento de teselas y con bloqueo temporal, con uno y con varios hilos) se calcula a la par que
+//        la implementación de referencia (calcularCuadriculaSiguienteReferencia, célula por célula con contarVecinasVivas), y ambas cuadrículas se
+//        comparan después de cada generación (o de cada pasada, con bloqueo temporal).
+//      - Los casos incluyen cuadrículas aleatorias, de una célula de ancho o de alto, con anchos alrededor de 64 y planeadores que cruzan las
+//        costuras del wrapping toroidal, con la regla de Conway, reglas con tabla de transición y una regla con B0.
+//      - Los motores ilimitados (disperso y HashLife) se comparan con la referencia en una sopa rodeada de un margen que no alcanza a cruzar.
+//      - El cálculo por franjas (ver franjas.c) se compara con la referencia por la población y el hash de la última generación, con cada transporte.
+//      - La lectura, la escritura y el conteo de regiones se comparan con el acceso célula por célula, en regiones al azar de cada caso.
+//
+//  2. Rendimiento:
+//      - Cada implementación se mide en varias dimensiones, densidades y números de hilos, repitiendo las generaciones hasta superar un tiempo mínimo.
+//      - Los motores disperso y HashLife (que usa un solo hilo) se miden con la misma configuración inicial, y el cálculo por franjas con cada
+//        transporte y tantos procesos (de un hilo cada uno) como hilos tiene la medición.
+//
+//  3. Salida:
+//      - Cada resultado es una línea JSON (JSON Lines) en stdout, precedida por una línea con el entorno (compilador, núcleos y mejor kernel);
+//        el progreso y el resumen se muestran en stderr. El programa retorna 1 si alguna implementación no coincide con la referencia.
+
+// Generaciones de cada caso de conformidad, y margen de las sopas de los motores ilimitados (la sopa crece como mucho una célula por generación).
+#define GENERACIONES_CONFORMIDAD 96
+#define LADO_SOPA_MOTORES 48
+
+// Dimensiones y procesos de la comprobación del cálculo por franjas (con 4 procesos, cada franja tiene bandas de borde y de interior).
+#define ANCHO_FRANJAS 131
+#define ALTO_FRANJAS 200
+#define PROCESOS_FRANJAS 4
+
+// Regiones al azar que se leen, escriben y cuentan en cada caso de la comprobación de regiones.
+#define REGIONES_CONFORMIDAD 64
+
+// Tiempo mínimo (en segundos) de cada medición de rendimiento, y generaciones de calentamiento antes de medir.
+#define TIEMPO_MINIMO_MEDICION 0.25
+#define TIEMPO_MINIMO_MEDICION_RAPIDA 0.05
+#define GENERACIONES_CALENTAMIENTO 4
+// Generaciones máximas de una medición de HashLife: en una sopa que ya se estabilizó cada salto cuesta casi lo mismo, y sin límite los planeadores que se
+// alejan terminarían saliendo de las coordenadas de 64 bits antes de alcanzar el tiempo mínimo.
+#define GENERACIONES_MAXIMAS_HASHLIFE ((uint64_t)1 << 40)
+
+// Máximo de implementaciones que se comparan o miden.
+#define MAXIMO_IMPLEMENTACIONES 16
+
+// Definición de una implementación del cálculo de la cuadrícula.
+typedef struct {
+    char nombre[32];
+    TipoKernel kernel;
+    bool seguimientoTeselas;
+    unsigned numHilos;
+    unsigned generacionesPorPasada;
+} Implementacion;
+
+// Definición de un caso de conformidad.
+typedef struct {
+    const char* nombre;
+    uint32_t ancho;
+    uint32_t alto;
+    unsigned porcentaje;
+    bool planeadores;       // Agrega planeadores que cruzan las costuras horizontal y vertical (y la esquina)
+} CasoConformidad;
+
+static const CasoConformidad CASOS_CONFORMIDAD[] = {
+    {"aleatoria", 200, 150, 30, false},
+    {"una-celula", 1, 1, 100, false},
+    {"ancho-1", 1, 97, 50, false},
+    {"alto-1", 130, 1, 50, false},
+    {"minima", 3, 2, 50, false},
+    {"ancho-63", 63, 40, 35, false},
+    {"ancho-64", 64, 64, 35, false},
+    {"ancho-65", 65, 33, 35, false},
+    {"costuras", 70, 50, 0, true},
+    {"costuras-aleatoria", 129, 45, 10, true},
+    {"varios-bloques", 4200, 70, 25, false},
+    {"bandas", 90, 300, 25, false},
+};
+
+static const char* const REGLAS_CONFORMIDAD[] = {"B3/S23", "B36/S23", "B2/S", "B0123478/S01234678"};
+
+// Función para obtener el tiempo actual (en segundos) de un reloj monótono.
+static double obtenerSegundos(void) {
+    struct timespec tiempo;
+    clock_gettime(CLOCK_MONOTONIC, &tiempo);
+    return (double)tiempo.tv_sec + (double)tiempo.tv_nsec / 1e9;
+}
+
+// Función para agregar a la lista de implementaciones las del motor cuadricula disponibles en este procesador, calculadas con numHilos hilos. Retorna el nuevo número de implementaciones.
+static size_t agregarImplementaciones(Implementacion* implementaciones, size_t cantidad, unsigned numHilos) {
+    for (int tipo = KERNEL_ESCALAR; tipo < NUM_TIPOS_KERNEL; tipo++) {
+        if (kernelDisponible((TipoKernel)tipo)) {
+            implementaciones[cantidad] = (Implementacion){"", (TipoKernel)tipo, true, numHilos, 1};
+            snprintf(implementaciones[cantidad++].nombre, sizeof(implementaciones[0].nombre), "%s", obtenerNombreKernel((TipoKernel)tipo));
+        }
+    }
+    // Las variantes usan el mejor kernel disponible.
+    TipoKernel mejor = detectarMejorKernel();
+    implementaciones[cantidad++] = (Implementacion){"sin-teselas", mejor, false, numHilos, 1};
+    implementaciones[cantidad++] = (Implementacion){"pasada-4", mejor, true, numHilos, 4};
+    implementaciones[cantidad] = (Implementacion){"", mejor, true, numHilos, GENERACIONES_POR_PASADA_MAXIMA};
+    snprintf(implementaciones[cantidad++].nombre, sizeof(implementaciones[0].nombre), "pasada-%d", GENERACIONES_POR_PASADA_MAXIMA);
+    return cantidad;
+}
+
+// Función para crear una cuadrícula configurada con una implementación. Retorna NULL si no se pudo crear.
+static Cuadricula* crearCuadriculaImplementacion(const Implementacion* implementacion, uint32_t ancho, uint32_t alto, uint64_t semilla, unsigned porcentaje, const Regla* regla) {
+    Cuadricula* cuadricula = crearCuadriculaConHilos(ancho, alto, semilla, porcentaje, regla, implementacion->numHilos);
+    if (cuadricula == NULL || !seleccionarKernelCuadricula(cuadricula, implementacion->kernel) ||
+        !configurarGeneracionesPorPasada(cuadricula, implementacion->generacionesPorPasada)) {
+        liberarCuadricula(cuadricula);
+        return NULL;
+    }
+    configurarSeguimientoTeselas(cuadricula, implementacion->seguimientoTeselas);
+    return cuadricula;
+}
+
+// Función para agregar a una cuadrícula planeadores que cruzan la costura derecha, la inferior y la esquina del wrapping toroidal.
+static void agregarPlaneadores(Cuadricula* cuadricula) {
+    // Planeador que avanza hacia abajo y a la derecha: sus células relativas a la esquina superior izquierda de su caja de 3 x 3.
+    static const int PLANEADOR[5][2] = {{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}};
+    uint32_t ancho = cuadricula->ancho, alto = cuadricula->alto;
+    const uint32_t esquinas[3][2] = {{ancho - 4, alto / 2}, {ancho / 2, alto - 4}, {ancho - 3, alto - 3}};
+    for (size_t i = 0; i < 3; i++) {
+        for (size_t c = 0; c < 5; c++) {
+            establecerEstadoCelula(cuadricula, (esquinas[i][0] + (uint32_t)PLANEADOR[c][0]) % ancho, (esquinas[i][1] + (uint32_t)PLANEADOR[c][1]) % alto, true);
+        }
+    }
+}
+
+// Función para saber si dos cuadrículas de las mismas dimensiones tienen las mismas células.
+static bool compararCuadriculas(Cuadricula* a, Cuadricula* b) {
+    for (uint32_t y = 0; y < a->alto; y++) {
+        if (memcmp(obtenerFilaCuadricula(a, y), obtenerFilaCuadricula(b, y), a->palabrasPorFila * sizeof(uint64_t)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Función para escribir el resultado de una comparación con la referencia como una línea JSON. Retorna true si coincidió.
+static bool informarConformidad(const char* implementacion, unsigned numHilos, const char* caso, uint32_t ancho, uint32_t alto, const char* regla, uint64_t generaciones, uint64_t primeraDiferencia) {
+    printf("{\"tipo\":\"conformidad\",\"implementacion\":\"%s\",\"hilos\":%u,\"caso\":\"%s\",\"ancho\":%u,\"alto\":%u,\"regla\":\"%s\",\"generaciones\":%llu,\"resultado\":\"%s\"",
+        implementacion, numHilos, caso, (unsigned)ancho, (unsigned)alto, regla, (unsigned long long)generaciones, (primeraDiferencia == 0) ? "ok" : "error");
+    if (primeraDiferencia != 0) {
+        printf(",\"primera_diferencia\":%llu", (unsigned long long)primeraDiferencia);
+        fprintf(stderr, "ERROR: %s (%u hilos) difiere de la referencia en '%s' (%ux%u, %s) en la generacion %llu\n", implementacion, numHilos, caso, (unsigned)ancho, (unsigned)alto, regla,
+            (unsigned long long)primeraDiferencia);
+    }
+    printf("}\n");
+    return primeraDiferencia == 0;
+}
+
+// Función para comparar todas las implementaciones con la referencia en un caso y una regla, generación por generación. Retorna el número de implementaciones que no coincidieron.
+static unsigned comprobarCaso(const CasoConformidad* caso, const char* textoRegla, const Implementacion* implementaciones, size_t numImplementaciones) {
+    Regla regla;
+    compilarRegla(textoRegla, &regla);
+    Cuadricula* referencia = crearCuadriculaConRegla(caso->ancho, caso->alto, 1, caso->porcentaje, &regla);
+    Cuadricula* cuadriculas[MAXIMO_IMPLEMENTACIONES] = {NULL};
+    uint64_t primeraDiferencia[MAXIMO_IMPLEMENTACIONES] = {0};
+    bool creadas = (referencia != NULL);
+    for (size_t i = 0; creadas && i < numImplementaciones; i++) {
+        cuadriculas[i] = crearCuadriculaImplementacion(&implementaciones[i], caso->ancho, caso->alto, 1, caso->porcentaje, &regla);
+        creadas = (cuadriculas[i] != NULL);
+    }
+    unsigned fallos = 0;
+    if (!creadas) {
+        fprintf(stderr, "No se pudieron crear las cuadrículas del caso '%s'.\n", caso->nombre);
+        fallos = (unsigned)numImplementaciones;
+    } else {
+        if (caso->planeadores) {
+            agregarPlaneadores(referencia);
+            for (size_t i = 0; i < numImplementaciones; i++) {
+                agregarPlaneadores(cuadriculas[i]);
+            }
+        }
+        // Las implementaciones con bloqueo temporal avanzan una pasada completa cada vez que la referencia la alcanza (y la última, con las generaciones que falten).
+        for (uint64_t g = 1; g <= GENERACIONES_CONFORMIDAD; g++) {
+            calcularCuadriculaSiguienteReferencia(referencia);
+            for (size_t i = 0; i < numImplementaciones; i++) {
+                unsigned pasada = implementaciones[i].generacionesPorPasada;
+                if (primeraDiferencia[i] != 0 || (g % pasada != 0 && g != GENERACIONES_CONFORMIDAD)) {
+                    continue;
+                }
+                avanzarCuadricula(cuadriculas[i], g - obtenerNumGeneracion(cuadriculas[i]));
+                if (!compararCuadriculas(referencia, cuadriculas[i])) {
+                    primeraDiferencia[i] = g;
+                }
+            }
+        }
+        for (size_t i = 0; i < numImplementaciones; i++) {
+            if (!informarConformidad(implementaciones[i].nombre, implementaciones[i].numHilos, caso->nombre, caso->ancho, caso->alto, textoRegla, GENERACIONES_CONFORMIDAD, primeraDiferencia[i])) {
+                fallos++;
+            }
+        }
+    }
+    for (size_t i = 0; i < numImplementaciones; i++) {
+        liberarCuadricula(cuadriculas[i]);
+    }
+    liberarCuadricula(referencia);
+    return fallos;
+}
+
+// Función para comparar los motores ilimitados con la referencia en una sopa de LADO_SOPA_MOTORES células de lado, rodeada de un margen mayor que las generaciones calculadas. Retorna el número de motores que no coincidieron.
+static unsigned comprobarMotores(const char* textoRegla) {
+    Regla regla;
+    compilarRegla(textoRegla, &regla);
+    uint32_t margen = GENERACIONES_CONFORMIDAD + 2;
+    uint32_t lado = LADO_SOPA_MOTORES + 2 * margen;
+    Cuadricula* sopa = crearCuadriculaConSemilla(LADO_SOPA_MOTORES, LADO_SOPA_MOTORES, 1, 35);
+    Cuadricula* referencia = crearCuadriculaConRegla(lado, lado, 0, 0, &regla);
+    if (sopa == NULL || referencia == NULL) {
+        liberarCuadricula(sopa);
+        liberarCuadricula(referencia);
+        fprintf(stderr, "No se pudieron crear las cuadrículas de los motores.\n");
+        return 2;
+    }
+    for (uint32_t y = 0; y < LADO_SOPA_MOTORES; y++) {
+        for (uint32_t x = 0; x < LADO_SOPA_MOTORES; x++) {
+            establecerEstadoCelula(referencia, x + margen, y + margen, obtenerEstadoCelula(sopa, x, y));
+        }
+    }
+    liberarCuadricula(sopa);
+    UniversoDisperso* disperso = crearUniversoDispersoDesdeCuadricula(referencia);
+    UniversoHashLife* hashlife = crearUniversoHashLifeDesdeCuadricula(referencia, 0);
+    bool creados = disperso != NULL && hashlife != NULL && configurarReglaUniversoDisperso(disperso, &regla) && configurarReglaHashLife(hashlife, &regla);
+    uint64_t diferenciaDisperso = creados ? 0 : 1, diferenciaHashLife = creados ? 0 : 1;
+    for (uint64_t g = 1; creados && g <= GENERACIONES_CONFORMIDAD; g++) {
+        calcularCuadriculaSiguienteReferencia(referencia);
+        calcularUniversoDispersoSiguiente(disperso);
+        avanzarGeneracionesHashLife(hashlife, 1);
+        uint64_t poblacion = contarPoblacion(referencia);
+        bool igualDisperso = (diferenciaDisperso == 0) && contarPoblacionDisperso(disperso) == poblacion;
+        bool igualHashLife = (diferenciaHashLife == 0) && contarPoblacionHashLife(hashlife) == poblacion;
+        for (uint32_t y = 0; (igualDisperso || igualHashLife) && y < lado; y++) {
+            for (uint32_t x = 0; x < lado; x++) {
+                bool viva = obtenerEstadoCelula(referencia, x, y);
+                igualDisperso = igualDisperso && obtenerEstadoCelulaDisperso(disperso, x, y) == viva;
+                igualHashLife = igualHashLife && obtenerEstadoCelulaHashLife(hashlife, x, y) == viva;
+            }
+        }
+        diferenciaDisperso = (diferenciaDisperso == 0 && !igualDisperso) ? g : diferenciaDisperso;
+        diferenciaHashLife = (diferenciaHashLife == 0 && !igualHashLife) ? g : diferenciaHashLife;
+    }
+    unsigned fallos = 0;
+    fallos += !informarConformidad("disperso", 1, "sopa-con-margen", lado, lado, textoRegla, GENERACIONES_CONFORMIDAD, diferenciaDisperso);
+    fallos += !informarConformidad("hashlife", 1, "sopa-con-margen", lado, lado, textoRegla, GENERACIONES_CONFORMIDAD, diferenciaHashLife);
+    liberarUniversoDisperso(disperso);
+    liberarUniversoHashLife(hashlife);
+    liberarCuadricula(referencia);
+    return fallos;
+}
+
+// Función para comparar el cálculo por franjas con la referencia, con cada transporte y con uno y varios procesos. Retorna el número de comprobaciones que no coincidieron.
+static unsigned comprobarFranjas(const char* textoRegla) {
+    Regla regla;
+    compilarRegla(textoRegla, &regla);
+    Cuadricula* referencia = crearCuadriculaConRegla(ANCHO_FRANJAS, ALTO_FRANJAS, 7, 35, &regla);
+    if (referencia == NULL) {
+        fprintf(stderr, "No se pudo crear la cuadrícula de las franjas.\n");
+        return 2 * NUM_TIPOS_TRANSPORTE;
+    }
+    for (uint64_t g = 0; g < GENERACIONES_CONFORMIDAD; g++) {
+        calcularCuadriculaSiguienteReferencia(referencia);
+    }
+    unsigned fallos = 0;
+    static const unsigned PROCESOS[] = {1, PROCESOS_FRANJAS};
+    for (int t = 0; t < NUM_TIPOS_TRANSPORTE; t++) {
+        for (size_t p = 0; p < sizeof(PROCESOS) / sizeof(PROCESOS[0]); p++) {
+            ConfiguracionFranjas configuracion = {
+                .numProcesos = PROCESOS[p],
+                .transporte = (TipoTransporte)t,
+                .ancho = ANCHO_FRANJAS,
+                .alto = ALTO_FRANJAS,
+                .semilla = 7,
+                .porcentaje = 35,
+                .generaciones = GENERACIONES_CONFORMIDAD,
+                .numHilos = 1,
+                .kernel = KERNEL_AUTOMATICO,
+                .regla = &regla
+            };
+            ResumenFranjas resumen;
+            bool igual = calcularFranjas(&configuracion, &resumen) && resumen.poblacion == contarPoblacion(referencia) && resumen.hash == obtenerHashCuadricula(referencia);
+            // Las franjas solo informan la última generación: una diferencia se atribuye a ella.
+            char nombre[32];
+            snprintf(nombre, sizeof(nombre), "franjas-%s-%u", obtenerNombreTransporte((TipoTransporte)t), PROCESOS[p]);
+            fallos += !informarConformidad(nombre, 1, "franjas", ANCHO_FRANJAS, ALTO_FRANJAS, textoRegla, GENERACIONES_CONFORMIDAD, igual ? 0 : GENERACIONES_CONFORMIDAD);
+        }
+    }
+    liberarCuadricula(referencia);
+    return fallos;
+}
+
+// Función para comparar la lectura, la escritura y el conteo de regiones (de 64 en 64 células, ver leerRegionCuadricula) con el acceso célula por célula, en regiones al azar de cada caso de conformidad. Después de las escrituras, la generación siguiente se compara con la referencia, para comprobar que se marcaron las teselas cambiadas. Retorna el número de casos que no coincidieron.
+static unsigned comprobarRegiones(void) {
+    unsigned fallos = 0;
+    for (size_t c = 0; c < sizeof(CASOS_CONFORMIDAD) / sizeof(CASOS_CONFORMIDAD[0]); c++) {
+        const CasoConformidad* caso = &CASOS_CONFORMIDAD[c];
+        Cuadricula* cuadricula = crearCuadriculaConSemilla(caso->ancho, caso->alto, 5, 40);
+        Cuadricula* referencia = crearCuadriculaConSemilla(caso->ancho, caso->alto, 5, 40);
+        size_t palabrasEntreFilas = PALABRAS_POR_FILA(caso->ancho) + 1;
+        uint64_t* region = (uint64_t*)malloc((size_t)caso->alto * palabrasEntreFilas * sizeof(uint64_t));
+        if (cuadricula == NULL || referencia == NULL || region == NULL) {
+            fprintf(stderr, "No se pudieron crear las cuadrículas de las regiones.\n");
+            liberarCuadricula(cuadricula);
+            liberarCuadricula(referencia);
+            free(region);
+            fallos++;
+            continue;
+        }
+        uint64_t estado = 17 + c;
+        uint64_t primeraDiferencia = 0;
+        for (uint64_t r = 1; primeraDiferencia == 0 && r <= REGIONES_CONFORMIDAD; r++) {
+            uint32_t x = (uint32_t)(generarAleatorio(&estado) % caso->ancho);
+            uint32_t y = (uint32_t)(generarAleatorio(&estado) % caso->alto);
+            uint32_t ancho = (uint32_t)(generarAleatorio(&estado) % (caso->ancho - x + 1));
+            uint32_t alto = (uint32_t)(generarAleatorio(&estado) % (caso->alto - y + 1));
+            // Lectura y conteo, contra el estado de cada célula.
+            bool igual = leerRegionCuadricula(cuadricula, x, y, ancho, alto, region, palabrasEntreFilas);
+            uint64_t poblacion = 0;
+            for (uint32_t j = 0; igual && j < alto; j++) {
+                const uint64_t* fila = region + (size_t)j * palabrasEntreFilas;
+                for (size_t i = 0; i < PALABRAS_POR_FILA(ancho) * BITS_POR_PALABRA; i++) {
+                    bool viva = (fila[i / BITS_POR_PALABRA] >> (i % BITS_POR_PALABRA)) & 1u;
+                    igual = igual && viva == (i < ancho && obtenerEstadoCelula(cuadricula, x + (uint32_t)i, y + j));
+                    poblacion += viva;
+                }
+            }
+            igual = igual && contarPoblacionRegion(cuadricula, x, y, ancho, alto) == poblacion;
+            // Escritura de células al azar (con bits sobrantes encendidos, que se deben ignorar), contra establecerEstadoCelula.
+            for (uint32_t j = 0; j < alto; j++) {
+                uint64_t* fila = region + (size_t)j * palabrasEntreFilas;
+                for (size_t p = 0; p < PALABRAS_POR_FILA(ancho); p++) {
+                    fila[p] = generarAleatorio(&estado);
+                }
+                for (uint32_t i = 0; i < ancho; i++) {
+                    establecerEstadoCelula(referencia, x + i, y + j, (fila[i / BITS_POR_PALABRA] >> (i % BITS_POR_PALABRA)) & 1u);
+                }
+            }
+            igual = igual && escribirRegionCuadricula(cuadricula, x, y, ancho, alto, region, palabrasEntreFilas) && compararCuadriculas(cuadricula, referencia);
+            calcularCuadriculaSiguiente(cuadricula);
+            calcularCuadriculaSiguienteReferencia(referencia);
+            igual = igual && compararCuadriculas(cuadricula, referencia);
+            primeraDiferencia = igual ? 0 : r;
+        }
+        fallos += !informarConformidad("regiones", 1, caso->nombre, caso->ancho, caso->alto, "B3/S23", REGIONES_CONFORMIDAD, primeraDiferencia);
+        liberarCuadricula(cuadricula);
+        liberarCuadricula(referencia);
+        free(region);
+    }
+    return fallos;
+}
+
+// Función para escribir una medición de rendimiento como una línea JSON.
+static void informarRendimiento(const char* implementacion, uint32_t lado, unsigned porcentaje, unsigned numHilos, uint64_t generaciones, double segundos) {
+    double celulas = (double)lado * (double)lado * (double)generaciones;
+    printf("{\"tipo\":\"rendimiento\",\"implementacion\":\"%s\",\"ancho\":%u,\"alto\":%u,\"relleno\":%u,\"hilos\":%u,\"generaciones\":%llu,\"segundos\":%.6f,"
+        "\"ns_por_generacion\":%.1f,\"celulas_por_segundo\":%.4e}\n",
+        implementacion, (unsigned)lado, (unsigned)lado, porcentaje, numHilos, (unsigned long long)generaciones, segundos, segundos * 1e9 / (double)generaciones, celulas / segundos);
+    fflush(stdout);
+}
+
+// Función para medir una implementación del motor cuadricula: duplica las generaciones hasta que el cálculo dura al menos tiempoMinimo segundos.
+static void medirCuadricula(const Implementacion* implementacion, uint32_t lado, unsigned porcentaje, double tiempoMinimo) {
+    Cuadricula* cuadricula = crearCuadriculaImplementacion(implementacion, lado, lado, 1, porcentaje, NULL);
+    if (cuadricula == NULL) {
+        fprintf(stderr, "No se pudo crear la cuadrícula de %ux%u para %s.\n", (unsigned)lado, (unsigned)lado, implementacion->nombre);
+        return;
+    }
+    avanzarCuadricula(cuadricula, GENERACIONES_CALENTAMIENTO);
+    uint64_t generaciones = implementacion->generacionesPorPasada;
+    double segundos = 0.0;
+    while (true) {
+        double inicio = obtenerSegundos();
+        avanzarCuadricula(cuadricula, generaciones);
+        segundos = obtenerSegundos() - inicio;
+        if (segundos >= tiempoMinimo) {
+            break;
+        }
+        generaciones *= 2;
+    }
+    informarRendimiento(implementacion->nombre, lado, porcentaje, implementacion->numHilos, generaciones, segundos);
+    liberarCuadricula(cuadricula);
+}
+
+// Función para medir el motor disperso, como medirCuadricula.
+static void medirDisperso(uint32_t lado, unsigned porcentaje, unsigned numHilos, double tiempoMinimo) {
+    UniversoDisperso* universo = crearUniversoDispersoConSemilla(lado, lado, 1, porcentaje);
+    if (universo == NULL || !configurarHilosUniversoDisperso(universo, numHilos)) {
+        liberarUniversoDisperso(universo);
+        fprintf(stderr, "No se pudo crear el universo disperso de %ux%u.\n", (unsigned)lado, (unsigned)lado);
+        return;
+    }
+    uint64_t generaciones = 1;
+    double segundos = 0.0;
+    while (true) {
+        double inicio = obtenerSegundos();
+        for (uint64_t i = 0; i < generaciones; i++) {
+            calcularUniversoDispersoSiguiente(universo);
+        }
+        segundos = obtenerSegundos() - inicio;
+        if (segundos >= tiempoMinimo) {
+            break;
+        }
+        generaciones *= 2;
+    }
+    informarRendimiento("disperso", lado, porcentaje, numHilos, generaciones, segundos);
+    liberarUniversoDisperso(universo);
+}
+
+// Función para medir el motor HashLife, como medirCuadricula (hasta GENERACIONES_MAXIMAS_HASHLIFE generaciones). Las generaciones de cada medición continúan desde la anterior, por lo que los resultados memorizados
+// de las anteriores también se aprovechan (como al avanzar muchas generaciones con --motor hashlife).
+static void medirHashLife(uint32_t lado, unsigned porcentaje, double tiempoMinimo) {
+    Cuadricula* cuadricula = crearCuadriculaConSemilla(lado, lado, 1, porcentaje);
+    UniversoHashLife* universo = (cuadricula != NULL) ? crearUniversoHashLifeDesdeCuadricula(cuadricula, 0) : NULL;
+    liberarCuadricula(cuadricula);
+    if (universo == NULL) {
+        fprintf(stderr, "No se pudo crear el universo de HashLife de %ux%u.\n", (unsigned)lado, (unsigned)lado);
+        return;
+    }
+    uint64_t generaciones = 1;
+    double segundos = 0.0;
+    while (true) {
+        double inicio = obtenerSegundos();
+        bool exito = avanzarGeneracionesHashLife(universo, generaciones);
+        segundos = obtenerSegundos() - inicio;
+        if (!exito) {
+            fprintf(stderr, "No se pudo avanzar el universo de HashLife de %ux%u.\n", (unsigned)lado, (unsigned)lado);
+            liberarUniversoHashLife(universo);
+            return;
+        }
+        if (segundos >= tiempoMinimo || generaciones >= GENERACIONES_MAXIMAS_HASHLIFE) {
+            break;
+        }
+        generaciones *= 2;
+    }
+    informarRendimiento("hashlife", lado, porcentaje, 1, generaciones, segundos);
+    liberarUniversoHashLife(universo);
+}
+
+// Función para medir el cálculo por franjas con numProcesos procesos de un hilo, como medirCuadricula. Cada medición calcula las generaciones desde la configuración
+// inicial, y el tiempo es el de cálculo del proceso más lento (sin la creación de los procesos).
+static void medirFranjas(TipoTransporte transporte, uint32_t lado, unsigned porcentaje, unsigned numProcesos, double tiempoMinimo) {
+    ConfiguracionFranjas configuracion = {
+        .numProcesos = numProcesos,
+        .transporte = transporte,
+        .ancho = lado,
+        .alto = lado,
+        .semilla = 1,
+        .porcentaje = porcentaje,
+        .generaciones = GENERACIONES_CALENTAMIENTO,
+        .numHilos = 1,
+        .kernel = KERNEL_AUTOMATICO,
+        .regla = NULL
+    };
+    ResumenFranjas resumen;
+    while (true) {
+        if (!calcularFranjas(&configuracion, &resumen)) {
+            fprintf(stderr, "No se pudo calcular %ux%u por franjas entre %u procesos.\n", (unsigned)lado, (unsigned)lado, numProcesos);
+            return;
+        }
+        if (resumen.segundos >= tiempoMinimo) {
+            break;
+        }
+        configuracion.generaciones *= 2;
+    }
+    char nombre[32];
+    snprintf(nombre, sizeof(nombre), "franjas-%s-%u", obtenerNombreTransporte(transporte), numProcesos);
+    informarRendimiento(nombre, lado, porcentaje, numProcesos, configuracion.generaciones, resumen.segundos);
+}
+
+// Función para mostrar la ayuda del banco de pruebas.
+static void mostrarAyudaBanco(FILE* salida, const char* programa) {
+    fprintf(salida,
+        "Uso: %s [opciones]\n"
+        "\n"
+        "Comprueba todas las implementaciones contra la referencia y mide su rendimiento; escribe una línea JSON por resultado en stdout.\n"
+        "\n"
+        "Opciones:\n"
+        "  --rapido              Mide menos dimensiones y durante menos tiempo\n"
+        "  --solo-conformidad    No mide el rendimiento\n"
+        "  -h, --ayuda           Muestra esta ayuda\n",
+        programa);
+}
+
+int main(int argc, char* argv[]) {
+    bool rapido = false, soloConformidad = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--rapido") == 0) {
+            rapido = true;
+        } else if (strcmp(argv[i], "--solo-conformidad") == 0) {
+            soloConformidad = true;
+        } else {
+            bool ayuda = strcmp(argv[i], "--ayuda") == 0 || strcmp(argv[i], "-h") == 0;
+            mostrarAyudaBanco(ayuda ? stdout : stderr, argv[0]);
+            return ayuda ? 0 : 1;
+        }
+    }
+    unsigned numNucleos = detectarNumNucleos();
+    // Con un solo núcleo, las implementaciones con hilos usan 3 igualmente, para comprobar el reparto de las bandas y los bloques.
+    unsigned hilosConformidad = (numNucleos > 1) ? numNucleos : 3;
+    printf("{\"tipo\":\"entorno\",\"compilador\":\"%s\",\"nucleos\":%u,\"mejor_kernel\":\"%s\",\"fecha\":%lld}\n",
+        __VERSION__, numNucleos, obtenerNombreKernel(detectarMejorKernel()), (long long)time(NULL));
+
+    // Conformidad: todas las implementaciones contra la referencia, en todos los casos y reglas.
+    Implementacion implementaciones[MAXIMO_IMPLEMENTACIONES];
+    size_t numImplementaciones = agregarImplementaciones(implementaciones, 0, 1);
+    numImplementaciones = agregarImplementaciones(implementaciones, numImplementaciones, hilosConformidad);
+    unsigned fallos = 0, comprobaciones = 0;
+    for (size_t c = 0; c < sizeof(CASOS_CONFORMIDAD) / sizeof(CASOS_CONFORMIDAD[0]); c++) {
+        for (size_t r = 0; r < sizeof(REGLAS_CONFORMIDAD) / sizeof(REGLAS_CONFORMIDAD[0]); r++) {
+            fallos += comprobarCaso(&CASOS_CONFORMIDAD[c], REGLAS_CONFORMIDAD[r], implementaciones, numImplementaciones);
+            comprobaciones += (unsigned)numImplementaciones;
+        }
+        fprintf(stderr, "conformidad: caso '%s' comprobado\n", CASOS_CONFORMIDAD[c].nombre);
+    }
+    // Los motores ilimitados no admiten reglas con B0; las franjas sí.
+    for (size_t r = 0; r < sizeof(REGLAS_CONFORMIDAD) / sizeof(REGLAS_CONFORMIDAD[0]); r++) {
+        fallos += comprobarFranjas(REGLAS_CONFORMIDAD[r]);
+        comprobaciones += 2 * NUM_TIPOS_TRANSPORTE;
+        Regla regla;
+        compilarRegla(REGLAS_CONFORMIDAD[r], &regla);
+        if (!(regla.nacimiento & 1u)) {
+            fallos += comprobarMotores(REGLAS_CONFORMIDAD[r]);
+            comprobaciones += 2;
+        }
+    }
+    fallos += comprobarRegiones();
+    comprobaciones += (unsigned)(sizeof(CASOS_CONFORMIDAD) / sizeof(CASOS_CONFORMIDAD[0]));
+    fprintf(stderr, "conformidad: %u de %u comprobaciones coinciden con la referencia\n", comprobaciones - fallos, comprobaciones);
+    fflush(stdout);
+
+    // Rendimiento: cada implementación en cada dimensión, densidad y número de hilos.
+    if (!soloConformidad) {
+        static const uint32_t LADOS[] = {256, 1024, 4096};
+        static const unsigned PORCENTAJES[] = {3, 30};
+        size_t numLados = rapido ? 2 : sizeof(LADOS) / sizeof(LADOS[0]);
+        double tiempoMinimo = rapido ? TIEMPO_MINIMO_MEDICION_RAPIDA : TIEMPO_MINIMO_MEDICION;
+        unsigned hilos[2] = {1, numNucleos};
+        size_t numHilos = (numNucleos > 1) ? 2 : 1;
+        for (size_t l = 0; l < numLados; l++) {
+            for (size_t p = 0; p < sizeof(PORCENTAJES) / sizeof(PORCENTAJES[0]); p++) {
+                for (size_t h = 0; h < numHilos; h++) {
+                    Implementacion medidas[MAXIMO_IMPLEMENTACIONES];
+                    size_t numMedidas = agregarImplementaciones(medidas, 0, hilos[h]);
+                    for (size_t i = 0; i < numMedidas; i++) {
+                        medirCuadricula(&medidas[i], LADOS[l], PORCENTAJES[p], tiempoMinimo);
+                    }
+                    medirDisperso(LADOS[l], PORCENTAJES[p], hilos[h], tiempoMinimo);
+                    unsigned numProcesos = (hilos[h] < LADOS[l]) ? hilos[h] : (unsigned)LADOS[l];
+                    for (int t = 0; t < NUM_TIPOS_TRANSPORTE; t++) {
+                        medirFranjas((TipoTransporte)t, LADOS[l], PORCENTAJES[p], numProcesos, tiempoMinimo);
+                    }
+                }
+                medirHashLife(LADOS[l], PORCENTAJES[p], tiempoMinimo);
+                fprintf(stderr, "rendimiento: %ux%u al %u%% medido\n", (unsigned)LADOS[l], (unsigned)LADOS[l], PORCENTAJES[p]);
+            }
+        }
+    }
+    if (fallos > 0) {
+        fprintf(stderr, "ERROR: %u comprobaciones no coinciden con la referencia.\n", fallos);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,282 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../include/censo.h"
+#include "../include/hilos.h"
+
+//  ================================================
+//  Conway's Game of Life - Censo de Sopas
+//  ================================================
+//  Este módulo calcula muchas sopas (cuadrículas pequeñas con configuraciones aleatorias independientes) en un solo proceso, para obtener estadísticas
+//  sobre su evolución sin pagar por cada una la creación de un proceso, la inicialización de ncurses ni una semilla tomada de la hora.
+//
+//  CARACTERÍSTICAS PRINCIPALES:
+//  1. Semillas deterministas:
+//      - La sopa i usa como semilla la salida i del generador SplitMix64 iniciado con la semilla del censo, por lo que dos sopas nunca comparten semilla
+//        (salvo colisiones de 64 bits) y el mismo censo produce siempre los mismos resultados, con cualquier número de hilos.
+//      - Cualquier sopa se puede reproducir por separado con --semilla y las mismas dimensiones, relleno y regla.
+//
+//  2. Reparto entre hilos:
+//      - Cada sopa es una tarea del pool de hilos, que las reparte con robo de trabajo: los hilos que terminan antes (sopas que se estabilizan pronto)
+//        roban sopas pendientes de los demás.
+//      - Cada hilo reutiliza una sola cuadrícula (sin pool propio) para todas sus sopas, por lo que el censo no reserva memoria por sopa.
+//
+//  3. Estadísticas:
+//      - Cada sopa se calcula con la detección de períodos de la cuadrícula (ver obtenerPeriodoCuadricula en game.c) hasta que se vuelve estable u oscilante,
+//        o hasta el máximo de generaciones.
+//      - Cada hilo acumula sus resultados en su propio resumen (sin sincronización), y los resúmenes se combinan al terminar. Todas las estadísticas
+//        (sumas, mínimos, máximos e histogramas) son independientes del orden, por lo que el resumen no depende del reparto.
+
+// Estado de cada hilo del censo, alineado a la línea de caché para que los resúmenes de dos hilos no la compartan (evitando el false sharing).
+typedef struct {
+    _Alignas(BYTES_LINEA_CACHE) Cuadricula* cuadricula; // Cuadrícula reutilizada para las sopas del hilo
+    ResumenCenso resumen;                                // Resultados de las sopas del hilo
+} EstadoHiloCenso;
+
+// Contexto compartido por las tareas del censo.
+typedef struct {
+    const ConfiguracionCenso* configuracion;
+    EstadoHiloCenso* hilos;
+} ContextoCenso;
+
+// Función para obtener el tiempo actual (en segundos) de un reloj monótono.
+static double obtenerSegundos(void) {
+    struct timespec tiempo;
+    clock_gettime(CLOCK_MONOTONIC, &tiempo);
+    return (double)tiempo.tv_sec + (double)tiempo.tv_nsec / 1e9;
+}
+
+// Función para obtener la semilla de la sopa indice de un censo (la salida indice del generador SplitMix64 iniciado con la semilla del censo).
+uint64_t obtenerSemillaSopa(uint64_t semilla, uint64_t indice) {
+    // SplitMix64 avanza su estado sumando una constante, por lo que la salida indice se obtiene directamente, sin generar las anteriores.
+    uint64_t estado = semilla + indice * 0x9E3779B97F4A7C15ull;
+    return generarAleatorio(&estado);
+}
+
+// Función para dejar un resumen vacío (los mínimos empiezan en el valor máximo, para que cualquier resultado los reemplace).
+static void iniciarResumen(ResumenCenso* resumen) {
+    memset(resumen, 0, sizeof(ResumenCenso));
+    resumen->estabilizacionMinima = UINT64_MAX;
+    resumen->poblacionMinima = UINT64_MAX;
+}
+
+// Función para obtener el intervalo del histograma de estabilización que corresponde a un número de generaciones (0 para 0, y i para [2^(i-1), 2^i)).
+static unsigned obtenerIntervaloEstabilizacion(uint64_t generaciones) {
+    return (generaciones == 0) ? 0 : (unsigned)(BITS_POR_PALABRA - __builtin_clzll(generaciones));
+}
+
+// Función para agregar al resumen de un hilo el resultado de una sopa.
+static void registrarSopa(ResumenCenso* resumen, uint64_t indice, uint64_t poblacion, uint64_t generaciones, uint64_t periodo, uint64_t inicioPeriodo) {
+    resumen->numSopas++;
+    resumen->generacionesCalculadas += generaciones;
+    resumen->sumaPoblacion += poblacion;
+    if (poblacion < resumen->poblacionMinima) {
+        resumen->poblacionMinima = poblacion;
+    }
+    if (poblacion > resumen->poblacionMaxima) {
+        resumen->poblacionMaxima = poblacion;
+    }
+    // El índice 0 del histograma de períodos cuenta las sopas que no se estabilizaron.
+    resumen->periodos[periodo]++;
+    if (periodo == 0) {
+        return;
+    }
+    resumen->estabilizadas++;
+    if (poblacion == 0) {
+        resumen->extintas++;
+    }
+    resumen->sumaEstabilizacion += inicioPeriodo;
+    resumen->intervalosEstabilizacion[obtenerIntervaloEstabilizacion(inicioPeriodo)]++;
+    if (inicioPeriodo < resumen->estabilizacionMinima) {
+        resumen->estabilizacionMinima = inicioPeriodo;
+    }
+    // Con empates se conserva la sopa de menor índice, para que el resultado no dependa del reparto.
+    if (resumen->estabilizadas == 1 || inicioPeriodo > resumen->estabilizacionMaxima ||
+        (inicioPeriodo == resumen->estabilizacionMaxima && indice < resumen->sopaMasLonga)) {
+        resumen->estabilizacionMaxima = inicioPeriodo;
+        resumen->sopaMasLonga = indice;
+    }
+}
+
+// Función para combinar el resumen de un hilo con el resumen total.
+static void combinarResumen(ResumenCenso* total, const ResumenCenso* parcial) {
+    if (parcial->estabilizadas > 0 && (total->estabilizadas == 0 || parcial->estabilizacionMaxima > total->estabilizacionMaxima ||
+        (parcial->estabilizacionMaxima == total->estabilizacionMaxima && parcial->sopaMasLonga < total->sopaMasLonga))) {
+        total->estabilizacionMaxima = parcial->estabilizacionMaxima;
+        total->sopaMasLonga = parcial->sopaMasLonga;
+    }
+    total->numSopas += parcial->numSopas;
+    total->estabilizadas += parcial->estabilizadas;
+    total->extintas += parcial->extintas;
+    for (size_t i = 0; i <= LONGITUD_HISTORIAL_HASH; i++) {
+        total->periodos[i] += parcial->periodos[i];
+    }
+    for (size_t i = 0; i < NUM_INTERVALOS_ESTABILIZACION; i++) {
+        total->intervalosEstabilizacion[i] += parcial->intervalosEstabilizacion[i];
+    }
+    if (parcial->estabilizacionMinima < total->estabilizacionMinima) {
+        total->estabilizacionMinima = parcial->estabilizacionMinima;
+    }
+    total->sumaEstabilizacion += parcial->sumaEstabilizacion;
+    if (parcial->poblacionMinima < total->poblacionMinima) {
+        total->poblacionMinima = parcial->poblacionMinima;
+    }
+    if (parcial->poblacionMaxima > total->poblacionMaxima) {
+        total->poblacionMaxima = parcial->poblacionMaxima;
+    }
+    total->sumaPoblacion += parcial->sumaPoblacion;
+    total->generacionesCalculadas += parcial->generacionesCalculadas;
+}
+
+// Función para calcular una sopa (tarea del pool) en la cuadrícula del hilo que la ejecuta, hasta que se estabiliza o llega al máximo de generaciones.
+static void calcularSopa(void* contexto, size_t tarea, unsigned hilo) {
+    ContextoCenso* censo = (ContextoCenso*)contexto;
+    const ConfiguracionCenso* configuracion = censo->configuracion;
+    EstadoHiloCenso* estado = &censo->hilos[hilo];
+    Cuadricula* cuadricula = estado->cuadricula;
+
+    // Generamos la configuración inicial de la sopa en la cuadrícula del hilo y empezamos el historial de hashes desde la generación 0.
+    configurarRellenoCuadricula(cuadricula, obtenerSemillaSopa(configuracion->semilla, tarea), configuracion->porcentaje);
+    reiniciarCuadricula(cuadricula);
+    configurarDeteccionPeriodo(cuadricula, true);
+
+    uint64_t periodo = 0, inicioPeriodo = 0;
+    while (!obtenerPeriodoCuadricula(cuadricula, &periodo, &inicioPeriodo) && obtenerNumGeneracion(cuadricula) < configuracion->generacionesMaximas) {
+        calcularCuadriculaSiguiente(cuadricula);
+    }
+    registrarSopa(&estado->resumen, tarea, contarPoblacion(cuadricula), obtenerNumGeneracion(cuadricula), periodo, inicioPeriodo);
+}
+
+// Función para liberar el pool y las cuadrículas de los hilos del censo.
+static void liberarHilosCenso(PoolHilos* pool, EstadoHiloCenso* hilos, unsigned numHilos) {
+    if (hilos != NULL) {
+        for (unsigned i = 0; i < numHilos; i++) {
+            liberarCuadricula(hilos[i].cuadricula);
+        }
+        free(hilos);
+    }
+    liberarPoolHilos(pool);
+}
+
+// Función para calcular las sopas de un censo repartidas entre los hilos (con robo de trabajo) y completar su resumen. Retorna false si no se pudieron crear los hilos o las cuadrículas.
+bool calcularCenso(const ConfiguracionCenso* configuracion, ResumenCenso* resumen) {
+    if (configuracion == NULL || resumen == NULL) {
+        return false;
+    }
+    PoolHilos* pool = crearPoolHilos(configuracion->numHilos);
+    if (pool == NULL) {
+        return false;
+    }
+    // Creamos una cuadrícula por hilo (de un solo hilo cada una: el paralelismo está entre sopas, no dentro de cada sopa).
+    unsigned numHilos = obtenerNumHilosPool(pool);
+    EstadoHiloCenso* hilos = (EstadoHiloCenso*)aligned_alloc(BYTES_LINEA_CACHE, numHilos * sizeof(EstadoHiloCenso));
+    if (hilos == NULL) {
+        liberarPoolHilos(pool);
+        return false;
+    }
+    bool exito = true;
+    for (unsigned i = 0; i < numHilos; i++) {
+        hilos[i].cuadricula = crearCuadriculaConRegla(configuracion->ancho, configuracion->alto, configuracion->semilla, 0, configuracion->regla);
+        iniciarResumen(&hilos[i].resumen);
+        if (hilos[i].cuadricula == NULL || !seleccionarKernelCuadricula(hilos[i].cuadricula, configuracion->kernel)) {
+            exito = false;
+        }
+    }
+    if (!exito) {
+        liberarHilosCenso(pool, hilos, numHilos);
+        return false;
+    }
+
+    ContextoCenso contexto = {configuracion, hilos};
+    double inicio = obtenerSegundos();
+    ejecutarEnParalelo(pool, configuracion->numSopas, calcularSopa, &contexto);
+    double segundos = obtenerSegundos() - inicio;
+
+    iniciarResumen(resumen);
+    for (unsigned i = 0; i < numHilos; i++) {
+        combinarResumen(resumen, &hilos[i].resumen);
+    }
+    resumen->numHilos = numHilos;
+    resumen->kernel = hilos[0].cuadricula->tipoKernel;
+    resumen->segundos = segundos;
+    liberarHilosCenso(pool, hilos, numHilos);
+    return true;
+}
+
+// Función para ejecutar el censo indicado en las opciones (--censo) y mostrar su resumen en stdout. Retorna el código de salida del programa (0 si no hubo errores).
+int ejecutarCenso(const Opciones* opciones) {
+    // Cada sopa es una configuración aleatoria en una cuadrícula toroidal, por lo que el censo no admite otros motores ni archivos de entrada o salida.
+    if (opciones->motor != MOTOR_CUADRICULA || opciones->patron != NULL || opciones->reanudar != NULL || opciones->guardar != NULL || opciones->instantanea != NULL ||
+        opciones->metricas != NULL || opciones->grabar != NULL || opciones->reproducir != NULL) {
+        fprintf(stderr, "La opción --censo solo admite el motor 'cuadricula' y no se puede usar con --patron, --reanudar, --guardar, --instantanea, --metricas, --grabar ni --reproducir.\n");
+        return 1;
+    }
+    // La regla de las opciones ya fue validada por analizarArgumentos (NULL = B3/S23). Las reglas con B0 se admiten: las sopas son toroidales.
+    Regla regla;
+    bool reglaIndicada = compilarRegla(opciones->regla, &regla);
+    ConfiguracionCenso configuracion = {
+        .numSopas = opciones->numSopas,
+        .ancho = opciones->ancho,
+        .alto = opciones->alto,
+        .semilla = opciones->semilla,
+        .porcentaje = opciones->porcentaje,
+        .generacionesMaximas = opciones->generaciones,
+        .numHilos = opciones->numHilos,
+        .kernel = opciones->kernel,
+        .regla = reglaIndicada ? &regla : NULL
+    };
+    ResumenCenso resumen;
+    if (!calcularCenso(&configuracion, &resumen)) {
+        fprintf(stderr, "No se pudo iniciar el censo (hilos, memoria o kernel no disponibles).\n");
+        return 1;
+    }
+
+    printf("censo: %llu sopas\n", (unsigned long long)resumen.numSopas);
+    printf("dimensiones: %ux%u\n", (unsigned)opciones->ancho, (unsigned)opciones->alto);
+    printf("semilla: %llu\n", (unsigned long long)opciones->semilla);
+    printf("relleno: %u%%\n", opciones->porcentaje);
+    printf("generaciones maximas: %llu\n", (unsigned long long)opciones->generaciones);
+    printf("regla: %s\n", reglaIndicada ? regla.texto : REGLA_CONWAY);
+    printf("kernel: %s\n", obtenerNombreKernel(resumen.kernel));
+    printf("hilos: %u\n", resumen.numHilos);
+
+    double numSopas = (resumen.numSopas > 0) ? (double)resumen.numSopas : 1.0;
+    printf("estabilizadas: %llu (%.2f%%), extintas: %llu\n", (unsigned long long)resumen.estabilizadas,
+        100.0 * (double)resumen.estabilizadas / numSopas, (unsigned long long)resumen.extintas);
+    if (resumen.estabilizadas > 0) {
+        printf("generaciones hasta estabilizar: minimo %llu, promedio %.1f, maximo %llu\n", (unsigned long long)resumen.estabilizacionMinima,
+            (double)resumen.sumaEstabilizacion / (double)resumen.estabilizadas, (unsigned long long)resumen.estabilizacionMaxima);
+        printf("sopa mas longeva: %llu (semilla %llu, estable desde la generacion %llu)\n", (unsigned long long)resumen.sopaMasLonga,
+            (unsigned long long)obtenerSemillaSopa(opciones->semilla, resumen.sopaMasLonga), (unsigned long long)resumen.estabilizacionMaxima);
+        printf("histograma de estabilizacion:\n");
+        for (unsigned i = 0; i < NUM_INTERVALOS_ESTABILIZACION; i++) {
+            if (resumen.intervalosEstabilizacion[i] == 0) {
+                continue;
+            }
+            // El intervalo i (i > 0) corresponde a [2^(i-1), 2^i) generaciones.
+            unsigned long long desde = (i == 0) ? 0 : 1ull << (i - 1);
+            unsigned long long hasta = (i == 0) ? 0 : (i == BITS_POR_PALABRA) ? UINT64_MAX : (1ull << i) - 1;
+            printf("  %llu-%llu: %llu\n", desde, hasta, (unsigned long long)resumen.intervalosEstabilizacion[i]);
+        }
+    }
+    if (resumen.numSopas > 0) {
+        printf("poblacion final: minimo %llu, promedio %.1f, maximo %llu\n", (unsigned long long)resumen.poblacionMinima,
+            (double)resumen.sumaPoblacion / numSopas, (unsigned long long)resumen.poblacionMaxima);
+    }
+    printf("histograma de periodos:\n");
+    for (unsigned periodo = 1; periodo <= LONGITUD_HISTORIAL_HASH; periodo++) {
+        if (resumen.periodos[periodo] > 0) {
+            printf("  %u: %llu\n", periodo, (unsigned long long)resumen.periodos[periodo]);
+        }
+    }
+    printf("  sin periodo (mayor que %d o sin estabilizar): %llu\n", LONGITUD_HISTORIAL_HASH, (unsigned long long)resumen.periodos[0]);
+
+    // Las células por segundo se calculan sobre las generaciones efectivamente calculadas (cada sopa se detiene al estabilizarse).
+    double celulas = (double)opciones->ancho * (double)opciones->alto * (double)resumen.generacionesCalculadas;
+    printf("generaciones calculadas: %llu\n", (unsigned long long)resumen.generacionesCalculadas);
+    printf("tiempo: %.6f s\n", resumen.segundos);
+    printf("sopas/s: %.4g\n", (resumen.segundos > 0.0) ? (double)resumen.numSopas / resumen.segundos : 0.0);
+    printf("celulas/s: %.4g\n", (resumen.segundos > 0.0) ? celulas / resumen.segundos : 0.0);
+    return 0;
+}
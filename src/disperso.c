@@ -0,0 +1,518 @@
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../include/disperso.h"
+#include "../include/game.h"
+
+//  ================================================
+//  Conway's Game of Life - Universo Disperso
+//  ================================================
+//  Este módulo implementa un universo sin dimensiones fijas, para patrones que crecen o se desplazan sin límite (cañones, naves, etc.).
+//
+//  CARACTERÍSTICAS PRINCIPALES:
+//  1. Sectores Empaquetados:
+//      - El plano se divide en sectores de LADO_SECTOR x LADO_SECTOR células, con una palabra de 64 bits por fila (igual que Cuadricula).
+//      - Cada sector guarda ambas generaciones (doble buffering); un índice común indica cuál es la actual.
+//      - Los sectores se guardan en una tabla hash indexada por sus coordenadas, y además en un arreglo para recorrerlos sin ramas.
+//
+//  2. Reserva y Liberación Automática:
+//      - Antes de cada generación se crean (vacíos) los sectores vecinos a las células vivas que tocan el borde de un sector.
+//      - Después de cada generación se liberan los sectores que siguen vacíos y que ninguna célula viva vecina necesita.
+//      - Así, la memoria es proporcional a la zona ocupada por células vivas y no al rectángulo que las contiene.
+//
+//  3. Sectores Activos:
+//      - Igual que las teselas de Cuadricula, solo se recalculan los sectores que cambiaron en la última generación o que tocan uno que cambió.
+//      - Los sectores restantes conservan en el buffer de escritura una copia idéntica de la generación actual, por lo que no necesitan ser copiados.
+//
+//  4. Cálculo en Paralelo:
+//      - Cada sector solo escribe su propia generación siguiente, por lo que los sectores se reparten entre los hilos de un pool (ver hilos.c).
+//
+//  NOTA: Las coordenadas de 64 bits se envuelven al superar INT64_MAX o INT64_MIN (un toro de 2^64 x 2^64 células, ilimitado en la práctica).
+
+// Tamaño inicial de la tabla hash (potencia de 2).
+#define TAMANO_INICIAL_TABLA 1024
+// Capacidad inicial del arreglo de sectores.
+#define CAPACIDAD_INICIAL_SECTORES 256
+// Rango de las coordenadas de los sectores (las células van de INT64_MIN a INT64_MAX).
+#define SECTOR_MINIMO (INT64_MIN / LADO_SECTOR)
+#define SECTOR_MAXIMO (INT64_MAX / LADO_SECTOR)
+
+// Definición de un sector del universo.
+typedef struct Sector {
+    int64_t sx, sy;                         // Coordenadas del sector (la célula (x, y) pertenece al sector (x / LADO_SECTOR, y / LADO_SECTOR), redondeando hacia abajo)
+    uint64_t filas[2][LADO_SECTOR];         // Ambas generaciones del sector (bit b de la fila y = célula (sx * LADO_SECTOR + b, sy * LADO_SECTOR + y))
+    struct Sector* siguiente;               // Siguiente sector en la misma posición de la tabla hash
+    size_t indice;                          // Posición del sector en el arreglo de sectores
+    uint32_t poblacion;                     // Número de células vivas en la generación actual
+    bool cambio;                            // Indica si el sector cambió en la última generación (o se modificó desde fuera)
+    bool cambioNuevo;                       // Indica si el sector cambió en la generación en curso
+} Sector;
+
+// Definición de la estructura del universo.
+struct UniversoDisperso {
+    Sector** tabla;                         // Tabla hash de sectores
+    size_t tamanoTabla;                     // Número de posiciones de la tabla (potencia de 2)
+    Sector** sectores;                      // Arreglo con todos los sectores reservados
+    size_t numSectores;                     // Número de sectores reservados
+    size_t capacidadSectores;               // Capacidad del arreglo de sectores
+    unsigned genActual;                     // Índice (0 o 1) de la generación actual en Sector.filas
+    uint64_t numGeneracion;                 // Número de generación actual
+    uint64_t anchoInicial;                  // Dimensiones del rectángulo que se llena al crear o reiniciar el universo
+    uint64_t altoInicial;
+    uint64_t estadoAleatorio;               // Estado del generador de números aleatorios (ver generarAleatorio en game.c)
+    unsigned porcentajeInicial;             // Porcentaje de células vivas del rectángulo inicial
+    PoolHilos* pool;                        // Pool de hilos para calcular las generaciones en paralelo (NULL = un solo hilo)
+    Regla regla;                            // Regla B/S con que se calculan las generaciones (B3/S23 por defecto)
+    KernelFila calcularFila;                // Kernel de cálculo, especializado para la regla (ver kernels.c)
+};
+
+// Función para obtener las coordenadas del sector que contiene a la célula de coordenada c, y la posición de la célula dentro del sector.
+static inline int64_t obtenerSector(int64_t c) {
+    uint64_t desplazamiento = (uint64_t)c % LADO_SECTOR;
+    return (c - (int64_t)desplazamiento) / LADO_SECTOR;
+}
+static inline unsigned obtenerPosicion(int64_t c) {
+    return (unsigned)((uint64_t)c % LADO_SECTOR);
+}
+
+// Función para obtener la coordenada del sector vecino (d = -1, 0 o 1), envolviendo en los extremos del rango.
+static inline int64_t desplazarSector(int64_t s, int d) {
+    if (d > 0 && s == SECTOR_MAXIMO) {
+        return SECTOR_MINIMO;
+    }
+    if (d < 0 && s == SECTOR_MINIMO) {
+        return SECTOR_MAXIMO;
+    }
+    return s + d;
+}
+
+// Función para calcular la posición de un sector en la tabla hash a partir de sus coordenadas.
+static inline size_t calcularHashSector(int64_t sx, int64_t sy, size_t tamanoTabla) {
+    uint64_t hash = (uint64_t)sx * 0x9E3779B97F4A7C15ull;
+    hash ^= (uint64_t)sy * 0xC2B2AE3D27D4EB4Full;
+    hash ^= hash >> 31;
+    return (size_t)hash & (tamanoTabla - 1);
+}
+
+// Función para buscar un sector por sus coordenadas (NULL si no está reservado).
+static Sector* buscarSector(const UniversoDisperso* universo, int64_t sx, int64_t sy) {
+    for (Sector* sector = universo->tabla[calcularHashSector(sx, sy, universo->tamanoTabla)]; sector != NULL; sector = sector->siguiente) {
+        if (sector->sx == sx && sector->sy == sy) {
+            return sector;
+        }
+    }
+    return NULL;
+}
+
+// Función para duplicar el tamaño de la tabla hash cuando se llena. Si no hay memoria, la tabla conserva su tamaño.
+static void agrandarTabla(UniversoDisperso* universo) {
+    size_t nuevoTamano = universo->tamanoTabla * 2;
+    Sector** nuevaTabla = (Sector**)calloc(nuevoTamano, sizeof(Sector*));
+    if (nuevaTabla == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < universo->numSectores; i++) {
+        Sector* sector = universo->sectores[i];
+        size_t posicion = calcularHashSector(sector->sx, sector->sy, nuevoTamano);
+        sector->siguiente = nuevaTabla[posicion];
+        nuevaTabla[posicion] = sector;
+    }
+    free(universo->tabla);
+    universo->tabla = nuevaTabla;
+    universo->tamanoTabla = nuevoTamano;
+}
+
+// Función para obtener un sector, reservándolo (vacío) si no existe. Retorna NULL si no hay memoria.
+static Sector* obtenerOCrearSector(UniversoDisperso* universo, int64_t sx, int64_t sy) {
+    Sector* sector = buscarSector(universo, sx, sy);
+    if (sector != NULL) {
+        return sector;
+    }
+    // Agrandamos el arreglo de sectores si está lleno.
+    if (universo->numSectores == universo->capacidadSectores) {
+        size_t nuevaCapacidad = universo->capacidadSectores * 2;
+        Sector** nuevosSectores = (Sector**)realloc(universo->sectores, nuevaCapacidad * sizeof(Sector*));
+        if (nuevosSectores == NULL) {
+            return NULL;
+        }
+        universo->sectores = nuevosSectores;
+        universo->capacidadSectores = nuevaCapacidad;
+    }
+    // Los sectores nuevos comienzan vacíos en ambas generaciones y marcados como cambiados, para que se calculen en la siguiente generación.
+    sector = (Sector*)calloc(1, sizeof(Sector));
+    if (sector == NULL) {
+        return NULL;
+    }
+    sector->sx = sx;
+    sector->sy = sy;
+    sector->cambio = true;
+    size_t posicion = calcularHashSector(sx, sy, universo->tamanoTabla);
+    sector->siguiente = universo->tabla[posicion];
+    universo->tabla[posicion] = sector;
+    sector->indice = universo->numSectores;
+    universo->sectores[universo->numSectores++] = sector;
+    if (universo->numSectores > universo->tamanoTabla) {
+        agrandarTabla(universo);
+    }
+    return sector;
+}
+
+// Función para liberar un sector, quitándolo de la tabla hash y del arreglo (el último sector del arreglo ocupa su lugar).
+static void eliminarSector(UniversoDisperso* universo, Sector* sector) {
+    Sector** enlace = &universo->tabla[calcularHashSector(sector->sx, sector->sy, universo->tamanoTabla)];
+    while (*enlace != sector) {
+        enlace = &(*enlace)->siguiente;
+    }
+    *enlace = sector->siguiente;
+    Sector* ultimo = universo->sectores[--universo->numSectores];
+    universo->sectores[sector->indice] = ultimo;
+    ultimo->indice = sector->indice;
+    free(sector);
+}
+
+// Función para liberar todos los sectores, dejando el universo vacío.
+static void eliminarTodosSectores(UniversoDisperso* universo) {
+    for (size_t i = 0; i < universo->numSectores; i++) {
+        free(universo->sectores[i]);
+    }
+    universo->numSectores = 0;
+    memset(universo->tabla, 0, universo->tamanoTabla * sizeof(Sector*));
+}
+
+// Función para llenar el rectángulo inicial con ~porcentajeInicial% de células vivas distribuidas aleatoriamente, a través del macro PORCENTAJE_CELULAS_VIVAS_INICIAL. Retorna false si no hay memoria suficiente.
+static bool llenarAleatoriamente(UniversoDisperso* universo) {
+    for (uint64_t y = 0; y < universo->altoInicial; y++) {
+        for (uint64_t x0 = 0; x0 < universo->anchoInicial; x0 += LADO_SECTOR) {
+            // Generamos las células de una fila del sector de una sola vez.
+            uint64_t palabra = 0;
+            for (unsigned b = 0; b < LADO_SECTOR && x0 + b < universo->anchoInicial; b++) {
+                if (PORCENTAJE_CELULAS_VIVAS_INICIAL(&universo->estadoAleatorio, universo->porcentajeInicial)) {
+                    palabra |= (uint64_t)1 << b;
+                }
+            }
+            if (palabra == 0) {
+                continue;
+            }
+            Sector* sector = obtenerOCrearSector(universo, (int64_t)(x0 / LADO_SECTOR), (int64_t)(y / LADO_SECTOR));
+            if (sector == NULL) {
+                return false;
+            }
+            sector->filas[universo->genActual][y % LADO_SECTOR] = palabra;
+            sector->poblacion += (uint32_t)__builtin_popcountll(palabra);
+        }
+    }
+    return true;
+}
+
+// Función para crear un nuevo universo con ~20% de células vivas iniciales (aleatorias) en el rectángulo [0, ancho) x [0, alto). Con ancho o alto 0, el universo comienza vacío.
+UniversoDisperso* crearUniversoDisperso(uint64_t ancho, uint64_t alto) {
+    return crearUniversoDispersoConSemilla(ancho, alto, (uint64_t)time(NULL), PORCENTAJE_CELULAS_VIVAS_DEFECTO);
+}
+
+// Función para crear un nuevo universo con ~porcentaje% de células vivas iniciales en el rectángulo [0, ancho) x [0, alto), generadas a partir de una semilla.
+UniversoDisperso* crearUniversoDispersoConSemilla(uint64_t ancho, uint64_t alto, uint64_t semilla, unsigned porcentaje) {
+    UniversoDisperso* universo = (UniversoDisperso*)calloc(1, sizeof(UniversoDisperso));
+    if (universo == NULL) {
+        return NULL;
+    }
+    universo->anchoInicial = ancho;
+    universo->altoInicial = alto;
+    universo->estadoAleatorio = semilla;
+    universo->porcentajeInicial = porcentaje;
+    universo->regla = *obtenerReglaConway();
+    universo->calcularFila = obtenerKernelFila(KERNEL_ESCALAR, &universo->regla);
+    universo->tamanoTabla = TAMANO_INICIAL_TABLA;
+    universo->tabla = (Sector**)calloc(universo->tamanoTabla, sizeof(Sector*));
+    universo->capacidadSectores = CAPACIDAD_INICIAL_SECTORES;
+    universo->sectores = (Sector**)malloc(universo->capacidadSectores * sizeof(Sector*));
+    if (universo->tabla == NULL || universo->sectores == NULL || !llenarAleatoriamente(universo)) {
+        liberarUniversoDisperso(universo);
+        return NULL;
+    }
+    return universo;
+}
+
+// Función para crear un nuevo universo con las células vivas de una cuadrícula (la célula (x, y) de la cuadrícula pasa a ser la célula (x, y) del universo). Las filas de un sector miden una palabra, por lo que se copian sin convertirlas.
+UniversoDisperso* crearUniversoDispersoDesdeCuadricula(Cuadricula* cuadricula) {
+    if (cuadricula == NULL) {
+        return NULL;
+    }
+    UniversoDisperso* universo = crearUniversoDispersoConSemilla(cuadricula->ancho, cuadricula->alto, 0, 0);
+    if (universo == NULL) {
+        return NULL;
+    }
+    for (uint32_t y = 0; y < cuadricula->alto; y++) {
+        const uint64_t* fila = obtenerFilaCuadricula(cuadricula, y);
+        for (size_t p = 0; p < cuadricula->palabrasPorFila; p++) {
+            if (fila[p] == 0) {
+                continue;
+            }
+            Sector* sector = obtenerOCrearSector(universo, (int64_t)p, (int64_t)(y / LADO_SECTOR));
+            if (sector == NULL) {
+                liberarUniversoDisperso(universo);
+                return NULL;
+            }
+            sector->filas[universo->genActual][y % LADO_SECTOR] = fila[p];
+            sector->poblacion += (uint32_t)__builtin_popcountll(fila[p]);
+        }
+    }
+    return universo;
+}
+
+// Función para liberar la memoria asignada a un universo.
+void liberarUniversoDisperso(UniversoDisperso* universo) {
+    if (universo == NULL) {
+        return;
+    }
+    if (universo->tabla != NULL && universo->sectores != NULL) {
+        eliminarTodosSectores(universo);
+    }
+    liberarPoolHilos(universo->pool);
+    free(universo->sectores);
+    free(universo->tabla);
+    free(universo);
+}
+
+// Función para reservar los sectores vecinos a las células vivas que tocan el borde de cada sector (donde pueden nacer células en la siguiente generación). Retorna false si no hay memoria suficiente.
+static bool reservarSectoresVecinos(UniversoDisperso* universo) {
+    // Los sectores que se reservan en este recorrido están vacíos, por lo que basta con revisar los que ya existían.
+    size_t numSectores = universo->numSectores;
+    for (size_t i = 0; i < numSectores; i++) {
+        Sector* sector = universo->sectores[i];
+        if (sector->poblacion == 0) {
+            continue;
+        }
+        const uint64_t* filas = sector->filas[universo->genActual];
+        uint64_t columnas = 0;
+        for (unsigned y = 0; y < LADO_SECTOR; y++) {
+            columnas |= filas[y];
+        }
+        // Bordes del sector con células vivas, indexados como [dy + 1][dx + 1].
+        bool bordes[3][3] = {
+            {(filas[0] & 1u) != 0, filas[0] != 0, (filas[0] >> 63) != 0},
+            {(columnas & 1u) != 0, false, (columnas >> 63) != 0},
+            {(filas[LADO_SECTOR - 1] & 1u) != 0, filas[LADO_SECTOR - 1] != 0, (filas[LADO_SECTOR - 1] >> 63) != 0},
+        };
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                if (bordes[dy + 1][dx + 1] && obtenerOCrearSector(universo, desplazarSector(sector->sx, dx), desplazarSector(sector->sy, dy)) == NULL) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// Función (tarea del pool) para calcular la siguiente generación de un sector.
+static void calcularSector(void* contexto, size_t tarea, unsigned hilo) {
+    (void)hilo;
+    UniversoDisperso* universo = (UniversoDisperso*)contexto;
+    Sector* sector = universo->sectores[tarea];
+    unsigned actual = universo->genActual;
+
+    // Buscamos los 8 sectores vecinos (NULL = vacío). Si ni el sector ni sus vecinos cambiaron, la generación siguiente es igual a la actual.
+    Sector* vecinos[3][3];
+    bool activo = false;
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            Sector* vecino = (dx == 0 && dy == 0) ? sector : buscarSector(universo, desplazarSector(sector->sx, dx), desplazarSector(sector->sy, dy));
+            vecinos[dy + 1][dx + 1] = vecino;
+            activo = activo || (vecino != NULL && vecino->cambio);
+        }
+    }
+    if (!activo) {
+        sector->cambioNuevo = false;
+        return;
+    }
+
+    // Copiamos el sector y su borde en una ventana de (LADO_SECTOR + 2) filas de 3 palabras (oeste, centro, este), que es la forma que espera el kernel.
+    uint64_t ventana[LADO_SECTOR + 2][3];
+    for (int columna = 0; columna < 3; columna++) {
+        const Sector* arriba = vecinos[0][columna];
+        const Sector* medio = vecinos[1][columna];
+        const Sector* abajo = vecinos[2][columna];
+        ventana[0][columna] = (arriba != NULL) ? arriba->filas[actual][LADO_SECTOR - 1] : 0;
+        for (unsigned y = 0; y < LADO_SECTOR; y++) {
+            ventana[y + 1][columna] = (medio != NULL) ? medio->filas[actual][y] : 0;
+        }
+        ventana[LADO_SECTOR + 1][columna] = (abajo != NULL) ? abajo->filas[actual][0] : 0;
+    }
+
+    // Calculamos cada fila con el kernel (una palabra por fila), contando las células vivas de la generación siguiente.
+    uint64_t* siguiente = sector->filas[actual ^ 1u];
+    uint64_t cambios = 0;
+    uint32_t poblacion = 0;
+    for (unsigned y = 0; y < LADO_SECTOR; y++) {
+        cambios |= universo->calcularFila(&siguiente[y], &ventana[y][1], &ventana[y + 1][1], &ventana[y + 2][1], 1, &universo->regla);
+        poblacion += (uint32_t)__builtin_popcountll(siguiente[y]);
+    }
+    sector->cambioNuevo = (cambios != 0);
+    sector->poblacion = poblacion;
+}
+
+// Función para saber si algún sector vecino tiene células vivas en el borde que toca a un sector (y, por lo tanto, pueden nacer células en él).
+static bool sectorNecesario(const UniversoDisperso* universo, const Sector* sector) {
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            if (dx == 0 && dy == 0) {
+                continue;
+            }
+            const Sector* vecino = buscarSector(universo, desplazarSector(sector->sx, dx), desplazarSector(sector->sy, dy));
+            if (vecino == NULL || vecino->poblacion == 0) {
+                continue;
+            }
+            // Del vecino solo importa la fila (o las filas) y la columna que tocan a este sector.
+            const uint64_t* filas = vecino->filas[universo->genActual];
+            uint64_t mascara = (dx < 0) ? (uint64_t)1 << 63 : (dx > 0) ? 1u : ~(uint64_t)0;
+            unsigned desde = (dy < 0) ? LADO_SECTOR - 1 : 0;
+            unsigned hasta = (dy > 0) ? 1 : LADO_SECTOR;
+            for (unsigned y = desde; y < hasta; y++) {
+                if (filas[y] & mascara) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+// Función para calcular la siguiente generación del universo según su regla (B3/S23 por defecto). Retorna false si no hay memoria suficiente (en ese caso, el universo no cambia).
+bool calcularUniversoDispersoSiguiente(UniversoDisperso* universo) {
+    // Verificamos que el universo no esté vacío.
+    if (universo == NULL) {
+        return false;
+    }
+    // Reservamos los sectores donde pueden nacer células (si falla, los sectores reservados están vacíos y no alteran el universo).
+    if (!reservarSectoresVecinos(universo)) {
+        return false;
+    }
+    // Calculamos los sectores en paralelo (cada uno escribe solo su generación siguiente) y luego intercambiamos las generaciones.
+    ejecutarEnParalelo(universo->pool, universo->numSectores, calcularSector, universo);
+    universo->genActual ^= 1u;
+    universo->numGeneracion++;
+
+    // Liberamos los sectores que siguen vacíos (vacíos en esta generación y en la anterior) y que ningún vecino necesita.
+    // NOTA: Un sector liberado equivale a uno vacío que no cambió, por lo que sus vecinos pueden seguir omitiéndose.
+    for (size_t i = 0; i < universo->numSectores; ) {
+        Sector* sector = universo->sectores[i];
+        sector->cambio = sector->cambioNuevo;
+        if (sector->poblacion == 0 && !sector->cambio && !sectorNecesario(universo, sector)) {
+            eliminarSector(universo, sector); // El último sector pasa a la posición i, que se revisa a continuación.
+        } else {
+            i++;
+        }
+    }
+    return true;
+}
+
+// Función para configurar el número de hilos con que se calcula cada generación (0 = todos los núcleos disponibles, 1 = sin hilos adicionales). Retorna false si no se pudo crear el pool.
+bool configurarHilosUniversoDisperso(UniversoDisperso* universo, unsigned numHilos) {
+    // Verificamos que el universo no esté vacío.
+    if (universo == NULL) {
+        return false;
+    }
+    // Reemplazamos el pool anterior (si existe) por uno con el número de hilos indicado.
+    liberarPoolHilos(universo->pool);
+    universo->pool = NULL;
+    if (numHilos == 0) {
+        numHilos = detectarNumNucleos();
+    }
+    if (numHilos > 1) {
+        universo->pool = crearPoolHilos(numHilos);
+        if (universo->pool == NULL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Función para cambiar la regla con que se calculan las generaciones. Retorna false (sin cambiarla) si la regla es NULL o hace nacer células sin vecinas (B0), que llenarían el plano ilimitado.
+bool configurarReglaUniversoDisperso(UniversoDisperso* universo, const Regla* regla) {
+    if (universo == NULL || regla == NULL || reglaNaceSinVecinas(regla)) {
+        return false;
+    }
+    universo->regla = *regla;
+    universo->calcularFila = obtenerKernelFila(KERNEL_ESCALAR, &universo->regla);
+    // Con otra regla pueden cambiar sectores que estaban estables, por lo que todos se recalculan en la siguiente generación.
+    for (size_t i = 0; i < universo->numSectores; i++) {
+        universo->sectores[i]->cambio = true;
+    }
+    return true;
+}
+
+// Función para establecer el estado de una célula. Retorna false si no hay memoria suficiente.
+bool establecerCelulaDisperso(UniversoDisperso* universo, int64_t x, int64_t y, bool viva) {
+    if (universo == NULL) {
+        return false;
+    }
+    // Solo reservamos un sector nuevo si la célula pasa a estar viva.
+    Sector* sector = viva ? obtenerOCrearSector(universo, obtenerSector(x), obtenerSector(y)) : buscarSector(universo, obtenerSector(x), obtenerSector(y));
+    if (sector == NULL) {
+        return !viva;
+    }
+    uint64_t* fila = &sector->filas[universo->genActual][obtenerPosicion(y)];
+    uint64_t mascara = (uint64_t)1 << obtenerPosicion(x);
+    if (((*fila & mascara) != 0) != viva) {
+        *fila ^= mascara;
+        sector->poblacion = viva ? sector->poblacion + 1 : sector->poblacion - 1;
+        sector->cambio = true;
+    }
+    return true;
+}
+
+// Función para obtener el estado de una célula específica del universo.
+bool obtenerEstadoCelulaDisperso(UniversoDisperso* universo, int64_t x, int64_t y) {
+    if (universo == NULL) {
+        return false;
+    }
+    const Sector* sector = buscarSector(universo, obtenerSector(x), obtenerSector(y));
+    return sector != NULL && ((sector->filas[universo->genActual][obtenerPosicion(y)] >> obtenerPosicion(x)) & 1u);
+}
+
+// Función para contar el número de células vivas alrededor de una célula específica.
+unsigned short contarVecinasVivasDisperso(UniversoDisperso* universo, int64_t x, int64_t y) {
+    unsigned short vecinasVivas = 0;
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            // Las coordenadas se envuelven en los extremos del rango de 64 bits.
+            int64_t vecinaX = (int64_t)((uint64_t)x + (uint64_t)(int64_t)dx);
+            int64_t vecinaY = (int64_t)((uint64_t)y + (uint64_t)(int64_t)dy);
+            if ((dx != 0 || dy != 0) && obtenerEstadoCelulaDisperso(universo, vecinaX, vecinaY)) {
+                vecinasVivas++;
+            }
+        }
+    }
+    return vecinasVivas;
+}
+
+// Función para obtener el número de generación actual.
+uint64_t obtenerNumGeneracionDisperso(UniversoDisperso* universo) {
+    return (universo != NULL) ? universo->numGeneracion : 0;
+}
+
+// Función para contar las células vivas del universo.
+uint64_t contarPoblacionDisperso(UniversoDisperso* universo) {
+    uint64_t poblacion = 0;
+    for (size_t i = 0; universo != NULL && i < universo->numSectores; i++) {
+        poblacion += universo->sectores[i]->poblacion;
+    }
+    return poblacion;
+}
+
+// Función para obtener el número de sectores reservados actualmente.
+size_t obtenerNumSectoresDisperso(UniversoDisperso* universo) {
+    return (universo != NULL) ? universo->numSectores : 0;
+}
+
+// Función para restablecer el universo a su estado inicial (con el porcentaje de células vivas y el rectángulo indicados al crearlo; la configuración continúa la secuencia aleatoria de la semilla).
+void reiniciarUniversoDisperso(UniversoDisperso* universo) {
+    // Verificamos que el universo no esté vacío.
+    if (universo == NULL) {
+        return;
+    }
+    eliminarTodosSectores(universo);
+    universo->genActual = 0;
+    universo->numGeneracion = 0;
+    llenarAleatoriamente(universo);
+}
@@ -0,0 +1,110 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "../include/fotogramas.h"
+
+//  ================================================
+//  Conway's Game of Life - Fotogramas
+//  ================================================
+//  Este módulo implementa los fotogramas y el buffer triple que comunica el hilo de simulación con el hilo de dibujo.
+//
+//  CARACTERÍSTICAS PRINCIPALES:
+//  1. Buffer Triple sin Bloqueos:
+//      - Hay tres fotogramas: uno de escritura (del hilo de simulación), uno de lectura (del hilo de dibujo) y uno intermedio con el último publicado.
+//      - Publicar intercambia el fotograma de escritura con el intermedio; leer intercambia el intermedio con el de lectura, solo si hay uno nuevo.
+//      - Ambos intercambios son una sola operación atómica, por lo que ningún hilo espera al otro: la simulación nunca se detiene por un dibujo lento,
+//        y el dibujo siempre obtiene la última generación completa (las intermedias que no alcanzó a dibujar se descartan).
+//
+//  2. Un Solo Bloque:
+//      - Los tres fotogramas comparten un bloque de memoria; cada uno guarda las filas empaquetadas sin el borde fantasma de la cuadrícula.
+
+// Bit que indica que el fotograma intermedio es nuevo (aún no leído). Los bits inferiores guardan su índice (0, 1 o 2).
+#define FOTOGRAMA_NUEVO 4u
+#define INDICE_FOTOGRAMA(estado) ((estado) & 3u)
+
+// Definición de la estructura del buffer triple.
+struct BufferTriple {
+    Fotograma fotogramas[3];        // Los tres fotogramas
+    BloqueMemoria memoria;          // Bloque que contiene las células de los tres fotogramas (con páginas grandes, si es posible)
+    unsigned escritura;             // Índice del fotograma de escritura (solo lo usa el hilo que escribe)
+    unsigned lectura;               // Índice del fotograma de lectura (solo lo usa el hilo que lee)
+    _Atomic unsigned intermedio;    // Índice del fotograma intermedio, más FOTOGRAMA_NUEVO si aún no se ha leído
+};
+
+// Función para obtener un fotograma que apunta (sin copiar) a la generación actual de la cuadrícula. Deja de ser válido al calcular la siguiente generación.
+Fotograma obtenerVistaCuadricula(Cuadricula* cuadricula) {
+    Fotograma vista = {
+        .ancho = cuadricula->ancho,
+        .alto = cuadricula->alto,
+        .numGeneracion = cuadricula->numGeneracion,
+        .palabrasEntreFilas = cuadricula->palabrasEntreFilas,
+        .celulas = FILA_CUADRICULA(cuadricula->genActual, cuadricula->palabrasEntreFilas, 0),
+    };
+    return vista;
+}
+
+// Función para copiar la generación actual de la cuadrícula en un fotograma de las mismas dimensiones.
+void capturarFotograma(Fotograma* destino, Cuadricula* cuadricula) {
+    for (uint32_t y = 0; y < cuadricula->alto; y++) {
+        memcpy(FILA_FOTOGRAMA(destino, y), obtenerFilaCuadricula(cuadricula, y), cuadricula->palabrasPorFila * sizeof(uint64_t));
+    }
+    destino->numGeneracion = cuadricula->numGeneracion;
+}
+
+// Función para crear un buffer triple con fotogramas de las dimensiones indicadas.
+BufferTriple* crearBufferTriple(uint32_t ancho, uint32_t alto) {
+    BufferTriple* buffer = (BufferTriple*)malloc(sizeof(BufferTriple));
+    if (buffer == NULL) {
+        return NULL;
+    }
+    size_t palabrasFotograma = (size_t)alto * PALABRAS_POR_FILA(ancho);
+    if (!reservarBloqueMemoria(&buffer->memoria, (3 * palabrasFotograma + 1) * sizeof(uint64_t))) {
+        free(buffer);
+        return NULL;
+    }
+    for (unsigned i = 0; i < 3; i++) {
+        buffer->fotogramas[i].ancho = ancho;
+        buffer->fotogramas[i].alto = alto;
+        buffer->fotogramas[i].numGeneracion = 0;
+        buffer->fotogramas[i].palabrasEntreFilas = PALABRAS_POR_FILA(ancho);
+        buffer->fotogramas[i].celulas = (uint64_t*)buffer->memoria.direccion + i * palabrasFotograma;
+    }
+    buffer->escritura = 0;
+    buffer->lectura = 1;
+    atomic_init(&buffer->intermedio, 2u);
+    return buffer;
+}
+
+// Función para liberar la memoria asignada a un buffer triple.
+void liberarBufferTriple(BufferTriple* buffer) {
+    if (buffer == NULL) {
+        return;
+    }
+    liberarBloqueMemoria(&buffer->memoria);
+    free(buffer);
+}
+
+// Función (solo para el hilo que escribe) para obtener el fotograma donde se escribe la siguiente generación.
+Fotograma* obtenerFotogramaEscritura(BufferTriple* buffer) {
+    return &buffer->fotogramas[buffer->escritura];
+}
+
+// Función (solo para el hilo que escribe) para publicar el fotograma de escritura como el más reciente.
+void publicarFotograma(BufferTriple* buffer) {
+    // El orden release garantiza que el hilo que lee vea las células escritas antes de publicar; el orden acquire, que el fotograma que recuperamos ya no se está leyendo.
+    unsigned anterior = atomic_exchange_explicit(&buffer->intermedio, buffer->escritura | FOTOGRAMA_NUEVO, memory_order_acq_rel);
+    buffer->escritura = INDICE_FOTOGRAMA(anterior);
+}
+
+// Función (solo para el hilo que lee) para obtener el fotograma publicado más reciente. Si nuevo no es NULL, indica si cambió desde la llamada anterior.
+const Fotograma* obtenerUltimoFotograma(BufferTriple* buffer, bool* nuevo) {
+    bool hayNuevo = (atomic_load_explicit(&buffer->intermedio, memory_order_relaxed) & FOTOGRAMA_NUEVO) != 0;
+    if (hayNuevo) {
+        unsigned anterior = atomic_exchange_explicit(&buffer->intermedio, buffer->lectura, memory_order_acq_rel);
+        buffer->lectura = INDICE_FOTOGRAMA(anterior);
+    }
+    if (nuevo != NULL) {
+        *nuevo = hayNuevo;
+    }
+    return &buffer->fotogramas[buffer->lectura];
+}
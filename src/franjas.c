@@ -0,0 +1,531 @@
+#define _GNU_SOURCE     // sched_setaffinity y las macros CPU_* (Linux)
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <sched.h>
+#include <poll.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include "../include/franjas.h"
+
+//  ================================================
+//  Conway's Game of Life - Cálculo por Franjas
+//  ================================================
+//  Este módulo reparte una sola cuadrícula toroidal entre varios procesos del mismo equipo (--procesos), como paso previo a repartirla entre
+//  varios equipos: cada proceso tiene su propia memoria y solo comparte con sus vecinos las filas de los bordes.
+//
+//  CARACTERÍSTICAS PRINCIPALES:
+//  1. Franjas con Halo:
+//      - El proceso i calcula las filas [alto * i / N, alto * (i + 1) / N) en una cuadrícula local con una fila más arriba y otra más abajo (el halo),
+//        que contienen la última fila del vecino de arriba y la primera del vecino de abajo (con wrapping toroidal entre el primero y el último).
+//      - Cada proceso genera su franja y su halo con generarFilaAleatoria, por lo que la configuración inicial es la misma que con un solo proceso
+//        y ningún proceso tiene la cuadrícula completa.
+//      - La población y el hash de la última generación se calculan por franjas y se suman: son los mismos que con un solo proceso.
+//
+//  2. Comunicación Solapada con el Cálculo:
+//      - Cada generación se calcula con calcularCuadriculaSiguienteConBordes: primero las bandas de los bordes, que se publican en cuanto están
+//        calculadas, y después el interior, mientras los vecinos ya pueden recibirlas. Solo se espera a los vecinos al terminar el interior.
+//
+//  3. Transportes:
+//      - memoria: una proyección compartida, creada antes de crear los procesos, con dos buzones por franja (la primera y la última fila). Cada
+//        buzón tiene dos ranuras (por la paridad de la generación) y un contador atómico con la última generación publicada. Dos ranuras bastan:
+//        un proceso solo puede adelantarse una generación a sus vecinos, porque necesita sus filas para continuar.
+//      - socket: un socket de dominio Unix por cada par de franjas vecinas. Los envíos no bloquean, y mientras se esperan las filas de los vecinos
+//        se siguen enviando las propias, por lo que dos vecinos que se envían a la vez no se bloquean entre sí.
+//      - Ambos transportes tienen la misma interfaz (EnlaceFranja); repartir las franjas entre equipos solo requiere otro transporte (por ejemplo,
+//        sockets TCP).
+//  4. Núcleos por Proceso:
+//      - Cada proceso se restringe a una parte distinta de los núcleos permitidos antes de crear su cuadrícula, de modo que sus hilos
+//        (que se fijan a los núcleos de su parte) no se amontonan en los mismos núcleos que los de los demás procesos.
+//  NOTA: El tiempo solo incluye el cálculo de las generaciones (no la creación de los procesos ni de la configuración inicial).
+
+// Vueltas que un proceso espera activamente la fila de un vecino en la memoria compartida antes de ceder el procesador.
+#define VUELTAS_ESPERA_ACTIVA 1024
+
+// Cabecera de la memoria compartida, alineada a la línea de caché.
+typedef struct {
+    _Alignas(BYTES_LINEA_CACHE) atomic_bool abortado; // Algún proceso falló: los demás dejan de esperar a sus vecinos
+} CabeceraRegion;
+
+// Resultado que cada proceso deja en la memoria compartida al terminar, alineado a la línea de caché para que los procesos no la compartan.
+typedef struct {
+    _Alignas(BYTES_LINEA_CACHE) uint64_t poblacion;   // Población final de la franja
+    uint64_t hash;                                     // Suma de los hashes de las filas de la franja (ver calcularHashFila)
+    double segundos;                                   // Tiempo de cálculo de la franja
+    double segundosEspera;                             // Tiempo esperando las filas de los vecinos
+    TipoKernel kernel;                                 // Kernel usado
+} ResultadoFranja;
+
+// Cabecera de un buzón de la memoria compartida, seguida de dos ranuras de una fila cada una (la de las generaciones pares y la de las impares).
+typedef struct {
+    _Alignas(BYTES_LINEA_CACHE) _Atomic uint64_t publicada; // Última generación publicada en el buzón
+} CabeceraBuzon;
+
+// Definición de un extremo de un socket entre dos franjas vecinas, con el mensaje que se está enviando y el que se está recibiendo (la generación seguida de la fila).
+typedef struct {
+    int descriptor;
+    uint8_t* envio;
+    size_t enviados;            // Bytes del mensaje de envío ya enviados (bytesMensaje = nada pendiente)
+    uint8_t* recepcion;
+    size_t recibidos;           // Bytes del mensaje de recepción ya recibidos
+} CanalSocket;
+
+// Definición del enlace de una franja con sus vecinas, con las funciones del transporte.
+typedef struct EnlaceFranja EnlaceFranja;
+struct EnlaceFranja {
+    // Publica la primera y la última fila de la franja en la generación indicada. Retorna false si no se pudieron enviar.
+    bool (*publicar)(EnlaceFranja* enlace, uint64_t generacion, const uint64_t* primeraFila, const uint64_t* ultimaFila);
+    // Espera la última fila del vecino de arriba y la primera del de abajo en la generación indicada. Retorna false si algún vecino falló.
+    bool (*recibir)(EnlaceFranja* enlace, uint64_t generacion, uint64_t* haloSuperior, uint64_t* haloInferior);
+    size_t palabrasPorFila;
+    CabeceraRegion* region;
+    // Transporte memoria: buzones propios (escritura) y de los vecinos (lectura).
+    uint8_t* buzonSuperior;
+    uint8_t* buzonInferior;
+    uint8_t* buzonVecinoSuperior;
+    uint8_t* buzonVecinoInferior;
+    // Transporte socket: canales con el vecino de arriba y con el de abajo.
+    CanalSocket arriba;
+    CanalSocket abajo;
+    size_t bytesMensaje;
+};
+
+// Contexto de la función que publica los bordes de cada generación.
+typedef struct {
+    EnlaceFranja* enlace;
+    uint64_t generacion;
+    uint32_t filas;             // Filas de la franja (sin el halo)
+    bool exito;
+} ContextoPaso;
+
+// Función para obtener el tiempo actual (en segundos) de un reloj monótono.
+static double obtenerSegundos(void) {
+    struct timespec tiempo;
+    clock_gettime(CLOCK_MONOTONIC, &tiempo);
+    return (double)tiempo.tv_sec + (double)tiempo.tv_nsec / 1e9;
+}
+
+// Función para obtener la primera fila global de la franja indice (la franja indice termina donde empieza la indice + 1).
+static uint32_t obtenerInicioFranja(const ConfiguracionFranjas* configuracion, unsigned indice) {
+    return (uint32_t)((uint64_t)configuracion->alto * indice / configuracion->numProcesos);
+}
+
+// Función para obtener la ranura de un buzón que corresponde a una generación.
+static inline uint64_t* obtenerRanuraBuzon(uint8_t* buzon, size_t palabrasPorFila, uint64_t generacion) {
+    return (uint64_t*)(buzon + sizeof(CabeceraBuzon)) + (generacion % 2) * palabrasPorFila;
+}
+
+// Función para publicar una fila en un buzón de la memoria compartida. El orden release garantiza que quien vea la generación también vea la fila.
+static void publicarBuzon(uint8_t* buzon, size_t palabrasPorFila, uint64_t generacion, const uint64_t* fila) {
+    memcpy(obtenerRanuraBuzon(buzon, palabrasPorFila, generacion), fila, palabrasPorFila * sizeof(uint64_t));
+    atomic_store_explicit(&((CabeceraBuzon*)buzon)->publicada, generacion, memory_order_release);
+}
+
+// Función para esperar a que un buzón de la memoria compartida tenga la fila de una generación y copiarla. Retorna false si algún proceso falló mientras tanto.
+static bool esperarBuzon(const EnlaceFranja* enlace, uint8_t* buzon, uint64_t generacion, uint64_t* fila) {
+    CabeceraBuzon* cabecera = (CabeceraBuzon*)buzon;
+    unsigned vueltas = 0;
+    while (atomic_load_explicit(&cabecera->publicada, memory_order_acquire) < generacion) {
+        if (atomic_load_explicit(&enlace->region->abortado, memory_order_relaxed)) {
+            return false;
+        }
+        // Con más procesos que núcleos, el vecino no avanza hasta que este proceso cede el procesador.
+        if (++vueltas == VUELTAS_ESPERA_ACTIVA) {
+            vueltas = 0;
+            sched_yield();
+        }
+    }
+    memcpy(fila, obtenerRanuraBuzon(buzon, enlace->palabrasPorFila, generacion), enlace->palabrasPorFila * sizeof(uint64_t));
+    return true;
+}
+
+// Función que publica los bordes de una franja en la memoria compartida.
+static bool publicarMemoria(EnlaceFranja* enlace, uint64_t generacion, const uint64_t* primeraFila, const uint64_t* ultimaFila) {
+    publicarBuzon(enlace->buzonSuperior, enlace->palabrasPorFila, generacion, primeraFila);
+    publicarBuzon(enlace->buzonInferior, enlace->palabrasPorFila, generacion, ultimaFila);
+    return true;
+}
+
+// Función que recibe el halo de una franja desde la memoria compartida.
+static bool recibirMemoria(EnlaceFranja* enlace, uint64_t generacion, uint64_t* haloSuperior, uint64_t* haloInferior) {
+    return esperarBuzon(enlace, enlace->buzonVecinoSuperior, generacion, haloSuperior) &&
+        esperarBuzon(enlace, enlace->buzonVecinoInferior, generacion, haloInferior);
+}
+
+// Función para enviar lo que se pueda del mensaje pendiente de un canal, sin bloquear. Retorna false si el vecino cerró el socket o hubo un error.
+static bool avanzarEnvio(CanalSocket* canal, size_t bytesMensaje) {
+    while (canal->enviados < bytesMensaje) {
+        ssize_t enviados = send(canal->descriptor, canal->envio + canal->enviados, bytesMensaje - canal->enviados, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (enviados < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+        canal->enviados += (size_t)enviados;
+    }
+    return true;
+}
+
+// Función para recibir lo que haya disponible del mensaje de un canal, sin bloquear ni leer el mensaje siguiente. Retorna false si el vecino cerró el socket o hubo un error.
+static bool avanzarRecepcion(CanalSocket* canal, size_t bytesMensaje) {
+    while (canal->recibidos < bytesMensaje) {
+        ssize_t recibidos = recv(canal->descriptor, canal->recepcion + canal->recibidos, bytesMensaje - canal->recibidos, MSG_DONTWAIT);
+        if (recibidos == 0) {
+            return false;
+        }
+        if (recibidos < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+        canal->recibidos += (size_t)recibidos;
+    }
+    return true;
+}
+
+// Función para preparar el envío de una fila por un canal (la generación seguida de la fila) y enviar lo que se pueda sin bloquear.
+static bool iniciarEnvio(CanalSocket* canal, size_t bytesMensaje, uint64_t generacion, const uint64_t* fila) {
+    memcpy(canal->envio, &generacion, sizeof(generacion));
+    memcpy(canal->envio + sizeof(generacion), fila, bytesMensaje - sizeof(generacion));
+    canal->enviados = 0;
+    return avanzarEnvio(canal, bytesMensaje);
+}
+
+// Función para copiar la fila del mensaje recibido por un canal y dejarlo listo para el siguiente. Retorna false si el mensaje no es de la generación esperada.
+static bool completarRecepcion(CanalSocket* canal, size_t bytesMensaje, uint64_t generacion, uint64_t* fila) {
+    uint64_t generacionMensaje;
+    memcpy(&generacionMensaje, canal->recepcion, sizeof(generacionMensaje));
+    memcpy(fila, canal->recepcion + sizeof(generacionMensaje), bytesMensaje - sizeof(generacionMensaje));
+    canal->recibidos = 0;
+    return generacionMensaje == generacion;
+}
+
+// Función que publica los bordes de una franja por los sockets (la primera fila hacia arriba y la última hacia abajo).
+static bool publicarSocket(EnlaceFranja* enlace, uint64_t generacion, const uint64_t* primeraFila, const uint64_t* ultimaFila) {
+    return iniciarEnvio(&enlace->arriba, enlace->bytesMensaje, generacion, primeraFila) &&
+        iniciarEnvio(&enlace->abajo, enlace->bytesMensaje, generacion, ultimaFila);
+}
+
+// Función que recibe el halo de una franja por los sockets, terminando a la vez los envíos pendientes.
+static bool recibirSocket(EnlaceFranja* enlace, uint64_t generacion, uint64_t* haloSuperior, uint64_t* haloInferior) {
+    size_t bytes = enlace->bytesMensaje;
+    CanalSocket* canales[2] = {&enlace->arriba, &enlace->abajo};
+    for (;;) {
+        struct pollfd descriptores[2];
+        bool pendiente = false;
+        for (int i = 0; i < 2; i++) {
+            if (!avanzarEnvio(canales[i], bytes) || !avanzarRecepcion(canales[i], bytes)) {
+                return false;
+            }
+            descriptores[i].fd = canales[i]->descriptor;
+            descriptores[i].events = (short)(((canales[i]->recibidos < bytes) ? POLLIN : 0) | ((canales[i]->enviados < bytes) ? POLLOUT : 0));
+            descriptores[i].revents = 0;
+            pendiente = pendiente || descriptores[i].events != 0;
+        }
+        if (!pendiente) {
+            break;
+        }
+        if (poll(descriptores, 2, -1) < 0 && errno != EINTR) {
+            return false;
+        }
+    }
+    return completarRecepcion(&enlace->arriba, bytes, generacion, haloSuperior) && completarRecepcion(&enlace->abajo, bytes, generacion, haloInferior);
+}
+
+// Función que llama calcularCuadriculaSiguienteConBordes cuando los bordes de la franja están calculados, para publicarlos antes de calcular el interior.
+static void publicarBordes(void* contexto, Cuadricula* cuadricula) {
+    ContextoPaso* paso = (ContextoPaso*)contexto;
+    paso->exito = paso->enlace->publicar(paso->enlace, paso->generacion, obtenerFilaSiguienteCuadricula(cuadricula, 1),
+        obtenerFilaSiguienteCuadricula(cuadricula, paso->filas));
+}
+
+// Función que ejecuta cada proceso hijo: calcula las generaciones de la franja indice y deja su resultado en la memoria compartida. Retorna false si no se pudo crear la cuadrícula o algún vecino falló.
+static bool calcularFranja(const ConfiguracionFranjas* configuracion, unsigned indice, EnlaceFranja* enlace, ResultadoFranja* resultado) {
+    uint32_t inicioFranja = obtenerInicioFranja(configuracion, indice);
+    uint32_t filas = obtenerInicioFranja(configuracion, indice + 1) - inicioFranja;
+    // La fila 0 de la cuadrícula local es el halo superior, las filas [1, filas] son la franja y la fila filas + 1 es el halo inferior.
+    Cuadricula* cuadricula = crearCuadriculaConHilos(configuracion->ancho, filas + 2, configuracion->semilla, 0, configuracion->regla, configuracion->numHilos);
+    if (cuadricula == NULL || !seleccionarKernelCuadricula(cuadricula, configuracion->kernel)) {
+        liberarCuadricula(cuadricula);
+        return false;
+    }
+    size_t palabrasPorFila = cuadricula->palabrasPorFila;
+    uint64_t* haloSuperior = (uint64_t*)malloc(2 * palabrasPorFila * sizeof(uint64_t));
+    if (haloSuperior == NULL) {
+        liberarCuadricula(cuadricula);
+        return false;
+    }
+    uint64_t* haloInferior = haloSuperior + palabrasPorFila;
+    for (uint32_t fila = 0; fila < filas + 2; fila++) {
+        uint64_t y = ((uint64_t)inicioFranja + configuracion->alto - 1 + fila) % configuracion->alto;
+        generarFilaAleatoria(configuracion->semilla, configuracion->ancho, y, configuracion->porcentaje, haloSuperior);
+        establecerFilaCuadricula(cuadricula, fila, haloSuperior);
+    }
+
+    ContextoPaso paso = {enlace, 0, filas, true};
+    double espera = 0.0;
+    double inicio = obtenerSegundos();
+    for (uint64_t i = 0; i < configuracion->generaciones && paso.exito; i++) {
+        paso.generacion = i + 1;
+        calcularCuadriculaSiguienteConBordes(cuadricula, 2, publicarBordes, &paso);
+        // Las filas de los halos de la generación siguiente se calcularon sin los vecinos: se reemplazan por las de ellos.
+        double inicioEspera = obtenerSegundos();
+        paso.exito = paso.exito && enlace->recibir(enlace, i + 1, haloSuperior, haloInferior);
+        espera += obtenerSegundos() - inicioEspera;
+        establecerFilaCuadricula(cuadricula, 0, haloSuperior);
+        establecerFilaCuadricula(cuadricula, filas + 1, haloInferior);
+    }
+    resultado->segundos = obtenerSegundos() - inicio;
+    resultado->segundosEspera = espera;
+    resultado->kernel = cuadricula->tipoKernel;
+    resultado->poblacion = 0;
+    resultado->hash = 0;
+    for (uint32_t fila = 1; fila <= filas; fila++) {
+        const uint64_t* palabras = obtenerFilaCuadricula(cuadricula, fila);
+        for (size_t p = 0; p < palabrasPorFila; p++) {
+            resultado->poblacion += (uint64_t)__builtin_popcountll(palabras[p]);
+        }
+        resultado->hash += calcularHashFila(palabras, palabrasPorFila, (uint64_t)inicioFranja + fila - 1);
+    }
+    free(haloSuperior);
+    liberarCuadricula(cuadricula);
+    return paso.exito;
+}
+
+// Función para cerrar los sockets de las franjas (se admiten descriptores ya cerrados, con valor -1).
+static void cerrarSockets(int (*sockets)[2], unsigned numProcesos) {
+    if (sockets == NULL) {
+        return;
+    }
+    for (unsigned i = 0; i < numProcesos; i++) {
+        for (int extremo = 0; extremo < 2; extremo++) {
+            if (sockets[i][extremo] >= 0) {
+                close(sockets[i][extremo]);
+                sockets[i][extremo] = -1;
+            }
+        }
+    }
+}
+
+// Función para restringir el proceso de la franja indice a su parte de los núcleos permitidos: los núcleos [n * indice / numProcesos, n * (indice + 1) / numProcesos)
+// de los n permitidos (al menos uno, compartido si hay menos núcleos que procesos). Así, con --hilos 0 cada proceso usa tantos hilos como núcleos tiene su parte.
+static void asignarNucleosFranja(unsigned indice, unsigned numProcesos) {
+#ifdef __linux__
+    cpu_set_t permitidos;
+    if (sched_getaffinity(0, sizeof(permitidos), &permitidos) != 0) {
+        return;
+    }
+    unsigned numNucleos = (unsigned)CPU_COUNT(&permitidos);
+    unsigned inicio = (unsigned)((uint64_t)numNucleos * indice / numProcesos);
+    unsigned fin = (unsigned)((uint64_t)numNucleos * (indice + 1) / numProcesos);
+    if (fin <= inicio) {
+        fin = inicio + 1;
+    }
+    cpu_set_t propios;
+    CPU_ZERO(&propios);
+    unsigned encontrados = 0;
+    for (int cpu = 0; cpu < CPU_SETSIZE && encontrados < fin; cpu++) {
+        if (CPU_ISSET(cpu, &permitidos)) {
+            if (encontrados >= inicio) {
+                CPU_SET(cpu, &propios);
+            }
+            encontrados++;
+        }
+    }
+    sched_setaffinity(0, sizeof(propios), &propios);
+#else
+    (void)indice;
+    (void)numProcesos;
+#endif
+}
+
+// Función que ejecuta el proceso hijo de la franja indice: prepara su enlace con el transporte de la configuración y calcula la franja. Retorna el código de salida del proceso.
+// El socket i une el extremo 0 (la última fila de la franja i) con el extremo 1 (la primera fila de la franja i + 1, o de la 0 para la última franja).
+static int ejecutarProcesoFranja(const ConfiguracionFranjas* configuracion, unsigned indice, uint8_t* region, int (*sockets)[2], size_t bytesBuzon) {
+    unsigned numProcesos = configuracion->numProcesos;
+    unsigned superior = (indice + numProcesos - 1) % numProcesos;
+    unsigned inferior = (indice + 1) % numProcesos;
+    // Antes de crear la cuadrícula y su pool de hilos, que fija sus trabajadores a los núcleos permitidos.
+    asignarNucleosFranja(indice, numProcesos);
+    EnlaceFranja enlace;
+    memset(&enlace, 0, sizeof(enlace));
+    enlace.palabrasPorFila = PALABRAS_POR_FILA(configuracion->ancho);
+    enlace.region = (CabeceraRegion*)region;
+    ResultadoFranja* resultados = (ResultadoFranja*)(region + sizeof(CabeceraRegion));
+    uint8_t* buzones = (uint8_t*)(resultados + numProcesos);
+    bool exito = true;
+    if (configuracion->transporte == TRANSPORTE_SOCKET) {
+        // Cada proceso conserva solo sus dos extremos.
+        enlace.arriba.descriptor = sockets[superior][1];
+        enlace.abajo.descriptor = sockets[indice][0];
+        sockets[superior][1] = -1;
+        sockets[indice][0] = -1;
+        cerrarSockets(sockets, numProcesos);
+        enlace.bytesMensaje = sizeof(uint64_t) + enlace.palabrasPorFila * sizeof(uint64_t);
+        enlace.arriba.envio = (uint8_t*)malloc(4 * enlace.bytesMensaje);
+        exito = enlace.arriba.envio != NULL;
+        if (exito) {
+            enlace.arriba.recepcion = enlace.arriba.envio + enlace.bytesMensaje;
+            enlace.abajo.envio = enlace.arriba.recepcion + enlace.bytesMensaje;
+            enlace.abajo.recepcion = enlace.abajo.envio + enlace.bytesMensaje;
+            enlace.arriba.enviados = enlace.bytesMensaje;
+            enlace.abajo.enviados = enlace.bytesMensaje;
+        }
+        enlace.publicar = publicarSocket;
+        enlace.recibir = recibirSocket;
+    } else {
+        enlace.buzonSuperior = buzones + (2 * (size_t)indice) * bytesBuzon;
+        enlace.buzonInferior = buzones + (2 * (size_t)indice + 1) * bytesBuzon;
+        enlace.buzonVecinoSuperior = buzones + (2 * (size_t)superior + 1) * bytesBuzon;
+        enlace.buzonVecinoInferior = buzones + (2 * (size_t)inferior) * bytesBuzon;
+        enlace.publicar = publicarMemoria;
+        enlace.recibir = recibirMemoria;
+    }
+    exito = exito && calcularFranja(configuracion, indice, &enlace, &resultados[indice]);
+    if (!exito) {
+        atomic_store(&enlace.region->abortado, true);
+    }
+    free(enlace.arriba.envio);
+    if (configuracion->transporte == TRANSPORTE_SOCKET) {
+        close(enlace.arriba.descriptor);
+        close(enlace.abajo.descriptor);
+    }
+    return exito ? 0 : 1;
+}
+
+// Función para calcular las generaciones de una cuadrícula repartida en franjas entre varios procesos hijos y completar su resumen. Retorna false si no se pudieron crear los procesos, los canales o las cuadrículas, o si algún proceso falló.
+bool calcularFranjas(const ConfiguracionFranjas* configuracion, ResumenFranjas* resumen) {
+    if (configuracion == NULL || resumen == NULL || configuracion->numProcesos == 0 || configuracion->numProcesos > configuracion->alto) {
+        return false;
+    }
+    unsigned numProcesos = configuracion->numProcesos;
+    // La memoria compartida (la cabecera, los resultados y dos buzones por franja) se proyecta antes de crear los procesos, que la heredan. Las páginas nuevas ya valen 0.
+    size_t bytesBuzon = (sizeof(CabeceraBuzon) + 2 * PALABRAS_POR_FILA(configuracion->ancho) * sizeof(uint64_t) + BYTES_LINEA_CACHE - 1) / BYTES_LINEA_CACHE * BYTES_LINEA_CACHE;
+    size_t bytesRegion = sizeof(CabeceraRegion) + numProcesos * sizeof(ResultadoFranja) + 2 * (size_t)numProcesos * bytesBuzon;
+    uint8_t* region = (uint8_t*)mmap(NULL, bytesRegion, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        return false;
+    }
+    CabeceraRegion* cabecera = (CabeceraRegion*)region;
+    ResultadoFranja* resultados = (ResultadoFranja*)(region + sizeof(CabeceraRegion));
+    bool exito = true;
+    int (*sockets)[2] = NULL;
+    if (configuracion->transporte == TRANSPORTE_SOCKET) {
+        sockets = (int (*)[2])malloc(numProcesos * sizeof(*sockets));
+        exito = sockets != NULL;
+        for (unsigned i = 0; exito && i < numProcesos; i++) {
+            sockets[i][0] = sockets[i][1] = -1;
+        }
+        for (unsigned i = 0; exito && i < numProcesos; i++) {
+            exito = socketpair(AF_UNIX, SOCK_STREAM, 0, sockets[i]) == 0;
+        }
+    }
+
+    // Vaciamos los buffers de stdio antes de crear los procesos, para que los hijos no repitan la salida pendiente.
+    fflush(stdout);
+    fflush(stderr);
+    unsigned numCreados = 0;
+    for (unsigned i = 0; exito && i < numProcesos; i++) {
+        pid_t proceso = fork();
+        if (proceso == 0) {
+            _exit(ejecutarProcesoFranja(configuracion, i, region, sockets, bytesBuzon));
+        }
+        if (proceso < 0) {
+            exito = false;
+            atomic_store(&cabecera->abortado, true);
+            break;
+        }
+        numCreados++;
+    }
+    // El proceso padre no usa los sockets: al cerrarlos, los hijos detectan que un vecino terminó en cuanto lo hace.
+    cerrarSockets(sockets, numProcesos);
+    free(sockets);
+    // Esperamos a los hijos en el orden en que terminan, para avisar a los demás en cuanto uno falla (los que esperan a un vecino por la memoria compartida no lo detectarían).
+    for (unsigned restantes = numCreados; restantes > 0; restantes--) {
+        int estado;
+        pid_t proceso = waitpid(-1, &estado, 0);
+        if (proceso < 0) {
+            if (errno == EINTR) {
+                restantes++;
+                continue;
+            }
+            exito = false;
+            break;
+        }
+        if (!WIFEXITED(estado) || WEXITSTATUS(estado) != 0) {
+            exito = false;
+            atomic_store(&cabecera->abortado, true);
+        }
+    }
+
+    memset(resumen, 0, sizeof(ResumenFranjas));
+    if (exito) {
+        resumen->filasMinimas = UINT32_MAX;
+        resumen->kernel = resultados[0].kernel;
+        for (unsigned i = 0; i < numProcesos; i++) {
+            uint32_t filas = obtenerInicioFranja(configuracion, i + 1) - obtenerInicioFranja(configuracion, i);
+            resumen->filasMinimas = (filas < resumen->filasMinimas) ? filas : resumen->filasMinimas;
+            resumen->filasMaximas = (filas > resumen->filasMaximas) ? filas : resumen->filasMaximas;
+            resumen->poblacion += resultados[i].poblacion;
+            resumen->hash += resultados[i].hash;
+            resumen->segundos = (resultados[i].segundos > resumen->segundos) ? resultados[i].segundos : resumen->segundos;
+            resumen->segundosEspera = (resultados[i].segundosEspera > resumen->segundosEspera) ? resultados[i].segundosEspera : resumen->segundosEspera;
+        }
+    }
+    munmap(region, bytesRegion);
+    return exito;
+}
+
+// Función para ejecutar el cálculo por franjas indicado en las opciones (--procesos) y mostrar su resumen en stdout. Retorna el código de salida del programa (0 si no hubo errores).
+int ejecutarFranjas(const Opciones* opciones) {
+    // Cada proceso genera su franja de la configuración aleatoria, por lo que no se admiten archivos de entrada o salida, otros motores ni las opciones que necesitan la cuadrícula completa.
+    if (opciones->motor != MOTOR_CUADRICULA || opciones->patron != NULL || opciones->reanudar != NULL || opciones->guardar != NULL || opciones->instantanea != NULL ||
+        opciones->metricas != NULL || opciones->detenerPeriodo || opciones->numSopas > 0 || opciones->generacionesPorPasada > 1 || opciones->grabar != NULL ||
+        opciones->reproducir != NULL) {
+        fprintf(stderr, "La opción --procesos solo admite el motor 'cuadricula' y no se puede usar con --patron, --reanudar, --guardar, --instantanea, --metricas, "
+            "--detener-periodo, --censo, --pasada, --grabar ni --reproducir.\n");
+        return 1;
+    }
+    if (opciones->numProcesos > opciones->alto) {
+        fprintf(stderr, "No se puede repartir una cuadrícula de %u filas entre %u procesos.\n", (unsigned)opciones->alto, opciones->numProcesos);
+        return 1;
+    }
+    // La regla de las opciones ya fue validada por analizarArgumentos (NULL = B3/S23). Las reglas con B0 se admiten: la cuadrícula es toroidal.
+    Regla regla;
+    bool reglaIndicada = compilarRegla(opciones->regla, &regla);
+    ConfiguracionFranjas configuracion = {
+        .numProcesos = opciones->numProcesos,
+        .transporte = opciones->transporte,
+        .ancho = opciones->ancho,
+        .alto = opciones->alto,
+        .semilla = opciones->semilla,
+        .porcentaje = opciones->porcentaje,
+        .generaciones = opciones->generaciones,
+        .numHilos = opciones->numHilos,
+        .kernel = opciones->kernel,
+        .regla = reglaIndicada ? &regla : NULL
+    };
+    printf("motor: %s\n", obtenerNombreMotor(opciones->motor));
+    printf("dimensiones: %ux%u\n", (unsigned)opciones->ancho, (unsigned)opciones->alto);
+    printf("semilla: %llu\n", (unsigned long long)opciones->semilla);
+    printf("relleno: %u%%\n", opciones->porcentaje);
+    ResumenFranjas resumen;
+    if (!calcularFranjas(&configuracion, &resumen)) {
+        fprintf(stderr, "No se pudo completar el cálculo por franjas (procesos, canales, memoria o kernel no disponibles).\n");
+        return 1;
+    }
+
+    printf("regla: %s\n", reglaIndicada ? regla.texto : REGLA_CONWAY);
+    printf("kernel: %s\n", obtenerNombreKernel(resumen.kernel));
+    printf("procesos: %u (transporte %s, %u-%u filas por franja, %u hilos por proceso)\n", opciones->numProcesos, obtenerNombreTransporte(opciones->transporte),
+        resumen.filasMinimas, resumen.filasMaximas, opciones->numHilos);
+    printf("espera de bordes: %.6f s (maximo por proceso)\n", resumen.segundosEspera);
+    printf("hash: %016llx\n", (unsigned long long)resumen.hash);
+    double celulas = (double)opciones->ancho * (double)opciones->alto * (double)opciones->generaciones;
+    printf("generaciones: %llu\n", (unsigned long long)opciones->generaciones);
+    printf("poblacion final: %llu\n", (unsigned long long)resumen.poblacion);
+    printf("tiempo: %.6f s\n", resumen.segundos);
+    printf("celulas/s: %.4g\n", (resumen.segundos > 0.0) ? celulas / resumen.segundos : 0.0);
+    return 0;
+}
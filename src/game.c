@@ -23,12 +23,190 @@
 //      - Una célula en el borde superior tiene vecinos en el borde inferior, y viceversa.
 
 // 3. Inicialización Aleatoria:
-//      - La cuadrícula se inicializa con un 20% de células vivas, distribuidas aleatoriamente.
-//      - Se utiliza la función rand() para generar posiciones aleatorias.
+//      - La cuadrícula se inicializa con un 20% de células vivas (o el porcentaje indicado), distribuidas aleatoriamente.
+//      - Se utiliza un generador SplitMix64 propio de cada cuadrícula, por lo que la misma semilla produce siempre la misma configuración inicial.
 
+// 4. Representación Empaquetada:
+//      - Cada célula ocupa un solo bit, y cada fila se almacena como un arreglo de palabras de 64 bits (8 veces menos memoria que con bool).
+//      - La siguiente generación se calcula de 64 en 64 células: los 8 vecinos de cada bit se obtienen desplazando las palabras de las filas
+//        superior, actual e inferior, y se suman con lógica de sumadores (operaciones AND/OR/XOR), sin recorrer las células una por una.
+//      - El cálculo de cada fila lo realiza un kernel (ver kernels.c): escalar o vectorial (SSE2/AVX2/AVX-512), elegido al crear la cuadrícula según el procesador.
+//      - La regla (B3/S23 u otra regla B/S, ver reglas.c) se compila al crear la cuadrícula, y el kernel elegido está especializado para ella.
+
+// 5. Bloque Único con Borde Fantasma:
+//      - Cada generación ocupa un único bloque de memoria contiguo y alineado a la línea de caché, rodeado por un borde de una fila y una palabra.
+//      - Antes de cada generación, el borde se rellena con copias de las filas y columnas opuestas, por lo que el bucle de cálculo no tiene ramas ni módulos.
+
+// 6. Cálculo en Paralelo:
+//      - Cada fila de la generación siguiente depende solo de tres filas de la generación actual, por lo que la cuadrícula se divide en bandas de FILAS_POR_TESELA filas.
+//      - Las bandas se reparten entre los hilos de un pool persistente (ver hilos.c), creado una sola vez junto a la cuadrícula; el intercambio de buffers ocurre tras la barrera final.
+
+// 7. Teselas Activas:
+//      - La cuadrícula se divide en teselas de FILAS_POR_TESELA filas por PALABRAS_POR_TESELA palabras, y se guarda qué teselas cambiaron en la última generación.
+//      - Solo se recalculan las teselas que cambiaron o que tocan una tesela que cambió; las demás (zonas vacías o estables) se dejan como están.
+//      - Así, el costo de cada generación depende de la actividad de la cuadrícula y no de su área.
+
+// 8. Nacimientos y Muertes:
+//      - Con configurarConteoCambios, cada tesela que cambió cuenta sus nacimientos y muertes (popcount de las palabras nuevas y anteriores, ver kernels.c) mientras aún está en la caché.
+//      - Cada banda acumula sus cuentas por separado, y la población se actualiza con ellas sin recorrer la cuadrícula completa.
+
+// 9. Cuadrículas Gigantes:
+//      - Las dimensiones son de 32 bits (hasta DIMENSION_MAXIMA por lado), y los índices y tamaños se calculan con size_t.
+//      - El bloque de las generaciones se respalda con páginas grandes (ver memoria.c), lo que reduce los fallos de la TLB al recorrerlo.
+//      - Al crear el pool de hilos, las generaciones se copian a un bloque nuevo banda por banda, desde el hilo que calculará cada banda,
+//        de modo que el primer contacto con cada página la deja en el nodo NUMA de ese hilo.
+
+// 10. Bloqueo Temporal:
+//      - Con configurarGeneracionesPorPasada, avanzarCuadricula calcula k generaciones en cada pasada: la cuadrícula se divide en bloques de
+//        TESELAS_POR_BLOQUE x TESELAS_POR_BLOQUE teselas, y cada hilo copia un bloque con un halo de k filas (y una palabra) a un buffer propio
+//        que cabe en la caché L2, lo avanza k generaciones dentro del buffer y escribe solo el resultado final.
+//      - Los halos de bloques vecinos se solapan y se calculan dos veces (tiling trapezoidal), a cambio de leer y escribir la memoria
+//        principal una vez cada k generaciones en lugar de una vez por generación.
+//      - Solo se calculan los bloques con alguna tesela a menos de k células de una que cambió, por lo que las zonas estables siguen sin costo.
+//
+// 11. Bordes Primero:
+//      - calcularCuadriculaSiguienteConBordes calcula primero las bandas de las filas de los bordes y avisa antes de calcular el resto, para
+//        que un proceso que calcula solo una franja de la cuadrícula envíe esas filas a sus vecinos mientras calcula el interior (ver franjas.c).
+//
+// 12. Regiones:
+//      - leerRegionCuadricula, escribirRegionCuadricula y contarPoblacionRegion trabajan con regiones rectangulares de 64 en 64 células
+//        (desplazando las palabras de la fila si la región no empieza al inicio de una palabra), para no leer o escribir célula por célula.
+
+
+// Función para obtener el estado de la célula en la columna x de una fila empaquetada.
+static inline bool obtenerBit(const uint64_t* fila, size_t x) {
+    return (fila[x / BITS_POR_PALABRA] >> (x % BITS_POR_PALABRA)) & 1u;
+}
+
+// Función para establecer el estado de la célula en la columna x de una fila empaquetada.
+static inline void establecerBit(uint64_t* fila, size_t x, bool viva) {
+    uint64_t mascara = (uint64_t)1 << (x % BITS_POR_PALABRA);
+    if (viva) {
+        fila[x / BITS_POR_PALABRA] |= mascara;
+    } else {
+        fila[x / BITS_POR_PALABRA] &= ~mascara;
+    }
+}
+
+// Funciones para obtener la fila y de la generación actual y siguiente.
+static inline uint64_t* filaActual(const Cuadricula* cuadricula, ptrdiff_t y) {
+    return FILA_CUADRICULA(cuadricula->genActual, cuadricula->palabrasEntreFilas, y);
+}
+static inline uint64_t* filaSiguiente(const Cuadricula* cuadricula, ptrdiff_t y) {
+    return FILA_CUADRICULA(cuadricula->genSiguiente, cuadricula->palabrasEntreFilas, y);
+}
+
+// Función para descartar el hash, el historial de hashes y los conteos incrementales (se usa cuando las células se modifican fuera de calcularCuadriculaSiguiente, ya que la nueva configuración no sigue a las anteriores).
+static void invalidarHash(Cuadricula* cuadricula) {
+    cuadricula->hashValido = false;
+    cuadricula->poblacionValida = false;
+    cuadricula->cambiosValidos = false;
+    cuadricula->historial.numEntradas = 0;
+    cuadricula->historial.siguiente = 0;
+    cuadricula->historial.periodo = 0;
+}
+
+// Macros para el hash de cada palabra de la generación: la palabra se suma a una clave propia de su posición (índice * CLAVE_HASH_POSICION) y el resultado se mezcla con una multiplicación y un desplazamiento.
+#define CLAVE_HASH_POSICION 0x9E3779B97F4A7C15ull
+#define MULTIPLICADOR_HASH 0xBF58476D1CE4E5B9ull
+
+// Función para obtener el hash de una palabra de la generación a partir de la clave de su posición (índice = y * palabrasPorFila + p).
+// NOTA: El hash de la generación es la suma de los hashes de todas sus palabras, por lo que al cambiar una palabra basta con restar su hash anterior y sumar el nuevo.
+static inline uint64_t calcularHashPalabra(uint64_t clave, uint64_t palabra) {
+    uint64_t z = (palabra + clave) * MULTIPLICADOR_HASH;
+    return z ^ (z >> 29);
+}
+
+// Función para marcar todas las teselas como cambiadas, de modo que la siguiente generación se calcule completa (se usa cuando las células se modifican fuera de calcularCuadriculaSiguiente).
+static void marcarTodasTeselasCambiadas(Cuadricula* cuadricula) {
+    memset(cuadricula->teselasCambiadas, 1, cuadricula->filasTeselas * cuadricula->columnasTeselas);
+    invalidarHash(cuadricula);
+}
+
+// Función para marcar como cambiadas las teselas de la fila y que contienen las palabras [primeraPalabra, ultimaPalabra] (se usa cuando las células se modifican fuera de calcularCuadriculaSiguiente).
+static void marcarTeselasCambiadas(Cuadricula* cuadricula, size_t y, size_t primeraPalabra, size_t ultimaPalabra) {
+    uint8_t* filaTeselas = cuadricula->teselasCambiadas + (y / FILAS_POR_TESELA) * cuadricula->columnasTeselas;
+    memset(filaTeselas + primeraPalabra / PALABRAS_POR_TESELA, 1, ultimaPalabra / PALABRAS_POR_TESELA - primeraPalabra / PALABRAS_POR_TESELA + 1);
+    invalidarHash(cuadricula);
+}
+
+// Incremento del estado del generador SplitMix64 en cada llamada. Como el estado solo se incrementa, el estado tras n llamadas es estado + n * INCREMENTO_SPLITMIX, lo que permite saltar directamente a cualquier posición de la secuencia.
+#define INCREMENTO_SPLITMIX 0x9E3779B97F4A7C15ull
+
+// Función para obtener el siguiente número pseudoaleatorio (SplitMix64) a partir del estado del generador, que avanza en cada llamada.
+uint64_t generarAleatorio(uint64_t* estado) {
+    uint64_t z = (*estado += INCREMENTO_SPLITMIX);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Función para generar la fila y de una configuración aleatoria de ancho células por fila, con ~porcentaje% de células vivas, a partir del estado del generador al comenzar la fila 0.
+// Cada célula consume un número del generador, por lo que la fila y empieza en el estado que deja y * ancho llamadas: el resultado es el mismo que al generar las filas en orden.
+void generarFilaAleatoria(uint64_t estadoInicial, uint32_t ancho, uint64_t y, unsigned porcentaje, uint64_t* palabras) {
+    memset(palabras, 0, PALABRAS_POR_FILA(ancho) * sizeof(uint64_t));
+    // Con 0% de células vivas (por ejemplo, antes de cargar un patrón) basta con dejar la fila vacía.
+    if (porcentaje == 0) {
+        return;
+    }
+    uint64_t estado = estadoInicial + y * ancho * INCREMENTO_SPLITMIX;
+    for (uint32_t x = 0; x < ancho; x++) {
+        establecerBit(palabras, x, PORCENTAJE_CELULAS_VIVAS_INICIAL(&estado, porcentaje));
+    }
+}
+
+// Función que ejecuta cada hilo del pool para llenar aleatoriamente las filas de una banda de teselas (ver llenarAleatoriamente). El resultado es el mismo con cualquier número de hilos.
+static void llenarBandaAleatoriamente(void* contexto, size_t banda, unsigned hilo) {
+    (void)hilo;
+    Cuadricula* cuadricula = (Cuadricula*)contexto;
+    size_t yInicio = banda * FILAS_POR_TESELA;
+    size_t yFin = (yInicio + FILAS_POR_TESELA < cuadricula->alto) ? yInicio + FILAS_POR_TESELA : cuadricula->alto;
+    for (size_t y = yInicio; y < yFin; y++) {
+        generarFilaAleatoria(cuadricula->estadoAleatorio, cuadricula->ancho, y, cuadricula->porcentajeInicial, filaActual(cuadricula, (ptrdiff_t)y));
+    }
+}
+
+// Función para llenar la generación actual con ~porcentajeInicial% de células vivas distribuidas aleatoriamente, a través del macro PORCENTAJE_CELULAS_VIVAS_INICIAL. Con un pool de hilos, las bandas se llenan en paralelo.
+static void llenarAleatoriamente(Cuadricula* cuadricula) {
+    ejecutarEnParalelo(cuadricula->pool, cuadricula->filasTeselas, llenarBandaAleatoriamente, cuadricula);
+    // El generador continúa donde terminó la última célula, de modo que el siguiente reinicio produce una configuración nueva.
+    if (cuadricula->porcentajeInicial != 0) {
+        cuadricula->estadoAleatorio += (uint64_t)cuadricula->alto * cuadricula->ancho * INCREMENTO_SPLITMIX;
+    }
+}
+
+// Función para crear el pool de hilos de una cuadrícula sin pool (0 = todos los núcleos disponibles; con 1 hilo no se crea). Retorna false si no se pudo crear.
+static bool crearPoolCuadricula(Cuadricula* cuadricula, unsigned numHilos) {
+    if (numHilos == 0) {
+        numHilos = detectarNumNucleos();
+    }
+    if (numHilos > 1) {
+        cuadricula->pool = crearPoolHilos(numHilos);
+        if (cuadricula->pool == NULL) {
+            return false;
+        }
+    }
+    return true;
+}
 
 // Función para crear una nueva cuadrícula con las dimensiones especificadas y ~20% de células vivas iniciales (aleatorizadas).
-Cuadricula* crearCuadricula(unsigned short ancho, unsigned short alto) {
+Cuadricula* crearCuadricula(uint32_t ancho, uint32_t alto) {
+    // Usamos time() como semilla, lo que permite obtener diferentes configuraciones iniciales en cada ejecución del programa.
+    return crearCuadriculaConSemilla(ancho, alto, (uint64_t)time(NULL), PORCENTAJE_CELULAS_VIVAS_DEFECTO);
+}
+
+// Función para crear una nueva cuadrícula con las dimensiones especificadas y ~porcentaje% de células vivas iniciales, generadas a partir de una semilla.
+Cuadricula* crearCuadriculaConSemilla(uint32_t ancho, uint32_t alto, uint64_t semilla, unsigned porcentaje) {
+    return crearCuadriculaConRegla(ancho, alto, semilla, porcentaje, NULL);
+}
+
+// Función para crear una nueva cuadrícula como crearCuadriculaConSemilla, que calcula las generaciones con la regla indicada (NULL = B3/S23).
+Cuadricula* crearCuadriculaConRegla(uint32_t ancho, uint32_t alto, uint64_t semilla, unsigned porcentaje, const Regla* regla) {
+    return crearCuadriculaConHilos(ancho, alto, semilla, porcentaje, regla, 1);
+}
+
+// Función para crear una nueva cuadrícula como crearCuadriculaConRegla, que calcula las generaciones con numHilos hilos. El pool se crea antes de llenar la cuadrícula.
+Cuadricula* crearCuadriculaConHilos(uint32_t ancho, uint32_t alto, uint64_t semilla, unsigned porcentaje, const Regla* regla, unsigned numHilos) {
     // Asignamos memoria para la estructura Cuadricula
     Cuadricula* cuadricula = (Cuadricula*)malloc(sizeof(Cuadricula));
     if (cuadricula == NULL) {
@@ -38,66 +216,62 @@ Cuadricula* crearCuadricula(unsigned short ancho, unsigned short alto) {
     cuadricula->ancho = ancho;
     cuadricula->alto = alto;
     cuadricula->numGeneracion = 0;
+    cuadricula->palabrasPorFila = PALABRAS_POR_FILA(ancho);
+    cuadricula->pool = NULL;
+    cuadricula->generacionesPorPasada = 1;
+    memset(&cuadricula->memoriaBloques, 0, sizeof(cuadricula->memoriaBloques));
+    // Copiamos la regla ya compilada y elegimos el kernel especializado para ella.
+    cuadricula->regla = (regla != NULL) ? *regla : *obtenerReglaConway();
+    cuadricula->tipoKernel = detectarMejorKernel();
+    cuadricula->calcularFila = obtenerKernelFila(cuadricula->tipoKernel, &cuadricula->regla);
 
-    // Asignamos memoria para la matriz de células actual. Para ello, se multiplica el tamaño de un puntero a un booleano (que corresponde a una fila de la matriz) por el número de filas (alto).
-    cuadricula->genActual = (bool**)malloc(alto * sizeof(bool*));
-    if (cuadricula->genActual == NULL) {
+    // Cada fila ocupa sus palabras de datos más una palabra fantasma a cada lado, redondeando a un múltiplo de la línea de caché para que todas las filas empiecen alineadas.
+    size_t palabrasFila = cuadricula->palabrasPorFila + 2;
+    cuadricula->palabrasEntreFilas = (palabrasFila + PALABRAS_LINEA_CACHE - 1) / PALABRAS_LINEA_CACHE * PALABRAS_LINEA_CACHE;
+    size_t palabrasGeneracion = ((size_t)alto + 2) * cuadricula->palabrasEntreFilas;
+
+    // Reservamos un único bloque alineado para ambas generaciones, con todas las células en 0 (muertas). Si es grande, se respalda con páginas grandes (ver memoria.c).
+    if (!reservarBloqueMemoria(&cuadricula->memoria, 2 * palabrasGeneracion * sizeof(uint64_t))) {
         free(cuadricula);
         return NULL;
     }
+    cuadricula->genActual = (uint64_t*)cuadricula->memoria.direccion;
+    cuadricula->genSiguiente = cuadricula->genActual + palabrasGeneracion;
 
-    // Asignamos memoria para cada fila de la matriz de células actual. Para cada fila, se multiplica el tamaño de un booleano (que corresponde a una célula) por el número de columnas (ancho).
-    for (unsigned short i = 0; i < alto; i++) {
-        cuadricula->genActual[i] = (bool*)malloc(ancho * sizeof(bool));
-        // Liberamos la memoria correspondiente a las filas asignadas y a la cuadrícula en caso de error.
-        if (cuadricula->genActual[i] == NULL) {
-            for (unsigned short j = 0; j < i; j++) {
-                free(cuadricula->genActual[j]);
-            }
-            free(cuadricula->genActual);
-            free(cuadricula);
-            return NULL;
-        }
-    }
-
-    // Asignamos memoria para la matriz de células siguiente (buffer de escritura).
-    cuadricula->genSiguiente = (bool**)malloc(alto * sizeof(bool*));
-    if (cuadricula->genSiguiente == NULL) {
-        for (unsigned short i = 0; i < alto; i++) {
-            free(cuadricula->genActual[i]);
-        }
-        free(cuadricula->genActual);
+    // Asignamos los mapas de teselas. Al inicio todas se marcan como cambiadas, para que la primera generación se calcule completa.
+    cuadricula->filasTeselas = ((size_t)alto + FILAS_POR_TESELA - 1) / FILAS_POR_TESELA;
+    cuadricula->columnasTeselas = (cuadricula->palabrasPorFila + PALABRAS_POR_TESELA - 1) / PALABRAS_POR_TESELA;
+    cuadricula->teselasCambiadas = (uint8_t*)malloc(cuadricula->filasTeselas * cuadricula->columnasTeselas);
+    cuadricula->teselasActivas = (uint8_t*)malloc(cuadricula->filasTeselas * cuadricula->columnasTeselas);
+    cuadricula->deltasHash = (uint64_t*)malloc(cuadricula->filasTeselas * sizeof(uint64_t));
+    cuadricula->nacimientosBanda = (uint64_t*)malloc(cuadricula->filasTeselas * sizeof(uint64_t));
+    cuadricula->muertesBanda = (uint64_t*)malloc(cuadricula->filasTeselas * sizeof(uint64_t));
+    if (cuadricula->teselasCambiadas == NULL || cuadricula->teselasActivas == NULL || cuadricula->deltasHash == NULL ||
+        cuadricula->nacimientosBanda == NULL || cuadricula->muertesBanda == NULL) {
+        free(cuadricula->teselasCambiadas);
+        free(cuadricula->teselasActivas);
+        free(cuadricula->deltasHash);
+        free(cuadricula->nacimientosBanda);
+        free(cuadricula->muertesBanda);
+        liberarBloqueMemoria(&cuadricula->memoria);
         free(cuadricula);
         return NULL;
     }
-
-    // Asignamos memoria para cada fila de la matriz de células siguiente. Usamos calloc para inicializar todas las células a false (muertas).
-    for (unsigned short i = 0; i < alto; i++) {
-        cuadricula->genSiguiente[i] = (bool*)calloc(ancho, sizeof(bool));
-        // Liberamos la memoria correspondiente a las filas asignadas y a la cuadrícula en caso de error.
-        if (cuadricula->genSiguiente[i] == NULL) {
-            for (unsigned short j = 0; j < i; j++) {
-                free(cuadricula->genSiguiente[j]);
-            }
-            free(cuadricula->genSiguiente);
-            for (unsigned short j = 0; j < alto; j++) {
-                free(cuadricula->genActual[j]);
-            }
-            free(cuadricula->genActual);
-            free(cuadricula);
-            return NULL;
-        }
+    cuadricula->seguimientoTeselas = true;
+    cuadricula->deteccionPeriodo = false;
+    cuadricula->conteoCambios = false;
+    cuadricula->contarCambios = obtenerContadorCambios();
+    marcarTodasTeselasCambiadas(cuadricula);
+    // Creamos el pool antes de tocar las generaciones: las páginas del bloque aún no existen, y cada una se asignará en el nodo del hilo que la llene.
+    if (!crearPoolCuadricula(cuadricula, numHilos)) {
+        liberarCuadricula(cuadricula);
+        return NULL;
     }
 
-    // Usamos srand() y time() para inicializar la semilla del generador de números aleatorios, lo que permite obtener diferentes configuraciones iniciales en cada ejecución del programa.
-    srand((unsigned int)time(NULL));
-
-    // Inicializamos la matriz de células actual con ~20% de células vivas distribuidas aleatoriamente, a través del macro PORCENTAJE_CELULAS_VIVAS_INICIAL.
-    for (unsigned short i = 0; i < alto; i++) {
-        for (unsigned short j = 0; j < ancho; j++) {
-            cuadricula->genActual[i][j] = PORCENTAJE_CELULAS_VIVAS_INICIAL(20);
-        }
-    }
+    // Inicializamos el generador de números aleatorios con la semilla, y la matriz de células actual con ~porcentaje% de células vivas distribuidas aleatoriamente.
+    cuadricula->estadoAleatorio = semilla;
+    cuadricula->porcentajeInicial = porcentaje;
+    llenarAleatoriamente(cuadricula);
     return cuadricula;
 }
 
@@ -107,24 +281,20 @@ void liberarCuadricula(Cuadricula* cuadricula) {
     if (cuadricula == NULL) {
         return;
     }
-    // Liberamos la memoria asignada a las matrices genActual y genSiguiente.
-    if (cuadricula->genActual != NULL) {
-        for (unsigned short i = 0; i < cuadricula->alto; i++) {
-            free(cuadricula->genActual[i]);
-        }
-        free(cuadricula->genActual);
-    }
-    if (cuadricula->genSiguiente != NULL) {
-        for (unsigned short i = 0; i < cuadricula->alto; i++) {
-            free(cuadricula->genSiguiente[i]);
-        }
-        free(cuadricula->genSiguiente);
-    }
+    // Detenemos los hilos del pool (si existe) y liberamos el bloque que contiene las generaciones genActual y genSiguiente.
+    liberarPoolHilos(cuadricula->pool);
+    free(cuadricula->teselasCambiadas);
+    free(cuadricula->teselasActivas);
+    free(cuadricula->deltasHash);
+    free(cuadricula->nacimientosBanda);
+    free(cuadricula->muertesBanda);
+    liberarBloqueMemoria(&cuadricula->memoria);
+    liberarBloqueMemoria(&cuadricula->memoriaBloques);
     free(cuadricula);
 }
 
 // Función para contar el número de células vivas alrededor de una célula específica, considerando el wrapping toroidal.
-unsigned short contarVecinasVivas(Cuadricula* cuadricula, unsigned short x, unsigned short y) {
+unsigned short contarVecinasVivas(Cuadricula* cuadricula, uint32_t x, uint32_t y) {
     // Verificamos que la cuadrícula no esté vacía.
     if (cuadricula == NULL) {
         return 0;
@@ -147,11 +317,11 @@ unsigned short contarVecinasVivas(Cuadricula* cuadricula, unsigned short x, unsi
             }
 
             // Calculamos las coordenadas de la célula vecina, aplicando el wrapping toroidal.
-            unsigned short vecinoX = (x + dx + cuadricula->ancho) % cuadricula->ancho;
-            unsigned short vecinoY = (y + dy + cuadricula->alto) % cuadricula->alto;
+            uint32_t vecinoX = (uint32_t)(((uint64_t)x + cuadricula->ancho + dx) % cuadricula->ancho);
+            uint32_t vecinoY = (uint32_t)(((uint64_t)y + cuadricula->alto + dy) % cuadricula->alto);
 
             // Si la célula vecina está viva, incrementamos el contador.
-            if (cuadricula->genActual[vecinoY][vecinoX] == true) {
+            if (obtenerBit(filaActual(cuadricula, vecinoY), vecinoX)) {
                 vecinasVivas++;
             }
         }
@@ -159,51 +329,893 @@ unsigned short contarVecinasVivas(Cuadricula* cuadricula, unsigned short x, unsi
     return vecinasVivas;
 }
 
-// Función para calcular la siguiente generación de la cuadrícula según las reglas del Juego de la Vida.
+// Función para intercambiar los buffers de la cuadrícula y avanzar el número de generación.
+static void intercambiarGeneraciones(Cuadricula* cuadricula) {
+    // Intercambiamos los punteros de las matrices genActual y genSiguiente para avanzar a la siguiente generación.
+    uint64_t* temp = cuadricula->genActual;
+    cuadricula->genActual = cuadricula->genSiguiente;
+    cuadricula->genSiguiente = temp;
+
+    // Incrementamos el número de generación.
+    cuadricula->numGeneracion++;
+}
+
+// Función para rellenar el borde fantasma de la generación actual con las filas y columnas opuestas (wrapping toroidal).
+// NOTA: Si el ancho no es múltiplo de 64, la primera célula de cada fila se copia también en el primer bit sobrante de la última palabra, que es la posición que ocupa la vecina derecha de la última célula. limpiarRelleno() lo vuelve a 0 al terminar la generación.
+static void actualizarBordes(Cuadricula* cuadricula) {
+    size_t numPalabras = cuadricula->palabrasPorFila;
+    size_t bitUltimaCelula = (size_t)(cuadricula->ancho - 1) % BITS_POR_PALABRA;
+
+    // Columnas fantasma: la palabra izquierda lleva la última célula de la fila en su bit 63 y la derecha lleva la primera palabra de la fila.
+    for (uint32_t y = 0; y < cuadricula->alto; y++) {
+        uint64_t* fila = filaActual(cuadricula, y);
+        uint64_t primeraCelula = fila[0] & 1u;
+        fila[-1] = ((fila[numPalabras - 1] >> bitUltimaCelula) & 1u) << (BITS_POR_PALABRA - 1);
+        if (bitUltimaCelula + 1 < BITS_POR_PALABRA) {
+            fila[numPalabras - 1] |= primeraCelula << (bitUltimaCelula + 1);
+        }
+        fila[numPalabras] = fila[0];
+    }
+    // Filas fantasma: la fila superior replica la última fila y la inferior replica la primera (incluyendo sus columnas fantasma, lo que resuelve las esquinas).
+    size_t bytesFila = (numPalabras + 2) * sizeof(uint64_t);
+    memcpy(filaActual(cuadricula, -1) - 1, filaActual(cuadricula, cuadricula->alto - 1) - 1, bytesFila);
+    memcpy(filaActual(cuadricula, cuadricula->alto) - 1, filaActual(cuadricula, 0) - 1, bytesFila);
+}
+
+// Función para obtener la máscara de las células válidas de la última palabra de cada fila (descarta los bits sobrantes).
+static inline uint64_t obtenerMascaraUltimaPalabra(const Cuadricula* cuadricula) {
+    size_t bitUltimaCelula = (size_t)(cuadricula->ancho - 1) % BITS_POR_PALABRA;
+    return ~(uint64_t)0 >> (BITS_POR_PALABRA - 1 - bitUltimaCelula);
+}
+
+// Función para volver a 0 los bits sobrantes de la última palabra de cada fila de la generación actual (ver actualizarBordes).
+static void limpiarRelleno(Cuadricula* cuadricula) {
+    uint64_t mascaraUltimaPalabra = obtenerMascaraUltimaPalabra(cuadricula);
+    for (uint32_t y = 0; y < cuadricula->alto; y++) {
+        filaActual(cuadricula, y)[cuadricula->palabrasPorFila - 1] &= mascaraUltimaPalabra;
+    }
+}
+
+// Función para marcar como activas las teselas que cambiaron en la última generación y las que están a radioFilas filas y radioColumnas columnas de teselas de ellas (con wrapping toroidal). Con radio 1 (las 8 vecinas), el resto no puede cambiar en la generación siguiente.
+static void marcarTeselasActivas(Cuadricula* cuadricula, size_t radioFilas, size_t radioColumnas) {
+    size_t filas = cuadricula->filasTeselas;
+    size_t columnas = cuadricula->columnasTeselas;
+    if (!cuadricula->seguimientoTeselas) {
+        memset(cuadricula->teselasActivas, 1, filas * columnas);
+        return;
+    }
+    memset(cuadricula->teselasActivas, 0, filas * columnas);
+    for (size_t ty = 0; ty < filas; ty++) {
+        for (size_t tx = 0; tx < columnas; tx++) {
+            if (!cuadricula->teselasCambiadas[ty * columnas + tx]) {
+                continue;
+            }
+            for (size_t dy = 0; dy <= 2 * radioFilas; dy++) {
+                size_t vy = (ty + filas * radioFilas + dy - radioFilas) % filas;
+                for (size_t dx = 0; dx <= 2 * radioColumnas; dx++) {
+                    size_t vx = (tx + columnas * radioColumnas + dx - radioColumnas) % columnas;
+                    cuadricula->teselasActivas[vy * columnas + vx] = 1;
+                }
+            }
+        }
+    }
+}
+
+// Función para calcular una tesela de la generación siguiente a partir de la actual, con el borde fantasma ya actualizado. Retorna true si alguna de sus células cambió.
+// Si deltaHash no es NULL, se le suma el cambio del hash de la generación debido a las palabras de la tesela que cambiaron. Si nacimientos y muertes no son NULL, se les suman los de la tesela.
+static bool calcularTesela(Cuadricula* cuadricula, size_t ty, size_t tx, uint64_t* deltaHash, uint64_t* nacimientos, uint64_t* muertes) {
+    size_t yInicio = ty * FILAS_POR_TESELA;
+    size_t yFin = (yInicio + FILAS_POR_TESELA < cuadricula->alto) ? yInicio + FILAS_POR_TESELA : cuadricula->alto;
+    size_t pInicio = tx * PALABRAS_POR_TESELA;
+    size_t pFin = (pInicio + PALABRAS_POR_TESELA < cuadricula->palabrasPorFila) ? pInicio + PALABRAS_POR_TESELA : cuadricula->palabrasPorFila;
+    bool incluyeUltimaPalabra = (pFin == cuadricula->palabrasPorFila);
+    uint64_t mascaraUltimaPalabra = obtenerMascaraUltimaPalabra(cuadricula);
+    uint64_t diferencias = 0;
+
+    for (size_t y = yInicio; y < yFin; y++) {
+        // Gracias a las filas fantasma, las filas vecinas siempre están en y - 1 e y + 1.
+        const uint64_t* arriba = filaActual(cuadricula, (ptrdiff_t)y - 1) + pInicio;
+        const uint64_t* actual = filaActual(cuadricula, (ptrdiff_t)y) + pInicio;
+        const uint64_t* abajo = filaActual(cuadricula, (ptrdiff_t)y + 1) + pInicio;
+        uint64_t* siguiente = filaSiguiente(cuadricula, (ptrdiff_t)y) + pInicio;
+        size_t numPalabras = pFin - pInicio;
+
+        // Gracias a las columnas fantasma (o a las teselas vecinas), las palabras vecinas siempre están en p - 1 y p + 1 (ver kernels.c).
+        // El kernel retorna las diferencias con la generación actual; la última palabra de la fila se calcula aparte para descartar sus bits sobrantes.
+        if (incluyeUltimaPalabra) {
+            size_t ultima = numPalabras - 1;
+            diferencias |= cuadricula->calcularFila(siguiente, arriba, actual, abajo, ultima, &cuadricula->regla);
+            cuadricula->calcularFila(siguiente + ultima, arriba + ultima, actual + ultima, abajo + ultima, 1, &cuadricula->regla);
+            siguiente[ultima] &= mascaraUltimaPalabra;
+            diferencias |= (siguiente[ultima] ^ actual[ultima]) & mascaraUltimaPalabra;
+        } else {
+            diferencias |= cuadricula->calcularFila(siguiente, arriba, actual, abajo, numPalabras, &cuadricula->regla);
+        }
+    }
+    // Actualizamos el hash con las palabras de la tesela, que ya está en la caché (las teselas sin cambios no se recorren).
+    if (deltaHash != NULL && diferencias != 0) {
+        uint64_t delta = 0;
+        for (size_t y = yInicio; y < yFin; y++) {
+            const uint64_t* actual = filaActual(cuadricula, (ptrdiff_t)y);
+            const uint64_t* siguiente = filaSiguiente(cuadricula, (ptrdiff_t)y);
+            uint64_t clave = (uint64_t)(y * cuadricula->palabrasPorFila + pInicio) * CLAVE_HASH_POSICION;
+            // Sin condiciones dentro del bucle: una palabra que no cambió suma y resta el mismo valor.
+            for (size_t p = pInicio; p < pFin; p++, clave += CLAVE_HASH_POSICION) {
+                delta += calcularHashPalabra(clave, siguiente[p]) - calcularHashPalabra(clave, actual[p]);
+            }
+            // La última palabra de la fila actual puede tener bits sobrantes del borde fantasma: corregimos su hash por el de la palabra sin ellos.
+            if (incluyeUltimaPalabra) {
+                clave -= CLAVE_HASH_POSICION;
+                delta += calcularHashPalabra(clave, actual[pFin - 1]) - calcularHashPalabra(clave, actual[pFin - 1] & mascaraUltimaPalabra);
+            }
+        }
+        *deltaHash += delta;
+    }
+    // Contamos los nacimientos (bits nuevos) y las muertes (bits perdidos) de la tesela, sin los bits sobrantes de la última palabra de la fila actual.
+    if (nacimientos != NULL && diferencias != 0) {
+        size_t palabrasCompletas = pFin - pInicio - (incluyeUltimaPalabra ? 1 : 0);
+        for (size_t y = yInicio; y < yFin; y++) {
+            const uint64_t* actual = filaActual(cuadricula, (ptrdiff_t)y) + pInicio;
+            const uint64_t* siguiente = filaSiguiente(cuadricula, (ptrdiff_t)y) + pInicio;
+            cuadricula->contarCambios(actual, siguiente, palabrasCompletas, nacimientos, muertes);
+            if (incluyeUltimaPalabra) {
+                uint64_t anterior = actual[palabrasCompletas] & mascaraUltimaPalabra;
+                cuadricula->contarCambios(&anterior, siguiente + palabrasCompletas, 1, nacimientos, muertes);
+            }
+        }
+    }
+    return diferencias != 0;
+}
+
+// Función que ejecuta cada hilo del pool para calcular una banda de teselas (FILAS_POR_TESELA filas).
+// NOTA: Una tesela inactiva no cambia en esta generación y tampoco cambió en la anterior, por lo que genSiguiente ya contiene su estado (el de hace dos generaciones, que es igual al actual) y no hace falta copiarla.
+static void calcularBanda(void* contexto, size_t banda, unsigned hilo) {
+    (void)hilo;
+    Cuadricula* cuadricula = (Cuadricula*)contexto;
+    size_t inicioBanda = banda * cuadricula->columnasTeselas;
+    // Cada banda acumula el cambio del hash por separado; la suma de las bandas no depende del orden en que las calculen los hilos.
+    bool actualizarHash = cuadricula->deteccionPeriodo && cuadricula->hashValido;
+    cuadricula->deltasHash[banda] = 0;
+    // Los nacimientos y las muertes se acumulan en variables locales y se guardan una sola vez, para no escribir en cada tesela la línea de caché que comparten las bandas vecinas.
+    uint64_t nacimientos = 0, muertes = 0;
+    for (size_t tx = 0; tx < cuadricula->columnasTeselas; tx++) {
+        bool cambiada = false;
+        if (cuadricula->teselasActivas[inicioBanda + tx]) {
+            cambiada = calcularTesela(cuadricula, banda, tx, actualizarHash ? &cuadricula->deltasHash[banda] : NULL,
+                cuadricula->conteoCambios ? &nacimientos : NULL, cuadricula->conteoCambios ? &muertes : NULL);
+        }
+        cuadricula->teselasCambiadas[inicioBanda + tx] = cambiada;
+    }
+    cuadricula->nacimientosBanda[banda] = nacimientos;
+    cuadricula->muertesBanda[banda] = muertes;
+}
+
+// Función para calcular el hash de la generación actual recorriendo todas sus palabras.
+static uint64_t calcularHashCompleto(const Cuadricula* cuadricula) {
+    uint64_t hash = 0;
+    uint64_t clave = 0;
+    for (uint32_t y = 0; y < cuadricula->alto; y++) {
+        const uint64_t* fila = filaActual(cuadricula, y);
+        for (size_t p = 0; p < cuadricula->palabrasPorFila; p++, clave += CLAVE_HASH_POSICION) {
+            hash += calcularHashPalabra(clave, fila[p]);
+        }
+    }
+    return hash;
+}
+
+// Función para guardar el hash de la generación actual en el historial y buscarlo entre los de las generaciones anteriores.
+static void registrarHistorial(Cuadricula* cuadricula) {
+    uint64_t hash = obtenerHashCuadricula(cuadricula);
+    HistorialHash* historial = &cuadricula->historial;
+    // Si la generación actual repite una anterior, la configuración es periódica desde esa generación (la primera vez que ocurre, es el inicio del ciclo).
+    if (historial->periodo == 0) {
+        for (size_t i = 0; i < historial->numEntradas; i++) {
+            if (historial->hashes[i] == hash) {
+                historial->periodo = cuadricula->numGeneracion - historial->generaciones[i];
+                historial->inicioPeriodo = historial->generaciones[i];
+                break;
+            }
+        }
+    }
+    historial->hashes[historial->siguiente] = hash;
+    historial->generaciones[historial->siguiente] = cuadricula->numGeneracion;
+    historial->siguiente = (historial->siguiente + 1) % LONGITUD_HISTORIAL_HASH;
+    if (historial->numEntradas < LONGITUD_HISTORIAL_HASH) {
+        historial->numEntradas++;
+    }
+}
+
+// Definición de las bandas que se reparten entre los hilos del pool en calcularCuadriculaSiguienteConBordes: las tareas [0, numPrimeras) son las bandas consecutivas desde primeraBanda, y las siguientes continúan salto bandas más adelante.
+typedef struct {
+    Cuadricula* cuadricula;
+    size_t primeraBanda;
+    size_t numPrimeras;
+    size_t salto;
+} RangoBandas;
+
+// Función que ejecuta cada hilo del pool para calcular la banda que corresponde a la tarea de un RangoBandas.
+static void calcularBandaRango(void* contexto, size_t tarea, unsigned hilo) {
+    const RangoBandas* rango = (const RangoBandas*)contexto;
+    size_t banda = rango->primeraBanda + tarea + ((tarea >= rango->numPrimeras) ? rango->salto : 0);
+    calcularBanda(rango->cuadricula, banda, hilo);
+}
+
+// Función para calcular la siguiente generación de la cuadrícula según su regla (B3/S23 por defecto).
 void calcularCuadriculaSiguiente(Cuadricula* cuadricula) {
+    calcularCuadriculaSiguienteConBordes(cuadricula, 0, NULL, NULL);
+}
+
+// Función para calcular la siguiente generación como calcularCuadriculaSiguiente, llamando a bordesCalculados en cuanto están calculadas las bandas de las primeras y las últimas filasBorde filas, antes de calcular el resto.
+void calcularCuadriculaSiguienteConBordes(Cuadricula* cuadricula, uint32_t filasBorde, FuncionBordesCalculados bordesCalculados, void* contexto) {
     // Verificamos que la cuadrícula no esté vacía.
     if (cuadricula == NULL) {
         return;
     }
-    // Recorremos cada célula de la cuadrícula actual para aplicar las reglas del Juego de la Vida.
-    for (unsigned short y = 0; y < cuadricula->alto; y++) {
-        for (unsigned short x = 0; x < cuadricula->ancho; x++) {
-            // Contamos el número de células vivas alrededor de la célula en (x, y).
-            unsigned short vecinasVivas = contarVecinasVivas(cuadricula, x, y);
-            // Aplicamos las reglas del Juego de la Vida para determinar el estado de la célula en la siguiente generación.
-            if (cuadricula->genActual[y][x] == true) {
-                // Una célula viva con 2 o 3 vecinas vivas sobrevive; de lo contrario, muere.
-                if (vecinasVivas == 2 || vecinasVivas == 3) {
-                    cuadricula->genSiguiente[y][x] = true; // La célula sobrevive.
-                } else {
-                    cuadricula->genSiguiente[y][x] = false; // La célula muere.
-                }
-            } else {
-                // Una célula muerta con exactamente 3 vecinas vivas se convierte en una célula viva.
-                if (vecinasVivas == 3) {
-                    cuadricula->genSiguiente[y][x] = true; // La célula nace.
-                } else {
-                    cuadricula->genSiguiente[y][x] = false; // La célula permanece muerta.
-                }
+    // Actualizamos el borde fantasma una sola vez y marcamos las teselas que hay que recalcular.
+    actualizarBordes(cuadricula);
+    marcarTeselasActivas(cuadricula, 1, 1);
+    // Calculamos las teselas activas, 64 células por iteración, repartiendo las bandas entre los hilos del pool.
+    // Las bandas [0, ultimaSuperior] contienen las primeras filasBorde filas y las bandas [primeraInferior, filasTeselas) las últimas.
+    size_t filas = (filasBorde < 1) ? 1 : (filasBorde > cuadricula->alto) ? cuadricula->alto : filasBorde;
+    size_t ultimaSuperior = (filas - 1) / FILAS_POR_TESELA;
+    size_t primeraInferior = (cuadricula->alto - filas) / FILAS_POR_TESELA;
+    if (bordesCalculados == NULL || primeraInferior <= ultimaSuperior + 1) {
+        ejecutarEnParalelo(cuadricula->pool, cuadricula->filasTeselas, calcularBanda, cuadricula);
+        if (bordesCalculados != NULL) {
+            bordesCalculados(contexto, cuadricula);
+        }
+    } else {
+        // Primero las bandas de los bordes; el interior se calcula mientras quien recibe las filas de los bordes ya puede usarlas.
+        RangoBandas bordes = {cuadricula, 0, ultimaSuperior + 1, primeraInferior - ultimaSuperior - 1};
+        ejecutarEnParalelo(cuadricula->pool, ultimaSuperior + 1 + cuadricula->filasTeselas - primeraInferior, calcularBandaRango, &bordes);
+        bordesCalculados(contexto, cuadricula);
+        RangoBandas interior = {cuadricula, ultimaSuperior + 1, SIZE_MAX, 0};
+        ejecutarEnParalelo(cuadricula->pool, primeraInferior - ultimaSuperior - 1, calcularBandaRango, &interior);
+    }
+    limpiarRelleno(cuadricula);
+    if (cuadricula->deteccionPeriodo && cuadricula->hashValido) {
+        for (size_t banda = 0; banda < cuadricula->filasTeselas; banda++) {
+            cuadricula->hash += cuadricula->deltasHash[banda];
+        }
+    }
+    if (cuadricula->conteoCambios) {
+        cuadricula->nacimientos = 0;
+        cuadricula->muertes = 0;
+        for (size_t banda = 0; banda < cuadricula->filasTeselas; banda++) {
+            cuadricula->nacimientos += cuadricula->nacimientosBanda[banda];
+            cuadricula->muertes += cuadricula->muertesBanda[banda];
+        }
+        cuadricula->cambiosValidos = true;
+        cuadricula->poblacion += cuadricula->nacimientos - cuadricula->muertes;
+    } else {
+        cuadricula->poblacionValida = false;
+    }
+    intercambiarGeneraciones(cuadricula);
+    if (cuadricula->deteccionPeriodo) {
+        registrarHistorial(cuadricula);
+    }
+}
+
+// Definición del contexto de una pasada de bloqueo temporal (ver avanzarCuadricula).
+typedef struct {
+    Cuadricula* cuadricula;
+    unsigned generaciones;          // Generaciones que se calculan en la pasada
+    size_t columnasBloques;         // Número de columnas de bloques (de TESELAS_POR_BLOQUE x TESELAS_POR_BLOQUE teselas)
+    size_t palabrasPorHilo;         // Palabras del buffer de cada hilo en memoriaBloques
+} PasadaTemporal;
+
+// Función para calcular las palabras del buffer de cada hilo en una pasada de generaciones generaciones: dos copias de un bloque con su halo (generaciones filas arriba y abajo, una palabra a cada lado) y una palabra fantasma a cada lado de cada fila, redondeadas a la línea de caché.
+static size_t calcularPalabrasBufferBloque(unsigned generaciones) {
+    size_t filas = (size_t)TESELAS_POR_BLOQUE * FILAS_POR_TESELA + 2 * (size_t)generaciones;
+    size_t palabrasEntreFilas = (size_t)TESELAS_POR_BLOQUE * PALABRAS_POR_TESELA + 4;
+    // La palabra adicional es la palabra fantasma izquierda de la primera fila.
+    size_t palabras = 2 * filas * palabrasEntreFilas + 1;
+    return (palabras + PALABRAS_LINEA_CACHE - 1) / PALABRAS_LINEA_CACHE * PALABRAS_LINEA_CACHE;
+}
+
+// Función para obtener las 64 células de una fila a partir de la columna x (con wrapping toroidal, aunque la fila mida menos de 64 células).
+// NOTA: Se usa fuera del cálculo de una generación, cuando los bits sobrantes de la última palabra de la fila están en 0.
+static inline uint64_t extraerPalabraToroidal(const Cuadricula* cuadricula, const uint64_t* fila, size_t x) {
+    // Caso habitual: la palabra coincide con una palabra de la fila.
+    if (x % BITS_POR_PALABRA == 0 && x + BITS_POR_PALABRA <= cuadricula->ancho) {
+        return fila[x / BITS_POR_PALABRA];
+    }
+    uint64_t palabra = 0;
+    size_t obtenidos = 0;
+    while (obtenidos < BITS_POR_PALABRA) {
+        size_t p = x / BITS_POR_PALABRA;
+        size_t desplazamiento = x % BITS_POR_PALABRA;
+        uint64_t bits = fila[p] >> desplazamiento;
+        if (desplazamiento != 0 && p + 1 < cuadricula->palabrasPorFila) {
+            bits |= fila[p + 1] << (BITS_POR_PALABRA - desplazamiento);
+        }
+        size_t disponibles = (size_t)cuadricula->ancho - x;
+        if (disponibles < BITS_POR_PALABRA) {
+            bits &= ~(uint64_t)0 >> (BITS_POR_PALABRA - disponibles);
+        }
+        palabra |= bits << obtenidos;
+        size_t tomados = (disponibles < BITS_POR_PALABRA - obtenidos) ? disponibles : BITS_POR_PALABRA - obtenidos;
+        obtenidos += tomados;
+        x = (x + tomados) % cuadricula->ancho;
+    }
+    return palabra;
+}
+
+// Función que ejecuta cada hilo del pool para avanzar un bloque de TESELAS_POR_BLOQUE x TESELAS_POR_BLOQUE teselas varias generaciones seguidas dentro de su buffer.
+// El bloque se copia con un halo de tantas filas como generaciones arriba y abajo, y de una palabra a cada lado: cada generación invalida una fila
+// y una célula más de cada borde del halo, por lo que al terminar el bloque sigue siendo exacto y se escribe en genSiguiente.
+// NOTA: Un bloque sin teselas activas no cambia en la pasada, y genSiguiente ya contiene su estado (ver calcularBanda).
+static void calcularBloqueTemporal(void* contexto, size_t bloque, unsigned hilo) {
+    const PasadaTemporal* pasada = (const PasadaTemporal*)contexto;
+    Cuadricula* cuadricula = pasada->cuadricula;
+    size_t generaciones = pasada->generaciones;
+    size_t tyInicio = bloque / pasada->columnasBloques * TESELAS_POR_BLOQUE;
+    size_t txInicio = bloque % pasada->columnasBloques * TESELAS_POR_BLOQUE;
+    size_t tyFin = (tyInicio + TESELAS_POR_BLOQUE < cuadricula->filasTeselas) ? tyInicio + TESELAS_POR_BLOQUE : cuadricula->filasTeselas;
+    size_t txFin = (txInicio + TESELAS_POR_BLOQUE < cuadricula->columnasTeselas) ? txInicio + TESELAS_POR_BLOQUE : cuadricula->columnasTeselas;
+    bool activo = false;
+    for (size_t ty = tyInicio; ty < tyFin; ty++) {
+        for (size_t tx = txInicio; tx < txFin; tx++) {
+            activo |= cuadricula->teselasActivas[ty * cuadricula->columnasTeselas + tx];
+            cuadricula->teselasCambiadas[ty * cuadricula->columnasTeselas + tx] = 0;
+        }
+    }
+    if (!activo) {
+        return;
+    }
+
+    // Filas [yInicio, yFin) y palabras [pInicio, pFin) de la cuadrícula que escribe el bloque.
+    size_t yInicio = tyInicio * FILAS_POR_TESELA;
+    size_t yFin = (tyFin * FILAS_POR_TESELA < cuadricula->alto) ? tyFin * FILAS_POR_TESELA : cuadricula->alto;
+    size_t pInicio = txInicio * PALABRAS_POR_TESELA;
+    size_t pFin = (txFin * PALABRAS_POR_TESELA < cuadricula->palabrasPorFila) ? txFin * PALABRAS_POR_TESELA : cuadricula->palabrasPorFila;
+    // La fila i del buffer es la fila (yInicio - generaciones + i) de la cuadrícula, y la palabra j empieza en la columna (pInicio - 1 + j) * 64, ambas con wrapping toroidal.
+    size_t filas = yFin - yInicio + 2 * generaciones;
+    size_t palabras = pFin - pInicio + 2;
+    size_t palabrasEntreFilas = palabras + 2;
+    uint64_t* buffers[2];
+    buffers[0] = (uint64_t*)cuadricula->memoriaBloques.direccion + (size_t)hilo * pasada->palabrasPorHilo + 1;
+    buffers[1] = buffers[0] + filas * palabrasEntreFilas;
+    size_t alto = cuadricula->alto;
+    size_t ancho = cuadricula->ancho;
+    size_t yOrigen = (yInicio + alto - generaciones % alto) % alto;
+    size_t xOrigen = (pInicio * BITS_POR_PALABRA + ancho - BITS_POR_PALABRA % ancho) % ancho;
+    // Lejos del borde izquierdo y derecho de la cuadrícula, las palabras del buffer son las de la fila, y se copian directamente.
+    bool palabrasAlineadas = (xOrigen % BITS_POR_PALABRA == 0) && (xOrigen + palabras * BITS_POR_PALABRA <= ancho);
+    size_t columnas[TESELAS_POR_BLOQUE * PALABRAS_POR_TESELA + 2];
+    for (size_t j = 0, x = xOrigen; j < palabras; j++, x = (x + BITS_POR_PALABRA) % ancho) {
+        columnas[j] = x;
+    }
+    for (size_t i = 0; i < filas; i++) {
+        const uint64_t* origen = filaActual(cuadricula, (ptrdiff_t)((yOrigen + i) % alto));
+        uint64_t* destino = buffers[0] + i * palabrasEntreFilas;
+        if (palabrasAlineadas) {
+            memcpy(destino, origen + xOrigen / BITS_POR_PALABRA, palabras * sizeof(uint64_t));
+        } else {
+            for (size_t j = 0; j < palabras; j++) {
+                destino[j] = extraerPalabraToroidal(cuadricula, origen, columnas[j]);
             }
         }
+        // Las palabras fantasma del buffer no son vecinas reales: su contenido solo alcanza al halo, que se descarta.
+        destino[-1] = destino[palabras] = 0;
+        buffers[1][i * palabrasEntreFilas - 1] = buffers[1][i * palabrasEntreFilas + palabras] = 0;
+    }
+    // Cada generación se calcula en las filas que aún tienen sus dos vecinas válidas.
+    for (size_t g = 1; g <= generaciones; g++) {
+        const uint64_t* anterior = buffers[(g - 1) % 2];
+        uint64_t* siguiente = buffers[g % 2];
+        for (size_t i = g; i < filas - g; i++) {
+            const uint64_t* actual = anterior + i * palabrasEntreFilas;
+            cuadricula->calcularFila(siguiente + i * palabrasEntreFilas, actual - palabrasEntreFilas, actual, actual + palabrasEntreFilas, palabras, &cuadricula->regla);
+        }
     }
-    // Intercambiamos los punteros de las matrices genActual y genSiguiente para avanzar a la siguiente generación.
-    bool** temp = cuadricula->genActual;
-    cuadricula->genActual = cuadricula->genSiguiente;
-    cuadricula->genSiguiente = temp;
 
-    // Incrementamos el número de generación.
-    cuadricula->numGeneracion++;
+    // Escribimos el bloque en genSiguiente. Cada tesela cambió si difiere de la generación actual (que genSiguiente pasa a ser) o de la penúltima de la pasada.
+    const uint64_t* final = buffers[generaciones % 2];
+    const uint64_t* penultima = buffers[(generaciones - 1) % 2];
+    uint64_t mascaraUltimaPalabra = obtenerMascaraUltimaPalabra(cuadricula);
+    for (size_t y = yInicio; y < yFin; y++) {
+        size_t i = y - yInicio + generaciones;
+        const uint64_t* actual = filaActual(cuadricula, (ptrdiff_t)y);
+        uint64_t* siguiente = filaSiguiente(cuadricula, (ptrdiff_t)y);
+        uint8_t* cambiadas = cuadricula->teselasCambiadas + (y / FILAS_POR_TESELA) * cuadricula->columnasTeselas;
+        for (size_t pTesela = pInicio; pTesela < pFin; pTesela += PALABRAS_POR_TESELA) {
+            size_t pFinTesela = (pTesela + PALABRAS_POR_TESELA < pFin) ? pTesela + PALABRAS_POR_TESELA : pFin;
+            uint64_t diferencias = 0;
+            for (size_t p = pTesela; p < pFinTesela; p++) {
+                size_t j = i * palabrasEntreFilas + p - pInicio + 1;
+                uint64_t mascara = (p + 1 == cuadricula->palabrasPorFila) ? mascaraUltimaPalabra : ~(uint64_t)0;
+                siguiente[p] = final[j] & mascara;
+                diferencias |= (siguiente[p] ^ actual[p]) | ((final[j] ^ penultima[j]) & mascara);
+            }
+            cambiadas[pTesela / PALABRAS_POR_TESELA] |= (diferencias != 0);
+        }
+    }
+}
+
+// Función para calcular una pasada de bloqueo temporal: avanza la cuadrícula generaciones generaciones de una sola vez. Retorna false si no hay memoria para los buffers de los hilos (la cuadrícula no cambia).
+static bool calcularPasadaTemporal(Cuadricula* cuadricula, unsigned generaciones) {
+    // Los buffers se reservan (y se tocan por primera vez) solo cuando hacen falta, y se conservan para las pasadas siguientes.
+    unsigned numHilos = obtenerNumHilosPool(cuadricula->pool);
+    size_t palabrasPorHilo = calcularPalabrasBufferBloque(generaciones);
+    size_t bytes = (size_t)numHilos * palabrasPorHilo * sizeof(uint64_t);
+    if (cuadricula->memoriaBloques.bytes < bytes) {
+        liberarBloqueMemoria(&cuadricula->memoriaBloques);
+        if (!reservarBloqueMemoria(&cuadricula->memoriaBloques, bytes)) {
+            return false;
+        }
+    }
+    // Una tesela solo puede cambiar en la pasada si alguna célula que cambió en la última generación está a menos de generaciones células.
+    size_t radioFilas = ((size_t)generaciones + FILAS_POR_TESELA - 1) / FILAS_POR_TESELA;
+    size_t radioColumnas = ((size_t)generaciones + PALABRAS_POR_TESELA * BITS_POR_PALABRA - 1) / (PALABRAS_POR_TESELA * BITS_POR_PALABRA);
+    marcarTeselasActivas(cuadricula, radioFilas, radioColumnas);
+    size_t filasBloques = (cuadricula->filasTeselas + TESELAS_POR_BLOQUE - 1) / TESELAS_POR_BLOQUE;
+    PasadaTemporal pasada = {
+        .cuadricula = cuadricula,
+        .generaciones = generaciones,
+        .columnasBloques = (cuadricula->columnasTeselas + TESELAS_POR_BLOQUE - 1) / TESELAS_POR_BLOQUE,
+        .palabrasPorHilo = palabrasPorHilo
+    };
+    ejecutarEnParalelo(cuadricula->pool, filasBloques * pasada.columnasBloques, calcularBloqueTemporal, &pasada);
+    // La pasada no cuenta nacimientos ni muertes (avanzarCuadricula solo la usa sin conteo de cambios ni detección de períodos).
+    cuadricula->poblacionValida = false;
+    cuadricula->cambiosValidos = false;
+    intercambiarGeneraciones(cuadricula);
+    cuadricula->numGeneracion += generaciones - 1;
+    return true;
+}
+
+// Función para avanzar la cuadrícula el número de generaciones indicado, con el mismo resultado que llamar a calcularCuadriculaSiguiente esas veces.
+void avanzarCuadricula(Cuadricula* cuadricula, uint64_t generaciones) {
+    // Verificamos que la cuadrícula no esté vacía.
+    if (cuadricula == NULL) {
+        return;
+    }
+    while (generaciones > 0) {
+        // La detección de períodos y el conteo de cambios necesitan cada generación, por lo que en ese caso se calculan de a una.
+        unsigned pasada = (generaciones < cuadricula->generacionesPorPasada) ? (unsigned)generaciones : cuadricula->generacionesPorPasada;
+        if (pasada > 1 && !cuadricula->deteccionPeriodo && !cuadricula->conteoCambios && calcularPasadaTemporal(cuadricula, pasada)) {
+            generaciones -= pasada;
+        } else {
+            calcularCuadriculaSiguiente(cuadricula);
+            generaciones--;
+        }
+    }
+}
+
+// Función para configurar cuántas generaciones calcula avanzarCuadricula en cada pasada por los bloques de la cuadrícula (1 = sin bloqueo temporal). Retorna false si el valor no está en [1, GENERACIONES_POR_PASADA_MAXIMA].
+bool configurarGeneracionesPorPasada(Cuadricula* cuadricula, unsigned generaciones) {
+    if (cuadricula == NULL || generaciones < 1 || generaciones > GENERACIONES_POR_PASADA_MAXIMA) {
+        return false;
+    }
+    cuadricula->generacionesPorPasada = generaciones;
+    return true;
+}
+
+// Función para obtener, durante calcularCuadriculaSiguienteConBordes, la fila y de la generación que se está calculando (al llamar a bordesCalculados solo están completas las filas de los bordes).
+const uint64_t* obtenerFilaSiguienteCuadricula(Cuadricula* cuadricula, uint32_t y) {
+    if (cuadricula == NULL || y >= cuadricula->alto) {
+        return NULL;
+    }
+    return filaSiguiente(cuadricula, y);
+}
+
+// Función para calcular la parte del hash de una generación que corresponde a su fila y (palabrasPorFila palabras, sin bits sobrantes). El hash de la generación es la suma de los de todas sus filas.
+uint64_t calcularHashFila(const uint64_t* palabras, size_t palabrasPorFila, uint64_t y) {
+    uint64_t hash = 0;
+    uint64_t clave = y * palabrasPorFila * CLAVE_HASH_POSICION;
+    for (size_t p = 0; p < palabrasPorFila; p++, clave += CLAVE_HASH_POSICION) {
+        hash += calcularHashPalabra(clave, palabras[p]);
+    }
+    return hash;
+}
+
+// Función para obtener el hash de 64 bits de la generación actual (dos generaciones con las mismas células tienen el mismo hash). Con la detección de períodos activada, se mantiene de forma incremental a partir de las teselas que cambian; si no, se calcula completo.
+uint64_t obtenerHashCuadricula(Cuadricula* cuadricula) {
+    // Verificamos que la cuadrícula no esté vacía.
+    if (cuadricula == NULL) {
+        return 0;
+    }
+    if (!cuadricula->hashValido) {
+        cuadricula->hash = calcularHashCompleto(cuadricula);
+        // Sin la detección de períodos, el hash no se actualiza al calcular la siguiente generación.
+        cuadricula->hashValido = cuadricula->deteccionPeriodo;
+        return cuadricula->hash;
+    }
+    return cuadricula->hash;
+}
+
+// Función para activar o desactivar la detección de configuraciones estables u oscilantes (se guarda el hash de las últimas LONGITUD_HISTORIAL_HASH generaciones).
+void configurarDeteccionPeriodo(Cuadricula* cuadricula, bool activar) {
+    // Verificamos que la cuadrícula no esté vacía.
+    if (cuadricula == NULL) {
+        return;
+    }
+    invalidarHash(cuadricula);
+    cuadricula->deteccionPeriodo = activar;
+    // La generación actual es la primera del historial.
+    if (activar) {
+        registrarHistorial(cuadricula);
+    }
+}
+
+// Función para saber si la cuadrícula se volvió estable (período 1) u oscilante, a partir de las generaciones calculadas desde que se activó la detección (o desde la última modificación de células). Si es así, retorna true e indica el período y la primera generación del ciclo.
+bool obtenerPeriodoCuadricula(Cuadricula* cuadricula, uint64_t* periodo, uint64_t* inicio) {
+    // Verificamos que la cuadrícula no esté vacía y que se haya detectado un período.
+    if (cuadricula == NULL || cuadricula->historial.periodo == 0) {
+        return false;
+    }
+    if (periodo != NULL) {
+        *periodo = cuadricula->historial.periodo;
+    }
+    if (inicio != NULL) {
+        *inicio = cuadricula->historial.inicioPeriodo;
+    }
+    return true;
+}
+
+// Función para activar o desactivar el conteo de nacimientos y muertes de cada generación. Con el conteo activado, la población también se mantiene de forma incremental.
+void configurarConteoCambios(Cuadricula* cuadricula, bool activar) {
+    // Verificamos que la cuadrícula no esté vacía.
+    if (cuadricula == NULL) {
+        return;
+    }
+    cuadricula->conteoCambios = activar;
+    cuadricula->cambiosValidos = false;
+    cuadricula->poblacionValida = false;
+}
+
+// Función para obtener los nacimientos y las muertes de la última generación calculada. Retorna false si el conteo no está activado o si las células se modificaron fuera del cálculo desde entonces.
+bool obtenerCambiosCuadricula(Cuadricula* cuadricula, uint64_t* nacimientos, uint64_t* muertes) {
+    // Verificamos que la cuadrícula no esté vacía y que haya conteos de la generación actual.
+    if (cuadricula == NULL || !cuadricula->conteoCambios || !cuadricula->cambiosValidos) {
+        return false;
+    }
+    if (nacimientos != NULL) {
+        *nacimientos = cuadricula->nacimientos;
+    }
+    if (muertes != NULL) {
+        *muertes = cuadricula->muertes;
+    }
+    return true;
+}
+
+// Función para activar o desactivar el seguimiento de teselas activas (si está desactivado, todas las teselas se recalculan en cada generación).
+void configurarSeguimientoTeselas(Cuadricula* cuadricula, bool activar) {
+    // Verificamos que la cuadrícula no esté vacía.
+    if (cuadricula == NULL) {
+        return;
+    }
+    cuadricula->seguimientoTeselas = activar;
+    marcarTodasTeselasCambiadas(cuadricula);
+}
+
+// Función para obtener el número de teselas que cambiaron en la última generación.
+size_t contarTeselasCambiadas(Cuadricula* cuadricula) {
+    // Verificamos que la cuadrícula no esté vacía.
+    if (cuadricula == NULL) {
+        return 0;
+    }
+    size_t cambiadas = 0;
+    for (size_t t = 0; t < cuadricula->filasTeselas * cuadricula->columnasTeselas; t++) {
+        cambiadas += cuadricula->teselasCambiadas[t];
+    }
+    return cambiadas;
+}
+
+// Definición del contexto para copiar las generaciones a un bloque nuevo, banda por banda (ver colocarMemoriaCuadricula).
+typedef struct {
+    const Cuadricula* cuadricula;
+    const uint64_t* origen;         // Bloque anterior (ambas generaciones)
+    uint64_t* destino;              // Bloque nuevo, aún sin tocar
+    size_t palabrasGeneracion;      // Palabras de cada generación, incluyendo el borde fantasma
+} ColocacionMemoria;
+
+// Función que ejecuta cada hilo del pool para copiar las filas de una banda (de ambas generaciones) al bloque nuevo, de modo que sus páginas queden en el nodo NUMA del hilo.
+static void copiarBandaMemoria(void* contexto, size_t banda, unsigned hilo) {
+    (void)hilo;
+    const ColocacionMemoria* colocacion = (const ColocacionMemoria*)contexto;
+    const Cuadricula* cuadricula = colocacion->cuadricula;
+    // Filas del bloque de la banda, contando la fila fantasma superior como la 0 (la primera y la última banda incluyen las filas fantasma).
+    size_t inicio = (banda == 0) ? 0 : banda * FILAS_POR_TESELA + 1;
+    size_t fin = (banda + 1 == cuadricula->filasTeselas) ? (size_t)cuadricula->alto + 2 : (banda + 1) * FILAS_POR_TESELA + 1;
+    size_t desplazamiento = inicio * cuadricula->palabrasEntreFilas;
+    size_t bytes = (fin - inicio) * cuadricula->palabrasEntreFilas * sizeof(uint64_t);
+    for (size_t generacion = 0; generacion < 2; generacion++) {
+        size_t posicion = generacion * colocacion->palabrasGeneracion + desplazamiento;
+        memcpy(colocacion->destino + posicion, colocacion->origen + posicion, bytes);
+    }
+}
+
+// Función para mover las generaciones a un bloque nuevo cuyas páginas toca por primera vez el mismo hilo del pool que luego calcula cada banda (first-touch), de modo que en un sistema NUMA cada hilo trabaje sobre memoria de su nodo.
+// NOTA: El pool reparte las bandas en rangos contiguos, uno por hilo, igual en cada llamada a ejecutarEnParalelo (ver hilos.c); el robo de trabajo solo cambia el reparto de las bandas finales de cada rango.
+// Si no hay memoria para el bloque nuevo, las generaciones se quedan donde están.
+static void colocarMemoriaCuadricula(Cuadricula* cuadricula) {
+    // Solo los bloques proyectados empiezan sin tocar; los pequeños caben en la caché y no vale la pena moverlos.
+    if (cuadricula->pool == NULL || !cuadricula->memoria.proyectado) {
+        return;
+    }
+    BloqueMemoria bloque;
+    if (!reservarBloqueMemoria(&bloque, cuadricula->memoria.bytes)) {
+        return;
+    }
+    ColocacionMemoria colocacion = {
+        .cuadricula = cuadricula,
+        .origen = (const uint64_t*)cuadricula->memoria.direccion,
+        .destino = (uint64_t*)bloque.direccion,
+        .palabrasGeneracion = ((size_t)cuadricula->alto + 2) * cuadricula->palabrasEntreFilas
+    };
+    ejecutarEnParalelo(cuadricula->pool, cuadricula->filasTeselas, copiarBandaMemoria, &colocacion);
+    cuadricula->genActual = colocacion.destino + (cuadricula->genActual - colocacion.origen);
+    cuadricula->genSiguiente = colocacion.destino + (cuadricula->genSiguiente - colocacion.origen);
+    liberarBloqueMemoria(&cuadricula->memoria);
+    cuadricula->memoria = bloque;
+}
+
+// Función para configurar el número de hilos con que se calcula cada generación (0 = todos los núcleos disponibles, 1 = sin hilos adicionales).
+bool configurarHilosCuadricula(Cuadricula* cuadricula, unsigned numHilos) {
+    // Verificamos que la cuadrícula no esté vacía.
+    if (cuadricula == NULL) {
+        return false;
+    }
+    // Si el pool ya tiene el número de hilos indicado (por ejemplo, porque la cuadrícula se creó con crearCuadriculaConHilos), la memoria ya está colocada.
+    unsigned hilosPedidos = (numHilos == 0) ? detectarNumNucleos() : numHilos;
+    if (obtenerNumHilosPool(cuadricula->pool) == ((hilosPedidos > 1) ? hilosPedidos : 1)) {
+        return true;
+    }
+    // Reemplazamos el pool anterior (si existe) por uno con el número de hilos indicado.
+    liberarPoolHilos(cuadricula->pool);
+    cuadricula->pool = NULL;
+    if (!crearPoolCuadricula(cuadricula, numHilos)) {
+        return false;
+    }
+    colocarMemoriaCuadricula(cuadricula);
+    return true;
+}
+
+// Función para seleccionar la implementación del kernel de cálculo (KERNEL_AUTOMATICO = la mejor disponible). Retorna false si el procesador no la soporta.
+bool seleccionarKernelCuadricula(Cuadricula* cuadricula, TipoKernel tipo) {
+    // Verificamos que la cuadrícula no esté vacía y que la implementación esté disponible.
+    KernelFila kernel = (cuadricula != NULL) ? obtenerKernelFila(tipo, &cuadricula->regla) : NULL;
+    if (kernel == NULL) {
+        return false;
+    }
+    cuadricula->tipoKernel = (tipo == KERNEL_AUTOMATICO) ? detectarMejorKernel() : tipo;
+    cuadricula->calcularFila = kernel;
+    return true;
+}
+
+// Función para cambiar la regla con que se calculan las generaciones (se conserva la implementación del kernel). Retorna false si la regla es NULL.
+bool configurarReglaCuadricula(Cuadricula* cuadricula, const Regla* regla) {
+    if (cuadricula == NULL || regla == NULL) {
+        return false;
+    }
+    cuadricula->regla = *regla;
+    cuadricula->calcularFila = obtenerKernelFila(cuadricula->tipoKernel, &cuadricula->regla);
+    // Con otra regla pueden cambiar teselas que estaban estables, y el historial de hashes ya no sirve para detectar oscilaciones.
+    marcarTodasTeselasCambiadas(cuadricula);
+    return true;
+}
+
+// Función para obtener la regla con que se calculan las generaciones.
+const Regla* obtenerReglaCuadricula(Cuadricula* cuadricula) {
+    return (cuadricula != NULL) ? &cuadricula->regla : obtenerReglaConway();
+}
+
+// Función para calcular la siguiente generación célula por célula, usando contarVecinasVivas (implementación de referencia, más lenta).
+void calcularCuadriculaSiguienteReferencia(Cuadricula* cuadricula) {
+    // Verificamos que la cuadrícula no esté vacía.
+    if (cuadricula == NULL) {
+        return;
+    }
+    // Recorremos cada célula de la cuadrícula actual para aplicar la regla.
+    for (uint32_t y = 0; y < cuadricula->alto; y++) {
+        for (uint32_t x = 0; x < cuadricula->ancho; x++) {
+            // Contamos el número de células vivas alrededor de la célula en (x, y).
+            unsigned short vecinasVivas = contarVecinasVivas(cuadricula, x, y);
+            // Aplicamos la regla de la cuadrícula (con B3/S23, una célula viva con 2 o 3 vecinas vivas sobrevive y una muerta con exactamente 3 nace).
+            bool viva = obtenerBit(filaActual(cuadricula, y), x);
+            establecerBit(filaSiguiente(cuadricula, y), x, aplicarRegla(&cuadricula->regla, viva, vecinasVivas));
+        }
+    }
+    intercambiarGeneraciones(cuadricula);
+    // No sabemos qué teselas cambiaron, por lo que la siguiente generación se calcula completa.
+    marcarTodasTeselasCambiadas(cuadricula);
 }
 
 // Función para obtener el estado de una célula específica en la cuadrícula.
-bool obtenerEstadoCelula(Cuadricula* cuadricula, unsigned short x, unsigned short y) {
+bool obtenerEstadoCelula(Cuadricula* cuadricula, uint32_t x, uint32_t y) {
     // Verificamos que la cuadrícula no esté vacía y que las coordenadas estén dentro de los límites.
     if (cuadricula == NULL || x >= cuadricula->ancho || y >= cuadricula->alto) {
         return false; // Retornamos false si la cuadrícula es nula o las coordenadas son inválidas.
     }
-    return cuadricula->genActual[y][x]; // Retornamos el estado de la célula en (x, y).
+    return obtenerBit(filaActual(cuadricula, y), x); // Retornamos el estado de la célula en (x, y).
+}
+
+// Función para establecer el estado de una célula específica en la cuadrícula. Retorna false si las coordenadas están fuera de la cuadrícula.
+bool establecerEstadoCelula(Cuadricula* cuadricula, uint32_t x, uint32_t y, bool viva) {
+    // Verificamos que la cuadrícula no esté vacía y que las coordenadas estén dentro de los límites.
+    if (cuadricula == NULL || x >= cuadricula->ancho || y >= cuadricula->alto) {
+        return false;
+    }
+    establecerBit(filaActual(cuadricula, y), x, viva);
+    marcarTeselasCambiadas(cuadricula, y, x / BITS_POR_PALABRA, x / BITS_POR_PALABRA);
+    return true;
+}
+
+// Función para establecer el estado de las células (x, y) a (x + longitud - 1, y), recortando el tramo al ancho de la cuadrícula.
+void establecerTramoCelulas(Cuadricula* cuadricula, uint32_t x, uint32_t y, size_t longitud, bool viva) {
+    // Verificamos que la cuadrícula no esté vacía y que el tramo tenga células dentro de los límites.
+    if (cuadricula == NULL || x >= cuadricula->ancho || y >= cuadricula->alto || longitud == 0) {
+        return;
+    }
+    size_t fin = (longitud < (size_t)(cuadricula->ancho - x)) ? x + longitud : cuadricula->ancho; // Primera columna fuera del tramo
+    uint64_t* fila = filaActual(cuadricula, y);
+    size_t primeraPalabra = x / BITS_POR_PALABRA;
+    size_t ultimaPalabra = (fin - 1) / BITS_POR_PALABRA;
+    // Escribimos el tramo palabra por palabra: cada palabra recibe una máscara con los bits del tramo que contiene.
+    for (size_t p = primeraPalabra; p <= ultimaPalabra; p++) {
+        size_t desde = (p == primeraPalabra) ? x % BITS_POR_PALABRA : 0;
+        size_t hasta = (p == ultimaPalabra) ? (fin - 1) % BITS_POR_PALABRA + 1 : BITS_POR_PALABRA;
+        uint64_t mascara = ((hasta == BITS_POR_PALABRA) ? ~(uint64_t)0 : ((uint64_t)1 << hasta) - 1) & (~(uint64_t)0 << desde);
+        fila[p] = viva ? (fila[p] | mascara) : (fila[p] & ~mascara);
+    }
+    marcarTeselasCambiadas(cuadricula, y, primeraPalabra, ultimaPalabra);
+}
+
+// Función para cambiar la semilla y el porcentaje de células vivas de las configuraciones aleatorias que genera reiniciarCuadricula.
+void configurarRellenoCuadricula(Cuadricula* cuadricula, uint64_t semilla, unsigned porcentaje) {
+    if (cuadricula == NULL) {
+        return;
+    }
+    cuadricula->estadoAleatorio = semilla;
+    cuadricula->porcentajeInicial = porcentaje;
+}
+
+// Función para reemplazar la fila y de la generación actual por palabras empaquetadas (palabrasPorFila palabras; los bits posteriores al ancho se ignoran).
+void establecerFilaCuadricula(Cuadricula* cuadricula, uint32_t y, const uint64_t* palabras) {
+    // Verificamos que la cuadrícula no esté vacía y que la fila esté dentro de los límites.
+    if (cuadricula == NULL || palabras == NULL || y >= cuadricula->alto) {
+        return;
+    }
+    uint64_t* fila = filaActual(cuadricula, y);
+    memcpy(fila, palabras, cuadricula->palabrasPorFila * sizeof(uint64_t));
+    fila[cuadricula->palabrasPorFila - 1] &= obtenerMascaraUltimaPalabra(cuadricula);
+    marcarTeselasCambiadas(cuadricula, y, 0, cuadricula->palabrasPorFila - 1);
+}
+
+// Función para dejar todas las células muertas y reiniciar el número de generación (por ejemplo, antes de cargar un patrón).
+void limpiarCuadricula(Cuadricula* cuadricula) {
+    // Verificamos que la cuadrícula no esté vacía.
+    if (cuadricula == NULL) {
+        return;
+    }
+    for (uint32_t i = 0; i < cuadricula->alto; i++) {
+        memset(filaActual(cuadricula, i), 0, cuadricula->palabrasPorFila * sizeof(uint64_t));
+    }
+    marcarTodasTeselasCambiadas(cuadricula);
+    cuadricula->numGeneracion = 0;
+}
+
+// Función para obtener, sin copiarla, la fila y de la generación actual, empaquetada en palabras de 64 bits. Retorna NULL si la fila no existe.
+const uint64_t* obtenerFilaCuadricula(Cuadricula* cuadricula, uint32_t y) {
+    // Verificamos que la cuadrícula no esté vacía y que la fila esté dentro de los límites.
+    if (cuadricula == NULL || y >= cuadricula->alto) {
+        return NULL;
+    }
+    return filaActual(cuadricula, y);
+}
+
+// Función para verificar que la región de anchoRegion x altoRegion células con esquina en (x, y) esté dentro de la cuadrícula, y que sus filas quepan en palabrasEntreFilas palabras.
+static bool validarRegion(const Cuadricula* cuadricula, uint32_t x, uint32_t y, uint32_t anchoRegion, uint32_t altoRegion, size_t palabrasEntreFilas) {
+    return (uint64_t)x + anchoRegion <= cuadricula->ancho && (uint64_t)y + altoRegion <= cuadricula->alto && palabrasEntreFilas >= PALABRAS_POR_FILA(anchoRegion);
+}
+
+// Función para obtener la máscara con los bits de las primeras n células de una palabra (1 <= n <= 64).
+static inline uint64_t obtenerMascaraCelulas(size_t n) {
+    return (n >= BITS_POR_PALABRA) ? ~(uint64_t)0 : ((uint64_t)1 << n) - 1;
+}
+
+// Función para copiar las células de una región de la generación actual, empaquetadas a partir de la columna x. Retorna false si la región no está dentro de la cuadrícula.
+bool leerRegionCuadricula(Cuadricula* cuadricula, uint32_t x, uint32_t y, uint32_t anchoRegion, uint32_t altoRegion, uint64_t* destino, size_t palabrasEntreFilasDestino) {
+    // Verificamos que la cuadrícula no esté vacía y que la región esté dentro de los límites.
+    if (cuadricula == NULL || !validarRegion(cuadricula, x, y, anchoRegion, altoRegion, palabrasEntreFilasDestino)) {
+        return false;
+    }
+    if (anchoRegion == 0 || altoRegion == 0) {
+        return true;
+    }
+    if (destino == NULL) {
+        return false;
+    }
+    size_t palabrasRegion = PALABRAS_POR_FILA(anchoRegion);
+    size_t primeraPalabra = x / BITS_POR_PALABRA;
+    size_t desplazamiento = x % BITS_POR_PALABRA;
+    uint64_t mascaraUltima = obtenerMascaraCelulas((anchoRegion - 1) % BITS_POR_PALABRA + 1);
+    for (uint32_t j = 0; j < altoRegion; j++) {
+        const uint64_t* fila = filaActual(cuadricula, (size_t)y + j) + primeraPalabra;
+        uint64_t* salida = destino + (size_t)j * palabrasEntreFilasDestino;
+        // Si la región empieza al inicio de una palabra, las filas se copian tal cual; si no, cada palabra de la región se arma con dos palabras de la fila.
+        if (desplazamiento == 0) {
+            memcpy(salida, fila, palabrasRegion * sizeof(uint64_t));
+        } else {
+            for (size_t k = 0; k < palabrasRegion; k++) {
+                uint64_t bits = fila[k] >> desplazamiento;
+                if (primeraPalabra + k + 1 < cuadricula->palabrasPorFila) {
+                    bits |= fila[k + 1] << (BITS_POR_PALABRA - desplazamiento);
+                }
+                salida[k] = bits;
+            }
+        }
+        salida[palabrasRegion - 1] &= mascaraUltima;
+    }
+    return true;
+}
+
+// Función para reemplazar las células de una región de la generación actual por las de origen, empaquetadas a partir de la columna x. Retorna false si la región no está dentro de la cuadrícula.
+bool escribirRegionCuadricula(Cuadricula* cuadricula, uint32_t x, uint32_t y, uint32_t anchoRegion, uint32_t altoRegion, const uint64_t* origen, size_t palabrasEntreFilasOrigen) {
+    // Verificamos que la cuadrícula no esté vacía y que la región esté dentro de los límites.
+    if (cuadricula == NULL || !validarRegion(cuadricula, x, y, anchoRegion, altoRegion, palabrasEntreFilasOrigen)) {
+        return false;
+    }
+    if (anchoRegion == 0 || altoRegion == 0) {
+        return true;
+    }
+    if (origen == NULL) {
+        return false;
+    }
+    size_t palabrasRegion = PALABRAS_POR_FILA(anchoRegion);
+    size_t primeraPalabra = x / BITS_POR_PALABRA;
+    size_t desplazamiento = x % BITS_POR_PALABRA;
+    for (uint32_t j = 0; j < altoRegion; j++) {
+        uint64_t* fila = filaActual(cuadricula, (size_t)y + j) + primeraPalabra;
+        const uint64_t* entrada = origen + (size_t)j * palabrasEntreFilasOrigen;
+        // Cada palabra de la región cae en una palabra de la fila, o en dos si la región no empieza al inicio de una palabra. Solo se modifican los bits de la región, por lo que los bits sobrantes de la fila siguen en 0.
+        for (size_t k = 0; k < palabrasRegion; k++) {
+            size_t celulas = (k + 1 < palabrasRegion) ? BITS_POR_PALABRA : (anchoRegion - 1) % BITS_POR_PALABRA + 1;
+            uint64_t mascara = obtenerMascaraCelulas(celulas);
+            uint64_t bits = entrada[k] & mascara;
+            fila[k] = (fila[k] & ~(mascara << desplazamiento)) | (bits << desplazamiento);
+            if (desplazamiento != 0 && celulas > BITS_POR_PALABRA - desplazamiento) {
+                fila[k + 1] = (fila[k + 1] & ~(mascara >> (BITS_POR_PALABRA - desplazamiento))) | (bits >> (BITS_POR_PALABRA - desplazamiento));
+            }
+        }
+        marcarTeselasCambiadas(cuadricula, (size_t)y + j, primeraPalabra, ((size_t)x + anchoRegion - 1) / BITS_POR_PALABRA);
+    }
+    return true;
+}
+
+// Función para contar las células vivas de una región de la generación actual, recortando la región a la cuadrícula.
+uint64_t contarPoblacionRegion(Cuadricula* cuadricula, uint32_t x, uint32_t y, uint32_t anchoRegion, uint32_t altoRegion) {
+    // Verificamos que la cuadrícula no esté vacía y que la región tenga células dentro de los límites.
+    if (cuadricula == NULL || x >= cuadricula->ancho || y >= cuadricula->alto || anchoRegion == 0 || altoRegion == 0) {
+        return 0;
+    }
+    size_t finX = (anchoRegion < cuadricula->ancho - x) ? (size_t)x + anchoRegion : cuadricula->ancho; // Primera columna fuera de la región
+    size_t finY = (altoRegion < cuadricula->alto - y) ? (size_t)y + altoRegion : cuadricula->alto;
+    // La cuadrícula completa ya tiene su conteo (incremental, con el conteo de cambios).
+    if (x == 0 && y == 0 && finX == cuadricula->ancho && finY == cuadricula->alto) {
+        return contarPoblacion(cuadricula);
+    }
+    size_t primeraPalabra = x / BITS_POR_PALABRA;
+    size_t ultimaPalabra = (finX - 1) / BITS_POR_PALABRA;
+    uint64_t mascaraPrimera = ~(uint64_t)0 << (x % BITS_POR_PALABRA);
+    uint64_t mascaraUltima = obtenerMascaraCelulas((finX - 1) % BITS_POR_PALABRA + 1);
+    uint64_t poblacion = 0;
+    for (size_t i = y; i < finY; i++) {
+        const uint64_t* fila = filaActual(cuadricula, i);
+        for (size_t p = primeraPalabra; p <= ultimaPalabra; p++) {
+            uint64_t bits = fila[p];
+            if (p == primeraPalabra) {
+                bits &= mascaraPrimera;
+            }
+            if (p == ultimaPalabra) {
+                bits &= mascaraUltima;
+            }
+            poblacion += (uint64_t)__builtin_popcountll(bits);
+        }
+    }
+    return poblacion;
 }
 
 // Función para obtener el número de generación actual.
@@ -215,24 +1227,40 @@ uint64_t obtenerNumGeneracion(Cuadricula* cuadricula) {
     return cuadricula->numGeneracion; // Retornamos el número de generación actual.
 }
 
-// Función para restablecer la cuadrícula a un estado inicial (con un ~20% de células vivas, aleatorizadas).
-void reiniciarCuadricula(Cuadricula* cuadricula) {
+// Función para contar las células vivas de la generación actual.
+uint64_t contarPoblacion(Cuadricula* cuadricula) {
     // Verificamos que la cuadrícula no esté vacía.
     if (cuadricula == NULL) {
-        return;
+        return 0;
     }
-    // Limpiamos la matriz de células siguiente (buffer de escritura), reestableciendo todas las células a 'false' (muertas). La función memset se utiliza para establecer todos los bytes de la memoria asignada a 0.
-    for (unsigned short i = 0; i < cuadricula->alto; i++) {
-        memset(cuadricula->genSiguiente[i], 0, cuadricula->ancho * sizeof(bool));
+    // Con el conteo de cambios, la población se actualiza en cada generación con los nacimientos y las muertes.
+    if (cuadricula->poblacionValida) {
+        return cuadricula->poblacion;
     }
-    // Generamos una nueva semilla para el generador de números aleatorios.
-    srand((unsigned int)time(NULL));
-    // Inicializamos la matriz de células actual con un ~20% de células vivas distribuidas aleatoriamente.
-    for (unsigned short i = 0; i < cuadricula->alto; i++) {
-        for (unsigned short j = 0; j < cuadricula->ancho; j++) {
-            cuadricula->genActual[i][j] = PORCENTAJE_CELULAS_VIVAS_INICIAL(20);
+    // Los bits sobrantes de la última palabra de cada fila están en 0, por lo que basta con contar los bits de todas las palabras.
+    uint64_t poblacion = 0;
+    for (uint32_t i = 0; i < cuadricula->alto; i++) {
+        const uint64_t* fila = filaActual(cuadricula, i);
+        for (size_t p = 0; p < cuadricula->palabrasPorFila; p++) {
+            poblacion += (uint64_t)__builtin_popcountll(fila[p]);
         }
     }
+    cuadricula->poblacion = poblacion;
+    cuadricula->poblacionValida = true;
+    return poblacion;
+}
+
+// Función para restablecer la cuadrícula a un estado inicial (con un ~20% de células vivas, aleatorizadas).
+void reiniciarCuadricula(Cuadricula* cuadricula) {
+    // Verificamos que la cuadrícula no esté vacía.
+    if (cuadricula == NULL) {
+        return;
+    }
+    // Limpiamos la matriz de células siguiente (buffer de escritura), reestableciendo todas las células a 0 (muertas). La función memset se utiliza para establecer todos los bytes de la memoria asignada a 0.
+    memset(cuadricula->genSiguiente, 0, ((size_t)cuadricula->alto + 2) * cuadricula->palabrasEntreFilas * sizeof(uint64_t));
+    // Inicializamos la matriz de células actual con el porcentaje de células vivas inicial (el generador continúa su secuencia, por lo que se obtiene una configuración nueva).
+    llenarAleatoriamente(cuadricula);
+    marcarTodasTeselasCambiadas(cuadricula);
     // Restablecemos el número de generación a 0.
     cuadricula->numGeneracion = 0;
 }
@@ -0,0 +1,823 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../include/grabacion.h"
+
+//  ================================================
+//  Conway's Game of Life - Grabaciones
+//  ================================================
+//  Este módulo graba todas las generaciones de una simulación en un archivo compacto y permite reproducirlas, hacia adelante o hacia atrás,
+//  y saltar a cualquier generación.
+//
+//  CARACTERÍSTICAS PRINCIPALES:
+//  1. Diferencias con XOR y Longitud de Tramos:
+//      - Cada generación se guarda como la diferencia (XOR) de sus palabras con las de la generación anterior, que en la mayoría de las palabras
+//        vale 0 (solo cambian las regiones activas).
+//      - La diferencia se codifica como pares (palabras en 0, palabras literales) con enteros de longitud variable (7 bits por byte), seguidos
+//        de las palabras literales sin comprimir. Una generación con pocos cambios ocupa unos pocos bytes, sin importar el tamaño de la cuadrícula.
+//      - Como XOR es su propia inversa, la misma diferencia sirve para avanzar y para retroceder una generación.
+//
+//  2. Claves e Índice:
+//      - Cada intervaloClaves generaciones se guarda además la generación completa (una clave, codificada igual pero contra una generación vacía).
+//      - Al cerrar la grabación se escribe al final un índice con la generación y la posición de cada clave, y se completa la cabecera.
+//      - Para ir a una generación se busca en el índice la clave anterior más cercana y se aplican, como máximo, intervaloClaves diferencias.
+//      - Cada registro guarda el tamaño del anterior, por lo que el archivo también se recorre hacia atrás. Si la grabación no se cerró
+//        (el programa terminó antes), el índice se reconstruye recorriendo los registros hasta el último completo.
+//
+//  3. Escritura en Segundo Plano:
+//      - registrarGeneracionGrabacion solo copia la generación (un memcpy por fila) en una cola de FOTOGRAMAS_COLA_GRABACION fotogramas; un hilo
+//        propio calcula las diferencias, las codifica y las escribe mientras la simulación continúa.
+//      - A diferencia de las instantáneas, una grabación no puede omitir generaciones: si la cola está llena, la simulación espera al hilo escritor.
+//
+//  4. Reproducción con mmap:
+//      - El archivo se proyecta en memoria y cada registro se decodifica directamente desde la proyección. La suma de verificación y la estructura
+//        de cada registro se validan antes de aplicarlo, de modo que un registro dañado nunca deja la generación a medio reconstruir.
+//  NOTA: Los números se guardan en el orden de bytes del procesador; la cabecera incluye una marca para rechazar archivos de otro orden.
+
+// Firma y versión del formato.
+#define FIRMA_GRABACION "VIDAGRAB"
+#define VERSION_GRABACION 1u
+// Marca para detectar un orden de bytes distinto.
+#define MARCA_ORDEN_BYTES 0x01020304u
+// Tipos de registro.
+#define REGISTRO_DIFERENCIA 1u
+#define REGISTRO_CLAVE 2u
+// Bytes máximos de un entero de longitud variable de 64 bits (7 bits por byte).
+#define BYTES_MAXIMOS_VARIABLE 10
+// Tamaño del buffer de escritura del archivo.
+#define TAMANO_BUFFER_ESCRITURA (1 << 16)
+// Capacidad inicial del buffer de los datos codificados de un registro.
+#define CAPACIDAD_INICIAL_DATOS 4096
+
+// Definición de la cabecera de una grabación (128 bytes, sin relleno entre los campos). Los últimos campos numéricos valen 0 hasta que la grabación se cierra.
+typedef struct {
+    char firma[8];                      // FIRMA_GRABACION (sin '\0')
+    uint32_t version;                   // VERSION_GRABACION
+    uint32_t marcaOrden;                // MARCA_ORDEN_BYTES
+    uint32_t ancho;                     // Dimensiones de la cuadrícula
+    uint32_t alto;
+    uint64_t primeraGeneracion;         // Generación de la primera clave
+    uint64_t intervaloClaves;           // Generaciones entre dos claves
+    uint64_t ultimaGeneracion;          // Última generación grabada
+    uint64_t posicionIndice;            // Posición del índice de claves (0 = grabación sin cerrar)
+    uint64_t numClaves;                 // Entradas del índice
+    char regla[LONGITUD_MAXIMA_REGLA];  // Regla (terminada en '\0')
+} CabeceraGrabacion;
+
+_Static_assert(sizeof(CabeceraGrabacion) == 128, "La cabecera de las grabaciones debe medir 128 bytes");
+
+// Definición de la cabecera de cada registro (una diferencia o una clave). Los datos codificados la siguen, rellenados con ceros hasta un múltiplo de 8 bytes.
+typedef struct {
+    uint32_t tipo;                      // REGISTRO_DIFERENCIA o REGISTRO_CLAVE
+    uint32_t reservado;                 // 0
+    uint64_t numGeneracion;             // Generación que produce el registro
+    uint64_t bytesDatos;                // Bytes de los datos codificados (sin el relleno)
+    uint64_t bytesAnterior;             // Tamaño total del registro anterior (0 = primer registro)
+    uint64_t sumaVerificacion;          // Suma de la cabecera (con este campo en 0) y de los datos rellenados
+} CabeceraRegistro;
+
+// Definición de una entrada del índice de claves. El índice termina con la suma de verificación de sus entradas.
+typedef struct {
+    uint64_t numGeneracion;             // Generación de la clave
+    uint64_t posicion;                  // Posición del registro de la clave en el archivo
+} EntradaIndice;
+
+// Definición de la grabación en curso.
+struct Grabador {
+    FILE* archivo;                      // Archivo de destino
+    CabeceraGrabacion cabecera;         // Cabecera, que se completa al cerrar
+    size_t palabrasPorFila;             // Palabras de cada fila
+    size_t totalPalabras;               // Palabras de una generación completa
+    uint64_t ultimaRegistrada;          // Última generación copiada en la cola (solo la usa el hilo de simulación)
+    // Campos que solo usa el hilo escritor (y finalizarGrabador, después de detenerlo).
+    uint64_t* anterior;                 // Última generación escrita, con las filas una tras otra
+    uint8_t* datos;                     // Datos codificados del registro en curso
+    size_t capacidadDatos;
+    uint64_t posicion;                  // Bytes escritos en el archivo
+    uint64_t bytesAnterior;             // Tamaño del último registro escrito
+    uint64_t generacionesEscritas;      // Generaciones escritas (0 = aún no se escribió la primera clave)
+    EntradaIndice* claves;              // Índice de las claves escritas
+    size_t numClaves;
+    size_t capacidadClaves;
+    // Cola de generaciones copiadas, en un solo bloque de memoria.
+    BloqueMemoria memoria;
+    Fotograma cola[FOTOGRAMAS_COLA_GRABACION];
+    pthread_t hilo;                     // Hilo escritor
+    pthread_mutex_t mutex;              // Protege los campos siguientes
+    pthread_cond_t condTrabajo;         // Señala al hilo escritor que hay una generación en la cola (o que debe terminar)
+    pthread_cond_t condLibre;           // Señala que se liberó un lugar de la cola
+    unsigned inicioCola;                // Primera generación de la cola
+    unsigned pendientes;                // Generaciones en la cola
+    bool salir;                         // Indica al hilo escritor que debe terminar
+    bool error;                         // Alguna escritura falló
+};
+
+// Definición de una grabación abierta para reproducirla.
+struct Reproduccion {
+    const uint8_t* proyeccion;          // Archivo proyectado en memoria
+    size_t tamano;                      // Tamaño del archivo
+    uint64_t finRegistros;              // Posición siguiente al último registro válido
+    uint64_t primeraGeneracion;         // Generaciones grabadas
+    uint64_t ultimaGeneracion;
+    EntradaIndice* claves;              // Índice de claves (leído del archivo o reconstruido)
+    size_t numClaves;
+    size_t totalPalabras;               // Palabras de una generación completa
+    Fotograma fotograma;                // Generación actual
+    uint64_t posicion;                  // Registro que produjo la generación actual (su diferencia, o la primera clave)
+};
+
+// Función para acumular una palabra en la suma de verificación (mezcla de 64 bits, sensible al orden de las palabras).
+static inline uint64_t acumularSuma(uint64_t suma, uint64_t palabra) {
+    suma ^= palabra * 0x9E3779B97F4A7C15ULL;
+    suma = (suma << 31) | (suma >> 33);
+    return suma * 0xBF58476D1CE4E5B9ULL;
+}
+
+// Función para acumular en la suma de verificación bytes bytes (múltiplo de 8), leídos sin exigir alineación.
+static uint64_t acumularSumaBytes(uint64_t suma, const void* bytes, size_t numBytes) {
+    const uint8_t* origen = (const uint8_t*)bytes;
+    for (size_t i = 0; i < numBytes; i += sizeof(uint64_t)) {
+        uint64_t palabra;
+        memcpy(&palabra, origen + i, sizeof(palabra));
+        suma = acumularSuma(suma, palabra);
+    }
+    return suma;
+}
+
+// Función para calcular la suma de verificación de un registro (su cabecera, con el campo de la suma en 0, y sus datos rellenados).
+static uint64_t calcularSumaRegistro(const CabeceraRegistro* registro, const uint8_t* datos) {
+    CabeceraRegistro copia = *registro;
+    copia.sumaVerificacion = 0;
+    return acumularSumaBytes(acumularSumaBytes(0, &copia, sizeof(copia)), datos, (registro->bytesDatos + 7) / 8 * 8);
+}
+
+// Función para escribir un entero de longitud variable (7 bits por byte; el bit alto indica que siguen más bytes). Retorna los bytes escritos.
+static size_t escribirVariable(uint8_t* destino, uint64_t valor) {
+    size_t bytes = 0;
+    while (valor >= 0x80) {
+        destino[bytes++] = (uint8_t)(valor | 0x80);
+        valor >>= 7;
+    }
+    destino[bytes++] = (uint8_t)valor;
+    return bytes;
+}
+
+// Función para leer un entero de longitud variable de los datos, sin pasar de fin. Retorna false si está incompleto o no cabe en 64 bits.
+static bool leerVariable(const uint8_t** datos, const uint8_t* fin, uint64_t* valor) {
+    uint64_t resultado = 0;
+    for (unsigned desplazamiento = 0; desplazamiento < 64 && *datos < fin; desplazamiento += 7) {
+        uint8_t byte = *(*datos)++;
+        resultado |= (uint64_t)(byte & 0x7F) << desplazamiento;
+        if ((byte & 0x80) == 0) {
+            *valor = resultado;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Función para asegurar que un buffer de datos codificados tenga lugar para bytesExtra bytes más después de usados (un buffer vacío empieza con CAPACIDAD_INICIAL_DATOS bytes). Retorna false si no hay memoria suficiente.
+static bool reservarDatos(uint8_t** datos, size_t* capacidad, size_t usados, size_t bytesExtra) {
+    if (usados + bytesExtra <= *capacidad) {
+        return true;
+    }
+    size_t nuevaCapacidad = (*capacidad > 0) ? *capacidad : CAPACIDAD_INICIAL_DATOS;
+    while (nuevaCapacidad < usados + bytesExtra) {
+        nuevaCapacidad *= 2;
+    }
+    uint8_t* nuevos = (uint8_t*)realloc(*datos, nuevaCapacidad);
+    if (nuevos == NULL) {
+        return false;
+    }
+    *datos = nuevos;
+    *capacidad = nuevaCapacidad;
+    return true;
+}
+
+// Función para codificar la diferencia entre dos generaciones de totalPalabras palabras (anterior NULL = una generación vacía) como pares (palabras en 0, palabras literales) seguidos de las literales. Retorna los bytes codificados, o SIZE_MAX si no hay memoria suficiente.
+size_t codificarDiferenciaPalabras(const uint64_t* actual, const uint64_t* anterior, size_t totalPalabras, uint8_t** datos, size_t* capacidad) {
+    size_t usados = 0;
+    size_t i = 0;
+    while (i < totalPalabras) {
+        // Contamos las palabras sin cambios y luego las cambiadas, hasta la siguiente sin cambios.
+        size_t inicioCeros = i;
+        while (i < totalPalabras && actual[i] == ((anterior != NULL) ? anterior[i] : 0)) {
+            i++;
+        }
+        size_t inicioLiterales = i;
+        while (i < totalPalabras && actual[i] != ((anterior != NULL) ? anterior[i] : 0)) {
+            i++;
+        }
+        size_t numLiterales = i - inicioLiterales;
+        if (!reservarDatos(datos, capacidad, usados, 2 * BYTES_MAXIMOS_VARIABLE + numLiterales * sizeof(uint64_t))) {
+            return SIZE_MAX;
+        }
+        usados += escribirVariable(*datos + usados, inicioLiterales - inicioCeros);
+        usados += escribirVariable(*datos + usados, numLiterales);
+        for (size_t j = inicioLiterales; j < i; j++) {
+            uint64_t palabra = actual[j] ^ ((anterior != NULL) ? anterior[j] : 0);
+            memcpy(*datos + usados, &palabra, sizeof(palabra));
+            usados += sizeof(palabra);
+        }
+    }
+    return usados;
+}
+
+// Función para verificar que los datos de una diferencia codificada cubran exactamente totalPalabras palabras. Retorna false si están incompletos o no son válidos.
+bool validarDiferenciaPalabras(const uint8_t* datos, size_t bytesDatos, size_t totalPalabras) {
+    const uint8_t* fin = datos + bytesDatos;
+    uint64_t total = totalPalabras;
+    uint64_t i = 0;
+    while (i < total) {
+        uint64_t ceros, literales;
+        if (!leerVariable(&datos, fin, &ceros) || !leerVariable(&datos, fin, &literales) || (ceros == 0 && literales == 0) ||
+            ceros > total - i || literales > total - i - ceros || literales > (uint64_t)(fin - datos) / sizeof(uint64_t)) {
+            return false;
+        }
+        i += ceros + literales;
+        datos += literales * sizeof(uint64_t);
+    }
+    return datos == fin;
+}
+
+// Función para combinar con XOR una diferencia codificada (ya validada) con las totalPalabras palabras de celulas.
+void aplicarDiferenciaPalabras(uint64_t* celulas, size_t totalPalabras, const uint8_t* datos, size_t bytesDatos) {
+    const uint8_t* fin = datos + bytesDatos;
+    uint64_t i = 0;
+    while (i < totalPalabras) {
+        uint64_t ceros = 0, literales = 0;
+        leerVariable(&datos, fin, &ceros);
+        leerVariable(&datos, fin, &literales);
+        i += ceros;
+        for (uint64_t j = 0; j < literales; j++, i++, datos += sizeof(uint64_t)) {
+            uint64_t palabra;
+            memcpy(&palabra, datos, sizeof(palabra));
+            celulas[i] ^= palabra;
+        }
+    }
+}
+
+// Función para codificar en el buffer de datos la diferencia entre la generación actual y la anterior (NULL = una generación vacía, es decir,
+// una clave). Si anterior no es NULL, se reemplaza por la actual. Retorna los bytes codificados, o SIZE_MAX si no hay memoria suficiente.
+static size_t codificarDiferencia(Grabador* grabador, const uint64_t* actual, uint64_t* anterior) {
+    size_t usados = codificarDiferenciaPalabras(actual, anterior, grabador->totalPalabras, &grabador->datos, &grabador->capacidadDatos);
+    if (usados != SIZE_MAX && anterior != NULL) {
+        memcpy(anterior, actual, grabador->totalPalabras * sizeof(uint64_t));
+    }
+    return usados;
+}
+
+// Función para escribir un registro con los bytesDatos bytes del buffer de datos. Retorna false si no se pudo escribir.
+static bool escribirRegistro(Grabador* grabador, uint32_t tipo, uint64_t numGeneracion, size_t bytesDatos) {
+    // Rellenamos los datos con ceros hasta un múltiplo de 8 bytes, para que la suma de verificación los recorra por palabras.
+    size_t bytesRellenos = (bytesDatos + 7) / 8 * 8;
+    if (!reservarDatos(&grabador->datos, &grabador->capacidadDatos, bytesDatos, bytesRellenos - bytesDatos)) {
+        return false;
+    }
+    memset(grabador->datos + bytesDatos, 0, bytesRellenos - bytesDatos);
+    CabeceraRegistro registro = {
+        .tipo = tipo,
+        .reservado = 0,
+        .numGeneracion = numGeneracion,
+        .bytesDatos = bytesDatos,
+        .bytesAnterior = grabador->bytesAnterior,
+        .sumaVerificacion = 0,
+    };
+    registro.sumaVerificacion = calcularSumaRegistro(&registro, grabador->datos);
+    if (fwrite(&registro, sizeof(registro), 1, grabador->archivo) != 1 ||
+        (bytesRellenos > 0 && fwrite(grabador->datos, bytesRellenos, 1, grabador->archivo) != 1)) {
+        return false;
+    }
+    if (tipo == REGISTRO_CLAVE) {
+        // Agregamos la clave al índice.
+        if (grabador->numClaves == grabador->capacidadClaves) {
+            size_t capacidad = (grabador->capacidadClaves > 0) ? grabador->capacidadClaves * 2 : 64;
+            EntradaIndice* claves = (EntradaIndice*)realloc(grabador->claves, capacidad * sizeof(EntradaIndice));
+            if (claves == NULL) {
+                return false;
+            }
+            grabador->claves = claves;
+            grabador->capacidadClaves = capacidad;
+        }
+        grabador->claves[grabador->numClaves].numGeneracion = numGeneracion;
+        grabador->claves[grabador->numClaves].posicion = grabador->posicion;
+        grabador->numClaves++;
+    }
+    grabador->bytesAnterior = sizeof(registro) + bytesRellenos;
+    grabador->posicion += grabador->bytesAnterior;
+    return true;
+}
+
+// Función (del hilo escritor) para escribir una generación: su diferencia con la anterior y, si corresponde, una clave (la primera generación solo se escribe como clave).
+static bool escribirGeneracion(Grabador* grabador, const Fotograma* fotograma) {
+    const uint64_t* actual = fotograma->celulas; // Las filas de los fotogramas de la cola están una tras otra, sin relleno.
+    uint64_t numGeneracion = fotograma->numGeneracion;
+    if (grabador->generacionesEscritas > 0) {
+        size_t bytesDatos = codificarDiferencia(grabador, actual, grabador->anterior);
+        if (bytesDatos == SIZE_MAX || !escribirRegistro(grabador, REGISTRO_DIFERENCIA, numGeneracion, bytesDatos)) {
+            return false;
+        }
+    } else {
+        memcpy(grabador->anterior, actual, grabador->totalPalabras * sizeof(uint64_t));
+    }
+    if ((numGeneracion - grabador->cabecera.primeraGeneracion) % grabador->cabecera.intervaloClaves == 0) {
+        size_t bytesDatos = codificarDiferencia(grabador, actual, NULL);
+        if (bytesDatos == SIZE_MAX || !escribirRegistro(grabador, REGISTRO_CLAVE, numGeneracion, bytesDatos)) {
+            return false;
+        }
+        // Vaciamos el buffer del archivo en cada clave, para que una grabación interrumpida conserve al menos hasta ahí.
+        if (fflush(grabador->archivo) != 0) {
+            return false;
+        }
+    }
+    grabador->generacionesEscritas++;
+    grabador->cabecera.ultimaGeneracion = numGeneracion;
+    return true;
+}
+
+// Función principal del hilo escritor.
+static void* ejecutarHiloGrabador(void* argumento) {
+    Grabador* grabador = (Grabador*)argumento;
+    pthread_mutex_lock(&grabador->mutex);
+    while (true) {
+        while (!grabador->salir && grabador->pendientes == 0) {
+            pthread_cond_wait(&grabador->condTrabajo, &grabador->mutex);
+        }
+        if (grabador->pendientes == 0) {
+            break; // Solo se termina cuando no quedan generaciones pendientes.
+        }
+        const Fotograma* fotograma = &grabador->cola[grabador->inicioCola];
+        bool error = grabador->error;
+        pthread_mutex_unlock(&grabador->mutex);
+
+        // Escribimos sin el mutex, para que la simulación pueda copiar otras generaciones mientras tanto. Tras un error, solo se vacía la cola.
+        bool exito = error || escribirGeneracion(grabador, fotograma);
+
+        pthread_mutex_lock(&grabador->mutex);
+        grabador->inicioCola = (grabador->inicioCola + 1) % FOTOGRAMAS_COLA_GRABACION;
+        grabador->pendientes--;
+        grabador->error = grabador->error || !exito;
+        pthread_cond_signal(&grabador->condLibre);
+    }
+    pthread_mutex_unlock(&grabador->mutex);
+    return NULL;
+}
+
+// Función (del hilo de simulación) para copiar la generación actual de la cuadrícula al final de la cola, esperando si está llena. Retorna false si falló alguna escritura.
+static bool encolarGeneracion(Grabador* grabador, Cuadricula* cuadricula) {
+    pthread_mutex_lock(&grabador->mutex);
+    while (grabador->pendientes == FOTOGRAMAS_COLA_GRABACION && !grabador->error) {
+        pthread_cond_wait(&grabador->condLibre, &grabador->mutex);
+    }
+    bool error = grabador->error;
+    unsigned indice = (grabador->inicioCola + grabador->pendientes) % FOTOGRAMAS_COLA_GRABACION;
+    pthread_mutex_unlock(&grabador->mutex);
+    if (error) {
+        return false;
+    }
+    // El hilo escritor no toca este lugar de la cola hasta que lo agregamos a las pendientes, por lo que la copia no necesita el mutex.
+    capturarFotograma(&grabador->cola[indice], cuadricula);
+    pthread_mutex_lock(&grabador->mutex);
+    grabador->pendientes++;
+    pthread_cond_signal(&grabador->condTrabajo);
+    pthread_mutex_unlock(&grabador->mutex);
+    grabador->ultimaRegistrada = cuadricula->numGeneracion;
+    return true;
+}
+
+// Función para liberar la memoria de un grabador (con el hilo ya detenido y el archivo ya cerrado).
+static void liberarMemoriaGrabador(Grabador* grabador) {
+    liberarBloqueMemoria(&grabador->memoria);
+    free(grabador->anterior);
+    free(grabador->datos);
+    free(grabador->claves);
+    free(grabador);
+}
+
+// Función para crear el archivo ruta, grabar la generación actual de la cuadrícula como primera clave e iniciar el hilo que escribe las generaciones siguientes, con una clave cada intervaloClaves generaciones (0 = INTERVALO_CLAVES_DEFECTO). Retorna NULL si no se pudo crear el archivo o el hilo.
+Grabador* crearGrabador(Cuadricula* cuadricula, const char* ruta, uint64_t intervaloClaves) {
+    if (cuadricula == NULL || ruta == NULL) {
+        return NULL;
+    }
+    Grabador* grabador = (Grabador*)calloc(1, sizeof(Grabador));
+    if (grabador == NULL) {
+        return NULL;
+    }
+    grabador->palabrasPorFila = PALABRAS_POR_FILA(cuadricula->ancho);
+    grabador->totalPalabras = (size_t)cuadricula->alto * grabador->palabrasPorFila;
+    grabador->anterior = (uint64_t*)malloc(grabador->totalPalabras * sizeof(uint64_t));
+    grabador->datos = (uint8_t*)malloc(CAPACIDAD_INICIAL_DATOS);
+    grabador->capacidadDatos = CAPACIDAD_INICIAL_DATOS;
+    if (grabador->anterior == NULL || grabador->datos == NULL ||
+        !reservarBloqueMemoria(&grabador->memoria, FOTOGRAMAS_COLA_GRABACION * grabador->totalPalabras * sizeof(uint64_t))) {
+        liberarMemoriaGrabador(grabador);
+        return NULL;
+    }
+    for (unsigned i = 0; i < FOTOGRAMAS_COLA_GRABACION; i++) {
+        grabador->cola[i].ancho = cuadricula->ancho;
+        grabador->cola[i].alto = cuadricula->alto;
+        grabador->cola[i].palabrasEntreFilas = grabador->palabrasPorFila;
+        grabador->cola[i].celulas = (uint64_t*)grabador->memoria.direccion + i * grabador->totalPalabras;
+    }
+
+    CabeceraGrabacion* cabecera = &grabador->cabecera;
+    memcpy(cabecera->firma, FIRMA_GRABACION, sizeof(cabecera->firma));
+    cabecera->version = VERSION_GRABACION;
+    cabecera->marcaOrden = MARCA_ORDEN_BYTES;
+    cabecera->ancho = cuadricula->ancho;
+    cabecera->alto = cuadricula->alto;
+    cabecera->primeraGeneracion = cuadricula->numGeneracion;
+    cabecera->intervaloClaves = (intervaloClaves > 0) ? intervaloClaves : INTERVALO_CLAVES_DEFECTO;
+    snprintf(cabecera->regla, sizeof(cabecera->regla), "%s", cuadricula->regla.texto);
+
+    // La cabecera se escribe sin cerrar (sin índice); finalizarGrabador la vuelve a escribir completa.
+    grabador->archivo = fopen(ruta, "wb");
+    if (grabador->archivo == NULL) {
+        liberarMemoriaGrabador(grabador);
+        return NULL;
+    }
+    setvbuf(grabador->archivo, NULL, _IOFBF, TAMANO_BUFFER_ESCRITURA);
+    if (fwrite(cabecera, sizeof(*cabecera), 1, grabador->archivo) != 1) {
+        fclose(grabador->archivo);
+        liberarMemoriaGrabador(grabador);
+        return NULL;
+    }
+    grabador->posicion = sizeof(*cabecera);
+
+    pthread_mutex_init(&grabador->mutex, NULL);
+    pthread_cond_init(&grabador->condTrabajo, NULL);
+    pthread_cond_init(&grabador->condLibre, NULL);
+    if (pthread_create(&grabador->hilo, NULL, ejecutarHiloGrabador, grabador) != 0) {
+        pthread_cond_destroy(&grabador->condLibre);
+        pthread_cond_destroy(&grabador->condTrabajo);
+        pthread_mutex_destroy(&grabador->mutex);
+        fclose(grabador->archivo);
+        liberarMemoriaGrabador(grabador);
+        return NULL;
+    }
+    // La primera generación también se escribe en el hilo escritor (como clave).
+    encolarGeneracion(grabador, cuadricula);
+    return grabador;
+}
+
+// Función para copiar la generación actual de la cuadrícula y pedir que se grabe en segundo plano. Retorna false (sin grabarla) si no es la generación siguiente a la última grabada o si falló alguna escritura.
+bool registrarGeneracionGrabacion(Grabador* grabador, Cuadricula* cuadricula) {
+    if (grabador == NULL || cuadricula == NULL || cuadricula->ancho != grabador->cabecera.ancho || cuadricula->alto != grabador->cabecera.alto ||
+        cuadricula->numGeneracion != grabador->ultimaRegistrada + 1) {
+        return false;
+    }
+    return encolarGeneracion(grabador, cuadricula);
+}
+
+// Función para esperar a que se escriban las generaciones pendientes, escribir el índice de claves, cerrar el archivo y liberar los recursos. Si info no es NULL, se completa con la información de la grabación. Retorna false si falló alguna escritura.
+bool finalizarGrabador(Grabador* grabador, InfoGrabacion* info) {
+    if (grabador == NULL) {
+        return false;
+    }
+    pthread_mutex_lock(&grabador->mutex);
+    grabador->salir = true;
+    pthread_cond_signal(&grabador->condTrabajo);
+    pthread_mutex_unlock(&grabador->mutex);
+    pthread_join(grabador->hilo, NULL);
+    pthread_cond_destroy(&grabador->condLibre);
+    pthread_cond_destroy(&grabador->condTrabajo);
+    pthread_mutex_destroy(&grabador->mutex);
+
+    // Escribimos el índice (las claves y su suma de verificación) y completamos la cabecera. Si alguna escritura falló, el archivo queda sin
+    // cerrar y la reproducción reconstruye el índice con los registros completos.
+    bool exito = !grabador->error && grabador->numClaves > 0;
+    CabeceraGrabacion* cabecera = &grabador->cabecera;
+    if (exito) {
+        uint64_t suma = acumularSumaBytes(0, grabador->claves, grabador->numClaves * sizeof(EntradaIndice));
+        exito = fwrite(grabador->claves, sizeof(EntradaIndice), grabador->numClaves, grabador->archivo) == grabador->numClaves &&
+            fwrite(&suma, sizeof(suma), 1, grabador->archivo) == 1;
+        cabecera->posicionIndice = grabador->posicion;
+        cabecera->numClaves = grabador->numClaves;
+        exito = exito && fseek(grabador->archivo, 0, SEEK_SET) == 0 && fwrite(cabecera, sizeof(*cabecera), 1, grabador->archivo) == 1;
+        grabador->posicion += grabador->numClaves * sizeof(EntradaIndice) + sizeof(suma);
+    }
+    exito = fflush(grabador->archivo) == 0 && !ferror(grabador->archivo) && fsync(fileno(grabador->archivo)) == 0 && exito;
+    exito = (fclose(grabador->archivo) == 0) && exito;
+    if (info != NULL) {
+        info->ancho = cabecera->ancho;
+        info->alto = cabecera->alto;
+        info->primeraGeneracion = cabecera->primeraGeneracion;
+        info->ultimaGeneracion = (grabador->generacionesEscritas > 0) ? cabecera->ultimaGeneracion : cabecera->primeraGeneracion;
+        info->intervaloClaves = cabecera->intervaloClaves;
+        info->numClaves = grabador->numClaves;
+        info->bytes = grabador->posicion;
+        info->indiceReconstruido = false;
+        snprintf(info->regla, sizeof(info->regla), "%s", cabecera->regla);
+    }
+    liberarMemoriaGrabador(grabador);
+    return exito;
+}
+
+// Función para leer la cabecera del registro en la posición indicada y ubicar sus datos, comprobando que quepan antes del fin de los registros. Retorna NULL si no cabe.
+static const uint8_t* leerRegistro(const Reproduccion* reproduccion, uint64_t posicion, uint64_t fin, CabeceraRegistro* registro) {
+    if (posicion < sizeof(CabeceraGrabacion) || posicion > fin || fin - posicion < sizeof(CabeceraRegistro)) {
+        return NULL;
+    }
+    memcpy(registro, reproduccion->proyeccion + posicion, sizeof(*registro));
+    uint64_t disponibles = fin - posicion - sizeof(CabeceraRegistro);
+    if ((registro->tipo != REGISTRO_DIFERENCIA && registro->tipo != REGISTRO_CLAVE) || registro->bytesDatos > disponibles ||
+        (registro->bytesDatos + 7) / 8 * 8 > disponibles) {
+        return NULL;
+    }
+    return reproduccion->proyeccion + posicion + sizeof(CabeceraRegistro);
+}
+
+// Función para obtener el tamaño total de un registro (cabecera y datos rellenados).
+static inline uint64_t medirRegistro(const CabeceraRegistro* registro) {
+    return sizeof(CabeceraRegistro) + (registro->bytesDatos + 7) / 8 * 8;
+}
+
+// Función para validar los datos de un registro: su suma de verificación y que sus pares cubran exactamente una generación completa. Retorna false si no son válidos.
+static bool validarDatosRegistro(const Reproduccion* reproduccion, const CabeceraRegistro* registro, const uint8_t* datos) {
+    return calcularSumaRegistro(registro, datos) == registro->sumaVerificacion &&
+        validarDiferenciaPalabras(datos, registro->bytesDatos, reproduccion->totalPalabras);
+}
+
+// Función para aplicar los datos (ya validados) de un registro a la generación actual: una clave la reemplaza y una diferencia se combina con XOR.
+static void aplicarDatosRegistro(Reproduccion* reproduccion, const CabeceraRegistro* registro, const uint8_t* datos) {
+    uint64_t* celulas = reproduccion->fotograma.celulas; // Las filas están una tras otra, sin relleno.
+    if (registro->tipo == REGISTRO_CLAVE) {
+        memset(celulas, 0, reproduccion->totalPalabras * sizeof(uint64_t));
+    }
+    aplicarDiferenciaPalabras(celulas, reproduccion->totalPalabras, datos, registro->bytesDatos);
+}
+
+// Función para validar y aplicar el registro en la posición indicada, que debe ser del tipo y la generación indicados. Retorna false (sin modificar la generación actual) si no lo es o está dañado.
+static bool aplicarRegistro(Reproduccion* reproduccion, uint64_t posicion, uint32_t tipo, uint64_t numGeneracion, CabeceraRegistro* registro) {
+    const uint8_t* datos = leerRegistro(reproduccion, posicion, reproduccion->finRegistros, registro);
+    if (datos == NULL || registro->tipo != tipo || registro->numGeneracion != numGeneracion || !validarDatosRegistro(reproduccion, registro, datos)) {
+        return false;
+    }
+    aplicarDatosRegistro(reproduccion, registro, datos);
+    return true;
+}
+
+// Función para agregar una clave al índice de la reproducción. Retorna false si no hay memoria suficiente.
+static bool agregarClave(Reproduccion* reproduccion, size_t* capacidad, uint64_t numGeneracion, uint64_t posicion) {
+    if (reproduccion->numClaves == *capacidad) {
+        size_t nuevaCapacidad = (*capacidad > 0) ? *capacidad * 2 : 64;
+        EntradaIndice* claves = (EntradaIndice*)realloc(reproduccion->claves, nuevaCapacidad * sizeof(EntradaIndice));
+        if (claves == NULL) {
+            return false;
+        }
+        reproduccion->claves = claves;
+        *capacidad = nuevaCapacidad;
+    }
+    reproduccion->claves[reproduccion->numClaves].numGeneracion = numGeneracion;
+    reproduccion->claves[reproduccion->numClaves].posicion = posicion;
+    reproduccion->numClaves++;
+    return true;
+}
+
+// Función para reconstruir el índice de una grabación sin cerrar, recorriendo sus registros hasta el último completo y válido (cada diferencia
+// debe producir la generación siguiente, y cada clave debe repetir la generación del registro anterior). Retorna false si no hay ninguna clave.
+static bool reconstruirIndice(Reproduccion* reproduccion, uint64_t primeraGeneracion) {
+    size_t capacidad = 0;
+    reproduccion->numClaves = 0;
+    uint64_t posicion = sizeof(CabeceraGrabacion);
+    uint64_t bytesAnterior = 0;
+    uint64_t ultimaGeneracion = primeraGeneracion;
+    CabeceraRegistro registro;
+    const uint8_t* datos;
+    while ((datos = leerRegistro(reproduccion, posicion, reproduccion->tamano, &registro)) != NULL) {
+        bool primero = posicion == sizeof(CabeceraGrabacion);
+        bool encadenado = primero ? (registro.tipo == REGISTRO_CLAVE && registro.numGeneracion == primeraGeneracion)
+            : (registro.numGeneracion == ultimaGeneracion + ((registro.tipo == REGISTRO_DIFERENCIA) ? 1 : 0));
+        if (!encadenado || registro.bytesAnterior != bytesAnterior || !validarDatosRegistro(reproduccion, &registro, datos)) {
+            break;
+        }
+        if (registro.tipo == REGISTRO_CLAVE && !agregarClave(reproduccion, &capacidad, registro.numGeneracion, posicion)) {
+            return false;
+        }
+        ultimaGeneracion = registro.numGeneracion;
+        bytesAnterior = medirRegistro(&registro);
+        posicion += bytesAnterior;
+    }
+    reproduccion->finRegistros = posicion;
+    reproduccion->ultimaGeneracion = ultimaGeneracion;
+    return reproduccion->numClaves > 0;
+}
+
+// Función para leer el índice de una grabación cerrada, comprobando su suma de verificación y que cada entrada apunte a una clave. Retorna false si no es válido.
+static bool leerIndice(Reproduccion* reproduccion, const CabeceraGrabacion* cabecera) {
+    if (cabecera->numClaves == 0 || cabecera->posicionIndice < sizeof(CabeceraGrabacion) || cabecera->posicionIndice > reproduccion->tamano ||
+        cabecera->numClaves > (reproduccion->tamano - cabecera->posicionIndice) / sizeof(EntradaIndice) ||
+        cabecera->posicionIndice + cabecera->numClaves * sizeof(EntradaIndice) + sizeof(uint64_t) != reproduccion->tamano ||
+        cabecera->ultimaGeneracion < cabecera->primeraGeneracion) {
+        return false;
+    }
+    size_t bytesIndice = cabecera->numClaves * sizeof(EntradaIndice);
+    const uint8_t* indice = reproduccion->proyeccion + cabecera->posicionIndice;
+    uint64_t suma;
+    memcpy(&suma, indice + bytesIndice, sizeof(suma));
+    reproduccion->claves = (EntradaIndice*)malloc(bytesIndice);
+    if (reproduccion->claves == NULL || acumularSumaBytes(0, indice, bytesIndice) != suma) {
+        return false;
+    }
+    memcpy(reproduccion->claves, indice, bytesIndice);
+    reproduccion->numClaves = cabecera->numClaves;
+    reproduccion->finRegistros = cabecera->posicionIndice;
+    reproduccion->ultimaGeneracion = cabecera->ultimaGeneracion;
+    for (size_t k = 0; k < reproduccion->numClaves; k++) {
+        const EntradaIndice* clave = &reproduccion->claves[k];
+        CabeceraRegistro registro;
+        if (leerRegistro(reproduccion, clave->posicion, reproduccion->finRegistros, &registro) == NULL || registro.tipo != REGISTRO_CLAVE ||
+            registro.numGeneracion != clave->numGeneracion || clave->numGeneracion > reproduccion->ultimaGeneracion ||
+            (k == 0) != (clave->posicion == sizeof(CabeceraGrabacion)) || (k > 0 && clave->numGeneracion <= reproduccion->claves[k - 1].numGeneracion)) {
+            return false;
+        }
+    }
+    return reproduccion->claves[0].numGeneracion == cabecera->primeraGeneracion;
+}
+
+// Función para ir a la clave indicada del índice. Retorna false si su registro está dañado.
+static bool aplicarClave(Reproduccion* reproduccion, size_t indiceClave) {
+    const EntradaIndice* clave = &reproduccion->claves[indiceClave];
+    CabeceraRegistro registro;
+    if (!aplicarRegistro(reproduccion, clave->posicion, REGISTRO_CLAVE, clave->numGeneracion, &registro)) {
+        return false;
+    }
+    // La generación actual queda asociada a la diferencia que la produjo (el registro anterior a la clave), salvo en la primera clave.
+    reproduccion->posicion = (registro.bytesAnterior > 0) ? clave->posicion - registro.bytesAnterior : clave->posicion;
+    reproduccion->fotograma.numGeneracion = clave->numGeneracion;
+    return true;
+}
+
+// Función para buscar la última clave del índice cuya generación es menor o igual a la indicada.
+static size_t buscarClave(const Reproduccion* reproduccion, uint64_t numGeneracion) {
+    size_t inicio = 0, fin = reproduccion->numClaves; // La respuesta está en [inicio, fin); la clave 0 es la primera generación.
+    while (fin - inicio > 1) {
+        size_t medio = inicio + (fin - inicio) / 2;
+        if (reproduccion->claves[medio].numGeneracion <= numGeneracion) {
+            inicio = medio;
+        } else {
+            fin = medio;
+        }
+    }
+    return inicio;
+}
+
+// Función para abrir una grabación y ubicarse en su primera generación. Si info no es NULL, se completa con la información de la grabación. Retorna NULL si el archivo no existe, no es una grabación válida o no hay memoria suficiente.
+Reproduccion* abrirReproduccion(const char* ruta, InfoGrabacion* info) {
+    int descriptor = open(ruta, O_RDONLY);
+    if (descriptor < 0) {
+        return NULL;
+    }
+    struct stat estado;
+    if (fstat(descriptor, &estado) != 0 || (size_t)estado.st_size < sizeof(CabeceraGrabacion)) {
+        close(descriptor);
+        return NULL;
+    }
+    size_t tamano = (size_t)estado.st_size;
+    void* proyeccion = mmap(NULL, tamano, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor); // La proyección sigue siendo válida después de cerrar el descriptor.
+    if (proyeccion == MAP_FAILED) {
+        return NULL;
+    }
+    const CabeceraGrabacion* cabecera = (const CabeceraGrabacion*)proyeccion;
+    Reproduccion* reproduccion = (Reproduccion*)calloc(1, sizeof(Reproduccion));
+    if (reproduccion == NULL || memcmp(cabecera->firma, FIRMA_GRABACION, sizeof(cabecera->firma)) != 0 || cabecera->version != VERSION_GRABACION ||
+        cabecera->marcaOrden != MARCA_ORDEN_BYTES || cabecera->ancho == 0 || cabecera->alto == 0 || cabecera->ancho > DIMENSION_MAXIMA ||
+        cabecera->alto > DIMENSION_MAXIMA || cabecera->intervaloClaves == 0 || memchr(cabecera->regla, '\0', sizeof(cabecera->regla)) == NULL) {
+        free(reproduccion);
+        munmap(proyeccion, tamano);
+        return NULL;
+    }
+    reproduccion->proyeccion = (const uint8_t*)proyeccion;
+    reproduccion->tamano = tamano;
+    reproduccion->primeraGeneracion = cabecera->primeraGeneracion;
+    size_t palabrasPorFila = PALABRAS_POR_FILA(cabecera->ancho);
+    reproduccion->totalPalabras = (size_t)cabecera->alto * palabrasPorFila;
+    reproduccion->fotograma.ancho = cabecera->ancho;
+    reproduccion->fotograma.alto = cabecera->alto;
+    reproduccion->fotograma.palabrasEntreFilas = palabrasPorFila;
+    reproduccion->fotograma.celulas = (uint64_t*)calloc(reproduccion->totalPalabras, sizeof(uint64_t));
+
+    // Usamos el índice de la grabación si se cerró y es válido; si no, lo reconstruimos recorriendo los registros.
+    bool cerrada = cabecera->posicionIndice != 0;
+    bool indiceValido = reproduccion->fotograma.celulas != NULL && cerrada && leerIndice(reproduccion, cabecera);
+    bool reconstruido = false;
+    if (!indiceValido && reproduccion->fotograma.celulas != NULL) {
+        free(reproduccion->claves);
+        reproduccion->claves = NULL;
+        indiceValido = reconstruirIndice(reproduccion, cabecera->primeraGeneracion);
+        reconstruido = true;
+    }
+    if (!indiceValido || !aplicarClave(reproduccion, 0)) {
+        cerrarReproduccion(reproduccion);
+        return NULL;
+    }
+    if (info != NULL) {
+        info->ancho = cabecera->ancho;
+        info->alto = cabecera->alto;
+        info->primeraGeneracion = reproduccion->primeraGeneracion;
+        info->ultimaGeneracion = reproduccion->ultimaGeneracion;
+        info->intervaloClaves = cabecera->intervaloClaves;
+        info->numClaves = reproduccion->numClaves;
+        info->bytes = tamano;
+        info->indiceReconstruido = reconstruido;
+        snprintf(info->regla, sizeof(info->regla), "%s", cabecera->regla);
+    }
+    return reproduccion;
+}
+
+// Función para obtener el fotograma con la generación actual de la reproducción.
+const Fotograma* obtenerFotogramaReproduccion(Reproduccion* reproduccion) {
+    return &reproduccion->fotograma;
+}
+
+// Función para avanzar (direccion > 0) o retroceder (direccion < 0) una generación. Retorna false si no hay más generaciones en esa dirección o sus datos están dañados.
+bool avanzarReproduccion(Reproduccion* reproduccion, int direccion) {
+    uint64_t actual = reproduccion->fotograma.numGeneracion;
+    CabeceraRegistro registro;
+    if (direccion > 0) {
+        if (actual >= reproduccion->ultimaGeneracion || leerRegistro(reproduccion, reproduccion->posicion, reproduccion->finRegistros, &registro) == NULL) {
+            return false;
+        }
+        // La diferencia siguiente está después del registro actual y, si la generación actual es una clave, después de esa clave.
+        uint64_t siguiente = reproduccion->posicion + medirRegistro(&registro);
+        if (registro.tipo == REGISTRO_DIFERENCIA && leerRegistro(reproduccion, siguiente, reproduccion->finRegistros, &registro) != NULL &&
+            registro.tipo == REGISTRO_CLAVE) {
+            siguiente += medirRegistro(&registro);
+        }
+        if (!aplicarRegistro(reproduccion, siguiente, REGISTRO_DIFERENCIA, actual + 1, &registro)) {
+            return false;
+        }
+        reproduccion->posicion = siguiente;
+        reproduccion->fotograma.numGeneracion = actual + 1;
+        return true;
+    }
+    // Para retroceder aplicamos otra vez la diferencia que produjo la generación actual (XOR es su propia inversa).
+    if (actual <= reproduccion->primeraGeneracion || !aplicarRegistro(reproduccion, reproduccion->posicion, REGISTRO_DIFERENCIA, actual, &registro)) {
+        return false;
+    }
+    // El registro anterior es la diferencia de la generación anterior, salvo que esa generación sea una clave (que se salta, excepto la primera).
+    uint64_t anterior = reproduccion->posicion - registro.bytesAnterior;
+    if (leerRegistro(reproduccion, anterior, reproduccion->finRegistros, &registro) != NULL && registro.tipo == REGISTRO_CLAVE && registro.bytesAnterior > 0) {
+        anterior -= registro.bytesAnterior;
+    }
+    reproduccion->posicion = anterior;
+    reproduccion->fotograma.numGeneracion = actual - 1;
+    return true;
+}
+
+// Función para ir a una generación cualquiera, partiendo de la clave más cercana anterior (o de la generación actual, si está más cerca). Retorna false si la generación no está grabada o los datos de algún registro están dañados (en ese caso, la reproducción queda en la última generación que se pudo reconstruir).
+bool irAGeneracionReproduccion(Reproduccion* reproduccion, uint64_t numGeneracion) {
+    if (numGeneracion < reproduccion->primeraGeneracion || numGeneracion > reproduccion->ultimaGeneracion) {
+        return false;
+    }
+    uint64_t actual = reproduccion->fotograma.numGeneracion;
+    size_t indiceClave = buscarClave(reproduccion, numGeneracion);
+    uint64_t desdeClave = numGeneracion - reproduccion->claves[indiceClave].numGeneracion;
+    // Partimos de la generación actual si está a menos diferencias que la clave (hacia adelante o hacia atrás); si no, de la clave.
+    uint64_t distancia = (actual > numGeneracion) ? actual - numGeneracion : numGeneracion - actual;
+    if (distancia > desdeClave && !aplicarClave(reproduccion, indiceClave)) {
+        return false;
+    }
+    int direccion = (reproduccion->fotograma.numGeneracion < numGeneracion) ? 1 : -1;
+    while (reproduccion->fotograma.numGeneracion != numGeneracion) {
+        if (!avanzarReproduccion(reproduccion, direccion)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Función para ir a la clave siguiente (direccion > 0) o a la anterior a la generación actual (direccion < 0). Retorna false si no hay más claves en esa dirección.
+bool irAClaveReproduccion(Reproduccion* reproduccion, int direccion) {
+    uint64_t actual = reproduccion->fotograma.numGeneracion;
+    size_t indiceClave = buscarClave(reproduccion, actual); // Última clave <= actual
+    if (direccion > 0) {
+        if (indiceClave + 1 >= reproduccion->numClaves) {
+            return false;
+        }
+        indiceClave++;
+    } else if (reproduccion->claves[indiceClave].numGeneracion == actual) {
+        if (indiceClave == 0) {
+            return false;
+        }
+        indiceClave--;
+    }
+    return aplicarClave(reproduccion, indiceClave);
+}
+
+// Función para cerrar una grabación abierta y liberar sus recursos.
+void cerrarReproduccion(Reproduccion* reproduccion) {
+    if (reproduccion == NULL) {
+        return;
+    }
+    munmap((void*)reproduccion->proyeccion, reproduccion->tamano);
+    free(reproduccion->fotograma.celulas);
+    free(reproduccion->claves);
+    free(reproduccion);
+}
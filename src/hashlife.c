@@ -0,0 +1,635 @@
+#include <stdlib.h>
+#include <string.h>
+#include "../include/hashlife.h"
+
+//  ================================================
+//  Conway's Game of Life - Motor HashLife
+//  ================================================
+//  Este módulo implementa el algoritmo HashLife (Gosper), un motor alternativo para avanzar generaciones muy lejanas en poco tiempo.
+//
+//  CARACTERÍSTICAS PRINCIPALES:
+//  1. Quadtree con nodos canónicos (hash-consing):
+//      - Un nodo de nivel n representa un cuadrado de 2^n x 2^n células, formado por cuatro hijos de nivel n - 1 (nw, ne, sw, se).
+//      - Los nodos se guardan en una tabla hash indexada por sus cuatro hijos, de modo que cada configuración existe una sola vez
+//        y las regiones repetidas (por ejemplo, el espacio vacío) se comparten.
+//
+//  2. Resultados memorizados:
+//      - El resultado de un nodo de nivel n es su cuadrado central (nivel n - 1) avanzado 2^j generaciones, con j = min(exponentePaso, n - 2).
+//      - Cada resultado se calcula una sola vez y se guarda en el nodo; como los nodos son canónicos, se reutiliza en todas las
+//        posiciones y generaciones donde aparece la misma configuración.
+//      - Cada nodo guarda también el exponente con que calculó su resultado: los nodos de nivel n <= exponente + 2 avanzan 2^(n-2)
+//        generaciones con cualquier salto mayor, así que al cambiar de exponente solo se recalculan los niveles superiores.
+//      - Si cambia la regla, los resultados memorizados se descartan.
+//
+//  3. Recolección de nodos (desalojo de la caché):
+//      - Cuando el número de nodos supera el límite configurado, se marcan los nodos alcanzables desde la raíz (y, durante un salto,
+//        los que están en uso en la recursión) y se liberan los demás, junto con los resultados memorizados que apuntaban a ellos.
+//      - Si a mitad de un salto la recolección no deja al menos un cuarto del límite libre, el salto falla en lugar de superar el límite.
+
+// Macros para los índices de los hijos de un nodo.
+#define NW 0
+#define NE 1
+#define SW 2
+#define SE 3
+
+// Número de nodos que se reservan de una sola vez.
+#define NODOS_POR_BLOQUE 4096
+// Tamaño inicial de la tabla hash (potencia de 2).
+#define TAMANO_INICIAL_TABLA (1u << 16)
+// Nivel mínimo de la raíz (8 x 8 células).
+#define NIVEL_MINIMO_RAIZ 3
+// Nivel máximo de un nodo (las coordenadas se representan con 64 bits).
+#define NIVEL_MAXIMO 63
+// Nodos en uso que protege cada nivel de la recursión de calcularResultado (9 sub-cuadrados, 9 resultados, 4 cuadrados y 4 finales).
+#define PROTEGIDOS_POR_NIVEL 26
+
+// Definición de un nodo del quadtree.
+typedef struct Nodo {
+    struct Nodo* hijos[4];          // Hijos nw, ne, sw y se (NULL en las hojas)
+    struct Nodo* resultado;         // Resultado memorizado (NULL si aún no se calcula)
+    struct Nodo* siguiente;         // Siguiente nodo en la misma posición de la tabla hash (o en la lista de nodos libres)
+    uint64_t poblacion;             // Número de células vivas del nodo
+    uint8_t nivel;                  // Nivel del nodo (el lado mide 2^nivel células)
+    uint8_t pasoResultado;          // Exponente con que se calculó el resultado (min(exponentePaso, nivel - 2))
+    bool marcado;                   // Marca usada durante la recolección
+} Nodo;
+
+// Bloque de nodos reservados de una sola vez.
+typedef struct BloqueNodos {
+    struct BloqueNodos* siguiente;
+    Nodo nodos[NODOS_POR_BLOQUE];
+} BloqueNodos;
+
+// Definición de la estructura del universo.
+struct UniversoHashLife {
+    Nodo hojas[2];                  // Hojas canónicas (célula muerta y viva)
+    Nodo* vacios[NIVEL_MAXIMO + 1]; // Nodo vacío de cada nivel (se crean a medida que se necesitan)
+    Nodo* raiz;                     // Raíz del universo; cubre las coordenadas [-2^(nivel-1), 2^(nivel-1)) en ambos ejes
+    Nodo** tabla;                   // Tabla hash de nodos canónicos
+    size_t tamanoTabla;             // Número de posiciones de la tabla (potencia de 2)
+    size_t numNodos;                // Número de nodos en la tabla
+    size_t limiteNodos;             // Número de nodos a partir del cual se recolecta antes del siguiente salto
+    BloqueNodos* bloques;           // Bloques de nodos reservados
+    Nodo* libres;                   // Lista de nodos libres
+    unsigned exponentePaso;         // Exponente del salto en curso
+    Nodo* protegidos[(NIVEL_MAXIMO + 1) * PROTEGIDOS_POR_NIVEL]; // Nodos en uso por la recursión del salto en curso, que la recolección no libera
+    size_t numProtegidos;           // Número de nodos protegidos
+    Regla regla;                    // Regla B/S con que se calculan los casos base (B3/S23 por defecto)
+    uint64_t numGeneracion;         // Número de generación actual
+    bool limiteCoordenadas;         // La última operación falló porque la raíz tendría que pasar de NIVEL_MAXIMO
+};
+
+// Función para calcular la posición de un nodo en la tabla hash a partir de sus hijos.
+static inline size_t calcularHash(Nodo* const hijos[4], size_t tamanoTabla) {
+    uint64_t hash = 0;
+    for (int i = 0; i < 4; i++) {
+        hash = (hash + (uint64_t)(uintptr_t)hijos[i]) * 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 29;
+    }
+    return (size_t)hash & (tamanoTabla - 1);
+}
+
+// Función para duplicar el tamaño de la tabla hash cuando se llena. Si no hay memoria, la tabla conserva su tamaño.
+static void agrandarTabla(UniversoHashLife* universo) {
+    size_t nuevoTamano = universo->tamanoTabla * 2;
+    Nodo** nuevaTabla = (Nodo**)calloc(nuevoTamano, sizeof(Nodo*));
+    if (nuevaTabla == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < universo->tamanoTabla; i++) {
+        Nodo* nodo = universo->tabla[i];
+        while (nodo != NULL) {
+            Nodo* siguiente = nodo->siguiente;
+            size_t posicion = calcularHash(nodo->hijos, nuevoTamano);
+            nodo->siguiente = nuevaTabla[posicion];
+            nuevaTabla[posicion] = nodo;
+            nodo = siguiente;
+        }
+    }
+    free(universo->tabla);
+    universo->tabla = nuevaTabla;
+    universo->tamanoTabla = nuevoTamano;
+}
+
+// Función para tomar un nodo de la lista de libres, reservando un nuevo bloque si está vacía.
+static Nodo* reservarNodo(UniversoHashLife* universo) {
+    if (universo->libres == NULL) {
+        BloqueNodos* bloque = (BloqueNodos*)malloc(sizeof(BloqueNodos));
+        if (bloque == NULL) {
+            return NULL;
+        }
+        bloque->siguiente = universo->bloques;
+        universo->bloques = bloque;
+        for (size_t i = 0; i < NODOS_POR_BLOQUE; i++) {
+            bloque->nodos[i].siguiente = universo->libres;
+            universo->libres = &bloque->nodos[i];
+        }
+    }
+    Nodo* nodo = universo->libres;
+    universo->libres = nodo->siguiente;
+    return nodo;
+}
+
+// Función para obtener el nodo canónico con los cuatro hijos indicados (todos del mismo nivel), creándolo si no existe. Retorna NULL si no hay memoria.
+static Nodo* obtenerNodo(UniversoHashLife* universo, Nodo* nw, Nodo* ne, Nodo* sw, Nodo* se) {
+    if (nw == NULL || ne == NULL || sw == NULL || se == NULL) {
+        return NULL;
+    }
+    Nodo* hijos[4] = {nw, ne, sw, se};
+    size_t posicion = calcularHash(hijos, universo->tamanoTabla);
+    for (Nodo* nodo = universo->tabla[posicion]; nodo != NULL; nodo = nodo->siguiente) {
+        if (nodo->hijos[NW] == nw && nodo->hijos[NE] == ne && nodo->hijos[SW] == sw && nodo->hijos[SE] == se) {
+            return nodo;
+        }
+    }
+    Nodo* nodo = reservarNodo(universo);
+    if (nodo == NULL) {
+        return NULL;
+    }
+    memcpy(nodo->hijos, hijos, sizeof(hijos));
+    nodo->resultado = NULL;
+    nodo->poblacion = nw->poblacion + ne->poblacion + sw->poblacion + se->poblacion;
+    nodo->nivel = (uint8_t)(nw->nivel + 1);
+    nodo->marcado = false;
+    nodo->siguiente = universo->tabla[posicion];
+    universo->tabla[posicion] = nodo;
+    universo->numNodos++;
+    if (universo->numNodos > universo->tamanoTabla) {
+        agrandarTabla(universo);
+    }
+    return nodo;
+}
+
+// Función para obtener el nodo vacío de un nivel. Retorna NULL si no hay memoria.
+static Nodo* obtenerVacio(UniversoHashLife* universo, unsigned nivel) {
+    if (nivel == 0) {
+        return &universo->hojas[0];
+    }
+    if (universo->vacios[nivel] == NULL) {
+        Nodo* hijo = obtenerVacio(universo, nivel - 1);
+        universo->vacios[nivel] = obtenerNodo(universo, hijo, hijo, hijo, hijo);
+    }
+    return universo->vacios[nivel];
+}
+
+// Función para obtener el cuadrado central (nivel n - 1) de un nodo de nivel n >= 2.
+static Nodo* obtenerCentro(UniversoHashLife* universo, Nodo* nodo) {
+    return obtenerNodo(universo, nodo->hijos[NW]->hijos[SE], nodo->hijos[NE]->hijos[SW], nodo->hijos[SW]->hijos[NE], nodo->hijos[SE]->hijos[NW]);
+}
+
+// Función para calcular el caso base: el centro 2 x 2 de un nodo de nivel 2 (4 x 4 células), avanzado una generación.
+static Nodo* calcularCasoBase(UniversoHashLife* universo, Nodo* nodo) {
+    // Reunimos las 16 células en una máscara de bits, con la célula (x, y) en el bit y * 4 + x.
+    unsigned celulas = 0;
+    for (int cuadrante = 0; cuadrante < 4; cuadrante++) {
+        Nodo* hijo = nodo->hijos[cuadrante];
+        for (int subcuadrante = 0; subcuadrante < 4; subcuadrante++) {
+            if (hijo->hijos[subcuadrante]->poblacion != 0) {
+                int x = (cuadrante % 2) * 2 + subcuadrante % 2;
+                int y = (cuadrante / 2) * 2 + subcuadrante / 2;
+                celulas |= 1u << (y * 4 + x);
+            }
+        }
+    }
+    // Aplicamos la regla del universo a las 4 células centrales.
+    Nodo* centro[4];
+    for (int i = 0; i < 4; i++) {
+        int x = 1 + i % 2;
+        int y = 1 + i / 2;
+        int vecinasVivas = 0;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                if ((dx != 0 || dy != 0) && (celulas >> ((y + dy) * 4 + (x + dx)) & 1u)) {
+                    vecinasVivas++;
+                }
+            }
+        }
+        bool viva = (celulas >> (y * 4 + x)) & 1u;
+        centro[i] = &universo->hojas[aplicarRegla(&universo->regla, viva, (unsigned)vecinasVivas) ? 1 : 0];
+    }
+    return obtenerNodo(universo, centro[NW], centro[NE], centro[SW], centro[SE]);
+}
+
+static void recolectarNodos(UniversoHashLife* universo);
+
+// Función para proteger de la recolección un nodo en uso por la recursión del salto en curso.
+static inline void protegerNodo(UniversoHashLife* universo, Nodo* nodo) {
+    universo->protegidos[universo->numProtegidos++] = nodo;
+}
+
+// Función para calcular (o recuperar de la memoria) el resultado de un nodo de nivel n >= 2: su centro avanzado 2^min(exponentePaso, n - 2) generaciones.
+static Nodo* calcularResultado(UniversoHashLife* universo, Nodo* nodo) {
+    uint8_t paso = (uint8_t)((universo->exponentePaso < nodo->nivel - 2u) ? universo->exponentePaso : nodo->nivel - 2u);
+    if (nodo->resultado != NULL) {
+        if (nodo->pasoResultado == paso) {
+            return nodo->resultado;
+        }
+        nodo->resultado = NULL;
+    }
+    nodo->pasoResultado = paso;
+    // Un nodo vacío sigue vacío.
+    if (nodo->poblacion == 0) {
+        nodo->resultado = obtenerVacio(universo, nodo->nivel - 1u);
+        return nodo->resultado;
+    }
+    if (nodo->nivel == 2) {
+        nodo->resultado = calcularCasoBase(universo, nodo);
+        return nodo->resultado;
+    }
+    // Si superamos el límite, recolectamos aquí mismo (el nodo ya está protegido por quien lo pide); si no se libera
+    // al menos un cuarto del límite, los nodos en uso no caben y el salto falla.
+    if (universo->numNodos > universo->limiteNodos) {
+        recolectarNodos(universo);
+        if (universo->numNodos > universo->limiteNodos / 4 * 3) {
+            return NULL;
+        }
+    }
+    size_t base = universo->numProtegidos;
+    Nodo* nw = nodo->hijos[NW];
+    Nodo* ne = nodo->hijos[NE];
+    Nodo* sw = nodo->hijos[SW];
+    Nodo* se = nodo->hijos[SE];
+
+    // Formamos los 9 sub-cuadrados de nivel n - 1 que se superponen, y calculamos sus resultados (nivel n - 2).
+    Nodo* subcuadrados[9] = {
+        nw,
+        obtenerNodo(universo, nw->hijos[NE], ne->hijos[NW], nw->hijos[SE], ne->hijos[SW]),
+        ne,
+        obtenerNodo(universo, nw->hijos[SW], nw->hijos[SE], sw->hijos[NW], sw->hijos[NE]),
+        obtenerCentro(universo, nodo),
+        obtenerNodo(universo, ne->hijos[SW], ne->hijos[SE], se->hijos[NW], se->hijos[NE]),
+        sw,
+        obtenerNodo(universo, sw->hijos[NE], se->hijos[NW], sw->hijos[SE], se->hijos[SW]),
+        se,
+    };
+    for (int i = 0; i < 9; i++) {
+        if (subcuadrados[i] == NULL) {
+            return NULL;
+        }
+        protegerNodo(universo, subcuadrados[i]);
+    }
+    Nodo* r[9];
+    for (int i = 0; i < 9; i++) {
+        if ((r[i] = calcularResultado(universo, subcuadrados[i])) == NULL) {
+            return NULL;
+        }
+        protegerNodo(universo, r[i]);
+    }
+
+    // Combinamos los 9 resultados en 4 cuadrados de nivel n - 1.
+    Nodo* cuadrados[4] = {
+        obtenerNodo(universo, r[0], r[1], r[3], r[4]),
+        obtenerNodo(universo, r[1], r[2], r[4], r[5]),
+        obtenerNodo(universo, r[3], r[4], r[6], r[7]),
+        obtenerNodo(universo, r[4], r[5], r[7], r[8]),
+    };
+    for (int i = 0; i < 4; i++) {
+        if (cuadrados[i] == NULL) {
+            return NULL;
+        }
+        protegerNodo(universo, cuadrados[i]);
+    }
+    Nodo* finales[4];
+    bool velocidadCompleta = (universo->exponentePaso >= nodo->nivel - 2u);
+    for (int i = 0; i < 4; i++) {
+        // A velocidad completa, los cuadrados se vuelven a avanzar (2^(n-3) + 2^(n-3) = 2^(n-2) generaciones); si el salto es menor, solo se toma su centro.
+        finales[i] = velocidadCompleta ? calcularResultado(universo, cuadrados[i]) : obtenerCentro(universo, cuadrados[i]);
+        if (finales[i] == NULL) {
+            return NULL;
+        }
+        protegerNodo(universo, finales[i]);
+    }
+    universo->numProtegidos = base;
+    nodo->resultado = obtenerNodo(universo, finales[NW], finales[NE], finales[SW], finales[SE]);
+    return nodo->resultado;
+}
+
+// Función para duplicar el lado de la raíz, rodeándola de espacio vacío y manteniéndola centrada. Retorna false si no hay memoria.
+static bool expandirRaiz(UniversoHashLife* universo) {
+    Nodo* raiz = universo->raiz;
+    Nodo* vacio = obtenerVacio(universo, raiz->nivel - 1u);
+    Nodo* nuevaRaiz = obtenerNodo(universo,
+        obtenerNodo(universo, vacio, vacio, vacio, raiz->hijos[NW]),
+        obtenerNodo(universo, vacio, vacio, raiz->hijos[NE], vacio),
+        obtenerNodo(universo, vacio, raiz->hijos[SW], vacio, vacio),
+        obtenerNodo(universo, raiz->hijos[SE], vacio, vacio, vacio));
+    if (nuevaRaiz == NULL) {
+        return false;
+    }
+    universo->raiz = nuevaRaiz;
+    return true;
+}
+
+// Función para expandir la raíz sin pasar de NIVEL_MAXIMO, para que las coordenadas sigan cabiendo en 64 bits. Retorna false (marcando limiteCoordenadas) si ya
+// está en el nivel máximo, o si no hay memoria.
+static bool expandirRaizDentroDelLimite(UniversoHashLife* universo) {
+    if (universo->raiz->nivel >= NIVEL_MAXIMO) {
+        universo->limiteCoordenadas = true;
+        return false;
+    }
+    return expandirRaiz(universo);
+}
+
+// Función para reducir la raíz a su centro mientras todas las células vivas estén en él (mantiene el árbol lo más pequeño posible).
+static void compactarRaiz(UniversoHashLife* universo) {
+    while (universo->raiz->nivel > NIVEL_MINIMO_RAIZ) {
+        Nodo* centro = obtenerCentro(universo, universo->raiz);
+        if (centro == NULL || centro->poblacion != universo->raiz->poblacion) {
+            return;
+        }
+        universo->raiz = centro;
+    }
+}
+
+// Función para marcar un nodo y todos sus descendientes como alcanzables.
+static void marcarNodo(Nodo* nodo) {
+    if (nodo == NULL || nodo->marcado || nodo->nivel == 0) {
+        return;
+    }
+    nodo->marcado = true;
+    for (int i = 0; i < 4; i++) {
+        marcarNodo(nodo->hijos[i]);
+    }
+}
+
+// Función para liberar los nodos que no son alcanzables desde la raíz, los nodos vacíos ni los nodos protegidos.
+static void recolectarNodos(UniversoHashLife* universo) {
+    marcarNodo(universo->raiz);
+    for (size_t i = 0; i < universo->numProtegidos; i++) {
+        marcarNodo(universo->protegidos[i]);
+    }
+    for (unsigned nivel = 0; nivel <= NIVEL_MAXIMO; nivel++) {
+        marcarNodo(universo->vacios[nivel]);
+    }
+    // Primera pasada: olvidamos los resultados memorizados que apuntan a nodos que se van a liberar.
+    for (size_t i = 0; i < universo->tamanoTabla; i++) {
+        for (Nodo* nodo = universo->tabla[i]; nodo != NULL; nodo = nodo->siguiente) {
+            if (nodo->resultado != NULL && nodo->resultado->nivel > 0 && !nodo->resultado->marcado) {
+                nodo->resultado = NULL;
+            }
+        }
+    }
+    // Segunda pasada: devolvemos los nodos no marcados a la lista de libres y quitamos las marcas.
+    for (size_t i = 0; i < universo->tamanoTabla; i++) {
+        Nodo** enlace = &universo->tabla[i];
+        while (*enlace != NULL) {
+            Nodo* nodo = *enlace;
+            if (nodo->marcado) {
+                nodo->marcado = false;
+                enlace = &nodo->siguiente;
+            } else {
+                *enlace = nodo->siguiente;
+                nodo->siguiente = universo->libres;
+                universo->libres = nodo;
+                universo->numNodos--;
+            }
+        }
+    }
+}
+
+// Función para descartar todos los resultados memorizados (se usa al cambiar la regla).
+static void olvidarResultados(UniversoHashLife* universo) {
+    for (size_t i = 0; i < universo->tamanoTabla; i++) {
+        for (Nodo* nodo = universo->tabla[i]; nodo != NULL; nodo = nodo->siguiente) {
+            nodo->resultado = NULL;
+        }
+    }
+}
+
+// Función para crear un universo vacío. limiteNodos indica cuántos nodos se conservan antes de recolectar los que ya no se usan (0 = LIMITE_NODOS_HASHLIFE_DEFECTO).
+UniversoHashLife* crearUniversoHashLife(size_t limiteNodos) {
+    UniversoHashLife* universo = (UniversoHashLife*)calloc(1, sizeof(UniversoHashLife));
+    if (universo == NULL) {
+        return NULL;
+    }
+    universo->tamanoTabla = TAMANO_INICIAL_TABLA;
+    universo->tabla = (Nodo**)calloc(universo->tamanoTabla, sizeof(Nodo*));
+    if (universo->tabla == NULL) {
+        free(universo);
+        return NULL;
+    }
+    // Inicializamos las hojas canónicas (nivel 0): una célula muerta y una viva.
+    universo->hojas[0].poblacion = 0;
+    universo->hojas[1].poblacion = 1;
+    universo->limiteNodos = (limiteNodos > 0) ? limiteNodos : LIMITE_NODOS_HASHLIFE_DEFECTO;
+    universo->regla = *obtenerReglaConway();
+    universo->raiz = obtenerVacio(universo, NIVEL_MINIMO_RAIZ);
+    if (universo->raiz == NULL) {
+        liberarUniversoHashLife(universo);
+        return NULL;
+    }
+    return universo;
+}
+
+// Función recursiva para construir el nodo de nivel 'nivel' cuya esquina superior izquierda es la célula (x0, y0) de la cuadrícula.
+static Nodo* construirNodoDesdeCuadricula(UniversoHashLife* universo, Cuadricula* cuadricula, unsigned nivel, uint64_t x0, uint64_t y0) {
+    // Las regiones fuera de la cuadrícula están vacías.
+    if (x0 >= cuadricula->ancho || y0 >= cuadricula->alto) {
+        return obtenerVacio(universo, nivel);
+    }
+    if (nivel == 0) {
+        return &universo->hojas[obtenerEstadoCelula(cuadricula, (uint32_t)x0, (uint32_t)y0) ? 1 : 0];
+    }
+    uint64_t mitad = (uint64_t)1 << (nivel - 1);
+    return obtenerNodo(universo,
+        construirNodoDesdeCuadricula(universo, cuadricula, nivel - 1, x0, y0),
+        construirNodoDesdeCuadricula(universo, cuadricula, nivel - 1, x0 + mitad, y0),
+        construirNodoDesdeCuadricula(universo, cuadricula, nivel - 1, x0, y0 + mitad),
+        construirNodoDesdeCuadricula(universo, cuadricula, nivel - 1, x0 + mitad, y0 + mitad));
+}
+
+// Función para crear un universo con las células vivas de la generación actual de una cuadrícula (la célula (x, y) de la cuadrícula pasa a la posición (x, y) del universo).
+UniversoHashLife* crearUniversoHashLifeDesdeCuadricula(Cuadricula* cuadricula, size_t limiteNodos) {
+    if (cuadricula == NULL) {
+        return NULL;
+    }
+    UniversoHashLife* universo = crearUniversoHashLife(limiteNodos);
+    if (universo == NULL) {
+        return NULL;
+    }
+    // Construimos de abajo hacia arriba un nodo que cubre toda la cuadrícula y lo colocamos como cuadrante se de la raíz, cuya esquina es el origen.
+    unsigned nivel = NIVEL_MINIMO_RAIZ - 1;
+    while (((uint64_t)1 << nivel) < cuadricula->ancho || ((uint64_t)1 << nivel) < cuadricula->alto) {
+        nivel++;
+    }
+    Nodo* vacio = obtenerVacio(universo, nivel);
+    Nodo* contenido = construirNodoDesdeCuadricula(universo, cuadricula, nivel, 0, 0);
+    Nodo* raiz = obtenerNodo(universo, vacio, vacio, vacio, contenido);
+    if (raiz == NULL) {
+        liberarUniversoHashLife(universo);
+        return NULL;
+    }
+    universo->raiz = raiz;
+    return universo;
+}
+
+// Función para liberar la memoria asignada a un universo.
+void liberarUniversoHashLife(UniversoHashLife* universo) {
+    if (universo == NULL) {
+        return;
+    }
+    while (universo->bloques != NULL) {
+        BloqueNodos* siguiente = universo->bloques->siguiente;
+        free(universo->bloques);
+        universo->bloques = siguiente;
+    }
+    free(universo->tabla);
+    free(universo);
+}
+
+// Función recursiva para obtener una copia de un nodo con la célula (x, y) (relativa a su esquina superior izquierda) cambiada.
+static Nodo* establecerEnNodo(UniversoHashLife* universo, Nodo* nodo, uint64_t x, uint64_t y, bool viva) {
+    if (nodo->nivel == 0) {
+        return &universo->hojas[viva ? 1 : 0];
+    }
+    uint64_t mitad = (uint64_t)1 << (nodo->nivel - 1);
+    int cuadrante = ((y >= mitad) ? 2 : 0) + ((x >= mitad) ? 1 : 0);
+    Nodo* hijos[4] = {nodo->hijos[NW], nodo->hijos[NE], nodo->hijos[SW], nodo->hijos[SE]};
+    hijos[cuadrante] = establecerEnNodo(universo, hijos[cuadrante], x % mitad, y % mitad, viva);
+    return obtenerNodo(universo, hijos[NW], hijos[NE], hijos[SW], hijos[SE]);
+}
+
+// Función para saber si la raíz cubre la coordenada (x, y).
+static bool raizContiene(const UniversoHashLife* universo, int64_t x, int64_t y) {
+    int64_t mitad = (int64_t)1 << (universo->raiz->nivel - 1);
+    return x >= -mitad && x < mitad && y >= -mitad && y < mitad;
+}
+
+// Función para establecer el estado de una célula. Retorna false si no hay memoria suficiente o la coordenada está fuera del rango del universo (ver limiteCoordenadasAlcanzadoHashLife).
+bool establecerCelulaHashLife(UniversoHashLife* universo, int64_t x, int64_t y, bool viva) {
+    if (universo == NULL) {
+        return false;
+    }
+    universo->limiteCoordenadas = false;
+    // Recolectamos los nodos que ya no se usan si superamos el límite (cada cambio deja nodos sin usar en el camino hasta la raíz).
+    if (universo->numNodos > universo->limiteNodos) {
+        recolectarNodos(universo);
+    }
+    // Expandimos la raíz hasta que cubra la coordenada.
+    while (!raizContiene(universo, x, y)) {
+        if (!expandirRaizDentroDelLimite(universo)) {
+            return false;
+        }
+    }
+    uint64_t mitad = (uint64_t)1 << (universo->raiz->nivel - 1);
+    Nodo* nuevaRaiz = establecerEnNodo(universo, universo->raiz, (uint64_t)x + mitad, (uint64_t)y + mitad, viva);
+    if (nuevaRaiz == NULL) {
+        return false;
+    }
+    universo->raiz = nuevaRaiz;
+    return true;
+}
+
+// Función para obtener el estado de una célula.
+bool obtenerEstadoCelulaHashLife(UniversoHashLife* universo, int64_t x, int64_t y) {
+    if (universo == NULL || !raizContiene(universo, x, y)) {
+        return false;
+    }
+    Nodo* nodo = universo->raiz;
+    uint64_t mitad = (uint64_t)1 << (nodo->nivel - 1);
+    uint64_t relativoX = (uint64_t)x + mitad;
+    uint64_t relativoY = (uint64_t)y + mitad;
+    // Descendemos por el árbol hasta la hoja, saliendo antes si el nodo está vacío.
+    while (nodo->nivel > 0 && nodo->poblacion > 0) {
+        mitad = (uint64_t)1 << (nodo->nivel - 1);
+        int cuadrante = ((relativoY >= mitad) ? 2 : 0) + ((relativoX >= mitad) ? 1 : 0);
+        nodo = nodo->hijos[cuadrante];
+        relativoX %= mitad;
+        relativoY %= mitad;
+    }
+    return nodo->poblacion > 0;
+}
+
+// Función para avanzar 2^exponente generaciones de una sola vez. Retorna false si no hay memoria suficiente o el patrón saldría del rango de coordenadas (ver limiteCoordenadasAlcanzadoHashLife).
+bool avanzarPotenciaHashLife(UniversoHashLife* universo, unsigned exponente) {
+    if (universo == NULL || exponente > EXPONENTE_MAXIMO_HASHLIFE) {
+        return false;
+    }
+    universo->limiteCoordenadas = false;
+    // Recolectamos los nodos que ya no se usan si superamos el límite.
+    if (universo->numNodos > universo->limiteNodos) {
+        recolectarNodos(universo);
+    }
+    // Los resultados memorizados con otro exponente se recalculan al pedirlos (ver calcularResultado).
+    universo->exponentePaso = exponente;
+    // Expandimos la raíz hasta que su nivel permita un salto de 2^exponente y todas las células vivas estén en su centro;
+    // una expansión adicional deja margen suficiente para que el patrón no salga del resultado.
+    while (universo->raiz->nivel < exponente + 2 || obtenerCentro(universo, universo->raiz) == NULL ||
+           obtenerCentro(universo, universo->raiz)->poblacion != universo->raiz->poblacion) {
+        if (!expandirRaizDentroDelLimite(universo)) {
+            return false;
+        }
+    }
+    if (!expandirRaizDentroDelLimite(universo)) {
+        return false;
+    }
+    universo->numProtegidos = 0;
+    Nodo* resultado = calcularResultado(universo, universo->raiz);
+    universo->numProtegidos = 0;
+    if (resultado == NULL) {
+        return false;
+    }
+    universo->raiz = resultado;
+    universo->numGeneracion += (uint64_t)1 << exponente;
+    compactarRaiz(universo);
+    return true;
+}
+
+// Función para avanzar un número arbitrario de generaciones, descomponiéndolo en saltos de potencias de 2. Retorna false si no hay memoria suficiente o el patrón saldría del rango de coordenadas (ver limiteCoordenadasAlcanzadoHashLife).
+bool avanzarGeneracionesHashLife(UniversoHashLife* universo, uint64_t generaciones) {
+    if (universo == NULL) {
+        return false;
+    }
+    for (unsigned exponente = 0; generaciones != 0; exponente++, generaciones >>= 1) {
+        if ((generaciones & 1u) == 0) {
+            continue;
+        }
+        // Los bits por encima de EXPONENTE_MAXIMO_HASHLIFE se avanzan como varios saltos del tamaño máximo.
+        uint64_t repeticiones = (exponente > EXPONENTE_MAXIMO_HASHLIFE) ? (uint64_t)1 << (exponente - EXPONENTE_MAXIMO_HASHLIFE) : 1;
+        unsigned exponenteSalto = (exponente > EXPONENTE_MAXIMO_HASHLIFE) ? EXPONENTE_MAXIMO_HASHLIFE : exponente;
+        for (uint64_t i = 0; i < repeticiones; i++) {
+            if (!avanzarPotenciaHashLife(universo, exponenteSalto)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Función para obtener el número de generación actual.
+uint64_t obtenerNumGeneracionHashLife(UniversoHashLife* universo) {
+    return (universo != NULL) ? universo->numGeneracion : 0;
+}
+
+// Función para contar las células vivas del universo.
+uint64_t contarPoblacionHashLife(UniversoHashLife* universo) {
+    return (universo != NULL) ? universo->raiz->poblacion : 0;
+}
+
+// Función para cambiar el límite de nodos antes de recolectar los que ya no se usan (0 = LIMITE_NODOS_HASHLIFE_DEFECTO).
+void configurarLimiteNodosHashLife(UniversoHashLife* universo, size_t limiteNodos) {
+    if (universo != NULL) {
+        universo->limiteNodos = (limiteNodos > 0) ? limiteNodos : LIMITE_NODOS_HASHLIFE_DEFECTO;
+    }
+}
+
+// Función para cambiar la regla con que se calculan las generaciones. Retorna false (sin cambiarla) si la regla es NULL o hace nacer células sin vecinas (B0), que llenarían el plano ilimitado.
+bool configurarReglaHashLife(UniversoHashLife* universo, const Regla* regla) {
+    if (universo == NULL || regla == NULL || reglaNaceSinVecinas(regla)) {
+        return false;
+    }
+    // Los resultados memorizados se calcularon con la regla anterior.
+    universo->regla = *regla;
+    olvidarResultados(universo);
+    return true;
+}
+
+// Función para saber si la última operación que falló lo hizo porque el patrón saldría del rango de coordenadas de 64 bits (y no por falta de memoria).
+bool limiteCoordenadasAlcanzadoHashLife(UniversoHashLife* universo) {
+    return (universo != NULL) ? universo->limiteCoordenadas : false;
+}
+
+// Función para obtener el número de nodos almacenados actualmente.
+size_t obtenerNumNodosHashLife(UniversoHashLife* universo) {
+    return (universo != NULL) ? universo->numNodos : 0;
+}
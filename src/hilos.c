@@ -0,0 +1,294 @@
+#define _GNU_SOURCE     // pthread_setaffinity_np y las macros CPU_* (Linux)
+#include <stdlib.h>
+#include <stdint.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "../include/hilos.h"
+
+//  ================================================
+//  Conway's Game of Life - Pool de Hilos
+//  ================================================
+//  Este módulo implementa un pool de hilos persistente, creado una sola vez y reutilizado en cada llamada a ejecutarEnParalelo.
+//
+//  CARACTERÍSTICAS PRINCIPALES:
+//  1. Hilos persistentes:
+//      - Los hilos trabajadores se crean al crear el pool y esperan en una variable de condición hasta que llega un nuevo lote de tareas.
+//      - El hilo que llama a ejecutarEnParalelo también trabaja (como hilo 0), por lo que un pool de N hilos crea N - 1 trabajadores.
+//
+//  2. Robo de trabajo (work-stealing):
+//      - Al empezar un lote, las tareas se reparten en rangos contiguos, uno por hilo.
+//      - Cada hilo toma tareas del inicio de su propio rango; cuando se queda sin tareas, roba la mitad final del rango de otro hilo.
+//      - Cada rango se guarda como (inicio, fin) en una sola palabra atómica de 64 bits, por lo que tomar y robar se resuelven con compare-and-swap, sin bloqueos.
+//
+//  3. Barrera única:
+//      - ejecutarEnParalelo retorna cuando todos los hilos han terminado el lote, lo que permite, por ejemplo, intercambiar los buffers de la cuadrícula justo después.
+//
+//  4. Afinidad:
+//      - En Linux, si hay al menos tantos núcleos permitidos como hilos, cada trabajador se fija a un núcleo distinto (el i-ésimo núcleo permitido al proceso).
+//        Como el reparto inicial de las tareas es siempre el mismo, cada trabajador vuelve a tocar la misma memoria desde el mismo núcleo (y el mismo nodo NUMA)
+//        en cada lote, lo que permite colocar la memoria con el primer contacto (ver game.c).
+
+// Macros para empaquetar un rango de tareas (inicio, fin) en una palabra de 64 bits.
+#define EMPAQUETAR_RANGO(inicio, fin) (((uint64_t)(inicio) << 32) | (uint64_t)(fin))
+#define INICIO_RANGO(rango) ((uint32_t)((rango) >> 32))
+#define FIN_RANGO(rango) ((uint32_t)(rango))
+
+// Tamaño de la línea de caché, para que el rango de cada hilo no comparta línea con el de otro hilo (evitando el false sharing).
+#define ALINEACION_RANGO 64
+
+// Rango de tareas pendientes de un hilo.
+typedef struct {
+    _Alignas(ALINEACION_RANGO) _Atomic uint64_t rango;
+} RangoTareas;
+
+// Definición de la estructura del pool de hilos.
+struct PoolHilos {
+    unsigned numHilos;          // Número total de hilos (incluyendo al que llama)
+    pthread_t* trabajadores;    // Hilos trabajadores (numHilos - 1)
+    RangoTareas* rangos;        // Rango de tareas pendientes de cada hilo
+    pthread_mutex_t mutex;      // Protege los campos siguientes
+    pthread_cond_t condInicio;  // Señala a los trabajadores que hay un nuevo lote
+    pthread_cond_t condFin;     // Señala al hilo 0 que todos los trabajadores terminaron
+    uint64_t numLote;           // Número del lote actual (cambia con cada ejecutarEnParalelo)
+    unsigned trabajadoresActivos; // Trabajadores que aún no terminan el lote actual
+    bool terminar;              // Indica a los trabajadores que deben salir
+    FuncionTarea funcion;       // Función del lote actual
+    void* contexto;             // Contexto del lote actual
+    size_t desplazamiento;      // Índice de la primera tarea de la ronda actual
+};
+
+// Argumentos con los que arranca cada hilo trabajador.
+typedef struct {
+    PoolHilos* pool;
+    unsigned indice;
+    unsigned numHilos;          // Hilos pedidos al crear el pool (para elegir el núcleo del trabajador)
+} ArgumentoTrabajador;
+
+// Función para tomar la siguiente tarea del inicio del rango propio. Retorna false si el rango está vacío.
+static bool tomarTarea(RangoTareas* propio, uint32_t* tarea) {
+    uint64_t rango = atomic_load_explicit(&propio->rango, memory_order_acquire);
+    while (INICIO_RANGO(rango) < FIN_RANGO(rango)) {
+        uint64_t nuevo = EMPAQUETAR_RANGO(INICIO_RANGO(rango) + 1, FIN_RANGO(rango));
+        if (atomic_compare_exchange_weak_explicit(&propio->rango, &rango, nuevo, memory_order_acq_rel, memory_order_acquire)) {
+            *tarea = INICIO_RANGO(rango);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Función para robar la mitad final del rango de otro hilo y guardarla como rango propio. Retorna false si no había nada que robar.
+static bool robarTareas(PoolHilos* pool, unsigned indice) {
+    for (unsigned i = 1; i < pool->numHilos; i++) {
+        RangoTareas* victima = &pool->rangos[(indice + i) % pool->numHilos];
+        uint64_t rango = atomic_load_explicit(&victima->rango, memory_order_acquire);
+        while (INICIO_RANGO(rango) < FIN_RANGO(rango)) {
+            uint32_t pendientes = FIN_RANGO(rango) - INICIO_RANGO(rango);
+            uint32_t nuevoFin = FIN_RANGO(rango) - (pendientes + 1) / 2;
+            uint64_t nuevo = EMPAQUETAR_RANGO(INICIO_RANGO(rango), nuevoFin);
+            if (atomic_compare_exchange_weak_explicit(&victima->rango, &rango, nuevo, memory_order_acq_rel, memory_order_acquire)) {
+                // El rango propio está vacío, por lo que ningún otro hilo lo modifica mientras lo reemplazamos.
+                atomic_store_explicit(&pool->rangos[indice].rango, EMPAQUETAR_RANGO(nuevoFin, FIN_RANGO(rango)), memory_order_release);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Función para procesar tareas (propias y robadas) hasta que no quede ninguna pendiente.
+static void procesarTareas(PoolHilos* pool, unsigned indice) {
+    uint32_t tarea;
+    do {
+        while (tomarTarea(&pool->rangos[indice], &tarea)) {
+            pool->funcion(pool->contexto, pool->desplazamiento + tarea, indice);
+        }
+    } while (robarTareas(pool, indice));
+}
+
+// Función para fijar el trabajador indice de un pool de numHilos hilos al indice-ésimo núcleo permitido al proceso (el primero queda para el hilo que llama). Si hay menos núcleos que hilos, no se fija.
+static void fijarAfinidadTrabajador(unsigned indice, unsigned numHilos) {
+#ifdef __linux__
+    cpu_set_t permitidos;
+    if (sched_getaffinity(0, sizeof(permitidos), &permitidos) != 0 || (unsigned)CPU_COUNT(&permitidos) < numHilos) {
+        return;
+    }
+    unsigned encontrados = 0;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &permitidos) && encontrados++ == indice) {
+            cpu_set_t propio;
+            CPU_ZERO(&propio);
+            CPU_SET(cpu, &propio);
+            pthread_setaffinity_np(pthread_self(), sizeof(propio), &propio);
+            return;
+        }
+    }
+#else
+    (void)indice;
+    (void)numHilos;
+#endif
+}
+
+// Función principal de cada hilo trabajador: espera un nuevo lote, lo procesa y avisa al terminar.
+static void* ejecutarTrabajador(void* argumento) {
+    ArgumentoTrabajador* datos = (ArgumentoTrabajador*)argumento;
+    PoolHilos* pool = datos->pool;
+    unsigned indice = datos->indice;
+    fijarAfinidadTrabajador(indice, datos->numHilos);
+    free(datos);
+
+    uint64_t ultimoLote = 0;
+    pthread_mutex_lock(&pool->mutex);
+    while (true) {
+        // Esperamos hasta que haya un nuevo lote o se pida terminar.
+        while (!pool->terminar && pool->numLote == ultimoLote) {
+            pthread_cond_wait(&pool->condInicio, &pool->mutex);
+        }
+        if (pool->terminar) {
+            break;
+        }
+        ultimoLote = pool->numLote;
+        pthread_mutex_unlock(&pool->mutex);
+
+        procesarTareas(pool, indice);
+
+        // Avisamos al hilo 0 cuando el último trabajador termina el lote.
+        pthread_mutex_lock(&pool->mutex);
+        pool->trabajadoresActivos--;
+        if (pool->trabajadoresActivos == 0) {
+            pthread_cond_signal(&pool->condFin);
+        }
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
+}
+
+// Función para obtener el número de núcleos disponibles para el proceso (los de su afinidad en Linux, o los del sistema).
+unsigned detectarNumNucleos(void) {
+#ifdef __linux__
+    cpu_set_t permitidos;
+    if (sched_getaffinity(0, sizeof(permitidos), &permitidos) == 0 && CPU_COUNT(&permitidos) > 0) {
+        return (unsigned)CPU_COUNT(&permitidos);
+    }
+#endif
+    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    return (nucleos > 0) ? (unsigned)nucleos : 1;
+}
+
+// Función para crear un pool con el número de hilos indicado (incluyendo al hilo que llama). Si numHilos es 0, se usa el número de núcleos disponibles.
+PoolHilos* crearPoolHilos(unsigned numHilos) {
+    if (numHilos == 0) {
+        numHilos = detectarNumNucleos();
+    }
+    PoolHilos* pool = (PoolHilos*)calloc(1, sizeof(PoolHilos));
+    if (pool == NULL) {
+        return NULL;
+    }
+    pool->numHilos = numHilos;
+    pool->rangos = (RangoTareas*)aligned_alloc(ALINEACION_RANGO, numHilos * sizeof(RangoTareas));
+    pool->trabajadores = (pthread_t*)malloc(numHilos * sizeof(pthread_t));
+    if (pool->rangos == NULL || pool->trabajadores == NULL) {
+        free(pool->rangos);
+        free(pool->trabajadores);
+        free(pool);
+        return NULL;
+    }
+    for (unsigned i = 0; i < numHilos; i++) {
+        atomic_init(&pool->rangos[i].rango, 0);
+    }
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->condInicio, NULL);
+    pthread_cond_init(&pool->condFin, NULL);
+
+    // Creamos los trabajadores. Si alguno falla, el pool se queda con los que sí se pudieron crear.
+    for (unsigned i = 1; i < numHilos; i++) {
+        ArgumentoTrabajador* argumento = (ArgumentoTrabajador*)malloc(sizeof(ArgumentoTrabajador));
+        if (argumento == NULL) {
+            pool->numHilos = i;
+            break;
+        }
+        argumento->pool = pool;
+        argumento->indice = i;
+        argumento->numHilos = numHilos;
+        if (pthread_create(&pool->trabajadores[i - 1], NULL, ejecutarTrabajador, argumento) != 0) {
+            free(argumento);
+            pool->numHilos = i;
+            break;
+        }
+    }
+    return pool;
+}
+
+// Función para detener los hilos del pool y liberar sus recursos.
+void liberarPoolHilos(PoolHilos* pool) {
+    if (pool == NULL) {
+        return;
+    }
+    // Pedimos a los trabajadores que terminen y esperamos a que salgan.
+    pthread_mutex_lock(&pool->mutex);
+    pool->terminar = true;
+    pthread_cond_broadcast(&pool->condInicio);
+    pthread_mutex_unlock(&pool->mutex);
+    for (unsigned i = 1; i < pool->numHilos; i++) {
+        pthread_join(pool->trabajadores[i - 1], NULL);
+    }
+    pthread_cond_destroy(&pool->condFin);
+    pthread_cond_destroy(&pool->condInicio);
+    pthread_mutex_destroy(&pool->mutex);
+    free(pool->trabajadores);
+    free(pool->rangos);
+    free(pool);
+}
+
+// Función para obtener el número de hilos del pool (incluyendo al hilo que llama).
+unsigned obtenerNumHilosPool(const PoolHilos* pool) {
+    return (pool != NULL) ? pool->numHilos : 1;
+}
+
+// Función para ejecutar una ronda de como máximo 2^32 - 1 tareas, numeradas a partir de desplazamiento.
+static void ejecutarRonda(PoolHilos* pool, size_t desplazamiento, size_t numTareas, FuncionTarea funcion, void* contexto) {
+    // Repartimos las tareas en rangos contiguos, uno por hilo.
+    for (unsigned i = 0; i < pool->numHilos; i++) {
+        size_t inicio = numTareas * i / pool->numHilos;
+        size_t fin = numTareas * (i + 1) / pool->numHilos;
+        atomic_store_explicit(&pool->rangos[i].rango, EMPAQUETAR_RANGO(inicio, fin), memory_order_relaxed);
+    }
+
+    // Publicamos el lote y despertamos a los trabajadores.
+    pthread_mutex_lock(&pool->mutex);
+    pool->funcion = funcion;
+    pool->contexto = contexto;
+    pool->desplazamiento = desplazamiento;
+    pool->trabajadoresActivos = pool->numHilos - 1;
+    pool->numLote++;
+    pthread_cond_broadcast(&pool->condInicio);
+    pthread_mutex_unlock(&pool->mutex);
+
+    // El hilo que llama también procesa tareas como hilo 0.
+    procesarTareas(pool, 0);
+
+    // Barrera: esperamos a que todos los trabajadores terminen el lote.
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->trabajadoresActivos > 0) {
+        pthread_cond_wait(&pool->condFin, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+// Función para ejecutar las tareas [0, numTareas) repartidas entre los hilos del pool. Retorna cuando todas las tareas han terminado (barrera).
+void ejecutarEnParalelo(PoolHilos* pool, size_t numTareas, FuncionTarea funcion, void* contexto) {
+    // Sin pool (o con un solo hilo, o una sola tarea) ejecutamos las tareas directamente en el hilo que llama.
+    if (pool == NULL || pool->numHilos == 1 || numTareas <= 1) {
+        for (size_t tarea = 0; tarea < numTareas; tarea++) {
+            funcion(contexto, tarea, 0);
+        }
+        return;
+    }
+    // Los índices de tarea se guardan en 32 bits; los lotes más grandes se dividen en varias rondas.
+    for (size_t base = 0; base < numTareas; base += UINT32_MAX) {
+        size_t tareasRonda = numTareas - base;
+        ejecutarRonda(pool, base, (tareasRonda > UINT32_MAX) ? UINT32_MAX : tareasRonda, funcion, contexto);
+    }
+}
@@ -0,0 +1,444 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../include/instantaneas.h"
+
+//  ================================================
+//  Conway's Game of Life - Instantáneas
+//  ================================================
+//  Este módulo guarda y carga instantáneas binarias de la cuadrícula, para reanudar simulaciones largas.
+//
+//  CARACTERÍSTICAS PRINCIPALES:
+//  1. Formato Compacto:
+//      - Una cabecera de 128 bytes (firma, versión, dimensiones, generación, regla y suma de verificación) seguida de las filas empaquetadas,
+//        de palabrasPorFila palabras cada una, sin el borde fantasma ni el relleno de alineación (igual que un Fotograma).
+//      - Las células se dividen en bloques de PALABRAS_POR_BLOQUE palabras. Si hay suficientes bloques vacíos, se guarda un mapa de bits
+//        con los bloques no vacíos seguido solo de esos bloques (una cuadrícula con pocas células vivas ocupa muy poco).
+//      - La suma de verificación cubre la cabecera y los datos, de modo que un archivo truncado o dañado se rechaza al cargarlo.
+//
+//  2. Carga con mmap:
+//      - El archivo se proyecta en memoria y cada fila se copia directamente de la proyección a la cuadrícula, sin leerlo a un buffer intermedio.
+//
+//  3. Escritura en Segundo Plano:
+//      - solicitarInstantanea solo copia la generación actual (un memcpy por fila) en un buffer triple (ver fotogramas.c) y despierta al
+//        hilo escritor, que comprime, calcula la suma de verificación y escribe el archivo mientras la simulación continúa.
+//      - Si el disco es más lento que las instantáneas pedidas, se escribe siempre la más reciente y se descartan las intermedias.
+//      - Cada instantánea se escribe en un archivo temporal que luego reemplaza al anterior (rename), por lo que siempre hay una instantánea completa.
+//  NOTA: Los números se guardan en el orden de bytes del procesador; la cabecera incluye una marca para rechazar archivos de otro orden.
+
+// Firma y versión del formato.
+#define FIRMA_INSTANTANEA "VIDAINST"
+#define VERSION_INSTANTANEA 1u
+// Marca para detectar un orden de bytes distinto.
+#define MARCA_ORDEN_BYTES 0x01020304u
+// Indicador de instantánea comprimida (solo con los bloques no vacíos).
+#define INDICADOR_COMPRIMIDA 1u
+// Palabras de cada bloque de la compresión (512 bytes).
+#define PALABRAS_POR_BLOQUE 64
+// Tamaño del buffer de escritura de los archivos.
+#define TAMANO_BUFFER_ESCRITURA (1 << 16)
+
+// Definición de la cabecera de una instantánea (128 bytes, sin relleno entre los campos).
+typedef struct {
+    char firma[8];                      // FIRMA_INSTANTANEA (sin '\0')
+    uint32_t version;                   // VERSION_INSTANTANEA
+    uint32_t marcaOrden;                // MARCA_ORDEN_BYTES
+    uint32_t ancho;                     // Dimensiones de la cuadrícula
+    uint32_t alto;
+    uint64_t numGeneracion;             // Generación guardada
+    uint32_t indicadores;               // INDICADOR_COMPRIMIDA
+    uint32_t reservado;                 // 0
+    uint64_t palabrasPorFila;           // Palabras de cada fila
+    uint64_t palabrasDatos;             // Palabras después de la cabecera
+    uint64_t sumaVerificacion;          // Suma de la cabecera (con este campo en 0) y de los datos
+    char regla[LONGITUD_MAXIMA_REGLA];  // Regla (terminada en '\0')
+} CabeceraInstantanea;
+
+_Static_assert(sizeof(CabeceraInstantanea) == 128, "La cabecera de las instantáneas debe medir 128 bytes");
+
+// Definición del hilo que escribe las instantáneas en segundo plano.
+struct EscritorInstantaneas {
+    BufferTriple* buffer;       // Instantáneas copiadas por la simulación (la más reciente se escribe)
+    char* ruta;                 // Archivo de destino
+    char regla[LONGITUD_MAXIMA_REGLA]; // Regla que se guarda en cada instantánea
+    pthread_t hilo;             // Hilo escritor
+    pthread_mutex_t mutex;      // Protege los campos siguientes
+    pthread_cond_t condTrabajo; // Señala al hilo escritor que hay una instantánea nueva (o que debe terminar)
+    pthread_cond_t condTerminada; // Señala que el hilo escritor no tiene trabajo pendiente
+    bool pendiente;             // Hay una instantánea publicada que el hilo escritor aún no tomó
+    bool escribiendo;           // El hilo escritor está escribiendo una instantánea
+    bool salir;                 // Indica al hilo escritor que debe terminar
+    bool error;                 // Alguna instantánea no se pudo escribir
+    uint64_t escritas;          // Instantáneas escritas
+};
+
+// Función para acumular una palabra en la suma de verificación (mezcla de 64 bits, sensible al orden de las palabras).
+static inline uint64_t acumularSuma(uint64_t suma, uint64_t palabra) {
+    suma ^= palabra * 0x9E3779B97F4A7C15ULL;
+    suma = (suma << 31) | (suma >> 33);
+    return suma * 0xBF58476D1CE4E5B9ULL;
+}
+
+// Función para acumular en la suma de verificación un bloque de palabras.
+static uint64_t acumularSumaPalabras(uint64_t suma, const uint64_t* palabras, size_t numPalabras) {
+    for (size_t i = 0; i < numPalabras; i++) {
+        suma = acumularSuma(suma, palabras[i]);
+    }
+    return suma;
+}
+
+// Función para acumular en la suma de verificación la cabecera (con el campo de la suma en 0).
+static uint64_t acumularSumaCabecera(uint64_t suma, const CabeceraInstantanea* cabecera) {
+    CabeceraInstantanea copia = *cabecera;
+    copia.sumaVerificacion = 0;
+    uint64_t palabras[sizeof(CabeceraInstantanea) / sizeof(uint64_t)];
+    memcpy(palabras, &copia, sizeof(copia));
+    return acumularSumaPalabras(suma, palabras, sizeof(palabras) / sizeof(uint64_t));
+}
+
+// Función para obtener la palabra i de las células de un fotograma, contando las filas una tras otra (sin relleno entre ellas).
+static inline uint64_t obtenerPalabraFotograma(const Fotograma* fotograma, size_t palabrasPorFila, size_t i) {
+    return FILA_FOTOGRAMA(fotograma, i / palabrasPorFila)[i % palabrasPorFila];
+}
+
+// Función para escribir palabras en el archivo y acumularlas en la suma de verificación.
+static void escribirPalabras(FILE* archivo, const uint64_t* palabras, size_t numPalabras, uint64_t* suma) {
+    fwrite(palabras, sizeof(uint64_t), numPalabras, archivo);
+    *suma = acumularSumaPalabras(*suma, palabras, numPalabras);
+}
+
+// Función para escribir las células del fotograma (comprimidas o no) a continuación de la cabecera. Retorna la suma de verificación de los datos.
+static uint64_t escribirDatos(FILE* archivo, const Fotograma* fotograma, size_t palabrasPorFila, const uint64_t* mapaBloques, uint64_t suma) {
+    size_t totalPalabras = (size_t)fotograma->alto * palabrasPorFila;
+    uint64_t bloque[PALABRAS_POR_BLOQUE];
+    if (mapaBloques != NULL) {
+        size_t numBloques = (totalPalabras + PALABRAS_POR_BLOQUE - 1) / PALABRAS_POR_BLOQUE;
+        escribirPalabras(archivo, mapaBloques, (numBloques + BITS_POR_PALABRA - 1) / BITS_POR_PALABRA, &suma);
+    }
+    // Copiamos las células por bloques (un bloque puede abarcar varias filas), omitiendo los vacíos si hay mapa de bloques.
+    for (size_t inicio = 0, b = 0; inicio < totalPalabras; inicio += PALABRAS_POR_BLOQUE, b++) {
+        if (mapaBloques != NULL && (mapaBloques[b / BITS_POR_PALABRA] & ((uint64_t)1 << (b % BITS_POR_PALABRA))) == 0) {
+            continue;
+        }
+        size_t numPalabras = (totalPalabras - inicio < PALABRAS_POR_BLOQUE) ? totalPalabras - inicio : PALABRAS_POR_BLOQUE;
+        for (size_t i = 0; i < numPalabras; i++) {
+            bloque[i] = obtenerPalabraFotograma(fotograma, palabrasPorFila, inicio + i);
+        }
+        escribirPalabras(archivo, bloque, numPalabras, &suma);
+    }
+    return suma;
+}
+
+// Función para guardar un fotograma en una instantánea, con la regla indicada (NULL = REGLA_CONWAY). Los bloques vacíos se omiten si así el archivo es más pequeño. El archivo se reemplaza de forma atómica (nunca queda una instantánea a medio escribir). Retorna false si no se pudo escribir.
+bool guardarInstantanea(const Fotograma* fotograma, const char* ruta, const char* regla) {
+    if (fotograma == NULL || ruta == NULL) {
+        return false;
+    }
+    size_t palabrasPorFila = PALABRAS_POR_FILA(fotograma->ancho);
+    size_t totalPalabras = (size_t)fotograma->alto * palabrasPorFila;
+    size_t numBloques = (totalPalabras + PALABRAS_POR_BLOQUE - 1) / PALABRAS_POR_BLOQUE;
+    size_t palabrasMapa = (numBloques + BITS_POR_PALABRA - 1) / BITS_POR_PALABRA;
+
+    // Buscamos los bloques no vacíos, y comprimimos solo si el mapa y esos bloques ocupan menos que todas las células.
+    uint64_t* mapaBloques = (uint64_t*)calloc(palabrasMapa + 1, sizeof(uint64_t));
+    if (mapaBloques == NULL) {
+        return false;
+    }
+    size_t palabrasComprimidas = palabrasMapa;
+    for (size_t inicio = 0, b = 0; inicio < totalPalabras; inicio += PALABRAS_POR_BLOQUE, b++) {
+        size_t numPalabras = (totalPalabras - inicio < PALABRAS_POR_BLOQUE) ? totalPalabras - inicio : PALABRAS_POR_BLOQUE;
+        uint64_t bits = 0;
+        for (size_t i = 0; i < numPalabras; i++) {
+            bits |= obtenerPalabraFotograma(fotograma, palabrasPorFila, inicio + i);
+        }
+        if (bits != 0) {
+            mapaBloques[b / BITS_POR_PALABRA] |= (uint64_t)1 << (b % BITS_POR_PALABRA);
+            palabrasComprimidas += numPalabras;
+        }
+    }
+    bool comprimir = palabrasComprimidas < totalPalabras;
+
+    CabeceraInstantanea cabecera;
+    memset(&cabecera, 0, sizeof(cabecera));
+    memcpy(cabecera.firma, FIRMA_INSTANTANEA, sizeof(cabecera.firma));
+    cabecera.version = VERSION_INSTANTANEA;
+    cabecera.marcaOrden = MARCA_ORDEN_BYTES;
+    cabecera.ancho = fotograma->ancho;
+    cabecera.alto = fotograma->alto;
+    cabecera.numGeneracion = fotograma->numGeneracion;
+    cabecera.indicadores = comprimir ? INDICADOR_COMPRIMIDA : 0;
+    cabecera.palabrasPorFila = palabrasPorFila;
+    cabecera.palabrasDatos = comprimir ? palabrasComprimidas : totalPalabras;
+    snprintf(cabecera.regla, sizeof(cabecera.regla), "%s", (regla != NULL) ? regla : REGLA_CONWAY);
+
+    // Escribimos en un archivo temporal; la cabecera se vuelve a escribir al final, con la suma de verificación de los datos.
+    size_t longitudRuta = strlen(ruta);
+    char* rutaTemporal = (char*)malloc(longitudRuta + 5);
+    if (rutaTemporal == NULL) {
+        free(mapaBloques);
+        return false;
+    }
+    memcpy(rutaTemporal, ruta, longitudRuta);
+    memcpy(rutaTemporal + longitudRuta, ".tmp", 5);
+    FILE* archivo = fopen(rutaTemporal, "wb");
+    bool exito = archivo != NULL;
+    if (exito) {
+        setvbuf(archivo, NULL, _IOFBF, TAMANO_BUFFER_ESCRITURA);
+        fwrite(&cabecera, sizeof(cabecera), 1, archivo);
+        uint64_t suma = escribirDatos(archivo, fotograma, palabrasPorFila, comprimir ? mapaBloques : NULL, acumularSumaCabecera(0, &cabecera));
+        cabecera.sumaVerificacion = suma;
+        exito = fseek(archivo, 0, SEEK_SET) == 0 && fwrite(&cabecera, sizeof(cabecera), 1, archivo) == 1;
+        // Nos aseguramos de que los datos lleguen al disco antes de reemplazar la instantánea anterior.
+        exito = exito && fflush(archivo) == 0 && !ferror(archivo) && fsync(fileno(archivo)) == 0;
+        exito = (fclose(archivo) == 0) && exito;
+        exito = exito && rename(rutaTemporal, ruta) == 0;
+        if (!exito) {
+            remove(rutaTemporal);
+        }
+    }
+    free(rutaTemporal);
+    free(mapaBloques);
+    return exito;
+}
+
+// Función para validar la cabecera de una instantánea proyectada en memoria (dimensiones, tamaño y suma de verificación). Retorna false si no es válida.
+static bool validarInstantanea(const CabeceraInstantanea* cabecera, size_t tamano) {
+    if (memcmp(cabecera->firma, FIRMA_INSTANTANEA, sizeof(cabecera->firma)) != 0 || cabecera->version != VERSION_INSTANTANEA ||
+        cabecera->marcaOrden != MARCA_ORDEN_BYTES || cabecera->ancho == 0 || cabecera->alto == 0 ||
+        cabecera->ancho > DIMENSION_MAXIMA || cabecera->alto > DIMENSION_MAXIMA || cabecera->palabrasPorFila != PALABRAS_POR_FILA(cabecera->ancho) ||
+        memchr(cabecera->regla, '\0', sizeof(cabecera->regla)) == NULL) {
+        return false;
+    }
+    // El tamaño de los datos debe coincidir con el del archivo y con lo que indica la cabecera.
+    size_t totalPalabras = (size_t)cabecera->alto * cabecera->palabrasPorFila;
+    if (cabecera->palabrasDatos != (tamano - sizeof(CabeceraInstantanea)) / sizeof(uint64_t) ||
+        (tamano - sizeof(CabeceraInstantanea)) % sizeof(uint64_t) != 0) {
+        return false;
+    }
+    const uint64_t* datos = (const uint64_t*)(cabecera + 1);
+    if ((cabecera->indicadores & INDICADOR_COMPRIMIDA) == 0) {
+        if (cabecera->palabrasDatos != totalPalabras) {
+            return false;
+        }
+    } else {
+        // Con compresión, los datos son el mapa de bloques y los bloques marcados (el último puede ser más corto).
+        size_t numBloques = (totalPalabras + PALABRAS_POR_BLOQUE - 1) / PALABRAS_POR_BLOQUE;
+        size_t palabrasMapa = (numBloques + BITS_POR_PALABRA - 1) / BITS_POR_PALABRA;
+        if (cabecera->palabrasDatos < palabrasMapa) {
+            return false;
+        }
+        size_t palabrasBloques = 0;
+        for (size_t b = 0; b < numBloques; b++) {
+            if (datos[b / BITS_POR_PALABRA] & ((uint64_t)1 << (b % BITS_POR_PALABRA))) {
+                palabrasBloques += (b + 1 < numBloques) ? PALABRAS_POR_BLOQUE : totalPalabras - b * PALABRAS_POR_BLOQUE;
+            }
+        }
+        if (palabrasMapa + palabrasBloques != cabecera->palabrasDatos) {
+            return false;
+        }
+    }
+    uint64_t suma = acumularSumaPalabras(acumularSumaCabecera(0, cabecera), datos, cabecera->palabrasDatos);
+    return suma == cabecera->sumaVerificacion;
+}
+
+// Función para crear una cuadrícula a partir de una instantánea, en la generación guardada. Si info no es NULL, se completa con la información de la instantánea. Retorna NULL si el archivo no existe, no es una instantánea válida (o está dañada) o no hay memoria suficiente.
+Cuadricula* cargarInstantanea(const char* ruta, InfoInstantanea* info) {
+    int descriptor = open(ruta, O_RDONLY);
+    if (descriptor < 0) {
+        return NULL;
+    }
+    struct stat estado;
+    if (fstat(descriptor, &estado) != 0 || (size_t)estado.st_size < sizeof(CabeceraInstantanea)) {
+        close(descriptor);
+        return NULL;
+    }
+    size_t tamano = (size_t)estado.st_size;
+    void* proyeccion = mmap(NULL, tamano, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor); // La proyección sigue siendo válida después de cerrar el descriptor.
+    if (proyeccion == MAP_FAILED) {
+        return NULL;
+    }
+    madvise(proyeccion, tamano, MADV_SEQUENTIAL);
+    const CabeceraInstantanea* cabecera = (const CabeceraInstantanea*)proyeccion;
+    if (!validarInstantanea(cabecera, tamano)) {
+        munmap(proyeccion, tamano);
+        return NULL;
+    }
+
+    // Con 0% de células vivas, la cuadrícula se crea vacía (sin generar números aleatorios). Si la regla guardada no es una regla B/S válida, se calcula con B3/S23.
+    Regla regla;
+    Cuadricula* cuadricula = crearCuadriculaConRegla((uint32_t)cabecera->ancho, (uint32_t)cabecera->alto, 0, 0,
+        compilarRegla(cabecera->regla, &regla) ? &regla : NULL);
+    uint64_t* fila = (uint64_t*)malloc(cabecera->palabrasPorFila * sizeof(uint64_t));
+    if (cuadricula == NULL || fila == NULL) {
+        liberarCuadricula(cuadricula);
+        free(fila);
+        munmap(proyeccion, tamano);
+        return NULL;
+    }
+    const uint64_t* datos = (const uint64_t*)(cabecera + 1);
+    size_t palabrasPorFila = cabecera->palabrasPorFila;
+    if ((cabecera->indicadores & INDICADOR_COMPRIMIDA) == 0) {
+        // Sin compresión, cada fila se copia directamente desde la proyección.
+        for (uint32_t y = 0; y < cuadricula->alto; y++) {
+            establecerFilaCuadricula(cuadricula, y, datos + (size_t)y * palabrasPorFila);
+        }
+    } else {
+        // Con compresión, reconstruimos cada fila tomando las palabras de los bloques guardados (los omitidos son 0).
+        size_t totalPalabras = (size_t)cabecera->alto * palabrasPorFila;
+        size_t numBloques = (totalPalabras + PALABRAS_POR_BLOQUE - 1) / PALABRAS_POR_BLOQUE;
+        const uint64_t* mapaBloques = datos;
+        const uint64_t* siguienteBloque = datos + (numBloques + BITS_POR_PALABRA - 1) / BITS_POR_PALABRA;
+        const uint64_t* bloqueActual = NULL;
+        for (size_t i = 0; i < totalPalabras; i++) {
+            size_t b = i / PALABRAS_POR_BLOQUE;
+            if (i % PALABRAS_POR_BLOQUE == 0) {
+                bool guardado = (mapaBloques[b / BITS_POR_PALABRA] & ((uint64_t)1 << (b % BITS_POR_PALABRA))) != 0;
+                bloqueActual = guardado ? siguienteBloque : NULL;
+                siguienteBloque += guardado ? PALABRAS_POR_BLOQUE : 0;
+            }
+            fila[i % palabrasPorFila] = (bloqueActual != NULL) ? bloqueActual[i % PALABRAS_POR_BLOQUE] : 0;
+            if (i % palabrasPorFila == palabrasPorFila - 1) {
+                establecerFilaCuadricula(cuadricula, (uint32_t)(i / palabrasPorFila), fila);
+            }
+        }
+    }
+    cuadricula->numGeneracion = cabecera->numGeneracion;
+    if (info != NULL) {
+        info->ancho = cabecera->ancho;
+        info->alto = cabecera->alto;
+        info->numGeneracion = cabecera->numGeneracion;
+        info->comprimida = (cabecera->indicadores & INDICADOR_COMPRIMIDA) != 0;
+        snprintf(info->regla, sizeof(info->regla), "%s", cabecera->regla);
+    }
+    free(fila);
+    munmap(proyeccion, tamano);
+    return cuadricula;
+}
+
+// Función principal del hilo escritor.
+static void* ejecutarHiloEscritor(void* argumento) {
+    EscritorInstantaneas* escritor = (EscritorInstantaneas*)argumento;
+    pthread_mutex_lock(&escritor->mutex);
+    while (true) {
+        while (!escritor->salir && !escritor->pendiente) {
+            pthread_cond_wait(&escritor->condTrabajo, &escritor->mutex);
+        }
+        if (!escritor->pendiente) {
+            break; // Solo se termina cuando no quedan instantáneas pendientes.
+        }
+        escritor->pendiente = false;
+        escritor->escribiendo = true;
+        pthread_mutex_unlock(&escritor->mutex);
+
+        // Tomamos la instantánea publicada más reciente y la escribimos sin el mutex, para que la simulación pueda publicar otra mientras tanto.
+        // Si ya la escribimos (se publicó antes de tomar el aviso anterior), no la repetimos.
+        bool nueva;
+        const Fotograma* fotograma = obtenerUltimoFotograma(escritor->buffer, &nueva);
+        bool exito = !nueva || guardarInstantanea(fotograma, escritor->ruta, escritor->regla);
+
+        pthread_mutex_lock(&escritor->mutex);
+        escritor->escribiendo = false;
+        escritor->error = escritor->error || !exito;
+        escritor->escritas += (nueva && exito) ? 1 : 0;
+        pthread_cond_broadcast(&escritor->condTerminada);
+    }
+    pthread_mutex_unlock(&escritor->mutex);
+    return NULL;
+}
+
+// Función para crear un hilo que escribe en segundo plano las instantáneas de una cuadrícula de las dimensiones indicadas en el archivo ruta, con la regla indicada (NULL = REGLA_CONWAY). Retorna NULL si no se pudo crear el hilo.
+EscritorInstantaneas* crearEscritorInstantaneas(uint32_t ancho, uint32_t alto, const char* ruta, const char* regla) {
+    if (ruta == NULL) {
+        return NULL;
+    }
+    EscritorInstantaneas* escritor = (EscritorInstantaneas*)calloc(1, sizeof(EscritorInstantaneas));
+    if (escritor == NULL) {
+        return NULL;
+    }
+    escritor->buffer = crearBufferTriple(ancho, alto);
+    escritor->ruta = strdup(ruta);
+    snprintf(escritor->regla, sizeof(escritor->regla), "%s", (regla != NULL) ? regla : REGLA_CONWAY);
+    if (escritor->buffer == NULL || escritor->ruta == NULL) {
+        liberarBufferTriple(escritor->buffer);
+        free(escritor->ruta);
+        free(escritor);
+        return NULL;
+    }
+    pthread_mutex_init(&escritor->mutex, NULL);
+    pthread_cond_init(&escritor->condTrabajo, NULL);
+    pthread_cond_init(&escritor->condTerminada, NULL);
+    if (pthread_create(&escritor->hilo, NULL, ejecutarHiloEscritor, escritor) != 0) {
+        pthread_cond_destroy(&escritor->condTerminada);
+        pthread_cond_destroy(&escritor->condTrabajo);
+        pthread_mutex_destroy(&escritor->mutex);
+        liberarBufferTriple(escritor->buffer);
+        free(escritor->ruta);
+        free(escritor);
+        return NULL;
+    }
+    return escritor;
+}
+
+// Función para copiar la generación actual de la cuadrícula y pedir que se escriba en segundo plano (no espera a la escritura). Si aún no se escribió la instantánea anterior, se reemplaza por esta.
+void solicitarInstantanea(EscritorInstantaneas* escritor, Cuadricula* cuadricula) {
+    if (escritor == NULL || cuadricula == NULL) {
+        return;
+    }
+    // La copia y la publicación no usan el mutex: el buffer triple nunca hace esperar a quien escribe.
+    capturarFotograma(obtenerFotogramaEscritura(escritor->buffer), cuadricula);
+    publicarFotograma(escritor->buffer);
+    pthread_mutex_lock(&escritor->mutex);
+    escritor->pendiente = true;
+    pthread_cond_signal(&escritor->condTrabajo);
+    pthread_mutex_unlock(&escritor->mutex);
+}
+
+// Función para esperar a que se escriban las instantáneas pedidas. Retorna false si alguna no se pudo escribir.
+bool esperarInstantaneas(EscritorInstantaneas* escritor) {
+    if (escritor == NULL) {
+        return true;
+    }
+    pthread_mutex_lock(&escritor->mutex);
+    while (escritor->pendiente || escritor->escribiendo) {
+        pthread_cond_wait(&escritor->condTerminada, &escritor->mutex);
+    }
+    bool exito = !escritor->error;
+    pthread_mutex_unlock(&escritor->mutex);
+    return exito;
+}
+
+// Función para obtener el número de instantáneas escritas hasta el momento.
+uint64_t contarInstantaneasEscritas(EscritorInstantaneas* escritor) {
+    if (escritor == NULL) {
+        return 0;
+    }
+    pthread_mutex_lock(&escritor->mutex);
+    uint64_t escritas = escritor->escritas;
+    pthread_mutex_unlock(&escritor->mutex);
+    return escritas;
+}
+
+// Función para esperar las instantáneas pendientes, detener el hilo y liberar sus recursos.
+void liberarEscritorInstantaneas(EscritorInstantaneas* escritor) {
+    if (escritor == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&escritor->mutex);
+    escritor->salir = true;
+    pthread_cond_signal(&escritor->condTrabajo);
+    pthread_mutex_unlock(&escritor->mutex);
+    pthread_join(escritor->hilo, NULL);
+
+    pthread_cond_destroy(&escritor->condTerminada);
+    pthread_cond_destroy(&escritor->condTrabajo);
+    pthread_mutex_destroy(&escritor->mutex);
+    liberarBufferTriple(escritor->buffer);
+    free(escritor->ruta);
+    free(escritor);
+}
@@ -1,3 +1,5 @@
+#include <stdlib.h>
+#include <string.h>
 #include <ncurses.h>
 #include <locale.h>
 #include "../include/interface.h"
@@ -19,6 +21,19 @@
 //      - Las funciones de dibujo de ncurses no se muestran inmediatamente en pantalla, sino que se almacenan en un buffer.
 //      - Esto permite evitar 'parpadeos' y mejorar el rendimiento.
 //      - La función actualizarPantalla() refresca la ventana para reflejar los cambios realizados en el buffer.
+//
+// 3. Dibujo Diferencial
+//      - Se guarda una copia empaquetada (1 bit por célula) de lo último que se dibujó, y en cada cuadro solo se escriben las células que cambiaron.
+//      - Las filas se comparan de 64 en 64 células con XOR, leyendo directamente las filas empaquetadas de la cuadrícula (sin copiarlas).
+//      - Las células cambiadas y cercanas se agrupan en tramos que se escriben con una sola llamada, por lo que el costo de dibujar depende de la actividad y no del área visible.
+//
+// 4. Vista con Desplazamiento y Zoom
+//      - La vista elige la región de la cuadrícula que se dibuja (flechas) y su nivel de detalle (zoom), por lo que se puede recorrer una cuadrícula más grande que la terminal.
+//      - En el nivel 0 cada carácter es una célula. Las filas se leen desplazadas a nivel de bits, de 64 en 64 células, desde la columna de la vista.
+//      - En los niveles alejados cada carácter es un patrón braille de 2x4 puntos, y cada punto se enciende si su bloque de células tiene alguna viva (contada con popcount
+//        sobre las palabras empaquetadas). En los bloques grandes solo se leen FILAS_MUESTRA_BLOQUE filas y PALABRAS_MUESTRA_BLOQUE palabras por fila, repartidas a lo largo
+//        del bloque, de modo que el costo de cada cuadro depende del tamaño de la terminal y no del de la cuadrícula (a cambio, un patrón pequeño y aislado puede no verse).
+//      - Los patrones braille también se dibujan de forma diferencial: solo se escriben los caracteres que cambiaron desde el último cuadro.
 
 // Macros para definir la representación visual de las células vivas y muertas en la interfaz de usuario.
 #define CELULA_VIVA "█"
@@ -31,12 +46,61 @@
 #define FILA_SEPARADOR 1            // Fila donde se dibuja la línea separadora debajo del título.
 #define POSICION_BORDE_IZQUIERDO 0  // Columna del borde izquierdo de la ventana.
 #define ANCHO_BORDE 1               // Ancho del borde de la ventana.
-#define ALTURA_PANEL_INFERIOR 3     // Altura total del panel inferior (separador, estado y controles).
+#define ALTURA_PANEL_INFERIOR 4     // Altura total del panel inferior (separador, estado, métricas y controles).
 
 // Macros para definir la disposición de la cuadrícula dentro de la ventana.
 #define INICIO_CUADRICULA_Y 2   // Fila de inicio de la cuadrícula.
 #define INICIO_CUADRICULA_X 1   // Columna de inicio de la cuadrícula, con margen izquierdo.
 
+// Macros para el dibujo diferencial.
+#define SEPARACION_MAXIMA_TRAMO 8   // Dos células cambiadas a esta distancia o menos se escriben en el mismo tramo (reescribiendo las intermedias).
+#define BYTES_MAXIMOS_CELULA 4      // Bytes máximos de CELULA_VIVA, CELULA_MUERTA y de un carácter braille en UTF-8.
+
+// Macros para el resumen de los bloques de células en los niveles de zoom alejados.
+#define PUNTOS_ANCHO_BRAILLE 2      // Columnas de puntos de un carácter braille.
+#define PUNTOS_ALTO_BRAILLE 4       // Filas de puntos de un carácter braille.
+#define FILAS_MUESTRA_BLOQUE 4      // Filas que se leen, como máximo, de cada bloque.
+#define PALABRAS_MUESTRA_BLOQUE 4   // Palabras que se leen, como máximo, de cada fila de un bloque.
+#define BRAILLE_VACIO " "           // Carácter de un patrón braille sin puntos (U+2800 se ve distinto en algunas fuentes).
+
+// Tamaño del texto de cada fila del panel inferior (antes de recortarlo al ancho de la ventana).
+#define TAMANO_TEXTO_PANEL 256
+
+// Bit de cada punto de un carácter braille (U+2800 + bits), según su fila y columna dentro del carácter.
+static const uint8_t PUNTOS_BRAILLE[PUNTOS_ALTO_BRAILLE][PUNTOS_ANCHO_BRAILLE] = {
+    {0x01, 0x08},
+    {0x02, 0x10},
+    {0x04, 0x20},
+    {0x40, 0x80}
+};
+
+// Último dibujo de la cuadrícula, usado para escribir solo las células (o los caracteres braille) que cambiaron.
+static struct {
+    WINDOW* ventana;            // Ventana donde se dibujó
+    int alto;                   // Caracteres del área visible dibujada
+    int ancho;
+    int nivel;                  // Vista con que se dibujó
+    int64_t x;
+    int64_t y;
+    size_t palabrasPorFila;     // Palabras de 64 bits por fila del dibujo (nivel 0)
+    uint64_t* celulas;          // Células dibujadas en el nivel 0, empaquetadas como en la cuadrícula
+    uint64_t* filaVisible;      // Buffer para la fila visible actual (nivel 0)
+    uint8_t* patrones;          // Patrones braille dibujados en los niveles alejados (uno por carácter)
+    uint8_t* patronesFila;      // Buffer para los patrones de la fila actual (niveles alejados)
+    char* texto;                // Buffer para armar el texto de cada tramo
+    bool completo;              // Indica si el siguiente dibujo debe escribir todas las células
+} dibujoAnterior;
+
+// Función para liberar el dibujo anterior, de modo que la siguiente llamada a dibujarCuadricula redibuje todas las células.
+static void liberarDibujoAnterior(void) {
+    free(dibujoAnterior.celulas);
+    free(dibujoAnterior.filaVisible);
+    free(dibujoAnterior.patrones);
+    free(dibujoAnterior.patronesFila);
+    free(dibujoAnterior.texto);
+    memset(&dibujoAnterior, 0, sizeof(dibujoAnterior));
+}
+
 // Función para inicializar la interfaz de usuario (a través de una ventana de ncurses).
 void inicializarInterfaz(void) {
     setlocale(LC_ALL, "");  // Configura la localización para permitir caracteres especiales.
@@ -70,6 +134,7 @@ WINDOW* crearVentana(void) {
         return NULL; // Retorna NULL si no se pudo crear la ventana.
     }
     nodelay(ventana, TRUE); // Configura la ventana para que no bloquee la ejecución del programa al esperar una tecla.
+    keypad(ventana, TRUE);  // Habilita la captura de las flechas en la ventana (que se usan para desplazar la vista).
     box(ventana, 0, 0);     // Dibujamos un borde alrededor de la ventana.
 
     // Añadimos el título en la parte superior de la ventana.
@@ -95,42 +160,338 @@ WINDOW* crearVentana(void) {
 // Función para eliminar una ventana de ncurses y liberar sus recursos.
 void cerrarVentana(WINDOW* ventana) {
     if (ventana != NULL) {
+        // Descartamos el último dibujo si corresponde a esta ventana.
+        if (dibujoAnterior.ventana == ventana) {
+            liberarDibujoAnterior();
+        }
         delwin(ventana); // Elimina la ventana y libera sus recursos.
     }
 }
 
-// Función para dibujar la cuadrícula en la ventana de ncurses.
-void dibujarCuadricula(WINDOW* ventana, Cuadricula* cuadricula) {
+// Función para obtener las células que abarca un carácter en el nivel de zoom indicado, en un eje donde el carácter tiene el número de puntos indicado.
+static int64_t celulasPorCaracter(int nivel, int puntos) {
+    return (nivel == 0) ? 1 : (int64_t)puntos << (nivel - 1);
+}
+
+// Función para preparar el dibujo anterior para un área visible de alto x ancho caracteres en la ventana, con la vista indicada. Si cambió la ventana, el área o la vista, el dibujo anterior se descarta y se limpia el área disponible de la ventana (de alturaDisponible x anchoDisponible caracteres). Retorna false si no hay memoria suficiente.
+static bool prepararDibujoAnterior(WINDOW* ventana, int alto, int ancho, const Vista* vista, int alturaDisponible, int anchoDisponible) {
+    if (dibujoAnterior.ventana == ventana && dibujoAnterior.alto == alto && dibujoAnterior.ancho == ancho &&
+        dibujoAnterior.nivel == vista->nivel && dibujoAnterior.x == vista->x && dibujoAnterior.y == vista->y) {
+        return true;
+    }
+    // Si solo cambió la vista (en la misma ventana), el nuevo dibujo puede ocupar menos que el anterior, por lo que limpiamos el área disponible.
+    if (dibujoAnterior.ventana == ventana) {
+        for (int y = 0; y < alturaDisponible; y++) {
+            mvwhline(ventana, INICIO_CUADRICULA_Y + y, INICIO_CUADRICULA_X, ' ', anchoDisponible);
+        }
+    }
+    liberarDibujoAnterior();
+    size_t palabrasPorFila = PALABRAS_POR_FILA(ancho);
+    dibujoAnterior.celulas = (uint64_t*)calloc((size_t)alto * palabrasPorFila + 1, sizeof(uint64_t));
+    dibujoAnterior.filaVisible = (uint64_t*)calloc(palabrasPorFila, sizeof(uint64_t));
+    dibujoAnterior.patrones = (uint8_t*)calloc((size_t)alto * (size_t)ancho, sizeof(uint8_t));
+    dibujoAnterior.patronesFila = (uint8_t*)calloc((size_t)ancho, sizeof(uint8_t));
+    dibujoAnterior.texto = (char*)malloc((size_t)ancho * BYTES_MAXIMOS_CELULA + 1);
+    if (dibujoAnterior.celulas == NULL || dibujoAnterior.filaVisible == NULL || dibujoAnterior.patrones == NULL ||
+        dibujoAnterior.patronesFila == NULL || dibujoAnterior.texto == NULL) {
+        liberarDibujoAnterior();
+        return false;
+    }
+    dibujoAnterior.ventana = ventana;
+    dibujoAnterior.alto = alto;
+    dibujoAnterior.ancho = ancho;
+    dibujoAnterior.nivel = vista->nivel;
+    dibujoAnterior.x = vista->x;
+    dibujoAnterior.y = vista->y;
+    dibujoAnterior.palabrasPorFila = palabrasPorFila;
+    dibujoAnterior.completo = true;
+    return true;
+}
+
+// Función para dibujar las células [inicio, fin] de la fila visible y con una sola escritura.
+static void dibujarTramo(WINDOW* ventana, const uint64_t* fila, int y, int inicio, int fin) {
+    char* texto = dibujoAnterior.texto;
+    size_t longitud = 0;
+    for (int x = inicio; x <= fin; x++) {
+        const char* caracterCelula = ((fila[x / BITS_POR_PALABRA] >> (x % BITS_POR_PALABRA)) & 1u) ? CELULA_VIVA : CELULA_MUERTA;
+        size_t bytes = strlen(caracterCelula);
+        memcpy(texto + longitud, caracterCelula, bytes);
+        longitud += bytes;
+    }
+    texto[longitud] = '\0';
+    mvwaddstr(ventana, INICIO_CUADRICULA_Y + y, INICIO_CUADRICULA_X + inicio, texto);
+}
+
+// Función para dibujar los caracteres braille [inicio, fin] de la fila y con una sola escritura.
+static void dibujarTramoBraille(WINDOW* ventana, const uint8_t* patrones, int y, int inicio, int fin) {
+    char* texto = dibujoAnterior.texto;
+    size_t longitud = 0;
+    for (int x = inicio; x <= fin; x++) {
+        if (patrones[x] == 0) {
+            memcpy(texto + longitud, BRAILLE_VACIO, strlen(BRAILLE_VACIO));
+            longitud += strlen(BRAILLE_VACIO);
+        } else {
+            // U+2800 + patrón, codificado en UTF-8 (3 bytes).
+            texto[longitud++] = (char)0xE2;
+            texto[longitud++] = (char)(0xA0 | (patrones[x] >> 6));
+            texto[longitud++] = (char)(0x80 | (patrones[x] & 0x3F));
+        }
+    }
+    texto[longitud] = '\0';
+    mvwaddstr(ventana, INICIO_CUADRICULA_Y + y, INICIO_CUADRICULA_X + inicio, texto);
+}
+
+// Función para copiar en destino (de numPalabras palabras) las células de la fila a partir de la columna inicio, desplazando los bits para que la columna inicio quede en el bit 0. La fila tiene palabrasFila palabras; las células posteriores al final de la fila quedan en 0.
+static void extraerFilaVisible(const uint64_t* fila, size_t palabrasFila, uint64_t inicio, uint64_t* destino, size_t numPalabras) {
+    size_t primeraPalabra = (size_t)(inicio / BITS_POR_PALABRA);
+    unsigned desplazamiento = (unsigned)(inicio % BITS_POR_PALABRA);
+    for (size_t p = 0; p < numPalabras; p++) {
+        size_t palabra = primeraPalabra + p;
+        uint64_t valor = (palabra < palabrasFila) ? fila[palabra] >> desplazamiento : 0;
+        if (desplazamiento != 0 && palabra + 1 < palabrasFila) {
+            valor |= fila[palabra + 1] << (BITS_POR_PALABRA - desplazamiento);
+        }
+        destino[p] = valor;
+    }
+}
+
+// Función para contar las células vivas de las columnas [inicio, inicio + longitud) de una fila empaquetada. Si el tramo abarca más de PALABRAS_MUESTRA_BLOQUE palabras, solo se cuentan PALABRAS_MUESTRA_BLOQUE palabras repartidas a lo largo del tramo, para que el costo no dependa del nivel de zoom.
+static uint64_t contarTramoFila(const uint64_t* fila, uint64_t inicio, uint64_t longitud) {
+    size_t primeraPalabra = (size_t)(inicio / BITS_POR_PALABRA);
+    size_t ultimaPalabra = (size_t)((inicio + longitud - 1) / BITS_POR_PALABRA);
+    size_t numPalabras = ultimaPalabra - primeraPalabra + 1;
+    if (numPalabras > PALABRAS_MUESTRA_BLOQUE) {
+        // Muestreamos palabras completas del interior del tramo (entre la primera y la última, que son parciales).
+        uint64_t vivas = 0;
+        for (size_t k = 0; k < PALABRAS_MUESTRA_BLOQUE; k++) {
+            vivas += (uint64_t)__builtin_popcountll(fila[primeraPalabra + 1 + k * (numPalabras - 2) / PALABRAS_MUESTRA_BLOQUE]);
+        }
+        return vivas;
+    }
+    uint64_t mascaraInicio = ~(uint64_t)0 << (inicio % BITS_POR_PALABRA);
+    unsigned bitsFinales = (unsigned)((inicio + longitud) % BITS_POR_PALABRA);
+    uint64_t mascaraFin = (bitsFinales == 0) ? ~(uint64_t)0 : ((uint64_t)1 << bitsFinales) - 1;
+    uint64_t vivas = 0;
+    for (size_t p = primeraPalabra; p <= ultimaPalabra; p++) {
+        uint64_t palabra = fila[p];
+        if (p == primeraPalabra) {
+            palabra &= mascaraInicio;
+        }
+        if (p == ultimaPalabra) {
+            palabra &= mascaraFin;
+        }
+        vivas += (uint64_t)__builtin_popcountll(palabra);
+    }
+    return vivas;
+}
+
+// Función para calcular los patrones braille de una fila de caracteres de la vista (de columnas caracteres), cuya primera célula es (x, y), con bloques de lado x lado células por punto.
+static void calcularFilaBraille(const Fotograma* fotograma, int64_t x, int64_t y, int64_t lado, int columnas, uint8_t* patrones) {
+    memset(patrones, 0, (size_t)columnas);
+    for (int filaPunto = 0; filaPunto < PUNTOS_ALTO_BRAILLE; filaPunto++) {
+        int64_t inicioBloque = y + filaPunto * lado;
+        if (inicioBloque >= fotograma->alto) {
+            break;
+        }
+        // Leemos como máximo FILAS_MUESTRA_BLOQUE filas del bloque, repartidas a lo largo de su altura.
+        int64_t filasBloque = (fotograma->alto - inicioBloque < lado) ? fotograma->alto - inicioBloque : lado;
+        int64_t muestras = (filasBloque < FILAS_MUESTRA_BLOQUE) ? filasBloque : FILAS_MUESTRA_BLOQUE;
+        for (int64_t k = 0; k < muestras; k++) {
+            const uint64_t* fila = FILA_FOTOGRAMA(fotograma, inicioBloque + k * filasBloque / muestras);
+            for (int columna = 0; columna < columnas; columna++) {
+                for (int columnaPunto = 0; columnaPunto < PUNTOS_ANCHO_BRAILLE; columnaPunto++) {
+                    uint8_t punto = PUNTOS_BRAILLE[filaPunto][columnaPunto];
+                    int64_t inicioColumna = x + ((int64_t)columna * PUNTOS_ANCHO_BRAILLE + columnaPunto) * lado;
+                    // Un punto ya encendido no necesita más muestras.
+                    if ((patrones[columna] & punto) != 0 || inicioColumna >= fotograma->ancho) {
+                        continue;
+                    }
+                    int64_t longitud = (fotograma->ancho - inicioColumna < lado) ? fotograma->ancho - inicioColumna : lado;
+                    if (contarTramoFila(fila, (uint64_t)inicioColumna, (uint64_t)longitud) > 0) {
+                        patrones[columna] |= punto;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Función para dibujar las filas visibles en el nivel 0 (un carácter por célula), comparando de 64 en 64 células la fila del fotograma (desplazada desde la columna de la vista) con la última que se dibujó.
+static void dibujarCelulas(WINDOW* ventana, const Fotograma* fotograma, const Vista* vista, int alturaVisible, int anchoVisible) {
+    size_t palabrasVisibles = dibujoAnterior.palabrasPorFila;
+    size_t palabrasFila = PALABRAS_POR_FILA(fotograma->ancho);
+    uint64_t* filaVisible = dibujoAnterior.filaVisible;
+    int bitsUltimaPalabra = anchoVisible % BITS_POR_PALABRA;
+    uint64_t mascaraUltimaPalabra = (bitsUltimaPalabra == 0) ? ~(uint64_t)0 : ((uint64_t)1 << bitsUltimaPalabra) - 1;
+    for (int y = 0; y < alturaVisible; y++) {
+        const uint64_t* fila = FILA_FOTOGRAMA(fotograma, vista->y + y);
+        uint64_t* filaAnterior = dibujoAnterior.celulas + (size_t)y * palabrasVisibles;
+        extraerFilaVisible(fila, palabrasFila, (uint64_t)vista->x, filaVisible, palabrasVisibles);
+        filaVisible[palabrasVisibles - 1] &= mascaraUltimaPalabra;
+        // Tramo de células pendiente de dibujar (inicio = -1 si no hay ninguno).
+        int inicioTramo = -1, finTramo = -1;
+        for (size_t p = 0; p < palabrasVisibles; p++) {
+            uint64_t mascara = (p + 1 == palabrasVisibles) ? mascaraUltimaPalabra : ~(uint64_t)0;
+            uint64_t cambios = dibujoAnterior.completo ? mascara : filaVisible[p] ^ filaAnterior[p];
+            // Recorremos solo los bits que cambiaron, agrupando en un tramo las células cambiadas separadas por menos de SEPARACION_MAXIMA_TRAMO células.
+            while (cambios != 0) {
+                int x = (int)(p * BITS_POR_PALABRA) + __builtin_ctzll(cambios);
+                cambios &= cambios - 1;
+                if (inicioTramo >= 0 && x - finTramo > SEPARACION_MAXIMA_TRAMO) {
+                    dibujarTramo(ventana, filaVisible, y, inicioTramo, finTramo);
+                    inicioTramo = -1;
+                }
+                if (inicioTramo < 0) {
+                    inicioTramo = x;
+                }
+                finTramo = x;
+            }
+        }
+        if (inicioTramo >= 0) {
+            dibujarTramo(ventana, filaVisible, y, inicioTramo, finTramo);
+        }
+        memcpy(filaAnterior, filaVisible, palabrasVisibles * sizeof(uint64_t));
+    }
+}
+
+// Función para dibujar las filas visibles en un nivel alejado (un carácter braille por bloque de 2x4 puntos), escribiendo solo los caracteres que cambiaron desde el último dibujo.
+static void dibujarBraille(WINDOW* ventana, const Fotograma* fotograma, const Vista* vista, int alturaVisible, int anchoVisible) {
+    int64_t lado = celulasPorCaracter(vista->nivel, 1);
+    uint8_t* patronesFila = dibujoAnterior.patronesFila;
+    for (int y = 0; y < alturaVisible; y++) {
+        uint8_t* patronesAnteriores = dibujoAnterior.patrones + (size_t)y * (size_t)anchoVisible;
+        calcularFilaBraille(fotograma, vista->x, vista->y + (int64_t)y * PUNTOS_ALTO_BRAILLE * lado, lado, anchoVisible, patronesFila);
+        // Agrupamos en un tramo los caracteres cambiados separados por menos de SEPARACION_MAXIMA_TRAMO caracteres.
+        int inicioTramo = -1, finTramo = -1;
+        for (int x = 0; x < anchoVisible; x++) {
+            if (!dibujoAnterior.completo && patronesFila[x] == patronesAnteriores[x]) {
+                continue;
+            }
+            if (inicioTramo >= 0 && x - finTramo > SEPARACION_MAXIMA_TRAMO) {
+                dibujarTramoBraille(ventana, patronesFila, y, inicioTramo, finTramo);
+                inicioTramo = -1;
+            }
+            if (inicioTramo < 0) {
+                inicioTramo = x;
+            }
+            finTramo = x;
+        }
+        if (inicioTramo >= 0) {
+            dibujarTramoBraille(ventana, patronesFila, y, inicioTramo, finTramo);
+        }
+        memcpy(patronesAnteriores, patronesFila, (size_t)anchoVisible);
+    }
+}
+
+// Función para dibujar la región de la cuadrícula indicada por la vista en la ventana de ncurses (NULL = la esquina superior izquierda, sin zoom).
+void dibujarCuadricula(WINDOW* ventana, Cuadricula* cuadricula, Vista* vista) {
     if (ventana == NULL || cuadricula == NULL) {
         return; // Retorna si la ventana o la cuadrícula son NULL.
     }
+    // Dibujamos la generación actual directamente desde la cuadrícula, sin copiarla.
+    Fotograma fotograma = obtenerVistaCuadricula(cuadricula);
+    dibujarFotograma(ventana, &fotograma, vista);
+}
+
+// Función para dibujar la región de un fotograma (una generación de la cuadrícula) indicada por la vista en la ventana de ncurses.
+void dibujarFotograma(WINDOW* ventana, const Fotograma* fotograma, Vista* vista) {
+    if (ventana == NULL || fotograma == NULL) {
+        return; // Retorna si la ventana o el fotograma son NULL.
+    }
+    Vista vistaDefecto = {0};
+    if (vista == NULL) {
+        vista = &vistaDefecto;
+    }
     int alturaVentana, anchoVentana;
     getmaxyx(ventana, alturaVentana, anchoVentana); // Obtiene las dimensiones de la ventana.
 
     // Calculamos el área disponible para mostrar la cuadrícula dentro de la ventana.
     int alturaDisponible = alturaVentana - ALTURA_PANEL_INFERIOR - INICIO_CUADRICULA_Y - ANCHO_BORDE;
     int anchoDisponible = anchoVentana - (ANCHO_BORDE * 2);
+    if (alturaDisponible <= 0 || anchoDisponible <= 0) {
+        return;
+    }
 
-    // Calculamos el área visible de la cuadrícula, limitándola al área disponible en la ventana.
-    // NOTA: El operador condicional ? : se utiliza para elegir el valor mínimo entre el tamaño de la cuadrícula y el área disponible. Si la cuadrícula es más pequeña que el área disponible, se muestra completamente; de lo contrario, se limita al área disponible.
-    int alturaVisible = (cuadricula->alto < alturaDisponible) ? cuadricula->alto : alturaDisponible;
-    int anchoVisible = (cuadricula->ancho < anchoDisponible) ? cuadricula->ancho : anchoDisponible;
+    // Limitamos el nivel de zoom al primero que muestra la cuadrícula completa (alejarse más solo la achicaría).
+    int nivelMaximo = 0;
+    while (nivelMaximo < NIVEL_MAXIMO_VISTA && (anchoDisponible * celulasPorCaracter(nivelMaximo, PUNTOS_ANCHO_BRAILLE) < fotograma->ancho ||
+                                                alturaDisponible * celulasPorCaracter(nivelMaximo, PUNTOS_ALTO_BRAILLE) < fotograma->alto)) {
+        nivelMaximo++;
+    }
+    vista->nivel = (vista->nivel < 0) ? 0 : (vista->nivel > nivelMaximo) ? nivelMaximo : vista->nivel;
+    int64_t celulasAncho = celulasPorCaracter(vista->nivel, PUNTOS_ANCHO_BRAILLE);
+    int64_t celulasAlto = celulasPorCaracter(vista->nivel, PUNTOS_ALTO_BRAILLE);
 
-    // Recorremos cada célula de la cuadrícula visible y la dibujamos en la ventana.
-    for (int y = 0; y < alturaVisible; y++) {
-        for (int x = 0; x < anchoVisible; x++) {
-            // Obtenemos el estado de la célula en la posición (x, y).
-            bool estadoCelula = obtenerEstadoCelula(cuadricula, x, y);
-            // Seleccionamos el carácter a dibujar según el estado de la célula.
-            char* caracterCelula = estadoCelula ? CELULA_VIVA : CELULA_MUERTA;
-            // Dibujamos la célula, ajustando las coordenadas para tener en cuenta el margen y la posición de inicio de la cuadrícula.
-            mvwprintw(ventana, INICIO_CUADRICULA_Y + y, INICIO_CUADRICULA_X + x, "%s", caracterCelula);
+    // Limitamos la posición para que la vista no salga de la cuadrícula, y calculamos el área visible (en caracteres), limitándola al área disponible en la ventana.
+    int64_t xMaximo = (fotograma->ancho > anchoDisponible * celulasAncho) ? fotograma->ancho - anchoDisponible * celulasAncho : 0;
+    int64_t yMaximo = (fotograma->alto > alturaDisponible * celulasAlto) ? fotograma->alto - alturaDisponible * celulasAlto : 0;
+    vista->x = (vista->x < 0) ? 0 : (vista->x > xMaximo) ? xMaximo : vista->x;
+    vista->y = (vista->y < 0) ? 0 : (vista->y > yMaximo) ? yMaximo : vista->y;
+    int64_t columnas = (fotograma->ancho - vista->x + celulasAncho - 1) / celulasAncho;
+    int64_t filas = (fotograma->alto - vista->y + celulasAlto - 1) / celulasAlto;
+    int anchoVisible = (columnas < anchoDisponible) ? (int)columnas : anchoDisponible;
+    int alturaVisible = (filas < alturaDisponible) ? (int)filas : alturaDisponible;
+    vista->columnas = anchoVisible;
+    vista->filas = alturaVisible;
+    if (alturaVisible <= 0 || anchoVisible <= 0 || !prepararDibujoAnterior(ventana, alturaVisible, anchoVisible, vista, alturaDisponible, anchoDisponible)) {
+        return;
+    }
+
+    if (vista->nivel == 0) {
+        dibujarCelulas(ventana, fotograma, vista, alturaVisible, anchoVisible);
+    } else {
+        dibujarBraille(ventana, fotograma, vista, alturaVisible, anchoVisible);
+    }
+    dibujoAnterior.completo = false;
+}
+
+// Función para desplazar la vista un cuarto del área visible en la dirección indicada (la posición se limita a la cuadrícula en el siguiente dibujo).
+void desplazarVista(Vista* vista, int direccionX, int direccionY) {
+    if (vista == NULL) {
+        return;
+    }
+    int64_t pasoX = (vista->columnas / 4 > 0) ? vista->columnas / 4 : 1;
+    int64_t pasoY = (vista->filas / 4 > 0) ? vista->filas / 4 : 1;
+    vista->x += direccionX * pasoX * celulasPorCaracter(vista->nivel, PUNTOS_ANCHO_BRAILLE);
+    vista->y += direccionY * pasoY * celulasPorCaracter(vista->nivel, PUNTOS_ALTO_BRAILLE);
+}
+
+// Función para cambiar el nivel de zoom de la vista, manteniendo el centro del área visible (el nivel y la posición se limitan a la cuadrícula en el siguiente dibujo).
+void cambiarNivelVista(Vista* vista, int delta) {
+    if (vista == NULL) {
+        return;
+    }
+    int nivel = vista->nivel + delta;
+    nivel = (nivel < 0) ? 0 : (nivel > NIVEL_MAXIMO_VISTA) ? NIVEL_MAXIMO_VISTA : nivel;
+    int64_t centroX = vista->x + vista->columnas * celulasPorCaracter(vista->nivel, PUNTOS_ANCHO_BRAILLE) / 2;
+    int64_t centroY = vista->y + vista->filas * celulasPorCaracter(vista->nivel, PUNTOS_ALTO_BRAILLE) / 2;
+    vista->nivel = nivel;
+    vista->x = centroX - vista->columnas * celulasPorCaracter(nivel, PUNTOS_ANCHO_BRAILLE) / 2;
+    vista->y = centroY - vista->filas * celulasPorCaracter(nivel, PUNTOS_ALTO_BRAILLE) / 2;
+}
+
+// Función para escribir un texto en una fila del panel inferior, limpiando la fila y recortando el texto al ancho de la ventana (para que nunca pase a la fila siguiente).
+static void escribirFilaPanel(WINDOW* ventana, int fila, char* texto) {
+    int anchoVentana = getmaxx(ventana);
+    int anchoDisponible = anchoVentana - (ANCHO_BORDE * 2) - 1;
+    if (anchoDisponible <= 0) {
+        return;
+    }
+    // Cada carácter ocupa al menos un byte, por lo que basta con cortar en anchoDisponible bytes (retrocediendo hasta el inicio de un carácter UTF-8).
+    size_t longitud = strlen(texto);
+    if (longitud > (size_t)anchoDisponible) {
+        longitud = (size_t)anchoDisponible;
+        while (longitud > 0 && ((unsigned char)texto[longitud] & 0xC0) == 0x80) {
+            longitud--;
         }
+        texto[longitud] = '\0';
     }
+    mvwhline(ventana, fila, ANCHO_BORDE, ' ', anchoVentana - (ANCHO_BORDE * 2));
+    mvwaddstr(ventana, fila, ANCHO_BORDE + 1, texto);
 }
 
 // Función para mostrar y actualizar el panel de estado y controles en la ventana de ncurses.
-void mostrarPanelEstado(WINDOW* ventana, uint64_t numGeneracion, int velocidadEvolucion, bool programaEnEjecucion) {
+void mostrarPanelEstado(WINDOW* ventana, uint64_t numGeneracion, int velocidadEvolucion, bool programaEnEjecucion, const char* regla, const Vista* vista) {
     if (ventana == NULL) {
         return; // Retorna si la ventana es NULL.
     }
@@ -148,17 +509,128 @@ void mostrarPanelEstado(WINDOW* ventana, uint64_t numGeneracion, int velocidadEv
     int filaEstado = inicioPanelInferior + 1;                        // Fila para mostrar el estado del juego.
     const char* textoEstado = programaEnEjecucion ? "CORRIENDO" : "EN PAUSA";   // Texto para el estado del juego.
 
-    // Limpiamos la fila del estado de juego antes de actualizarla.
-    mvwhline(ventana, filaEstado, ANCHO_BORDE, ' ', anchoVentana - (ANCHO_BORDE * 2));
+    // Mostramos el estado del juego en la primera línea del panel inferior, con la posición de la vista y las células que abarca cada carácter.
+    char texto[TAMANO_TEXTO_PANEL];
+    int longitud = snprintf(texto, sizeof(texto), "Generación: %llu | Velocidad: %d ms | Estado: %s | Regla: %s",
+        (unsigned long long)numGeneracion, velocidadEvolucion, textoEstado, (regla != NULL) ? regla : REGLA_CONWAY);
+    if (vista != NULL && longitud > 0 && (size_t)longitud < sizeof(texto)) {
+        snprintf(texto + longitud, sizeof(texto) - (size_t)longitud, " | Vista: %lld,%lld (%lldx%lld por carácter)",
+            (long long)vista->x, (long long)vista->y, (long long)celulasPorCaracter(vista->nivel, PUNTOS_ANCHO_BRAILLE),
+            (long long)celulasPorCaracter(vista->nivel, PUNTOS_ALTO_BRAILLE));
+    }
+    escribirFilaPanel(ventana, filaEstado, texto);
+
+    int filaControles = filaEstado + 2; // Fila para mostrar los controles del juego (debajo de la fila de métricas).
+
+    // Mostramos los controles disponibles en la última línea del panel inferior.
+    snprintf(texto, sizeof(texto), "[Q]Salir [P]Pausa [-/+]Velocidad [SPACE]Avanzar [R]Reiniciar [G]Guardar [Flechas]Mover [Z/X]Zoom");
+    escribirFilaPanel(ventana, filaControles, texto);
+}
+
+// Función para mostrar el resumen de las métricas (ver metricas.c) en la fila del panel inferior debajo del estado. Si resumen es NULL, indica que aún se está midiendo el primer intervalo.
+void mostrarPanelMetricas(WINDOW* ventana, const ResumenMetricas* resumen) {
+    if (ventana == NULL) {
+        return; // Retorna si la ventana es NULL.
+    }
+    int filaMetricas = getmaxy(ventana) - ALTURA_PANEL_INFERIOR - ANCHO_BORDE + 2; // Fila siguiente a la del estado del juego.
+
+    // Armamos el texto completo, que escribirFilaPanel recorta al ancho de la ventana.
+    char texto[TAMANO_TEXTO_PANEL];
+    if (resumen == NULL) {
+        snprintf(texto, sizeof(texto), "Métricas: midiendo...");
+    } else {
+        const TiemposFase* calculo = &resumen->fases[FASE_CALCULO];
+        const TiemposFase* dibujo = &resumen->fases[FASE_DIBUJO];
+        const TiemposFase* refresco = &resumen->fases[FASE_REFRESCO];
+        const TiemposFase* entrada = &resumen->fases[FASE_ENTRADA];
+        snprintf(texto, sizeof(texto), "Gen/s: %.0f | Células/s: %.3g | Población: %llu (+%.0f/-%.0f por gen) | ms prom/p99: cálculo %.2f/%.2f, dibujo %.2f/%.2f, refresco %.2f/%.2f, entrada %.3f/%.3f",
+            resumen->generacionesPorSegundo, resumen->celulasPorSegundo, (unsigned long long)resumen->poblacion, resumen->nacimientosPorGeneracion,
+            resumen->muertesPorGeneracion, calculo->promedio / 1000.0, calculo->p99 / 1000.0, dibujo->promedio / 1000.0, dibujo->p99 / 1000.0,
+            refresco->promedio / 1000.0, refresco->p99 / 1000.0, entrada->promedio / 1000.0, entrada->p99 / 1000.0);
+    }
+    escribirFilaPanel(ventana, filaMetricas, texto);
+}
+
+// Función para mostrar el panel inferior de una reproducción, con las mismas filas que el del juego: estado, información de la grabación (en lugar de las métricas) y controles.
+void mostrarPanelReproduccion(WINDOW* ventana, const EstadoReproduccion* estado, const char* regla, const Vista* vista) {
+    if (ventana == NULL || estado == NULL) {
+        return; // Retorna si la ventana o el estado son NULL.
+    }
+    int alturaVentana, anchoVentana;
+    getmaxyx(ventana, alturaVentana, anchoVentana); // Obtiene las dimensiones de la ventana.
+
+    // Dibujamos la línea separadora del panel inferior.
+    int inicioPanelInferior = alturaVentana - ALTURA_PANEL_INFERIOR - ANCHO_BORDE;
+    mvwhline(ventana, inicioPanelInferior, ANCHO_BORDE, ACS_HLINE, anchoVentana - (ANCHO_BORDE * 2));
+    mvwaddch(ventana, inicioPanelInferior, POSICION_BORDE_IZQUIERDO, ACS_LTEE);      // Conexión con el borde izquierdo.
+    mvwaddch(ventana, inicioPanelInferior, anchoVentana - ANCHO_BORDE, ACS_RTEE);    // Conexión con el borde derecho.
+
+    // Mostramos el estado de la reproducción, con la posición de la vista y las células que abarca cada carácter.
+    int filaEstado = inicioPanelInferior + 1;
+    const char* textoEstado = !estado->enReproduccion ? "EN PAUSA" : estado->haciaAtras ? "RETROCEDIENDO" : "REPRODUCIENDO";
+    char texto[TAMANO_TEXTO_PANEL];
+    int longitud = snprintf(texto, sizeof(texto), "Generación: %llu de %llu-%llu | Velocidad: %d ms | Estado: %s | Regla: %s",
+        (unsigned long long)estado->numGeneracion, (unsigned long long)estado->primeraGeneracion, (unsigned long long)estado->ultimaGeneracion,
+        estado->velocidad, textoEstado, (regla != NULL) ? regla : REGLA_CONWAY);
+    if (vista != NULL && longitud > 0 && (size_t)longitud < sizeof(texto)) {
+        snprintf(texto + longitud, sizeof(texto) - (size_t)longitud, " | Vista: %lld,%lld (%lldx%lld por carácter)",
+            (long long)vista->x, (long long)vista->y, (long long)celulasPorCaracter(vista->nivel, PUNTOS_ANCHO_BRAILLE),
+            (long long)celulasPorCaracter(vista->nivel, PUNTOS_ALTO_BRAILLE));
+    }
+    escribirFilaPanel(ventana, filaEstado, texto);
+
+    // Mostramos la información de la grabación y, si se está escribiendo una generación, el número escrito hasta el momento.
+    uint64_t generaciones = estado->ultimaGeneracion - estado->primeraGeneracion + 1;
+    if (estado->destino != NULL) {
+        snprintf(texto, sizeof(texto), "Ir a la generación: %s_ ([Enter] saltar, [Esc] cancelar)", estado->destino);
+    } else {
+        snprintf(texto, sizeof(texto), "Grabación: %llu generaciones | Claves: %llu (cada %llu) | Tamaño: %.1f KiB (%.1f bytes por generación)%s",
+            (unsigned long long)generaciones, (unsigned long long)estado->numClaves, (unsigned long long)estado->intervaloClaves,
+            (double)estado->bytes / 1024.0, (double)estado->bytes / (double)generaciones, estado->indiceReconstruido ? " | Índice reconstruido" : "");
+    }
+    escribirFilaPanel(ventana, filaEstado + 1, texto);
+
+    // Mostramos los controles disponibles en la última línea del panel inferior.
+    snprintf(texto, sizeof(texto), "[Q]Salir [P]Pausa [-/+]Velocidad [D]Dirección [,/.]Anterior/Siguiente [[/]]Clave [Inicio/Fin] [0-9]Ir a [G]Guardar [Flechas]Mover [Z/X]Zoom");
+    escribirFilaPanel(ventana, filaEstado + 2, texto);
+}
+
+// Función para mostrar el panel inferior de un espectador, con las mismas filas que el del juego: estado, lo recibido del servidor (en lugar de las métricas) y controles.
+void mostrarPanelEspectador(WINDOW* ventana, const EstadoEspectador* estado, const char* regla, const Vista* vista) {
+    if (ventana == NULL || estado == NULL) {
+        return; // Retorna si la ventana o el estado son NULL.
+    }
+    int alturaVentana, anchoVentana;
+    getmaxyx(ventana, alturaVentana, anchoVentana); // Obtiene las dimensiones de la ventana.
 
-    // Mostramos el estado del juego en la primera línea del panel inferior.
-    mvwprintw(ventana, filaEstado, ANCHO_BORDE + 1, "Generación: %llu | Velocidad de Evolución: %d ms | Estado: %s",
-        (unsigned long long)numGeneracion, velocidadEvolucion, textoEstado);
+    // Dibujamos la línea separadora del panel inferior.
+    int inicioPanelInferior = alturaVentana - ALTURA_PANEL_INFERIOR - ANCHO_BORDE;
+    mvwhline(ventana, inicioPanelInferior, ANCHO_BORDE, ACS_HLINE, anchoVentana - (ANCHO_BORDE * 2));
+    mvwaddch(ventana, inicioPanelInferior, POSICION_BORDE_IZQUIERDO, ACS_LTEE);      // Conexión con el borde izquierdo.
+    mvwaddch(ventana, inicioPanelInferior, anchoVentana - ANCHO_BORDE, ACS_RTEE);    // Conexión con el borde derecho.
+
+    // Mostramos el estado de la conexión, con la posición de la vista y las células que abarca cada carácter.
+    int filaEstado = inicioPanelInferior + 1;
+    const char* textoEstado = !estado->conectado ? "DESCONECTADO" : (estado->fotogramas == 0) ? "ESPERANDO" : "RECIBIENDO";
+    char texto[TAMANO_TEXTO_PANEL];
+    int longitud = snprintf(texto, sizeof(texto), "Generación: %llu | Velocidad: %d ms | Estado: %s | Regla: %s",
+        (unsigned long long)estado->numGeneracion, estado->velocidad, textoEstado, (regla != NULL) ? regla : REGLA_CONWAY);
+    if (vista != NULL && longitud > 0 && (size_t)longitud < sizeof(texto)) {
+        snprintf(texto + longitud, sizeof(texto) - (size_t)longitud, " | Vista: %lld,%lld (%lldx%lld por carácter)",
+            (long long)vista->x, (long long)vista->y, (long long)celulasPorCaracter(vista->nivel, PUNTOS_ANCHO_BRAILLE),
+            (long long)celulasPorCaracter(vista->nivel, PUNTOS_ALTO_BRAILLE));
+    }
+    escribirFilaPanel(ventana, filaEstado, texto);
 
-    int filaControles = filaEstado + 1; // Fila para mostrar los controles del juego.
+    // Mostramos lo recibido del servidor: las generaciones completas son la primera y las que siguen a un atraso del espectador.
+    snprintf(texto, sizeof(texto), "Servidor: %s | Recibidas: %llu generaciones (%llu completas) | Saltadas: %llu | Recibido: %.1f KiB",
+        (estado->direccion != NULL) ? estado->direccion : "", (unsigned long long)estado->fotogramas, (unsigned long long)estado->claves,
+        (unsigned long long)estado->saltadas, (double)estado->bytes / 1024.0);
+    escribirFilaPanel(ventana, filaEstado + 1, texto);
 
-    // Mostramos los controles disponibles en la segunda línea del panel inferior.
-    mvwprintw(ventana, filaControles, ANCHO_BORDE + 1, "[Q]Salir | [P]Play/Pausa | [-/+]Velocidad | [SPACE]Avanzar generación | [R]Reiniciar");
+    // Mostramos los controles disponibles en la última línea del panel inferior (la simulación la controla el servidor).
+    snprintf(texto, sizeof(texto), "[Q]Salir [G]Guardar [Flechas]Mover [Z/X]Zoom");
+    escribirFilaPanel(ventana, filaEstado + 2, texto);
 }
 
 // Función para actualizar la ventana de ncurses para reflejar los cambios realizados en el buffer.
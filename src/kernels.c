@@ -0,0 +1,260 @@
+#include <string.h>
+#include <pthread.h>
+#include "../include/kernels.h"
+
+//  ================================================
+//  Conway's Game of Life - Kernels de Cálculo
+//  ================================================
+//  Este módulo implementa los kernels que calculan la siguiente generación de una fila empaquetada (64 células por palabra).
+//
+//  CARACTERÍSTICAS PRINCIPALES:
+//  1. Un solo algoritmo para todas las implementaciones:
+//      - Las macros APLICAR_REGLAS y CARGAR_VECINOS están escritas con operadores de C (&, |, ^, ~, <<, >>), por lo que sirven tanto para
+//        palabras de 64 bits como para los tipos vectoriales de GCC/Clang, donde cada operador se aplica a todas las palabras del vector.
+//      - La implementación escalar es la referencia: las versiones vectoriales repiten su cuerpo (compilado con las mismas instrucciones que el resto
+//        del kernel, sin mezclar código SSE y AVX) para las palabras finales que no completan un vector.
+//
+//  2. Versiones SSE2, AVX2 y AVX-512:
+//      - Se compilan con __attribute__((target(...))), por lo que el resto del programa no necesita flags especiales.
+//      - Las palabras vecinas (p - 1 y p + 1) se obtienen con cargas no alineadas desplazadas una palabra, gracias al borde fantasma de cada fila.
+//
+//  3. Selección en tiempo de ejecución:
+//      - La mejor implementación soportada se detecta una sola vez mediante CPUID (__builtin_cpu_supports).
+//
+//  4. Reglas B/S:
+//      - La regla de Conway (B3/S23) tiene su propio kernel, que decide con tres operaciones a partir de la suma parcial de vecinas.
+//      - Cualquier otra regla usa el kernel con tabla de transición: completa la suma (bits dos, cuatro y ocho) y la evalúa con las máscaras
+//        compiladas una sola vez en reglas.c. Ambos kernels se eligen al seleccionar la implementación, por lo que el bucle no pregunta por la regla.
+//
+//  5. Conteo de nacimientos y muertes:
+//      - El contador de cambios cuenta los bits que aparecen y desaparecen entre dos filas. La arquitectura base x86-64 no incluye la instrucción
+//        POPCNT (GCC la reemplaza por una secuencia de ~12 operaciones), por lo que hay una versión compilada con target("popcnt") que se elige
+//        si el procesador la soporta.
+
+// Macro para obtener, para cada bit de 'centro', el estado de su vecina izquierda (x - 1) y derecha (x + 1), a partir de las palabras 'previo' y 'siguiente'.
+#define DESPLAZAR_VECINOS(previo, centro, siguiente, izquierda, derecha) \
+    do { \
+        (izquierda) = ((centro) << 1) | ((previo) >> 63); \
+        (derecha) = ((centro) >> 1) | ((siguiente) << 63); \
+    } while (0)
+
+// Macro para cargar (sin requerir alineación) las palabras p - 1, p y p + 1 de una fila en variables de tipo T, y obtener sus vecinas izquierda y derecha.
+#define CARGAR_VECINOS(T, fila, p, izquierda, centro, derecha) \
+    do { \
+        T previo_, siguiente_; \
+        memcpy(&previo_, (fila) + (p) - 1, sizeof(T)); \
+        memcpy(&(centro), (fila) + (p), sizeof(T)); \
+        memcpy(&siguiente_, (fila) + (p) + 1, sizeof(T)); \
+        DESPLAZAR_VECINOS(previo_, centro, siguiente_, izquierda, derecha); \
+    } while (0)
+
+// Macro con el primer tramo común a todas las reglas: suma los 8 vecinos de cada bit con sumadores completos bit a bit.
+// Deja en 'unidades' el bit de peso 1 de la suma, en 'acarreoUnidades', 'sumaDos' y 'acarreoDos' los bits de peso 2 y 4 aún sin combinar.
+#define SUMAR_VECINOS(T, arribaIzq, arriba, arribaDer, izq, der, abajoIzq, abajo, abajoDer, unidades, acarreoUnidades, sumaDos, acarreoDos) \
+    do { \
+        /* Primer nivel: tres sumadores que reducen los 8 vecinos a bits de peso 1 (suma) y peso 2 (acarreo). */ \
+        T sumaArriba_ = (arribaIzq) ^ (arriba) ^ (arribaDer); \
+        T acarreoArriba_ = ((arribaIzq) & (arriba)) | ((arribaDer) & ((arribaIzq) ^ (arriba))); \
+        T sumaMedio_ = (izq) ^ (der) ^ (abajoIzq); \
+        T acarreoMedio_ = ((izq) & (der)) | ((abajoIzq) & ((izq) ^ (der))); \
+        T sumaAbajo_ = (abajo) ^ (abajoDer); \
+        T acarreoAbajo_ = (abajo) & (abajoDer); \
+        /* Segundo nivel: sumamos los bits de peso 1, obteniendo el bit de las unidades y un nuevo acarreo de peso 2. */ \
+        (unidades) = sumaArriba_ ^ sumaMedio_ ^ sumaAbajo_; \
+        (acarreoUnidades) = (sumaArriba_ & sumaMedio_) | (sumaAbajo_ & (sumaArriba_ ^ sumaMedio_)); \
+        /* Tercer nivel: sumamos los acarreos de peso 2 de los tres sumadores. */ \
+        (sumaDos) = acarreoArriba_ ^ acarreoMedio_ ^ acarreoAbajo_; \
+        (acarreoDos) = (acarreoArriba_ & acarreoMedio_) | (acarreoAbajo_ & (acarreoArriba_ ^ acarreoMedio_)); \
+    } while (0)
+
+// Macro para aplicar las reglas del Juego de la Vida de Conway (B3/S23) a todas las células de una palabra (o vector de palabras) de tipo T. 'mascaras' no se usa.
+#define APLICAR_REGLAS_CONWAY(T, arribaIzq, arriba, arribaDer, izq, actual, der, abajoIzq, abajo, abajoDer, mascaras, resultado) \
+    do { \
+        T unidades, acarreoUnidades, sumaDos, acarreoDos; \
+        SUMAR_VECINOS(T, arribaIzq, arriba, arribaDer, izq, der, abajoIzq, abajo, abajoDer, unidades, acarreoUnidades, sumaDos, acarreoDos); \
+        /* Si hay 2 o más acarreos de peso 2 entre los tres sumadores, el total de vecinas es 4 o más. Exactamente un bit de peso 2 significa
+           2 o 3 vecinas vivas: con 3 la célula nace o sobrevive, con 2 solo sobrevive si está viva. */ \
+        (resultado) = ~acarreoDos & (sumaDos ^ acarreoUnidades) & (unidades | (actual)); \
+    } while (0)
+
+// Macro para elegir, bit a bit, y donde 'bit' vale 1 y x donde vale 0.
+#define SELECCIONAR(x, y, bit) ((x) ^ (((x) ^ (y)) & (bit)))
+
+// Macro para aplicar una regla B/S cualquiera a todas las células de una palabra (o vector de palabras) de tipo T, a partir de las máscaras de su tabla de transición (ver reglas.c), ya copiadas en variables de tipo T.
+// NOTA: Se completa la suma de vecinas (bits dos, cuatro y ocho) y se recorre un árbol de selectores sin ramas, de las hojas (bit de las unidades) a la raíz (estado de la célula).
+#define APLICAR_REGLAS_TABLA(T, arribaIzq, arriba, arribaDer, izq, actual, der, abajoIzq, abajo, abajoDer, mascaras, resultado) \
+    do { \
+        T unidades, acarreoUnidades, sumaDos, acarreoDos; \
+        SUMAR_VECINOS(T, arribaIzq, arriba, arribaDer, izq, der, abajoIzq, abajo, abajoDer, unidades, acarreoUnidades, sumaDos, acarreoDos); \
+        T dos = sumaDos ^ acarreoUnidades; \
+        T acarreoCuatro = sumaDos & acarreoUnidades; \
+        T cuatro = acarreoDos ^ acarreoCuatro; \
+        T ocho = acarreoDos & acarreoCuatro; \
+        /* Hojas: cada par de máscaras elige según el bit de las unidades; luego se elige según los bits dos y cuatro (índice = viva * 4 + cuatro * 2 + dos). */ \
+        T muerta_ = SELECCIONAR( \
+            SELECCIONAR((mascaras)[0] ^ ((mascaras)[1] & unidades), (mascaras)[2] ^ ((mascaras)[3] & unidades), dos), \
+            SELECCIONAR((mascaras)[4] ^ ((mascaras)[5] & unidades), (mascaras)[6] ^ ((mascaras)[7] & unidades), dos), cuatro); \
+        T viva_ = SELECCIONAR( \
+            SELECCIONAR((mascaras)[8] ^ ((mascaras)[9] & unidades), (mascaras)[10] ^ ((mascaras)[11] & unidades), dos), \
+            SELECCIONAR((mascaras)[12] ^ ((mascaras)[13] & unidades), (mascaras)[14] ^ ((mascaras)[15] & unidades), dos), cuatro); \
+        /* Con 8 vecinas el árbol eligió la hoja de 0 vecinas: la corregimos con las dos últimas máscaras. */ \
+        (resultado) = SELECCIONAR(muerta_, viva_, (actual)) ^ (ocho & ((mascaras)[16] ^ ((mascaras)[17] & (actual)))); \
+    } while (0)
+
+// Macros para preparar, una sola vez por fila, lo que necesita cada forma de aplicar las reglas: la de Conway no usa la regla; la tabla de transición se copia a variables de tipo T (en los vectores, cada máscara se repite en todas las palabras).
+#define PREPARAR_REGLAS_CONWAY(T, regla, copia) \
+    T* copia = NULL; \
+    (void)(copia); \
+    (void)(regla)
+#define PREPARAR_REGLAS_TABLA(T, regla, copia) \
+    T copia[NUM_MASCARAS_REGLA]; \
+    for (int m_ = 0; m_ < NUM_MASCARAS_REGLA; m_++) { \
+        copia[m_] = (T){0} + (regla)->mascaras[m_]; \
+    }
+
+// Macro con el cuerpo común de todos los kernels: calcula las palabras [p, numPalabras) de a sizeof(T) / 8 palabras por iteración con las macros PREPARAR_REGLAS_##REGLAS y APLICAR_REGLAS_##REGLAS (CONWAY o TABLA), acumulando en 'cambios' los bits que difieren de la generación actual.
+#define CALCULAR_PALABRAS(T, REGLAS, siguiente, arriba, actual, abajo, p, numPalabras, regla, cambios) \
+    do { \
+        PREPARAR_REGLAS_##REGLAS(T, regla, mascaras_); \
+        for (; (p) + sizeof(T) / sizeof(uint64_t) <= (numPalabras); (p) += sizeof(T) / sizeof(uint64_t)) { \
+            T arribaIzq, arribaCentro, arribaDer, izq, centro, der, abajoIzq, abajoCentro, abajoDer, resultado; \
+            CARGAR_VECINOS(T, arriba, p, arribaIzq, arribaCentro, arribaDer); \
+            CARGAR_VECINOS(T, actual, p, izq, centro, der); \
+            CARGAR_VECINOS(T, abajo, p, abajoIzq, abajoCentro, abajoDer); \
+            APLICAR_REGLAS_##REGLAS(T, arribaIzq, arribaCentro, arribaDer, izq, centro, der, abajoIzq, abajoCentro, abajoDer, mascaras_, resultado); \
+            (cambios) |= resultado ^ centro; \
+            memcpy((siguiente) + (p), &resultado, sizeof(T)); \
+        } \
+    } while (0)
+
+// Macro para definir un kernel escalar (referencia): una palabra de 64 células por iteración.
+#define DEFINIR_KERNEL_ESCALAR(nombre, REGLAS) \
+    static uint64_t nombre(uint64_t* siguiente, const uint64_t* arriba, const uint64_t* actual, const uint64_t* abajo, size_t numPalabras, const Regla* regla) { \
+        size_t p = 0; \
+        uint64_t cambios = 0; \
+        CALCULAR_PALABRAS(uint64_t, REGLAS, siguiente, arriba, actual, abajo, p, numPalabras, regla, cambios); \
+        return cambios; \
+    }
+
+DEFINIR_KERNEL_ESCALAR(calcularFilaEscalar, CONWAY)
+DEFINIR_KERNEL_ESCALAR(calcularFilaEscalarTabla, TABLA)
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define KERNELS_X86 1
+
+// Macro para definir un kernel vectorial de 'bytes' bytes compilado para el conjunto de instrucciones 'objetivo'. Las palabras que no completan un vector se calculan de a una, con el cuerpo del kernel escalar.
+// NOTA: El cuerpo escalar se repite aquí en lugar de llamar al kernel escalar, que está compilado con instrucciones SSE sin prefijo VEX: mezclarlas con registros AVX sin vzeroupper penaliza cada llamada.
+#define DEFINIR_KERNEL_VECTORIAL(nombre, objetivo, bytes, REGLAS) \
+    typedef uint64_t nombre##Vector __attribute__((vector_size(bytes))); \
+    __attribute__((target(objetivo))) \
+    static uint64_t nombre(uint64_t* siguiente, const uint64_t* arriba, const uint64_t* actual, const uint64_t* abajo, size_t numPalabras, const Regla* regla) { \
+        size_t p = 0; \
+        nombre##Vector cambiosVector = {0}; \
+        CALCULAR_PALABRAS(nombre##Vector, REGLAS, siguiente, arriba, actual, abajo, p, numPalabras, regla, cambiosVector); \
+        uint64_t cambios = 0; \
+        CALCULAR_PALABRAS(uint64_t, REGLAS, siguiente, arriba, actual, abajo, p, numPalabras, regla, cambios); \
+        for (size_t i = 0; i < sizeof(nombre##Vector) / sizeof(uint64_t); i++) { \
+            cambios |= cambiosVector[i]; \
+        } \
+        return cambios; \
+    }
+
+DEFINIR_KERNEL_VECTORIAL(calcularFilaSSE2, "sse2", 16, CONWAY)
+DEFINIR_KERNEL_VECTORIAL(calcularFilaAVX2, "avx2", 32, CONWAY)
+DEFINIR_KERNEL_VECTORIAL(calcularFilaAVX512, "avx512f", 64, CONWAY)
+DEFINIR_KERNEL_VECTORIAL(calcularFilaSSE2Tabla, "sse2", 16, TABLA)
+DEFINIR_KERNEL_VECTORIAL(calcularFilaAVX2Tabla, "avx2", 32, TABLA)
+DEFINIR_KERNEL_VECTORIAL(calcularFilaAVX512Tabla, "avx512f", 64, TABLA)
+#endif
+
+// Macro para definir un contador de cambios (nacimientos y muertes entre dos versiones de una fila) compilado con los atributos indicados.
+#define DEFINIR_CONTADOR_CAMBIOS(nombre, atributos) \
+    atributos static void nombre(const uint64_t* anterior, const uint64_t* siguiente, size_t numPalabras, uint64_t* nacimientos, uint64_t* muertes) { \
+        uint64_t nacidas = 0, muertas = 0; \
+        for (size_t p = 0; p < numPalabras; p++) { \
+            nacidas += (uint64_t)__builtin_popcountll(siguiente[p] & ~anterior[p]); \
+            muertas += (uint64_t)__builtin_popcountll(anterior[p] & ~siguiente[p]); \
+        } \
+        *nacimientos += nacidas; \
+        *muertes += muertas; \
+    }
+
+DEFINIR_CONTADOR_CAMBIOS(contarCambiosEscalar, )
+#ifdef KERNELS_X86
+DEFINIR_CONTADOR_CAMBIOS(contarCambiosPOPCNT, __attribute__((target("popcnt"))))
+#endif
+
+// Nombres de las implementaciones, en el orden de TipoKernel.
+static const char* const NOMBRES_KERNEL[NUM_TIPOS_KERNEL] = {"automatico", "escalar", "sse2", "avx2", "avx512"};
+
+// Mejor implementación soportada, detectada una sola vez.
+static TipoKernel mejorKernel = KERNEL_ESCALAR;
+static bool popcntDisponible = false;
+static pthread_once_t deteccionKernel = PTHREAD_ONCE_INIT;
+
+// Función para consultar al procesador (CPUID) y guardar la mejor implementación soportada.
+static void detectarKernel(void) {
+#ifdef KERNELS_X86
+    __builtin_cpu_init();
+    popcntDisponible = __builtin_cpu_supports("popcnt");
+    if (__builtin_cpu_supports("avx512f")) {
+        mejorKernel = KERNEL_AVX512;
+    } else if (__builtin_cpu_supports("avx2")) {
+        mejorKernel = KERNEL_AVX2;
+    } else if (__builtin_cpu_supports("sse2")) {
+        mejorKernel = KERNEL_SSE2;
+    }
+#endif
+}
+
+// Función para detectar (una sola vez, mediante CPUID) la mejor implementación soportada por el procesador.
+TipoKernel detectarMejorKernel(void) {
+    pthread_once(&deteccionKernel, detectarKernel);
+    return mejorKernel;
+}
+
+// Función para saber si el procesador soporta una implementación.
+bool kernelDisponible(TipoKernel tipo) {
+    // Las implementaciones están ordenadas de menor a mayor exigencia: cada una requiere las instrucciones de las anteriores.
+    return tipo < NUM_TIPOS_KERNEL && tipo <= detectarMejorKernel();
+}
+
+// Función para obtener la función de una implementación para una regla (NULL si el procesador no la soporta). KERNEL_AUTOMATICO retorna la mejor disponible.
+KernelFila obtenerKernelFila(TipoKernel tipo, const Regla* regla) {
+    if (tipo == KERNEL_AUTOMATICO) {
+        tipo = detectarMejorKernel();
+    }
+    if (!kernelDisponible(tipo)) {
+        return NULL;
+    }
+    // La regla de Conway tiene kernels especializados; el resto usa los kernels con tabla de transición.
+    bool conway = (regla == NULL || regla->esConway);
+    switch (tipo) {
+#ifdef KERNELS_X86
+        case KERNEL_SSE2:
+            return conway ? calcularFilaSSE2 : calcularFilaSSE2Tabla;
+        case KERNEL_AVX2:
+            return conway ? calcularFilaAVX2 : calcularFilaAVX2Tabla;
+        case KERNEL_AVX512:
+            return conway ? calcularFilaAVX512 : calcularFilaAVX512Tabla;
+#endif
+        default:
+            return conway ? calcularFilaEscalar : calcularFilaEscalarTabla;
+    }
+}
+
+// Función para obtener el contador de cambios más rápido soportado por el procesador.
+ContadorCambios obtenerContadorCambios(void) {
+    detectarMejorKernel();
+#ifdef KERNELS_X86
+    if (popcntDisponible) {
+        return contarCambiosPOPCNT;
+    }
+#endif
+    return contarCambiosEscalar;
+}
+
+// Función para obtener el nombre de una implementación (por ejemplo, "avx2").
+const char* obtenerNombreKernel(TipoKernel tipo) {
+    return (tipo < NUM_TIPOS_KERNEL) ? NOMBRES_KERNEL[tipo] : "desconocido";
+}
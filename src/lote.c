@@ -0,0 +1,411 @@
+#include <stdio.h>
+#include <time.h>
+#include "../include/lote.h"
+#include "../include/game.h"
+#include "../include/disperso.h"
+#include "../include/hashlife.h"
+#include "../include/fotogramas.h"
+#include "../include/patrones.h"
+#include "../include/instantaneas.h"
+#include "../include/metricas.h"
+#include "../include/grabacion.h"
+
+//  ================================================
+//  Conway's Game of Life - Modo Sin Interfaz
+//  ================================================
+//  Este módulo ejecuta la simulación sin ncurses (por ejemplo, en un servidor o dentro de un script):
+//      - Crea el motor indicado con la semilla, dimensiones y porcentaje de células vivas de las opciones, con el patrón de --patron o desde la instantánea de --reanudar.
+//      - La regla es la de --regla, o la del patrón o la instantánea (B3/S23 por defecto); los motores ilimitados no admiten reglas con B0.
+//      - Con --detener-periodo, se detiene en cuanto la cuadrícula se vuelve estable u oscilante (ver obtenerPeriodoCuadricula en game.c).
+//      - Con --metricas, mide cada generación y escribe cada segundo un resumen (tiempos, generaciones por segundo, población, nacimientos y muertes) en CSV o JSON Lines (ver metricas.c).
+//      - Con --instantanea, escribe instantáneas cada --cada generaciones (y al terminar) en segundo plano, sin detener el cálculo.
+//      - Calcula las generaciones sin pausas entre ellas ni salida por la terminal.
+//      - Con --grabar, graba todas las generaciones en segundo plano, como diferencias con la anterior y con claves cada --claves generaciones (ver grabacion.c).
+//      - Con --reproducir, no calcula nada: abre la grabación, salta a la generación --generaciones y muestra su población y su hash.
+//      - Con --pasada, calcula las generaciones entre instantáneas por pasadas de varias generaciones (bloqueo temporal, ver avanzarCuadricula en game.c).
+//      - Al terminar, muestra en stdout la población final, el tiempo de cálculo y las células calculadas por segundo, y guarda la última generación si se indicó --guardar.
+//  NOTA: El tiempo solo incluye el cálculo de las generaciones (no la creación de la configuración inicial).
+
+// Función para obtener el tiempo actual (en segundos) de un reloj monótono.
+static double obtenerSegundos(void) {
+    struct timespec tiempo;
+    clock_gettime(CLOCK_MONOTONIC, &tiempo);
+    return (double)tiempo.tv_sec + (double)tiempo.tv_nsec / 1e9;
+}
+
+// Función para crear la cuadrícula inicial: desde la instantánea de las opciones, el patrón (centrado en una cuadrícula de al menos ancho x alto) o una configuración aleatoria. La regla de --regla reemplaza a la del archivo. Retorna NULL (tras mostrar el error en stderr) si no se pudo crear.
+Cuadricula* crearCuadriculaInicial(const Opciones* opciones) {
+    // La regla de las opciones ya fue validada por analizarArgumentos (NULL = la del archivo, o B3/S23).
+    Regla regla;
+    bool reglaIndicada = compilarRegla(opciones->regla, &regla);
+    Cuadricula* cuadricula;
+    char reglaArchivo[LONGITUD_MAXIMA_REGLA];
+    if (opciones->reanudar != NULL) {
+        InfoInstantanea info;
+        double inicio = obtenerSegundos();
+        cuadricula = cargarInstantanea(opciones->reanudar, &info);
+        if (cuadricula == NULL) {
+            fprintf(stderr, "No se pudo cargar la instantánea '%s' (no existe, no es válida o está dañada).\n", opciones->reanudar);
+            return NULL;
+        }
+        printf("reanudada: %s (%ux%u, generacion %llu, regla %s, leida en %.6f s)\n", opciones->reanudar, info.ancho, info.alto,
+            (unsigned long long)info.numGeneracion, info.regla, obtenerSegundos() - inicio);
+        snprintf(reglaArchivo, sizeof(reglaArchivo), "%s", info.regla);
+    } else if (opciones->patron != NULL) {
+        InfoPatron info;
+        double inicio = obtenerSegundos();
+        cuadricula = crearCuadriculaDesdePatron(opciones->patron, opciones->ancho, opciones->alto, &info);
+        if (cuadricula == NULL) {
+            fprintf(stderr, "No se pudo leer el patrón '%s' (no existe, no es válido o mide más de %ux%u).\n", opciones->patron, (unsigned)DIMENSION_MAXIMA, (unsigned)DIMENSION_MAXIMA);
+            return NULL;
+        }
+        printf("patron: %s (%ux%u, regla %s, leido en %.6f s)\n", opciones->patron, info.ancho, info.alto, info.regla, obtenerSegundos() - inicio);
+        snprintf(reglaArchivo, sizeof(reglaArchivo), "%s", info.regla);
+    } else {
+        cuadricula = crearCuadriculaConHilos(opciones->ancho, opciones->alto, opciones->semilla, opciones->porcentaje, reglaIndicada ? &regla : NULL, opciones->numHilos);
+        if (cuadricula == NULL) {
+            fprintf(stderr, "No se pudo crear la cuadrícula.\n");
+        }
+        return cuadricula;
+    }
+    // La cuadrícula ya calcula con la regla del archivo, salvo que no sea una regla B/S válida o que las opciones indiquen otra.
+    if (reglaIndicada) {
+        configurarReglaCuadricula(cuadricula, &regla);
+    } else if (!compilarRegla(reglaArchivo, &regla)) {
+        fprintf(stderr, "Aviso: la regla '%s' no es una regla B/S válida; se calcula con %s.\n", reglaArchivo, REGLA_CONWAY);
+    }
+    return cuadricula;
+}
+
+// Función para ejecutar la simulación con el motor de cuadrícula. En generaciones se indica cuántas se calcularon (menos que las pedidas si se detuvo al detectar un período), y en ancho y alto las dimensiones de la cuadrícula (las del patrón o la instantánea, si se indicó uno). Retorna false si no se pudo crear la cuadrícula.
+static bool ejecutarCuadricula(const Opciones* opciones, uint64_t* poblacion, double* segundos, uint64_t* generaciones, uint32_t* ancho, uint32_t* alto) {
+    Cuadricula* cuadricula = crearCuadriculaInicial(opciones);
+    if (cuadricula == NULL) {
+        return false;
+    }
+    *ancho = cuadricula->ancho;
+    *alto = cuadricula->alto;
+    if (!configurarHilosCuadricula(cuadricula, opciones->numHilos) || !seleccionarKernelCuadricula(cuadricula, opciones->kernel)) {
+        fprintf(stderr, "No se pudo configurar la cuadrícula (hilos o kernel no disponibles).\n");
+        liberarCuadricula(cuadricula);
+        return false;
+    }
+    EscritorInstantaneas* escritor = NULL;
+    if (opciones->instantanea != NULL) {
+        escritor = crearEscritorInstantaneas(cuadricula->ancho, cuadricula->alto, opciones->instantanea, cuadricula->regla.texto);
+        if (escritor == NULL) {
+            fprintf(stderr, "No se pudo iniciar el hilo de instantáneas.\n");
+            liberarCuadricula(cuadricula);
+            return false;
+        }
+    }
+    Metricas* metricas = NULL;
+    if (opciones->metricas != NULL) {
+        metricas = crearMetricas((uint64_t)cuadricula->ancho * cuadricula->alto, opciones->metricas, obtenerFormatoMetricasPorExtension(opciones->metricas));
+        if (metricas == NULL) {
+            fprintf(stderr, "No se pudo crear el archivo de métricas '%s'.\n", opciones->metricas);
+            liberarEscritorInstantaneas(escritor);
+            liberarCuadricula(cuadricula);
+            return false;
+        }
+        // El conteo de cambios da los nacimientos, las muertes y la población de cada generación sin recorrer la cuadrícula completa.
+        configurarConteoCambios(cuadricula, true);
+    }
+    // La grabación se crea al final, cuando ya no hay errores posibles de las otras opciones; su primera clave es la generación inicial.
+    Grabador* grabador = NULL;
+    if (opciones->grabar != NULL) {
+        grabador = crearGrabador(cuadricula, opciones->grabar, opciones->intervaloClaves);
+        if (grabador == NULL) {
+            fprintf(stderr, "No se pudo crear la grabación '%s'.\n", opciones->grabar);
+            liberarMetricas(metricas);
+            liberarEscritorInstantaneas(escritor);
+            liberarCuadricula(cuadricula);
+            return false;
+        }
+    }
+    configurarDeteccionPeriodo(cuadricula, opciones->detenerPeriodo);
+    configurarGeneracionesPorPasada(cuadricula, opciones->generacionesPorPasada);
+    // Las instantáneas periódicas se incluyen en el tiempo: solo cuestan la copia de la generación, ya que se escriben en segundo plano.
+    double inicio = obtenerSegundos();
+    uint64_t periodo = 0, inicioPeriodo = 0;
+    uint64_t i = 0;
+    bool grabacionFallida = false;
+    while (i < opciones->generaciones) {
+        // Si la configuración ya se repite, las generaciones siguientes no aportan nada nuevo.
+        if (opciones->detenerPeriodo && obtenerPeriodoCuadricula(cuadricula, &periodo, &inicioPeriodo)) {
+            break;
+        }
+        // Sin --metricas, --detener-periodo ni --grabar, las generaciones hasta la siguiente instantánea se calculan de una vez, por pasadas de --pasada generaciones.
+        uint64_t pasos = 1;
+        if (metricas == NULL && !opciones->detenerPeriodo && grabador == NULL) {
+            pasos = opciones->generaciones - i;
+            if (escritor != NULL && opciones->intervaloInstantaneas > 0 && opciones->intervaloInstantaneas - i % opciones->intervaloInstantaneas < pasos) {
+                pasos = opciones->intervaloInstantaneas - i % opciones->intervaloInstantaneas;
+            }
+        }
+        // Sin --metricas no se lee el reloj en cada generación.
+        if (metricas != NULL) {
+            uint64_t inicioCalculo = obtenerInstanteMetricas();
+            calcularCuadriculaSiguiente(cuadricula);
+            registrarFase(metricas, FASE_CALCULO, inicioCalculo);
+            registrarGeneracionCuadricula(metricas, cuadricula);
+            actualizarMetricas(metricas);
+        } else {
+            avanzarCuadricula(cuadricula, pasos);
+        }
+        i += pasos;
+        // La grabación solo copia la generación; el hilo escritor la codifica y la escribe mientras calculamos la siguiente.
+        if (grabador != NULL && !registrarGeneracionGrabacion(grabador, cuadricula)) {
+            grabacionFallida = true;
+            break;
+        }
+        if (escritor != NULL && opciones->intervaloInstantaneas > 0 && i % opciones->intervaloInstantaneas == 0 && i < opciones->generaciones) {
+            solicitarInstantanea(escritor, cuadricula);
+        }
+    }
+    *segundos = obtenerSegundos() - inicio;
+    *poblacion = contarPoblacion(cuadricula);
+    *generaciones = i;
+    printf("regla: %s\n", cuadricula->regla.texto);
+    printf("kernel: %s\n", obtenerNombreKernel(cuadricula->tipoKernel));
+    if (cuadricula->generacionesPorPasada > 1) {
+        printf("pasada: %u generaciones\n", cuadricula->generacionesPorPasada);
+    }
+    printf("paginas: %s (%.1f MiB)\n", obtenerNombrePaginas(cuadricula->memoria.paginas), (double)cuadricula->memoria.bytes / (1024.0 * 1024.0));
+    printf("hash: %016llx\n", (unsigned long long)obtenerHashCuadricula(cuadricula));
+    if (opciones->detenerPeriodo) {
+        if (obtenerPeriodoCuadricula(cuadricula, &periodo, &inicioPeriodo)) {
+            printf("periodo: %llu (desde la generacion %llu%s)\n", (unsigned long long)periodo, (unsigned long long)inicioPeriodo, (periodo == 1) ? ", estable" : "");
+        } else {
+            printf("periodo: no detectado (maximo %d)\n", LONGITUD_HISTORIAL_HASH);
+        }
+    }
+    bool exito = true;
+    if (metricas != NULL) {
+        TiemposFase calculo = obtenerTiemposTotalesFase(metricas, FASE_CALCULO);
+        printf("calculo por generacion: minimo %.3f us, promedio %.3f us, p99 %.3f us, maximo %.3f us\n", calculo.minimo, calculo.promedio, calculo.p99, calculo.maximo);
+        if (!finalizarMetricas(metricas)) {
+            exito = false;
+            fprintf(stderr, "No se pudieron escribir las métricas en '%s'.\n", opciones->metricas);
+        }
+        printf("metricas: %s\n", opciones->metricas);
+        liberarMetricas(metricas);
+    }
+    if (escritor != NULL) {
+        // La última generación siempre se guarda, y esperamos a que se escriba antes de terminar.
+        solicitarInstantanea(escritor, cuadricula);
+        bool escritas = esperarInstantaneas(escritor);
+        exito = escritas && exito;
+        printf("instantaneas: %llu en %s (generacion %llu)\n", (unsigned long long)contarInstantaneasEscritas(escritor), opciones->instantanea,
+            (unsigned long long)obtenerNumGeneracion(cuadricula));
+        if (!escritas) {
+            fprintf(stderr, "No se pudo escribir alguna instantánea en '%s'.\n", opciones->instantanea);
+        }
+        liberarEscritorInstantaneas(escritor);
+    }
+    if (grabador != NULL) {
+        // Esperamos a que se escriban las generaciones pendientes y el índice de claves.
+        InfoGrabacion info;
+        bool grabada = finalizarGrabador(grabador, &info) && !grabacionFallida;
+        uint64_t generacionesGrabadas = info.ultimaGeneracion - info.primeraGeneracion + 1;
+        printf("grabacion: %s (generaciones %llu-%llu, %llu claves cada %llu, %llu bytes, %.1f bytes/generacion)\n", opciones->grabar,
+            (unsigned long long)info.primeraGeneracion, (unsigned long long)info.ultimaGeneracion, (unsigned long long)info.numClaves,
+            (unsigned long long)info.intervaloClaves, (unsigned long long)info.bytes, (double)info.bytes / (double)generacionesGrabadas);
+        if (!grabada) {
+            exito = false;
+            fprintf(stderr, "No se pudo escribir la grabación en '%s'.\n", opciones->grabar);
+        }
+    }
+    if (opciones->guardar != NULL) {
+        Fotograma vista = obtenerVistaCuadricula(cuadricula);
+        if (!guardarPatron(&vista, opciones->guardar, obtenerFormatoPorExtension(opciones->guardar), cuadricula->regla.texto)) {
+            exito = false;
+            fprintf(stderr, "No se pudo guardar la última generación en '%s'.\n", opciones->guardar);
+        }
+    }
+    liberarCuadricula(cuadricula);
+    return exito;
+}
+
+// Función para ejecutar la simulación con el motor disperso. En ancho y alto se indican las dimensiones de la configuración inicial. Retorna false si no hay memoria suficiente.
+static bool ejecutarDisperso(const Opciones* opciones, uint64_t* poblacion, double* segundos, uint32_t* ancho, uint32_t* alto) {
+    UniversoDisperso* universo;
+    Regla regla = *obtenerReglaConway();
+    if (opciones->patron != NULL || opciones->reanudar != NULL) {
+        Cuadricula* cuadricula = crearCuadriculaInicial(opciones);
+        if (cuadricula == NULL) {
+            return false;
+        }
+        universo = crearUniversoDispersoDesdeCuadricula(cuadricula);
+        regla = *obtenerReglaCuadricula(cuadricula);
+        *ancho = cuadricula->ancho;
+        *alto = cuadricula->alto;
+        liberarCuadricula(cuadricula);
+    } else {
+        universo = crearUniversoDispersoConSemilla(opciones->ancho, opciones->alto, opciones->semilla, opciones->porcentaje);
+        compilarRegla(opciones->regla, &regla);
+    }
+    if (universo == NULL || !configurarHilosUniversoDisperso(universo, opciones->numHilos)) {
+        fprintf(stderr, "No se pudo crear el universo disperso.\n");
+        liberarUniversoDisperso(universo);
+        return false;
+    }
+    if (!configurarReglaUniversoDisperso(universo, &regla)) {
+        fprintf(stderr, "La regla %s hace nacer células sin vecinas (B0); solo se puede calcular con el motor 'cuadricula'.\n", regla.texto);
+        liberarUniversoDisperso(universo);
+        return false;
+    }
+    printf("regla: %s\n", regla.texto);
+    double inicio = obtenerSegundos();
+    bool exito = true;
+    for (uint64_t i = 0; exito && i < opciones->generaciones; i++) {
+        exito = calcularUniversoDispersoSiguiente(universo);
+    }
+    *segundos = obtenerSegundos() - inicio;
+    *poblacion = contarPoblacionDisperso(universo);
+    if (!exito) {
+        fprintf(stderr, "Memoria insuficiente en la generación %llu.\n", (unsigned long long)obtenerNumGeneracionDisperso(universo));
+    }
+    liberarUniversoDisperso(universo);
+    return exito;
+}
+
+// Función para ejecutar la simulación con el motor HashLife. En ancho y alto se indican las dimensiones de la configuración inicial. Retorna false si no hay memoria suficiente.
+static bool ejecutarHashLife(const Opciones* opciones, uint64_t* poblacion, double* segundos, uint32_t* ancho, uint32_t* alto) {
+    // La configuración inicial se genera con una cuadrícula, de modo que coincide con la de los otros motores para la misma semilla.
+    Cuadricula* cuadricula = crearCuadriculaInicial(opciones);
+    if (cuadricula == NULL) {
+        return false;
+    }
+    UniversoHashLife* universo = crearUniversoHashLifeDesdeCuadricula(cuadricula, 0);
+    Regla regla = *obtenerReglaCuadricula(cuadricula);
+    *ancho = cuadricula->ancho;
+    *alto = cuadricula->alto;
+    liberarCuadricula(cuadricula);
+    if (universo == NULL) {
+        fprintf(stderr, "No se pudo crear el universo de HashLife.\n");
+        return false;
+    }
+    if (!configurarReglaHashLife(universo, &regla)) {
+        fprintf(stderr, "La regla %s hace nacer células sin vecinas (B0); solo se puede calcular con el motor 'cuadricula'.\n", regla.texto);
+        liberarUniversoHashLife(universo);
+        return false;
+    }
+    printf("regla: %s\n", regla.texto);
+    double inicio = obtenerSegundos();
+    bool exito = avanzarGeneracionesHashLife(universo, opciones->generaciones);
+    *segundos = obtenerSegundos() - inicio;
+    *poblacion = contarPoblacionHashLife(universo);
+    if (!exito && limiteCoordenadasAlcanzadoHashLife(universo)) {
+        fprintf(stderr, "El patrón salió del rango de coordenadas de HashLife en la generación %llu.\n", (unsigned long long)obtenerNumGeneracionHashLife(universo));
+    } else if (!exito) {
+        fprintf(stderr, "Memoria insuficiente en la generación %llu.\n", (unsigned long long)obtenerNumGeneracionHashLife(universo));
+    }
+    liberarUniversoHashLife(universo);
+    return exito;
+}
+
+// Función para reproducir la grabación de --reproducir: salta a la generación --generaciones (o a la grabada más cercana) y muestra su población y su hash, que coinciden con los de la simulación grabada. Retorna el código de salida del programa (0 si no hubo errores).
+static int ejecutarReproduccion(const Opciones* opciones) {
+    InfoGrabacion info;
+    double inicio = obtenerSegundos();
+    Reproduccion* reproduccion = abrirReproduccion(opciones->reproducir, &info);
+    if (reproduccion == NULL) {
+        fprintf(stderr, "No se pudo abrir la grabación '%s' (no existe, no es válida o está dañada).\n", opciones->reproducir);
+        return 1;
+    }
+    uint64_t generacionesGrabadas = info.ultimaGeneracion - info.primeraGeneracion + 1;
+    printf("grabacion: %s (%ux%u, regla %s, abierta en %.6f s%s)\n", opciones->reproducir, (unsigned)info.ancho, (unsigned)info.alto, info.regla,
+        obtenerSegundos() - inicio, info.indiceReconstruido ? ", indice reconstruido" : "");
+    printf("generaciones grabadas: %llu-%llu\n", (unsigned long long)info.primeraGeneracion, (unsigned long long)info.ultimaGeneracion);
+    printf("claves: %llu (cada %llu generaciones)\n", (unsigned long long)info.numClaves, (unsigned long long)info.intervaloClaves);
+    printf("tamano: %llu bytes (%.1f bytes/generacion)\n", (unsigned long long)info.bytes, (double)info.bytes / (double)generacionesGrabadas);
+
+    uint64_t destino = opciones->generaciones;
+    destino = (destino < info.primeraGeneracion) ? info.primeraGeneracion : (destino > info.ultimaGeneracion) ? info.ultimaGeneracion : destino;
+    if (destino != opciones->generaciones) {
+        fprintf(stderr, "Aviso: la generación %llu no está grabada; se salta a la %llu.\n", (unsigned long long)opciones->generaciones, (unsigned long long)destino);
+    }
+    inicio = obtenerSegundos();
+    bool exito = irAGeneracionReproduccion(reproduccion, destino);
+    double segundos = obtenerSegundos() - inicio;
+    const Fotograma* fotograma = obtenerFotogramaReproduccion(reproduccion);
+    if (!exito) {
+        fprintf(stderr, "La grabación está dañada después de la generación %llu.\n", (unsigned long long)fotograma->numGeneracion);
+        cerrarReproduccion(reproduccion);
+        return 1;
+    }
+    // El hash es el mismo que el de obtenerHashCuadricula, calculado fila por fila sobre el fotograma.
+    size_t palabrasPorFila = PALABRAS_POR_FILA(fotograma->ancho);
+    uint64_t poblacion = 0, hash = 0;
+    for (uint32_t y = 0; y < fotograma->alto; y++) {
+        const uint64_t* fila = FILA_FOTOGRAMA(fotograma, y);
+        for (size_t p = 0; p < palabrasPorFila; p++) {
+            poblacion += (uint64_t)__builtin_popcountll(fila[p]);
+        }
+        hash += calcularHashFila(fila, palabrasPorFila, y);
+    }
+    printf("generacion: %llu (salto en %.6f s)\n", (unsigned long long)fotograma->numGeneracion, segundos);
+    printf("hash: %016llx\n", (unsigned long long)hash);
+    printf("poblacion final: %llu\n", (unsigned long long)poblacion);
+    int codigo = 0;
+    if (opciones->guardar != NULL && !guardarPatron(fotograma, opciones->guardar, obtenerFormatoPorExtension(opciones->guardar), info.regla)) {
+        fprintf(stderr, "No se pudo guardar la generación en '%s'.\n", opciones->guardar);
+        codigo = 1;
+    }
+    cerrarReproduccion(reproduccion);
+    return codigo;
+}
+
+// Función para ejecutar la simulación sin interfaz con las opciones indicadas. Retorna el código de salida del programa (0 si no hubo errores).
+int ejecutarLote(const Opciones* opciones) {
+    // Una reproducción no calcula ninguna generación: solo lee la grabación.
+    if (opciones->reproducir != NULL) {
+        return ejecutarReproduccion(opciones);
+    }
+    printf("motor: %s\n", obtenerNombreMotor(opciones->motor));
+    printf("semilla: %llu\n", (unsigned long long)opciones->semilla);
+    printf("relleno: %u%%\n", opciones->porcentaje);
+
+    // Guardar la última generación, escribir instantáneas, detectar períodos, medir o grabar las generaciones requiere una cuadrícula, que solo existe en el motor de cuadrícula.
+    if ((opciones->guardar != NULL || opciones->instantanea != NULL || opciones->detenerPeriodo || opciones->metricas != NULL || opciones->grabar != NULL) &&
+        opciones->motor != MOTOR_CUADRICULA) {
+        fprintf(stderr, "Las opciones --guardar, --instantanea, --detener-periodo, --metricas y --grabar solo están disponibles con el motor 'cuadricula'.\n");
+        return 1;
+    }
+    if (opciones->patron != NULL && opciones->reanudar != NULL) {
+        fprintf(stderr, "Las opciones --patron y --reanudar no se pueden usar juntas.\n");
+        return 1;
+    }
+
+    uint64_t poblacion = 0;
+    double segundos = 0.0;
+    uint64_t generaciones = opciones->generaciones;
+    // Con --patron o --reanudar, las dimensiones son las del archivo y no las de las opciones.
+    uint32_t ancho = opciones->ancho;
+    uint32_t alto = opciones->alto;
+    bool exito;
+    switch (opciones->motor) {
+        case MOTOR_DISPERSO:
+            exito = ejecutarDisperso(opciones, &poblacion, &segundos, &ancho, &alto);
+            break;
+        case MOTOR_HASHLIFE:
+            exito = ejecutarHashLife(opciones, &poblacion, &segundos, &ancho, &alto);
+            break;
+        default:
+            exito = ejecutarCuadricula(opciones, &poblacion, &segundos, &generaciones, &ancho, &alto);
+            break;
+    }
+    if (!exito) {
+        return 1;
+    }
+
+    // Las células por segundo se calculan sobre el área de la configuración inicial, para poder comparar los motores entre sí.
+    double celulas = (double)ancho * (double)alto * (double)generaciones;
+    printf("dimensiones: %ux%u\n", (unsigned)ancho, (unsigned)alto);
+    printf("generaciones: %llu\n", (unsigned long long)generaciones);
+    printf("poblacion final: %llu\n", (unsigned long long)poblacion);
+    printf("tiempo: %.6f s\n", segundos);
+    printf("celulas/s: %.4g\n", (segundos > 0.0) ? celulas / segundos : 0.0);
+    return 0;
+}
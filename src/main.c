@@ -1,19 +1,98 @@
+#include <stdlib.h>
 #include <ncurses.h>
 #include "../include/game.h"
 #include "../include/interface.h"
+#include "../include/argumentos.h"
+#include "../include/lote.h"
+#include "../include/censo.h"
+#include "../include/franjas.h"
+#include "../include/simulacion.h"
+#include "../include/patrones.h"
+#include "../include/instantaneas.h"
+#include "../include/metricas.h"
+#include "../include/grabacion.h"
+#include "../include/servidor.h"
 
 //  ================================================
 //  Conway's Game of Life - Programa Principal
 //  ================================================
 //  Este programa organiza la ejecución del Juego de la Vida de Conway, cuya lógica e interfaz se encuentran en los módulos game.c e interface.c.
 //  El programa principal gestiona la inicialización, el loop principal de ejecución y la limpieza de recursos al finalizar el juego.
+//  Con la opción --sin-interfaz, la simulación se ejecuta sin ncurses (ver lote.c), sin pausas entre generaciones.
+//  Con la opción --desacoplado, las generaciones se calculan en un hilo propio (ver simulacion.c) y este hilo solo lee el teclado y dibuja
+//  la última generación completa a un ritmo fijo de cuadros por segundo, de modo que una generación lenta no retrasa la interfaz ni viceversa.
+//  Con la opción --patron, la configuración inicial se lee de un archivo RLE o de texto plano (ver patrones.c); la tecla [G] guarda la generación actual.
+//  Con la opción --reanudar, la simulación continúa desde una instantánea (ver instantaneas.c).
+//  Con la opción --regla, las generaciones se calculan con otra regla B/S (ver reglas.c); el panel de estado muestra la regla en uso.
+//  El bucle mide el tiempo de cada fase (entrada, cálculo, dibujo y refresco) y el panel muestra su resumen (ver metricas.c); con la opción --metricas,
+//  los resúmenes también se escriben en un archivo CSV o JSON Lines.
+//  Las flechas desplazan la vista y [Z]/[X] cambian su zoom, para recorrer cuadrículas más grandes que la terminal (ver interface.c).
+//  Con la opción --censo, se calculan muchas sopas aleatorias en paralelo y se muestran sus estadísticas, sin ncurses (ver censo.c).
+//  Con la opción --grabar, cada generación calculada se graba en segundo plano (ver grabacion.c); con --reproducir, se reproduce una grabación
+//  hacia adelante o hacia atrás, saltando a cualquier generación desde la clave más cercana.
+//  Con la opción --procesos, la cuadrícula se reparte por franjas de filas entre varios procesos que solo intercambian los bordes, sin ncurses (ver franjas.c).
+//  Con la opción --servidor, la simulación se calcula sin ncurses y sus generaciones se envían a los espectadores conectados (ver servidor.c);
+//  con --conectar, la interfaz dibuja las generaciones que recibe de un servidor en lugar de calcularlas.
 
 // Macros para definir las dimensiones mínimas de la terminal necesarias para mostrar la cuadrícula.
 #define ALTURA_MINIMA_TERMINAL 20    // Altura mínima requerida de la terminal para mostrar la cuadrícula.
 #define ANCHO_MINIMO_TERMINAL 90     // Ancho mínimo requerido de la terminal para mostrar la cuadrícula.
 
-// Función principal del programa.
-int main(void) {
+// Macro para definir el tamaño del nombre de archivo que se usa al guardar sin --guardar.
+#define LONGITUD_NOMBRE_GUARDADO 64
+
+// Macro para definir los dígitos máximos de la generación a la que se salta en una reproducción.
+#define LONGITUD_DESTINO_REPRODUCCION 19
+
+// Función para guardar una generación (calculada con la regla indicada) en la ruta indicada o, si es NULL, en "generacion_<N>.rle". Si no se pudo guardar, avisa con un pitido.
+static void guardarGeneracion(const Fotograma* fotograma, const char* ruta, const char* regla) {
+    char nombre[LONGITUD_NOMBRE_GUARDADO];
+    if (ruta == NULL) {
+        snprintf(nombre, sizeof(nombre), "generacion_%llu.rle", (unsigned long long)fotograma->numGeneracion);
+        ruta = nombre;
+    }
+    if (!guardarPatron(fotograma, ruta, obtenerFormatoPorExtension(ruta), regla)) {
+        beep();
+    }
+}
+
+// Función para cerrar el intervalo de las métricas (si ya terminó) y mostrar el resumen del último intervalo en el panel inferior.
+static void mostrarMetricas(WINDOW* ventana, Metricas* metricas) {
+    actualizarMetricas(metricas);
+    ResumenMetricas resumen;
+    mostrarPanelMetricas(ventana, obtenerResumenMetricas(metricas, &resumen) ? &resumen : NULL);
+}
+
+// Función para procesar las teclas que mueven la vista (flechas) y cambian su zoom ([Z] acercar, [X] alejar). Retorna false si la tecla no corresponde a la vista.
+static bool procesarTeclaVista(int tecla, Vista* vista) {
+    switch (tecla) {
+        case KEY_LEFT:
+            desplazarVista(vista, -1, 0);
+            return true;
+        case KEY_RIGHT:
+            desplazarVista(vista, 1, 0);
+            return true;
+        case KEY_UP:
+            desplazarVista(vista, 0, -1);
+            return true;
+        case KEY_DOWN:
+            desplazarVista(vista, 0, 1);
+            return true;
+        case 'z':
+        case 'Z':
+            cambiarNivelVista(vista, -1);
+            return true;
+        case 'x':
+        case 'X':
+            cambiarNivelVista(vista, 1);
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Función para inicializar ncurses y crear la ventana principal, comprobando que la terminal tenga el tamaño mínimo requerido. Retorna NULL (tras cerrar ncurses y mostrar el error en stderr) si no se pudo.
+static WINDOW* abrirVentanaPrincipal(void) {
     // Inicializamos la interfaz de usuario a través de ncurses.
     inicializarInterfaz();
     // Creamos la ventana principal para mostrar el juego.
@@ -21,7 +100,7 @@ int main(void) {
     if (ventana == NULL) {
         cerrarInterfaz();
         fprintf(stderr, "Error al crear la ventana de ncurses.\n");
-        return 1;
+        return NULL;
     }
 
     // Verificamos que la terminal tenga el tamaño mínimo requerido para mostrar la cuadrícula.
@@ -37,25 +116,437 @@ int main(void) {
             ALTURA_MINIMA_TERMINAL,
             ANCHO_MINIMO_TERMINAL
         );
+        return NULL;
+    }
+    return ventana;
+}
+
+// Función para ejecutar el bucle de reproducción de una grabación: avanza o retrocede a la velocidad indicada, salta entre claves o a la generación escrita, y dibuja cada generación con la vista. Retorna el código de salida del programa.
+static int ejecutarReproduccion(const Opciones* opciones) {
+    // Abrimos la grabación antes de inicializar ncurses, para poder mostrar el error en la terminal.
+    InfoGrabacion info;
+    Reproduccion* reproduccion = abrirReproduccion(opciones->reproducir, &info);
+    if (reproduccion == NULL) {
+        fprintf(stderr, "No se pudo abrir la grabación '%s'.\n", opciones->reproducir);
+        return 1;
+    }
+    WINDOW* ventana = abrirVentanaPrincipal();
+    if (ventana == NULL) {
+        cerrarReproduccion(reproduccion);
+        return 1;
+    }
+    EstadoReproduccion estado = {
+        .primeraGeneracion = info.primeraGeneracion,
+        .ultimaGeneracion = info.ultimaGeneracion,
+        .intervaloClaves = info.intervaloClaves,
+        .numClaves = info.numClaves,
+        .bytes = info.bytes,
+        .indiceReconstruido = info.indiceReconstruido,
+        .velocidad = VELOCIDAD_DEFECTO,
+        .enReproduccion = false,
+        .haciaAtras = false,
+        .destino = NULL,
+    };
+    char destino[LONGITUD_DESTINO_REPRODUCCION + 1] = ""; // Generación que se está escribiendo con las teclas numéricas
+    size_t longitudDestino = 0;
+    Vista vista = {0}; // Región de la cuadrícula que se dibuja (la esquina superior izquierda, sin zoom)
+    bool salir = false;
+    while (salir == false) {
+        // Cada salto o paso se aplica en cuanto se presiona la tecla; si no es posible (no hay más generaciones o la grabación está dañada), avisamos con un pitido.
+        bool posible = true;
+        int tecla = wgetch(ventana);
+        if (tecla >= '0' && tecla <= '9') {
+            if (longitudDestino < LONGITUD_DESTINO_REPRODUCCION) {
+                destino[longitudDestino++] = (char)tecla;
+                destino[longitudDestino] = '\0';
+            }
+        } else if (longitudDestino > 0 && (tecla == '\n' || tecla == KEY_ENTER)) {
+            posible = irAGeneracionReproduccion(reproduccion, strtoull(destino, NULL, 10));
+            longitudDestino = 0;
+        } else if (longitudDestino > 0 && (tecla == KEY_BACKSPACE || tecla == 127 || tecla == '\b')) {
+            destino[--longitudDestino] = '\0';
+        } else if (tecla == 27) {
+            longitudDestino = 0; // [Esc] cancela la generación escrita.
+        } else if (tecla != ERR) {
+            switch (tecla) {
+                case 'q':
+                case 'Q':
+                    salir = true;
+                    break;
+                case 'p':
+                case 'P':
+                    estado.enReproduccion = !estado.enReproduccion;
+                    break;
+                case 'd':
+                case 'D':
+                    estado.haciaAtras = !estado.haciaAtras;
+                    break;
+                case ' ':
+                case '.':
+                    posible = avanzarReproduccion(reproduccion, 1);
+                    break;
+                case ',':
+                    posible = avanzarReproduccion(reproduccion, -1);
+                    break;
+                case ']':
+                    posible = irAClaveReproduccion(reproduccion, 1);
+                    break;
+                case '[':
+                    posible = irAClaveReproduccion(reproduccion, -1);
+                    break;
+                case KEY_HOME:
+                    posible = irAGeneracionReproduccion(reproduccion, info.primeraGeneracion);
+                    break;
+                case KEY_END:
+                    posible = irAGeneracionReproduccion(reproduccion, info.ultimaGeneracion);
+                    break;
+                case '+':
+                case '=':
+                    // Igual que con el hilo separado, se puede llegar a VELOCIDAD_LIBRE (sin pausas entre generaciones).
+                    estado.velocidad = (estado.velocidad > VELOCIDAD_MAXIMA) ? estado.velocidad - VELOCIDAD_PASO : VELOCIDAD_LIBRE;
+                    break;
+                case '-':
+                case '_':
+                    if (estado.velocidad < VELOCIDAD_MAXIMA) {
+                        estado.velocidad = VELOCIDAD_MAXIMA;
+                    } else if (estado.velocidad < VELOCIDAD_MINIMA) {
+                        estado.velocidad += VELOCIDAD_PASO;
+                    }
+                    break;
+                case 'g':
+                case 'G':
+                    guardarGeneracion(obtenerFotogramaReproduccion(reproduccion), opciones->guardar, info.regla);
+                    break;
+                default:
+                    procesarTeclaVista(tecla, &vista);
+                    break;
+            }
+        }
+        if (!posible) {
+            beep();
+        }
+        // En reproducción avanzamos una generación en la dirección elegida; al llegar a un extremo, la reproducción se pone en pausa.
+        if (estado.enReproduccion && !avanzarReproduccion(reproduccion, estado.haciaAtras ? -1 : 1)) {
+            estado.enReproduccion = false;
+        }
+        const Fotograma* fotograma = obtenerFotogramaReproduccion(reproduccion);
+        estado.numGeneracion = fotograma->numGeneracion;
+        estado.destino = (longitudDestino > 0) ? destino : NULL;
+        dibujarFotograma(ventana, fotograma, &vista);
+        mostrarPanelReproduccion(ventana, &estado, info.regla, &vista);
+        actualizarVentana(ventana);
+        napms(estado.enReproduccion ? estado.velocidad : 50);
+    }
+    cerrarReproduccion(reproduccion);
+    cerrarVentana(ventana);
+    cerrarInterfaz();
+    return 0;
+}
+
+// Función para ejecutar el bucle de un espectador: recibe las generaciones del servidor sin esperarlo y dibuja la última recibida a un ritmo fijo de cuadros por segundo, con la vista. Retorna el código de salida del programa.
+static int ejecutarEspectador(const Opciones* opciones) {
+    // Las generaciones las calcula el servidor, por lo que no se admiten las opciones que crean o calculan una simulación.
+    if (opciones->sinInterfaz || opciones->numSopas > 0 || opciones->numProcesos > 0 || opciones->reproducir != NULL || opciones->servidor != NULL ||
+        opciones->patron != NULL || opciones->reanudar != NULL || opciones->instantanea != NULL || opciones->metricas != NULL || opciones->grabar != NULL) {
+        fprintf(stderr, "La opción --conectar no se puede usar con --sin-interfaz, --censo, --procesos, --reproducir, --servidor, --patron, --reanudar, "
+            "--instantanea, --metricas ni --grabar.\n");
+        return 1;
+    }
+    // Nos conectamos antes de inicializar ncurses, para poder mostrar el error en la terminal.
+    Conexion* conexion = conectarServidor(opciones->conectar);
+    if (conexion == NULL) {
+        return 1;
+    }
+    WINDOW* ventana = abrirVentanaPrincipal();
+    if (ventana == NULL) {
+        cerrarConexion(conexion);
+        return 1;
+    }
+    EstadoConexion recibido; // Estado de la conexión (la regla no cambia mientras está abierta)
+    obtenerEstadoConexion(conexion, &recibido);
+    EstadoEspectador estado = {.direccion = opciones->conectar};
+    int esperaFotograma = 1000 / (int)opciones->fotogramasPorSegundo; // Tiempo entre cuadros (en ms).
+    Vista vista = {0}; // Región de la cuadrícula que se dibuja (la esquina superior izquierda, sin zoom)
+    bool salir = false;
+    while (salir == false) {
+        bool vistaCambiada = false; // Indica si la vista cambió, por lo que hay que dibujar aunque no haya una generación nueva
+        int tecla;
+        while ((tecla = wgetch(ventana)) != ERR) {
+            switch (tecla) {
+                case 'q':
+                case 'Q':
+                    salir = true;
+                    break;
+                case 'g':
+                case 'G':
+                    // Guardamos la generación que está en pantalla (es una copia propia, por lo que el servidor no se entera).
+                    if (obtenerFotogramaConexion(conexion) != NULL) {
+                        guardarGeneracion(obtenerFotogramaConexion(conexion), opciones->guardar, recibido.regla);
+                    }
+                    break;
+                default:
+                    vistaCambiada = procesarTeclaVista(tecla, &vista) || vistaCambiada;
+                    break;
+            }
+        }
+        // Aplicamos todo lo recibido desde el cuadro anterior y dibujamos solo la última generación. Si el servidor terminó, se sigue mostrando la última.
+        bool nuevo;
+        recibirConexion(conexion, &nuevo);
+        obtenerEstadoConexion(conexion, &recibido);
+        const Fotograma* fotograma = obtenerFotogramaConexion(conexion);
+        if (fotograma != NULL && (nuevo || vistaCambiada)) {
+            dibujarFotograma(ventana, fotograma, &vista);
+        }
+        estado.numGeneracion = (fotograma != NULL) ? fotograma->numGeneracion : 0;
+        estado.velocidad = recibido.velocidad;
+        estado.conectado = recibido.conectada;
+        estado.fotogramas = recibido.fotogramas;
+        estado.claves = recibido.claves;
+        estado.saltadas = recibido.saltadas;
+        estado.bytes = recibido.bytes;
+        mostrarPanelEspectador(ventana, &estado, recibido.regla, &vista);
+        actualizarVentana(ventana);
+        napms(esperaFotograma);
+    }
+    cerrarConexion(conexion);
+    cerrarVentana(ventana);
+    cerrarInterfaz();
+    return 0;
+}
+
+// Función para ejecutar el bucle de la interfaz con la simulación en un hilo separado, que graba cada generación si grabador no es NULL. Retorna false si no se pudo iniciar el hilo de simulación.
+static bool ejecutarDesacoplado(WINDOW* ventana, Cuadricula* cuadricula, unsigned fotogramasPorSegundo, const char* rutaGuardado, Metricas* metricas, Grabador* grabador) {
+    int velocidad = VELOCIDAD_DEFECTO; // Velocidad de evolución del juego (en ms; VELOCIDAD_LIBRE = sin pausas).
+    const char* regla = obtenerReglaCuadricula(cuadricula)->texto; // La regla no cambia mientras corre la simulación, por lo que se puede leer desde este hilo.
+    // El hilo de simulación registra el cálculo de cada generación (y la graba); este hilo registra la entrada, el dibujo y el refresco.
+    Simulacion* simulacion = iniciarSimulacion(cuadricula, velocidad, metricas, grabador);
+    if (simulacion == NULL) {
+        return false;
+    }
+    int esperaFotograma = 1000 / (int)fotogramasPorSegundo; // Tiempo entre cuadros (en ms).
+
+    const Fotograma* fotogramaDibujado = NULL; // Último fotograma dibujado (válido hasta pedir el siguiente)
+    Vista vista = {0}; // Región de la cuadrícula que se dibuja (la esquina superior izquierda, sin zoom)
+    bool salir = false;
+    while (salir == false) {
+        bool vistaCambiada = false; // Indica si la vista cambió, por lo que hay que dibujar aunque no haya un fotograma nuevo
+        // Procesamos todas las teclas presionadas desde el cuadro anterior. Los comandos solo se encolan, por lo que nunca esperan a la simulación.
+        uint64_t inicioFase = obtenerInstanteMetricas();
+        int tecla;
+        while ((tecla = wgetch(ventana)) != ERR) {
+            switch (tecla) {
+                case 'q':
+                case 'Q':
+                    salir = true;
+                    break;
+                case 'p':
+                case 'P':
+                    alternarEjecucionSimulacion(simulacion);
+                    break;
+                case ' ':
+                    avanzarGeneracionSimulacion(simulacion);
+                    break;
+                case '+':
+                case '=':
+                    // Con el hilo separado se puede llegar a VELOCIDAD_LIBRE (sin pausas entre generaciones).
+                    velocidad = (velocidad > VELOCIDAD_MAXIMA) ? velocidad - VELOCIDAD_PASO : VELOCIDAD_LIBRE;
+                    configurarVelocidadSimulacion(simulacion, velocidad);
+                    break;
+                case '-':
+                case '_':
+                    if (velocidad < VELOCIDAD_MAXIMA) {
+                        velocidad = VELOCIDAD_MAXIMA;
+                    } else if (velocidad < VELOCIDAD_MINIMA) {
+                        velocidad += VELOCIDAD_PASO;
+                    }
+                    configurarVelocidadSimulacion(simulacion, velocidad);
+                    break;
+                case 'r':
+                case 'R':
+                    reiniciarSimulacion(simulacion);
+                    break;
+                case 'g':
+                case 'G':
+                    // Guardamos la generación que está en pantalla (el fotograma de lectura pertenece a este hilo, por lo que no se detiene la simulación).
+                    if (fotogramaDibujado != NULL) {
+                        guardarGeneracion(fotogramaDibujado, rutaGuardado, regla);
+                    }
+                    break;
+                default:
+                    vistaCambiada = procesarTeclaVista(tecla, &vista) || vistaCambiada;
+                    break;
+            }
+        }
+        registrarFase(metricas, FASE_ENTRADA, inicioFase);
+        // Dibujamos la última generación completa (solo las células que cambiaron) y el panel de estado.
+        inicioFase = obtenerInstanteMetricas();
+        bool nuevo;
+        const Fotograma* fotograma = obtenerUltimoFotogramaSimulacion(simulacion, &nuevo);
+        if (nuevo || vistaCambiada) {
+            dibujarFotograma(ventana, fotograma, &vista);
+        }
+        fotogramaDibujado = fotograma;
+        mostrarPanelEstado(ventana, fotograma->numGeneracion, velocidad, simulacionEnEjecucion(simulacion), regla, &vista);
+        mostrarMetricas(ventana, metricas);
+        registrarFase(metricas, FASE_DIBUJO, inicioFase);
+        inicioFase = obtenerInstanteMetricas();
+        actualizarVentana(ventana);
+        registrarFase(metricas, FASE_REFRESCO, inicioFase);
+        napms(esperaFotograma);
+    }
+    detenerSimulacion(simulacion);
+    return true;
+}
+
+// Función principal del programa.
+int main(int argc, char* argv[]) {
+    // Interpretamos los argumentos de la línea de comandos antes de inicializar ncurses, para poder mostrar los errores en la terminal.
+    Opciones opciones;
+    if (!analizarArgumentos(argc, argv, &opciones)) {
+        mostrarAyuda(stderr, argv[0]);
+        return 1;
+    }
+    if (opciones.mostrarAyuda) {
+        mostrarAyuda(stdout, argv[0]);
+        return 0;
+    }
+    // El servidor tampoco usa ncurses: calcula la simulación y envía sus generaciones hasta recibir Ctrl+C. Un espectador dibuja las que recibe.
+    if (opciones.servidor != NULL) {
+        return ejecutarServidor(&opciones);
+    }
+    if (opciones.conectar != NULL) {
+        return ejecutarEspectador(&opciones);
+    }
+    // El cálculo por franjas tampoco usa ncurses: repartimos la cuadrícula entre los procesos y mostramos el resumen.
+    if (opciones.numProcesos > 0) {
+        return ejecutarFranjas(&opciones);
+    }
+    // El censo de sopas tampoco usa ncurses: calculamos todas las sopas y mostramos sus estadísticas.
+    if (opciones.numSopas > 0) {
+        return ejecutarCenso(&opciones);
+    }
+    // En el modo sin interfaz no se usa ncurses: calculamos las generaciones (o saltamos a una generación grabada) y mostramos el resumen.
+    if (opciones.sinInterfaz) {
+        return ejecutarLote(&opciones);
+    }
+    // Una reproducción solo dibuja las generaciones de la grabación, sin calcular ninguna.
+    if (opciones.reproducir != NULL) {
+        return ejecutarReproduccion(&opciones);
+    }
+    // El modo interactivo dibuja una cuadrícula, por lo que solo admite el motor de cuadrícula.
+    if (opciones.motor != MOTOR_CUADRICULA) {
+        fprintf(stderr, "El motor '%s' solo está disponible con --sin-interfaz.\n", obtenerNombreMotor(opciones.motor));
+        return 1;
+    }
+    // Con --patron o --reanudar, leemos el archivo antes de inicializar ncurses, para poder mostrar los errores y avisos en la terminal.
+    // La regla de --regla (ya validada) reemplaza a la del archivo.
+    Regla regla;
+    bool reglaIndicada = compilarRegla(opciones.regla, &regla);
+    Cuadricula* cuadricula = NULL;
+    if (opciones.reanudar != NULL || opciones.patron != NULL) {
+        char reglaArchivo[LONGITUD_MAXIMA_REGLA];
+        if (opciones.reanudar != NULL) {
+            InfoInstantanea info;
+            cuadricula = cargarInstantanea(opciones.reanudar, &info);
+            if (cuadricula == NULL) {
+                fprintf(stderr, "No se pudo cargar la instantánea '%s'.\n", opciones.reanudar);
+                return 1;
+            }
+            snprintf(reglaArchivo, sizeof(reglaArchivo), "%s", info.regla);
+        } else {
+            InfoPatron info;
+            cuadricula = crearCuadriculaDesdePatron(opciones.patron, opciones.ancho, opciones.alto, &info);
+            if (cuadricula == NULL) {
+                fprintf(stderr, "No se pudo leer el patrón '%s'.\n", opciones.patron);
+                return 1;
+            }
+            snprintf(reglaArchivo, sizeof(reglaArchivo), "%s", info.regla);
+        }
+        if (reglaIndicada) {
+            configurarReglaCuadricula(cuadricula, &regla);
+        } else if (!compilarRegla(reglaArchivo, &regla)) {
+            fprintf(stderr, "Aviso: la regla '%s' no es una regla B/S válida; se calcula con %s.\n", reglaArchivo, REGLA_CONWAY);
+        }
+        // [R] sigue generando configuraciones aleatorias con la semilla y el porcentaje de las opciones.
+        configurarRellenoCuadricula(cuadricula, opciones.semilla, opciones.porcentaje);
+    }
+
+    // Inicializamos ncurses y creamos la ventana principal para mostrar el juego.
+    WINDOW* ventana = abrirVentanaPrincipal();
+    if (ventana == NULL) {
+        liberarCuadricula(cuadricula);
         return 1;
     }
 
-    // Creamos la cuadrícula del juego con dimensiones definidas.
-    Cuadricula* cuadricula = crearCuadricula(ANCHO_CUADRICULA, ALTO_CUADRICULA);
+    // Creamos la cuadrícula del juego (si no se leyó de un patrón) con las dimensiones, la semilla, la regla y la configuración de cálculo indicadas.
     if (cuadricula == NULL) {
+        cuadricula = crearCuadriculaConHilos(opciones.ancho, opciones.alto, opciones.semilla, opciones.porcentaje, reglaIndicada ? &regla : NULL, opciones.numHilos);
+    }
+    if (cuadricula == NULL || !configurarHilosCuadricula(cuadricula, opciones.numHilos) || !seleccionarKernelCuadricula(cuadricula, opciones.kernel)) {
+        liberarCuadricula(cuadricula);
         cerrarVentana(ventana);
         cerrarInterfaz();
         fprintf(stderr, "No se pudo crear la cuadrícula.\n");
         return 1;
     }
+    // Creamos las métricas que muestra el panel (y que se escriben en el archivo de --metricas, si se indicó). El conteo de cambios da los nacimientos, las muertes y la población sin recorrer la cuadrícula.
+    Metricas* metricas = crearMetricas((uint64_t)cuadricula->ancho * cuadricula->alto, opciones.metricas, obtenerFormatoMetricasPorExtension(opciones.metricas));
+    if (metricas == NULL) {
+        liberarCuadricula(cuadricula);
+        cerrarVentana(ventana);
+        cerrarInterfaz();
+        fprintf(stderr, "No se pudo crear el archivo de métricas '%s'.\n", (opciones.metricas != NULL) ? opciones.metricas : "");
+        return 1;
+    }
+    configurarConteoCambios(cuadricula, true);
+    // Con --grabar, grabamos desde la generación inicial; la grabación termina al salir o al reiniciar la cuadrícula.
+    Grabador* grabador = NULL;
+    if (opciones.grabar != NULL) {
+        grabador = crearGrabador(cuadricula, opciones.grabar, opciones.intervaloClaves);
+        if (grabador == NULL) {
+            liberarMetricas(metricas);
+            liberarCuadricula(cuadricula);
+            cerrarVentana(ventana);
+            cerrarInterfaz();
+            fprintf(stderr, "No se pudo crear la grabación '%s'.\n", opciones.grabar);
+            return 1;
+        }
+    }
+    // Con --desacoplado, la simulación corre en su propio hilo y este bucle solo dibuja y lee el teclado.
+    if (opciones.desacoplado) {
+        bool exito = ejecutarDesacoplado(ventana, cuadricula, opciones.fotogramasPorSegundo, opciones.guardar, metricas, grabador);
+        bool metricasEscritas = finalizarMetricas(metricas);
+        bool grabacionEscrita = grabador == NULL || finalizarGrabador(grabador, NULL);
+        liberarMetricas(metricas);
+        liberarCuadricula(cuadricula);
+        cerrarVentana(ventana);
+        cerrarInterfaz();
+        if (!exito) {
+            fprintf(stderr, "No se pudo iniciar el hilo de simulación.\n");
+            return 1;
+        }
+        if (!metricasEscritas) {
+            fprintf(stderr, "No se pudieron escribir las métricas en '%s'.\n", opciones.metricas);
+            return 1;
+        }
+        if (!grabacionEscrita) {
+            fprintf(stderr, "No se pudo escribir la grabación en '%s'.\n", opciones.grabar);
+            return 1;
+        }
+        return 0;
+    }
+
     // Configuramos las variables iniciales del juego.
     bool enEjecucion = false; // Indica si el juego está en ejecución (true) o en pausa (false).
     int velocidad = VELOCIDAD_DEFECTO; // Velocidad de evolución del juego (en ms).
+    Vista vista = {0}; // Región de la cuadrícula que se dibuja (la esquina superior izquierda, sin zoom).
+    bool grabando = grabador != NULL; // Indica si las generaciones calculadas se siguen grabando.
 
     // Dibujamos la cuadrícula inicial en la ventana.
-    dibujarCuadricula(ventana, cuadricula);
+    dibujarCuadricula(ventana, cuadricula, &vista);
     // Mostramos el panel de estado y controles.
-    mostrarPanelEstado(ventana, obtenerNumGeneracion(cuadricula), velocidad, enEjecucion);
+    mostrarPanelEstado(ventana, obtenerNumGeneracion(cuadricula), velocidad, enEjecucion, obtenerReglaCuadricula(cuadricula)->texto, &vista);
+    mostrarMetricas(ventana, metricas);
     // Actualizamos la ventana para reflejar los cambios.
     actualizarVentana(ventana);
 
@@ -65,6 +556,8 @@ int main(void) {
 
     while (salir == false) {
         // Verificamos si hay una tecla presionada.
+        uint64_t inicioFase = obtenerInstanteMetricas();
+        bool avanzar = false; // Indica si se pidió avanzar una generación en pausa.
         tecla = wgetch(ventana);
 
         if (tecla != ERR) {
@@ -78,9 +571,7 @@ int main(void) {
                     enEjecucion = !enEjecucion; // Alternamos entre ejecución y pausa.
                     break;
                 case ' ':
-                    if (!enEjecucion) {
-                        calcularCuadriculaSiguiente(cuadricula); // Avanzamos una generación si está en pausa.
-                    }
+                    avanzar = !enEjecucion; // Avanzamos una generación si está en pausa (se calcula después, para medirla aparte de la entrada).
                     break;
                 case '+':
                 case '=':
@@ -99,18 +590,39 @@ int main(void) {
                     reiniciarCuadricula(cuadricula); // Reiniciamos la cuadrícula.
                     enEjecucion = false; // Ponemos el juego en pausa.
                     break;
+                case 'g':
+                case 'G': {
+                    Fotograma actual = obtenerVistaCuadricula(cuadricula);
+                    guardarGeneracion(&actual, opciones.guardar, obtenerReglaCuadricula(cuadricula)->texto); // Guardamos la generación actual.
+                    break;
+                }
                 default:
+                    procesarTeclaVista(tecla, &vista); // Movemos la vista o cambiamos su zoom.
                     break;
             }
         }
-        // Si el juego está en ejecución, calculamos la siguiente generación.
-        if (enEjecucion) {
+        registrarFase(metricas, FASE_ENTRADA, inicioFase);
+        // Si el juego está en ejecución (o se pidió avanzar), calculamos la siguiente generación.
+        if (enEjecucion || avanzar) {
+            inicioFase = obtenerInstanteMetricas();
             calcularCuadriculaSiguiente(cuadricula);
+            registrarFase(metricas, FASE_CALCULO, inicioFase);
+            registrarGeneracionCuadricula(metricas, cuadricula);
+            // Tras reiniciar la cuadrícula las generaciones ya no siguen a las grabadas: la grabación termina en la última (y avisamos con un pitido).
+            if (grabando && !registrarGeneracionGrabacion(grabador, cuadricula)) {
+                grabando = false;
+                beep();
+            }
         }
         // Actualizamos la cuadrícula y el panel de estado.
-        dibujarCuadricula(ventana, cuadricula);
-        mostrarPanelEstado(ventana, obtenerNumGeneracion(cuadricula), velocidad, enEjecucion);
+        inicioFase = obtenerInstanteMetricas();
+        dibujarCuadricula(ventana, cuadricula, &vista);
+        mostrarPanelEstado(ventana, obtenerNumGeneracion(cuadricula), velocidad, enEjecucion, obtenerReglaCuadricula(cuadricula)->texto, &vista);
+        mostrarMetricas(ventana, metricas);
+        registrarFase(metricas, FASE_DIBUJO, inicioFase);
+        inicioFase = obtenerInstanteMetricas();
         actualizarVentana(ventana);
+        registrarFase(metricas, FASE_REFRESCO, inicioFase);
 
         // Designamos un tiempo de espera según el estado de ejecución y la velocidad.
         if (enEjecucion) {
@@ -120,9 +632,20 @@ int main(void) {
         }
     }
     // Liberamos los recursos antes de salir.
+    bool metricasEscritas = finalizarMetricas(metricas);
+    bool grabacionEscrita = grabador == NULL || finalizarGrabador(grabador, NULL);
+    liberarMetricas(metricas);
     liberarCuadricula(cuadricula);
     cerrarVentana(ventana);
     cerrarInterfaz();
+    if (!metricasEscritas) {
+        fprintf(stderr, "No se pudieron escribir las métricas en '%s'.\n", opciones.metricas);
+        return 1;
+    }
+    if (!grabacionEscrita) {
+        fprintf(stderr, "No se pudo escribir la grabación en '%s'.\n", opciones.grabar);
+        return 1;
+    }
 
     return 0;
 }
@@ -0,0 +1,105 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include "../include/memoria.h"
+
+//  ================================================
+//  Conway's Game of Life - Memoria con Páginas Grandes
+//  ================================================
+//  Este módulo reserva los bloques grandes de memoria del programa (las dos generaciones de la cuadrícula y los fotogramas).
+//
+//  CARACTERÍSTICAS PRINCIPALES:
+//  1. Páginas Grandes:
+//      - Con páginas de 4 KiB, recorrer una cuadrícula de varios GiB necesita cientos de miles de entradas de la TLB, que no caben en ella.
+//      - Los bloques de TAMANO_PAGINA_GRANDE bytes o más se proyectan con mmap. Primero se piden páginas grandes explícitas (MAP_HUGETLB), que
+//        solo existen si el administrador las reservó (vm.nr_hugepages); si no, se usa una proyección normal alineada a 2 MiB y se pide al
+//        núcleo que la respalde con páginas grandes transparentes (madvise(MADV_HUGEPAGE)).
+//      - Los bloques pequeños se reservan con aligned_alloc, alineados a la línea de caché.
+//
+//  2. Primer Contacto (first-touch):
+//      - Las páginas de una proyección nueva ya valen 0 y no se asignan hasta que se escriben por primera vez, en el nodo NUMA del hilo que
+//        las escribe. Por eso los bloques proyectados no se limpian con memset: el código que los usa decide qué hilo toca cada parte (ver game.c).
+
+// Alineación de los bloques pequeños (una línea de caché).
+#define ALINEACION_BLOQUE_PEQUENO 64
+
+// Nombres de los tipos de páginas, en el orden de TipoPaginas.
+static const char* NOMBRES_PAGINAS[NUM_TIPOS_PAGINAS] = {"normales", "transparentes", "grandes"};
+
+// Función para proyectar bytes bytes (múltiplo de TAMANO_PAGINA_GRANDE) alineados a TAMANO_PAGINA_GRANDE, con páginas normales. Retorna NULL si no hay memoria suficiente.
+// NOTA: mmap solo garantiza la alineación a la página base, por lo que se proyecta una página grande de más y se devuelven los extremos sobrantes.
+static void* proyectarAlineado(size_t bytes) {
+    size_t bytesProyectados = bytes + TAMANO_PAGINA_GRANDE;
+    uint8_t* proyeccion = (uint8_t*)mmap(NULL, bytesProyectados, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (proyeccion == MAP_FAILED) {
+        return NULL;
+    }
+    size_t sobranteInicio = (TAMANO_PAGINA_GRANDE - (uintptr_t)proyeccion % TAMANO_PAGINA_GRANDE) % TAMANO_PAGINA_GRANDE;
+    size_t sobranteFin = TAMANO_PAGINA_GRANDE - sobranteInicio;
+    if (sobranteInicio > 0) {
+        munmap(proyeccion, sobranteInicio);
+    }
+    munmap(proyeccion + sobranteInicio + bytes, sobranteFin);
+    return proyeccion + sobranteInicio;
+}
+
+// Función para reservar un bloque de al menos bytes bytes, con todas sus palabras en 0.
+bool reservarBloqueMemoria(BloqueMemoria* bloque, size_t bytes) {
+    memset(bloque, 0, sizeof(*bloque));
+    if (bytes < TAMANO_PAGINA_GRANDE) {
+        // aligned_alloc exige que el tamaño sea múltiplo de la alineación.
+        size_t bytesAlineados = (bytes + ALINEACION_BLOQUE_PEQUENO - 1) / ALINEACION_BLOQUE_PEQUENO * ALINEACION_BLOQUE_PEQUENO;
+        bloque->direccion = aligned_alloc(ALINEACION_BLOQUE_PEQUENO, (bytesAlineados > 0) ? bytesAlineados : ALINEACION_BLOQUE_PEQUENO);
+        if (bloque->direccion == NULL) {
+            return false;
+        }
+        memset(bloque->direccion, 0, bytesAlineados);
+        bloque->bytes = bytesAlineados;
+        bloque->paginas = PAGINAS_NORMALES;
+        return true;
+    }
+    size_t bytesProyectados = (bytes + TAMANO_PAGINA_GRANDE - 1) / TAMANO_PAGINA_GRANDE * TAMANO_PAGINA_GRANDE;
+    bloque->bytes = bytesProyectados;
+    bloque->proyectado = true;
+#ifdef MAP_HUGETLB
+    // Las páginas grandes explícitas se asignan de la reserva del sistema; si está vacía (lo habitual), mmap falla y seguimos con las transparentes.
+    void* proyeccion = mmap(NULL, bytesProyectados, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (proyeccion != MAP_FAILED) {
+        bloque->direccion = proyeccion;
+        bloque->paginas = PAGINAS_GRANDES;
+        return true;
+    }
+#endif
+    bloque->direccion = proyectarAlineado(bytesProyectados);
+    if (bloque->direccion == NULL) {
+        memset(bloque, 0, sizeof(*bloque));
+        return false;
+    }
+    bloque->paginas = PAGINAS_NORMALES;
+#ifdef MADV_HUGEPAGE
+    // Si el núcleo no tiene páginas grandes transparentes (o están desactivadas), el bloque sigue siendo válido con páginas normales.
+    if (madvise(bloque->direccion, bytesProyectados, MADV_HUGEPAGE) == 0) {
+        bloque->paginas = PAGINAS_TRANSPARENTES;
+    }
+#endif
+    return true;
+}
+
+// Función para liberar un bloque reservado con reservarBloqueMemoria (se admite un bloque vacío).
+void liberarBloqueMemoria(BloqueMemoria* bloque) {
+    if (bloque == NULL || bloque->direccion == NULL) {
+        return;
+    }
+    if (bloque->proyectado) {
+        munmap(bloque->direccion, bloque->bytes);
+    } else {
+        free(bloque->direccion);
+    }
+    memset(bloque, 0, sizeof(*bloque));
+}
+
+// Función para obtener el nombre de un tipo de páginas (por ejemplo, "transparentes").
+const char* obtenerNombrePaginas(TipoPaginas paginas) {
+    return (paginas >= 0 && paginas < NUM_TIPOS_PAGINAS) ? NOMBRES_PAGINAS[paginas] : "desconocidas";
+}
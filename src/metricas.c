@@ -0,0 +1,391 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <pthread.h>
+#include "../include/metricas.h"
+
+//  ================================================
+//  Conway's Game of Life - Métricas
+//  ================================================
+//  Este módulo mide dónde se va el tiempo de la simulación, con un costo bajo para poder dejarlo activado en producción.
+//
+//  CARACTERÍSTICAS PRINCIPALES:
+//  1. Fases:
+//      - Cada fase (entrada, cálculo, dibujo y refresco) se mide con el reloj monótono, con una lectura al empezar y otra al terminar.
+//      - Cada medición actualiza, en tiempo constante, la cantidad, la suma, el mínimo, el máximo y un histograma logarítmico del intervalo en curso.
+//      - El histograma divide cada potencia de 2 (en ns) en 16 partes iguales, por lo que el p99 se obtiene sin guardar las mediciones, con un error
+//        relativo de hasta 1/16.
+//
+//  2. Intervalos:
+//      - Cada INTERVALO_METRICAS segundos, actualizarMetricas cierra el intervalo en curso: calcula su resumen (el que muestra el panel de estado),
+//        escribe su línea en el archivo de métricas y lo acumula en los totales.
+//      - Las generaciones, la población, los nacimientos y las muertes se registran por generación, y se resumen como generaciones y células por
+//        segundo y nacimientos y muertes por generación.
+//
+//  3. Exportación:
+//      - CSV (una cabecera y una fila por intervalo) o JSON Lines (un objeto por línea), según la extensión del archivo.
+//      - Cada línea se envía al archivo al cerrar su intervalo, de modo que se puede seguir una ejecución larga mientras corre.
+//
+//  NOTA: Las fases se pueden registrar desde varios hilos (por ejemplo, el cálculo desde el hilo de simulación y el dibujo desde el hilo de la interfaz).
+//  Cada registro toma un mutex que casi nunca está ocupado, lo que cuesta unas decenas de ns frente a los µs o ms de cada fase.
+
+// Macros para el histograma de tiempos: los valores menores que SUBINTERVALOS_HISTOGRAMA ns tienen una cubeta propia, y cada potencia de 2 mayor se divide en SUBINTERVALOS_HISTOGRAMA cubetas.
+#define BITS_SUBINTERVALO 4
+#define SUBINTERVALOS_HISTOGRAMA (1u << BITS_SUBINTERVALO)
+#define NUM_CUBETAS_HISTOGRAMA ((64 - BITS_SUBINTERVALO + 1) * SUBINTERVALOS_HISTOGRAMA)
+
+// Macros para las conversiones de unidades.
+#define NANOSEGUNDOS_POR_SEGUNDO 1000000000ull
+#define NANOSEGUNDOS_POR_MICROSEGUNDO 1000.0
+
+// Percentil de los tiempos que se informa, además del mínimo, el promedio y el máximo.
+#define PERCENTIL_TIEMPOS 0.99
+
+// Nombres de las fases, en el orden de FaseMetricas.
+static const char* const NOMBRES_FASE[NUM_FASES_METRICAS] = {"entrada", "calculo", "dibujo", "refresco"};
+
+// Estadísticas de una fase (en ns).
+typedef struct {
+    uint64_t muestras;
+    uint64_t suma;
+    uint64_t minimo;
+    uint64_t maximo;
+    uint32_t cubetas[NUM_CUBETAS_HISTOGRAMA];
+} EstadisticasFase;
+
+// Definición de la estructura de las métricas.
+struct Metricas {
+    pthread_mutex_t mutex;                          // Protege todos los campos siguientes
+    FILE* archivo;                                  // Archivo de métricas (NULL = no se exportan)
+    FormatoMetricas formato;
+    bool errorEscritura;                            // Indica si alguna línea no se pudo escribir
+    bool finalizadas;                               // Indica si ya se llamó a finalizarMetricas
+    uint64_t celulasPorGeneracion;
+    uint64_t instanteCreacion;                      // Instantes (en ns) de la creación y del inicio del intervalo en curso
+    uint64_t inicioIntervalo;
+    EstadisticasFase fases[NUM_FASES_METRICAS];     // Intervalo en curso
+    EstadisticasFase totales[NUM_FASES_METRICAS];   // Intervalos cerrados
+    uint64_t generaciones;                          // Generaciones registradas en el intervalo en curso
+    uint64_t sumaNacimientos;
+    uint64_t sumaMuertes;
+    uint64_t numGeneracion;                         // Última generación registrada
+    uint64_t poblacion;                             // Población de la última generación registrada
+    bool hayResumen;                                // Indica si ya se cerró algún intervalo
+    ResumenMetricas resumen;                        // Resumen del último intervalo cerrado
+};
+
+// Función para obtener el instante actual (en nanosegundos, de un reloj monótono), que marca el inicio de una fase.
+uint64_t obtenerInstanteMetricas(void) {
+    struct timespec tiempo;
+    clock_gettime(CLOCK_MONOTONIC, &tiempo);
+    return (uint64_t)tiempo.tv_sec * NANOSEGUNDOS_POR_SEGUNDO + (uint64_t)tiempo.tv_nsec;
+}
+
+// Función para obtener la cubeta del histograma que corresponde a una duración (en ns).
+static unsigned obtenerCubeta(uint64_t duracion) {
+    if (duracion < SUBINTERVALOS_HISTOGRAMA) {
+        return (unsigned)duracion;
+    }
+    // El exponente es la posición del bit más alto, y los BITS_SUBINTERVALO bits siguientes indican la parte de esa potencia de 2.
+    unsigned exponente = 63u - (unsigned)__builtin_clzll(duracion);
+    unsigned subintervalo = (unsigned)(duracion >> (exponente - BITS_SUBINTERVALO)) & (SUBINTERVALOS_HISTOGRAMA - 1);
+    return (exponente - BITS_SUBINTERVALO + 1) * SUBINTERVALOS_HISTOGRAMA + subintervalo;
+}
+
+// Función para obtener la mayor duración (en ns) que corresponde a una cubeta del histograma.
+static uint64_t obtenerLimiteCubeta(unsigned cubeta) {
+    if (cubeta < SUBINTERVALOS_HISTOGRAMA) {
+        return cubeta;
+    }
+    unsigned exponente = cubeta / SUBINTERVALOS_HISTOGRAMA + BITS_SUBINTERVALO - 1;
+    uint64_t ancho = 1ull << (exponente - BITS_SUBINTERVALO);
+    uint64_t inicio = (uint64_t)(SUBINTERVALOS_HISTOGRAMA + cubeta % SUBINTERVALOS_HISTOGRAMA) * ancho;
+    return inicio + ancho - 1;
+}
+
+// Función para dejar vacías las estadísticas de una fase.
+static void vaciarEstadisticas(EstadisticasFase* estadisticas) {
+    memset(estadisticas, 0, sizeof(EstadisticasFase));
+    estadisticas->minimo = UINT64_MAX;
+}
+
+// Función para agregar las estadísticas de una fase a otras.
+static void combinarEstadisticas(EstadisticasFase* total, const EstadisticasFase* parcial) {
+    if (parcial->muestras == 0) {
+        return;
+    }
+    total->muestras += parcial->muestras;
+    total->suma += parcial->suma;
+    total->minimo = (parcial->minimo < total->minimo) ? parcial->minimo : total->minimo;
+    total->maximo = (parcial->maximo > total->maximo) ? parcial->maximo : total->maximo;
+    for (unsigned i = 0; i < NUM_CUBETAS_HISTOGRAMA; i++) {
+        total->cubetas[i] += parcial->cubetas[i];
+    }
+}
+
+// Función para resumir las estadísticas de una fase en microsegundos.
+static TiemposFase resumirEstadisticas(const EstadisticasFase* estadisticas) {
+    TiemposFase tiempos = {0};
+    if (estadisticas->muestras == 0) {
+        return tiempos;
+    }
+    tiempos.muestras = estadisticas->muestras;
+    tiempos.minimo = (double)estadisticas->minimo / NANOSEGUNDOS_POR_MICROSEGUNDO;
+    tiempos.maximo = (double)estadisticas->maximo / NANOSEGUNDOS_POR_MICROSEGUNDO;
+    tiempos.promedio = (double)estadisticas->suma / (double)estadisticas->muestras / NANOSEGUNDOS_POR_MICROSEGUNDO;
+    // El percentil es el límite de la primera cubeta que acumula al menos ese porcentaje de las muestras (sin pasar del máximo observado).
+    uint64_t posicion = (uint64_t)((double)estadisticas->muestras * PERCENTIL_TIEMPOS + 0.999999);
+    uint64_t acumuladas = 0;
+    for (unsigned i = 0; i < NUM_CUBETAS_HISTOGRAMA; i++) {
+        acumuladas += estadisticas->cubetas[i];
+        if (acumuladas >= posicion) {
+            uint64_t limite = obtenerLimiteCubeta(i);
+            tiempos.p99 = (double)((limite < estadisticas->maximo) ? limite : estadisticas->maximo) / NANOSEGUNDOS_POR_MICROSEGUNDO;
+            break;
+        }
+    }
+    return tiempos;
+}
+
+// Función para escribir la cabecera del archivo de métricas (solo en CSV).
+static void escribirCabecera(Metricas* metricas) {
+    if (metricas->formato != FORMATO_METRICAS_CSV) {
+        return;
+    }
+    fprintf(metricas->archivo, "tiempo_s,duracion_s,generacion,generaciones,generaciones_s,celulas_s,poblacion,nacimientos_gen,muertes_gen");
+    for (unsigned fase = 0; fase < NUM_FASES_METRICAS; fase++) {
+        const char* nombre = NOMBRES_FASE[fase];
+        fprintf(metricas->archivo, ",%s_muestras,%s_min_us,%s_prom_us,%s_p99_us,%s_max_us", nombre, nombre, nombre, nombre, nombre);
+    }
+    fprintf(metricas->archivo, "\n");
+}
+
+// Función para escribir la línea de un resumen en el archivo de métricas.
+static void escribirResumen(Metricas* metricas, const ResumenMetricas* resumen) {
+    FILE* archivo = metricas->archivo;
+    if (metricas->formato == FORMATO_METRICAS_JSON) {
+        fprintf(archivo, "{\"tiempo_s\":%.6f,\"duracion_s\":%.6f,\"generacion\":%llu,\"generaciones\":%llu,\"generaciones_s\":%.6g,\"celulas_s\":%.6g,"
+            "\"poblacion\":%llu,\"nacimientos_gen\":%.6g,\"muertes_gen\":%.6g,\"fases\":{", resumen->tiempo, resumen->duracion,
+            (unsigned long long)resumen->numGeneracion, (unsigned long long)resumen->generaciones, resumen->generacionesPorSegundo,
+            resumen->celulasPorSegundo, (unsigned long long)resumen->poblacion, resumen->nacimientosPorGeneracion, resumen->muertesPorGeneracion);
+        for (unsigned fase = 0; fase < NUM_FASES_METRICAS; fase++) {
+            const TiemposFase* tiempos = &resumen->fases[fase];
+            fprintf(archivo, "%s\"%s\":{\"muestras\":%llu,\"min_us\":%.3f,\"prom_us\":%.3f,\"p99_us\":%.3f,\"max_us\":%.3f}", (fase > 0) ? "," : "",
+                NOMBRES_FASE[fase], (unsigned long long)tiempos->muestras, tiempos->minimo, tiempos->promedio, tiempos->p99, tiempos->maximo);
+        }
+        fprintf(archivo, "}}\n");
+    } else {
+        fprintf(archivo, "%.6f,%.6f,%llu,%llu,%.6g,%.6g,%llu,%.6g,%.6g", resumen->tiempo, resumen->duracion, (unsigned long long)resumen->numGeneracion,
+            (unsigned long long)resumen->generaciones, resumen->generacionesPorSegundo, resumen->celulasPorSegundo, (unsigned long long)resumen->poblacion,
+            resumen->nacimientosPorGeneracion, resumen->muertesPorGeneracion);
+        for (unsigned fase = 0; fase < NUM_FASES_METRICAS; fase++) {
+            const TiemposFase* tiempos = &resumen->fases[fase];
+            fprintf(archivo, ",%llu,%.3f,%.3f,%.3f,%.3f", (unsigned long long)tiempos->muestras, tiempos->minimo, tiempos->promedio, tiempos->p99, tiempos->maximo);
+        }
+        fprintf(archivo, "\n");
+    }
+    // Enviamos la línea al archivo en cada intervalo, para poder seguirlo mientras la simulación corre.
+    if (fflush(archivo) != 0 || ferror(archivo)) {
+        metricas->errorEscritura = true;
+    }
+}
+
+// Función para cerrar el intervalo en curso (con el mutex tomado): calcula su resumen, escribe su línea, lo acumula en los totales y empieza el siguiente.
+static void cerrarIntervalo(Metricas* metricas, uint64_t ahora) {
+    ResumenMetricas* resumen = &metricas->resumen;
+    resumen->tiempo = (double)(ahora - metricas->instanteCreacion) / (double)NANOSEGUNDOS_POR_SEGUNDO;
+    resumen->duracion = (double)(ahora - metricas->inicioIntervalo) / (double)NANOSEGUNDOS_POR_SEGUNDO;
+    resumen->numGeneracion = metricas->numGeneracion;
+    resumen->generaciones = metricas->generaciones;
+    resumen->generacionesPorSegundo = (resumen->duracion > 0.0) ? (double)metricas->generaciones / resumen->duracion : 0.0;
+    resumen->celulasPorSegundo = resumen->generacionesPorSegundo * (double)metricas->celulasPorGeneracion;
+    resumen->poblacion = metricas->poblacion;
+    double generaciones = (metricas->generaciones > 0) ? (double)metricas->generaciones : 1.0;
+    resumen->nacimientosPorGeneracion = (double)metricas->sumaNacimientos / generaciones;
+    resumen->muertesPorGeneracion = (double)metricas->sumaMuertes / generaciones;
+    for (unsigned fase = 0; fase < NUM_FASES_METRICAS; fase++) {
+        resumen->fases[fase] = resumirEstadisticas(&metricas->fases[fase]);
+        combinarEstadisticas(&metricas->totales[fase], &metricas->fases[fase]);
+        vaciarEstadisticas(&metricas->fases[fase]);
+    }
+    metricas->hayResumen = true;
+    if (metricas->archivo != NULL) {
+        escribirResumen(metricas, resumen);
+    }
+    metricas->generaciones = 0;
+    metricas->sumaNacimientos = 0;
+    metricas->sumaMuertes = 0;
+    metricas->inicioIntervalo = ahora;
+}
+
+// Función para crear las métricas de una simulación de celulasPorGeneracion células. Si ruta no es NULL, se escribe una línea por intervalo en ese archivo con el formato indicado. Retorna NULL si no se pudo crear el archivo o no hay memoria suficiente.
+Metricas* crearMetricas(uint64_t celulasPorGeneracion, const char* ruta, FormatoMetricas formato) {
+    Metricas* metricas = (Metricas*)calloc(1, sizeof(Metricas));
+    if (metricas == NULL) {
+        return NULL;
+    }
+    if (ruta != NULL) {
+        metricas->archivo = fopen(ruta, "w");
+        if (metricas->archivo == NULL) {
+            free(metricas);
+            return NULL;
+        }
+    }
+    pthread_mutex_init(&metricas->mutex, NULL);
+    metricas->formato = formato;
+    metricas->celulasPorGeneracion = celulasPorGeneracion;
+    for (unsigned fase = 0; fase < NUM_FASES_METRICAS; fase++) {
+        vaciarEstadisticas(&metricas->fases[fase]);
+        vaciarEstadisticas(&metricas->totales[fase]);
+    }
+    metricas->instanteCreacion = obtenerInstanteMetricas();
+    metricas->inicioIntervalo = metricas->instanteCreacion;
+    if (metricas->archivo != NULL) {
+        escribirCabecera(metricas);
+    }
+    return metricas;
+}
+
+// Función para cerrar el intervalo en curso (escribiendo su línea) y el archivo de métricas. Retorna false si alguna línea no se pudo escribir.
+bool finalizarMetricas(Metricas* metricas) {
+    if (metricas == NULL) {
+        return true;
+    }
+    pthread_mutex_lock(&metricas->mutex);
+    if (!metricas->finalizadas) {
+        metricas->finalizadas = true;
+        // El último intervalo suele ser más corto que INTERVALO_METRICAS, pero también se escribe si registró algo.
+        bool intervaloConDatos = metricas->generaciones > 0;
+        for (unsigned fase = 0; fase < NUM_FASES_METRICAS; fase++) {
+            intervaloConDatos = intervaloConDatos || metricas->fases[fase].muestras > 0;
+        }
+        if (intervaloConDatos) {
+            cerrarIntervalo(metricas, obtenerInstanteMetricas());
+        }
+        if (metricas->archivo != NULL && fclose(metricas->archivo) != 0) {
+            metricas->errorEscritura = true;
+        }
+        metricas->archivo = NULL;
+    }
+    bool exito = !metricas->errorEscritura;
+    pthread_mutex_unlock(&metricas->mutex);
+    return exito;
+}
+
+// Función para liberar las métricas (si no se finalizaron, se finalizan antes).
+void liberarMetricas(Metricas* metricas) {
+    if (metricas == NULL) {
+        return;
+    }
+    finalizarMetricas(metricas);
+    pthread_mutex_destroy(&metricas->mutex);
+    free(metricas);
+}
+
+// Función para registrar una fase que empezó en el instante inicio y termina ahora. Se puede llamar desde varios hilos. Si metricas es NULL, no hace nada.
+void registrarFase(Metricas* metricas, FaseMetricas fase, uint64_t inicio) {
+    if (metricas == NULL || fase >= NUM_FASES_METRICAS) {
+        return;
+    }
+    // Leemos el reloj antes de tomar el mutex, para no medir la espera.
+    uint64_t duracion = obtenerInstanteMetricas() - inicio;
+    pthread_mutex_lock(&metricas->mutex);
+    EstadisticasFase* estadisticas = &metricas->fases[fase];
+    estadisticas->muestras++;
+    estadisticas->suma += duracion;
+    estadisticas->minimo = (duracion < estadisticas->minimo) ? duracion : estadisticas->minimo;
+    estadisticas->maximo = (duracion > estadisticas->maximo) ? duracion : estadisticas->maximo;
+    estadisticas->cubetas[obtenerCubeta(duracion)]++;
+    pthread_mutex_unlock(&metricas->mutex);
+}
+
+// Función para registrar una generación calculada, con su población y sus nacimientos y muertes. Se puede llamar desde varios hilos. Si metricas es NULL, no hace nada.
+void registrarGeneracionMetricas(Metricas* metricas, uint64_t numGeneracion, uint64_t poblacion, uint64_t nacimientos, uint64_t muertes) {
+    if (metricas == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&metricas->mutex);
+    metricas->generaciones++;
+    metricas->sumaNacimientos += nacimientos;
+    metricas->sumaMuertes += muertes;
+    metricas->numGeneracion = numGeneracion;
+    metricas->poblacion = poblacion;
+    pthread_mutex_unlock(&metricas->mutex);
+}
+
+// Función para registrar la generación actual de una cuadrícula, con su población y, si el conteo de cambios está activado, sus nacimientos y muertes. Si metricas es NULL, no hace nada.
+void registrarGeneracionCuadricula(Metricas* metricas, Cuadricula* cuadricula) {
+    if (metricas == NULL || cuadricula == NULL) {
+        return;
+    }
+    // Con el conteo de cambios, la población se mantiene de forma incremental, por lo que contarPoblacion no recorre la cuadrícula.
+    uint64_t nacimientos = 0, muertes = 0;
+    obtenerCambiosCuadricula(cuadricula, &nacimientos, &muertes);
+    registrarGeneracionMetricas(metricas, obtenerNumGeneracion(cuadricula), contarPoblacion(cuadricula), nacimientos, muertes);
+}
+
+// Función para cerrar el intervalo en curso si ya pasaron INTERVALO_METRICAS segundos, actualizando el resumen y escribiendo su línea. Retorna true si se cerró un intervalo.
+bool actualizarMetricas(Metricas* metricas) {
+    if (metricas == NULL) {
+        return false;
+    }
+    uint64_t ahora = obtenerInstanteMetricas();
+    bool cerrado = false;
+    pthread_mutex_lock(&metricas->mutex);
+    if (!metricas->finalizadas && (double)(ahora - metricas->inicioIntervalo) >= INTERVALO_METRICAS * (double)NANOSEGUNDOS_POR_SEGUNDO) {
+        cerrarIntervalo(metricas, ahora);
+        cerrado = true;
+    }
+    pthread_mutex_unlock(&metricas->mutex);
+    return cerrado;
+}
+
+// Función para obtener el resumen del último intervalo cerrado. Retorna false si aún no se cerró ninguno.
+bool obtenerResumenMetricas(Metricas* metricas, ResumenMetricas* resumen) {
+    if (metricas == NULL || resumen == NULL) {
+        return false;
+    }
+    pthread_mutex_lock(&metricas->mutex);
+    bool hayResumen = metricas->hayResumen;
+    if (hayResumen) {
+        *resumen = metricas->resumen;
+    }
+    pthread_mutex_unlock(&metricas->mutex);
+    return hayResumen;
+}
+
+// Función para obtener los tiempos de una fase desde la creación de las métricas (todos los intervalos).
+TiemposFase obtenerTiemposTotalesFase(Metricas* metricas, FaseMetricas fase) {
+    TiemposFase tiempos = {0};
+    if (metricas == NULL || fase >= NUM_FASES_METRICAS) {
+        return tiempos;
+    }
+    // Combinamos los intervalos cerrados con el intervalo en curso, sin modificar ninguno.
+    EstadisticasFase* total = (EstadisticasFase*)malloc(sizeof(EstadisticasFase));
+    if (total == NULL) {
+        return tiempos;
+    }
+    pthread_mutex_lock(&metricas->mutex);
+    *total = metricas->totales[fase];
+    combinarEstadisticas(total, &metricas->fases[fase]);
+    pthread_mutex_unlock(&metricas->mutex);
+    tiempos = resumirEstadisticas(total);
+    free(total);
+    return tiempos;
+}
+
+// Función para obtener el formato de métricas que corresponde a la extensión de un archivo (.json o .jsonl = JSON; cualquier otra = CSV).
+FormatoMetricas obtenerFormatoMetricasPorExtension(const char* ruta) {
+    const char* extension = (ruta != NULL) ? strrchr(ruta, '.') : NULL;
+    if (extension != NULL && (strcasecmp(extension, ".json") == 0 || strcasecmp(extension, ".jsonl") == 0)) {
+        return FORMATO_METRICAS_JSON;
+    }
+    return FORMATO_METRICAS_CSV;
+}
+
+// Función para obtener el nombre de una fase (por ejemplo, "calculo").
+const char* obtenerNombreFase(FaseMetricas fase) {
+    return (fase < NUM_FASES_METRICAS) ? NOMBRES_FASE[fase] : "desconocida";
+}
@@ -0,0 +1,488 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../include/patrones.h"
+
+//  ================================================
+//  Conway's Game of Life - Patrones
+//  ================================================
+//  Este módulo lee y escribe patrones en los formatos estándar RLE (.rle) y texto plano (.cells).
+//
+//  CARACTERÍSTICAS PRINCIPALES:
+//  1. Lectura en Flujo:
+//      - El archivo se proyecta en memoria con mmap (sin copiarlo a un buffer) y se recorre una sola vez, de principio a fin.
+//      - Cada tramo de células vivas ("25o" en RLE, "OOO" en texto plano) se escribe directamente en las filas empaquetadas de la cuadrícula
+//        con establecerTramoCelulas, palabra por palabra, sin reservar memoria por célula ni construir una lista intermedia.
+//      - En RLE, las dimensiones se toman de la cabecera; en texto plano, de un recorrido previo que solo busca los saltos de línea.
+//
+//  2. Reglas:
+//      - Se lee la regla de la cabecera RLE ("rule = B3/S23") o de un comentario "#r 23/3" (notación antigua S/B).
+//      - crearCuadriculaDesdePatron aplica la regla a la cuadrícula (ver reglas.c) si es una regla B/S válida; si no, se informa en InfoPatron
+//        y la cuadrícula calcula B3/S23.
+//
+//  3. Escritura:
+//      - RLE: los tramos de cada fila se buscan de a 64 células con __builtin_ctzll, se agrupan los saltos de fila ("3$") y las líneas
+//        no superan los 70 caracteres. Las filas vacías del final se omiten.
+//      - Texto plano: una línea por fila, sin los puntos del final de cada línea.
+//      - La salida pasa por un buffer grande de stdio, para escribir el archivo en pocas llamadas al sistema.
+
+// Longitud máxima de las líneas de un archivo RLE (recomendada por el formato).
+#define LONGITUD_MAXIMA_LINEA_RLE 70
+// Tamaño del buffer de escritura de los archivos.
+#define TAMANO_BUFFER_ESCRITURA (1 << 16)
+
+// Definición de un archivo proyectado en memoria.
+typedef struct {
+    const char* datos;
+    size_t tamano;
+} ArchivoMapeado;
+
+// Función para proyectar un archivo en memoria (solo lectura). Retorna false si no existe, está vacío o no se pudo proyectar.
+static bool abrirArchivoMapeado(const char* ruta, ArchivoMapeado* archivo) {
+    int descriptor = open(ruta, O_RDONLY);
+    if (descriptor < 0) {
+        return false;
+    }
+    struct stat estado;
+    if (fstat(descriptor, &estado) != 0 || estado.st_size <= 0) {
+        close(descriptor);
+        return false;
+    }
+    void* datos = mmap(NULL, (size_t)estado.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor); // La proyección sigue siendo válida después de cerrar el descriptor.
+    if (datos == MAP_FAILED) {
+        return false;
+    }
+    // El archivo se lee una sola vez y en orden: el kernel puede leer por adelantado y descartar las páginas ya leídas.
+    madvise(datos, (size_t)estado.st_size, MADV_SEQUENTIAL);
+    archivo->datos = (const char*)datos;
+    archivo->tamano = (size_t)estado.st_size;
+    return true;
+}
+
+// Función para liberar la proyección de un archivo.
+static void cerrarArchivoMapeado(ArchivoMapeado* archivo) {
+    munmap((void*)archivo->datos, archivo->tamano);
+}
+
+// Función para avanzar el cursor hasta el siguiente salto de línea (o el final) y retornar el inicio de la línea siguiente.
+static const char* saltarLinea(const char* cursor, const char* fin) {
+    const char* salto = (const char*)memchr(cursor, '\n', (size_t)(fin - cursor));
+    return (salto != NULL) ? salto + 1 : fin;
+}
+
+// Función para leer un número decimal (saturado en SIZE_MAX) a partir del cursor. Retorna false si no hay ningún dígito.
+static bool leerEntero(const char** cursor, const char* fin, size_t* valor) {
+    const char* c = *cursor;
+    size_t numero = 0;
+    while (c < fin && isdigit((unsigned char)*c)) {
+        size_t digito = (size_t)(*c - '0');
+        numero = (numero > (SIZE_MAX - digito) / 10) ? SIZE_MAX : numero * 10 + digito;
+        c++;
+    }
+    if (c == *cursor) {
+        return false;
+    }
+    *cursor = c;
+    *valor = numero;
+    return true;
+}
+
+// Función para copiar en destino el texto [inicio, fin) sin los espacios de los extremos (truncado a LONGITUD_MAXIMA_REGLA - 1 caracteres).
+static void copiarRegla(char* destino, const char* inicio, const char* fin) {
+    while (inicio < fin && isspace((unsigned char)*inicio)) {
+        inicio++;
+    }
+    while (fin > inicio && isspace((unsigned char)fin[-1])) {
+        fin--;
+    }
+    size_t longitud = (size_t)(fin - inicio);
+    if (longitud > LONGITUD_MAXIMA_REGLA - 1) {
+        longitud = LONGITUD_MAXIMA_REGLA - 1;
+    }
+    memcpy(destino, inicio, longitud);
+    destino[longitud] = '\0';
+}
+
+// Función para leer los comentarios y la cabecera ("x = m, y = n, rule = B3/S23") de un archivo RLE. Retorna el inicio de los tramos, o NULL si la cabecera no es válida.
+static const char* leerCabeceraRLE(const char* cursor, const char* fin, InfoPatron* info) {
+    // Comentarios y líneas vacías antes de la cabecera. "#r" indica la regla en la notación antigua.
+    while (cursor < fin) {
+        while (cursor < fin && isspace((unsigned char)*cursor)) {
+            cursor++;
+        }
+        if (cursor == fin || *cursor != '#') {
+            break;
+        }
+        const char* siguiente = saltarLinea(cursor, fin);
+        if (siguiente - cursor >= 2 && cursor[1] == 'r') {
+            copiarRegla(info->regla, cursor + 2, siguiente);
+        }
+        cursor = siguiente;
+    }
+    if (cursor == fin || *cursor != 'x') {
+        return NULL;
+    }
+    // La cabecera es una lista "clave = valor" separada por comas; x e y son obligatorias.
+    const char* finLinea = saltarLinea(cursor, fin);
+    bool hayAncho = false, hayAlto = false;
+    while (cursor < finLinea) {
+        while (cursor < finLinea && (isspace((unsigned char)*cursor) || *cursor == ',')) {
+            cursor++;
+        }
+        const char* clave = cursor;
+        while (cursor < finLinea && isalpha((unsigned char)*cursor)) {
+            cursor++;
+        }
+        size_t longitudClave = (size_t)(cursor - clave);
+        while (cursor < finLinea && (*cursor == ' ' || *cursor == '\t')) {
+            cursor++;
+        }
+        if (longitudClave == 0 || cursor == finLinea || *cursor != '=') {
+            break;
+        }
+        cursor++;
+        while (cursor < finLinea && (*cursor == ' ' || *cursor == '\t')) {
+            cursor++;
+        }
+        const char* valor = cursor;
+        while (cursor < finLinea && *cursor != ',') {
+            cursor++;
+        }
+        size_t numero;
+        const char* inicioNumero = valor;
+        if (longitudClave == 1 && (*clave == 'x' || *clave == 'y')) {
+            if (!leerEntero(&inicioNumero, cursor, &numero) || numero > UINT_MAX) {
+                return NULL;
+            }
+            if (*clave == 'x') {
+                info->ancho = (unsigned)numero;
+                hayAncho = true;
+            } else {
+                info->alto = (unsigned)numero;
+                hayAlto = true;
+            }
+        } else if (longitudClave == 4 && strncmp(clave, "rule", 4) == 0) {
+            copiarRegla(info->regla, valor, cursor);
+        }
+    }
+    return (hayAncho && hayAlto) ? finLinea : NULL;
+}
+
+// Función para escribir los tramos RLE [cursor, fin) en la cuadrícula, con la esquina superior izquierda del patrón en (x0, y0). Las células fuera de la cuadrícula se descartan.
+static void escribirTramosRLE(Cuadricula* cuadricula, const char* cursor, const char* fin, size_t x0, size_t y0) {
+    size_t x = x0, y = y0;
+    while (cursor < fin) {
+        // Número de repeticiones (1 si se omite), leído sin llamadas porque se repite en casi todos los elementos.
+        size_t repeticiones = 1;
+        if (*cursor >= '0' && *cursor <= '9') {
+            repeticiones = 0;
+            do {
+                size_t digito = (size_t)(*cursor++ - '0');
+                repeticiones = (repeticiones > (SIZE_MAX - digito) / 10) ? SIZE_MAX : repeticiones * 10 + digito;
+            } while (cursor < fin && *cursor >= '0' && *cursor <= '9');
+            if (cursor == fin) {
+                break;
+            }
+        }
+        char simbolo = *cursor++;
+        if (simbolo == 'b' || simbolo == '.') {
+            x = (repeticiones > SIZE_MAX - x) ? SIZE_MAX : x + repeticiones;
+        } else if (simbolo == '$') {
+            y = (repeticiones > SIZE_MAX - y) ? SIZE_MAX : y + repeticiones;
+            x = x0;
+        } else if (simbolo == '!') {
+            break; // Fin del patrón (lo que sigue es un comentario).
+        } else if (isalpha((unsigned char)simbolo)) {
+            // 'o' es una célula viva; otras letras son estados de reglas con más estados, que también se toman como vivos.
+            if (x < cuadricula->ancho && y < cuadricula->alto) {
+                establecerTramoCelulas(cuadricula, (uint32_t)x, (uint32_t)y, repeticiones, true);
+            }
+            x = (repeticiones > SIZE_MAX - x) ? SIZE_MAX : x + repeticiones;
+        }
+        // Los espacios y saltos de línea entre los tramos se ignoran.
+    }
+}
+
+// Función para saber si un carácter de una línea de texto plano es una célula viva.
+static inline bool esCelulaVivaTextoPlano(char c) {
+    return c == 'O' || c == 'o' || c == '*';
+}
+
+// Función para medir un patrón de texto plano (las líneas que empiezan con '!' son comentarios). Retorna false si no tiene ninguna fila.
+static bool medirTextoPlano(const char* cursor, const char* fin, InfoPatron* info) {
+    size_t ancho = 0, alto = 0;
+    while (cursor < fin) {
+        const char* siguiente = saltarLinea(cursor, fin);
+        if (*cursor != '!') {
+            const char* finFila = siguiente;
+            while (finFila > cursor && (finFila[-1] == '\n' || finFila[-1] == '\r')) {
+                finFila--;
+            }
+            if ((size_t)(finFila - cursor) > ancho) {
+                ancho = (size_t)(finFila - cursor);
+            }
+            alto++;
+        }
+        cursor = siguiente;
+    }
+    if (alto == 0 || ancho > UINT_MAX || alto > UINT_MAX) {
+        return false;
+    }
+    info->ancho = (unsigned)ancho;
+    info->alto = (unsigned)alto;
+    return true;
+}
+
+// Función para escribir las filas de texto plano [cursor, fin) en la cuadrícula, con la esquina superior izquierda del patrón en (x0, y0).
+static void escribirTextoPlano(Cuadricula* cuadricula, const char* cursor, const char* fin, size_t x0, size_t y0) {
+    size_t y = y0;
+    while (cursor < fin && y < cuadricula->alto) {
+        const char* siguiente = saltarLinea(cursor, fin);
+        if (*cursor == '!') {
+            cursor = siguiente;
+            continue;
+        }
+        // Buscamos los tramos de células vivas consecutivas y escribimos cada uno de una vez.
+        const char* c = cursor;
+        while (c < siguiente) {
+            if (!esCelulaVivaTextoPlano(*c)) {
+                c++;
+                continue;
+            }
+            const char* inicioTramo = c;
+            while (c < siguiente && esCelulaVivaTextoPlano(*c)) {
+                c++;
+            }
+            size_t x = x0 + (size_t)(inicioTramo - cursor);
+            if (x < cuadricula->ancho) {
+                establecerTramoCelulas(cuadricula, (uint32_t)x, (uint32_t)y, (size_t)(c - inicioTramo), true);
+            }
+        }
+        cursor = siguiente;
+        y++;
+    }
+}
+
+// Función para leer la información de un patrón proyectado en memoria, detectando el formato por su contenido. Retorna el inicio de las células, o NULL si el patrón no es válido.
+static const char* leerInfoPatron(const ArchivoMapeado* archivo, InfoPatron* info) {
+    const char* cursor = archivo->datos;
+    const char* fin = archivo->datos + archivo->tamano;
+    memset(info, 0, sizeof(InfoPatron));
+    strcpy(info->regla, REGLA_CONWAY);
+
+    const char* primero = cursor;
+    while (primero < fin && isspace((unsigned char)*primero)) {
+        primero++;
+    }
+    // Un archivo RLE empieza con comentarios '#' o con la cabecera "x = ..."; uno de texto plano, con comentarios '!' o con las filas.
+    if (primero < fin && (*primero == '!' || *primero == '.' || esCelulaVivaTextoPlano(*primero))) {
+        info->formato = FORMATO_TEXTO_PLANO;
+        return medirTextoPlano(cursor, fin, info) ? cursor : NULL;
+    }
+    info->formato = FORMATO_RLE;
+    return leerCabeceraRLE(cursor, fin, info);
+}
+
+// Función para escribir las células de un patrón (ya leída su información) centrado en la cuadrícula, que debe estar vacía.
+static void escribirPatron(Cuadricula* cuadricula, const ArchivoMapeado* archivo, const char* celulas, const InfoPatron* info) {
+    size_t x0 = (cuadricula->ancho - info->ancho) / 2;
+    size_t y0 = (cuadricula->alto - info->alto) / 2;
+    const char* fin = archivo->datos + archivo->tamano;
+    if (info->formato == FORMATO_TEXTO_PLANO) {
+        escribirTextoPlano(cuadricula, celulas, fin, x0, y0);
+    } else {
+        escribirTramosRLE(cuadricula, celulas, fin, x0, y0);
+    }
+}
+
+// Función para crear una cuadrícula con el patrón de un archivo (RLE o texto plano, detectado por su contenido), centrado en la cuadrícula. La cuadrícula mide al menos anchoMinimo x altoMinimo, o más si el patrón es más grande. Si info no es NULL, se completa con la información del patrón. Retorna NULL si el archivo no existe, no es válido o no cabe en una cuadrícula.
+Cuadricula* crearCuadriculaDesdePatron(const char* ruta, uint32_t anchoMinimo, uint32_t altoMinimo, InfoPatron* info) {
+    ArchivoMapeado archivo;
+    if (!abrirArchivoMapeado(ruta, &archivo)) {
+        return NULL;
+    }
+    InfoPatron informacion;
+    const char* celulas = leerInfoPatron(&archivo, &informacion);
+    if (celulas == NULL || informacion.ancho > DIMENSION_MAXIMA || informacion.alto > DIMENSION_MAXIMA) {
+        cerrarArchivoMapeado(&archivo);
+        return NULL;
+    }
+    uint32_t ancho = (informacion.ancho > anchoMinimo) ? (uint32_t)informacion.ancho : anchoMinimo;
+    uint32_t alto = (informacion.alto > altoMinimo) ? (uint32_t)informacion.alto : altoMinimo;
+    // Con 0% de células vivas, la cuadrícula se crea vacía (sin generar números aleatorios). Si la regla del patrón no es una regla B/S válida, se calcula con B3/S23.
+    Regla regla;
+    Cuadricula* cuadricula = crearCuadriculaConRegla(ancho, alto, 0, 0, compilarRegla(informacion.regla, &regla) ? &regla : NULL);
+    if (cuadricula != NULL) {
+        escribirPatron(cuadricula, &archivo, celulas, &informacion);
+        if (info != NULL) {
+            *info = informacion;
+        }
+    }
+    cerrarArchivoMapeado(&archivo);
+    return cuadricula;
+}
+
+// Función para reemplazar las células de una cuadrícula por el patrón de un archivo, centrado, y reiniciar el número de generación. Retorna false (sin modificar la cuadrícula) si el archivo no es válido o el patrón no cabe en la cuadrícula.
+bool cargarPatronEnCuadricula(Cuadricula* cuadricula, const char* ruta, InfoPatron* info) {
+    if (cuadricula == NULL) {
+        return false;
+    }
+    ArchivoMapeado archivo;
+    if (!abrirArchivoMapeado(ruta, &archivo)) {
+        return false;
+    }
+    InfoPatron informacion;
+    const char* celulas = leerInfoPatron(&archivo, &informacion);
+    bool valido = celulas != NULL && informacion.ancho <= cuadricula->ancho && informacion.alto <= cuadricula->alto;
+    if (valido) {
+        limpiarCuadricula(cuadricula);
+        escribirPatron(cuadricula, &archivo, celulas, &informacion);
+        if (info != NULL) {
+            *info = informacion;
+        }
+    }
+    cerrarArchivoMapeado(&archivo);
+    return valido;
+}
+
+// Función para buscar la primera célula de la fila con el estado indicado a partir de la columna desde. Retorna ancho si no hay ninguna.
+static size_t buscarCelula(const uint64_t* fila, size_t ancho, size_t desde, bool viva) {
+    size_t p = desde / BITS_POR_PALABRA;
+    size_t numPalabras = PALABRAS_POR_FILA(ancho);
+    if (p >= numPalabras) {
+        return ancho;
+    }
+    // Invertimos las palabras para buscar células muertas, y descartamos los bits anteriores a desde en la primera palabra.
+    uint64_t invertir = viva ? 0 : ~(uint64_t)0;
+    uint64_t palabra = (fila[p] ^ invertir) & (~(uint64_t)0 << (desde % BITS_POR_PALABRA));
+    while (palabra == 0) {
+        if (++p == numPalabras) {
+            return ancho;
+        }
+        palabra = fila[p] ^ invertir;
+    }
+    size_t columna = p * BITS_POR_PALABRA + (size_t)__builtin_ctzll(palabra);
+    return (columna < ancho) ? columna : ancho;
+}
+
+// Definición del estado de la escritura de un archivo RLE: la línea actual se arma en memoria y se escribe completa, para no llamar a stdio por cada elemento.
+typedef struct {
+    FILE* archivo;
+    size_t columna;                                 // Caracteres de la línea actual
+    char linea[LONGITUD_MAXIMA_LINEA_RLE + 1];      // Línea actual (más el salto de línea)
+} EscrituraRLE;
+
+// Función para escribir la línea actual en el archivo y empezar una nueva.
+static void terminarLineaRLE(EscrituraRLE* escritura) {
+    escritura->linea[escritura->columna++] = '\n';
+    fwrite(escritura->linea, 1, escritura->columna, escritura->archivo);
+    escritura->columna = 0;
+}
+
+// Función para escribir un elemento RLE ("12o", "b", "3$"...), pasando a la línea siguiente si no cabe en la actual.
+static void escribirElementoRLE(EscrituraRLE* escritura, size_t repeticiones, char simbolo) {
+    // Armamos el elemento de atrás hacia adelante: primero el símbolo y luego los dígitos de las repeticiones (si son más de 1).
+    char elemento[24];
+    size_t inicio = sizeof(elemento) - 1;
+    elemento[inicio] = simbolo;
+    for (size_t resto = repeticiones; repeticiones > 1 && resto > 0; resto /= 10) {
+        elemento[--inicio] = (char)('0' + resto % 10);
+    }
+    size_t longitud = sizeof(elemento) - inicio;
+    if (escritura->columna + longitud > LONGITUD_MAXIMA_LINEA_RLE) {
+        terminarLineaRLE(escritura);
+    }
+    memcpy(escritura->linea + escritura->columna, elemento + inicio, longitud);
+    escritura->columna += longitud;
+}
+
+// Función para escribir un fotograma en formato RLE.
+static void guardarRLE(FILE* archivo, const Fotograma* fotograma, const char* regla) {
+    fprintf(archivo, "#C Generacion %llu\n", (unsigned long long)fotograma->numGeneracion);
+    fprintf(archivo, "x = %u, y = %u, rule = %s\n", (unsigned)fotograma->ancho, (unsigned)fotograma->alto, regla);
+    EscrituraRLE escritura;
+    escritura.archivo = archivo;
+    escritura.columna = 0;
+    size_t saltosPendientes = 0; // Filas terminadas que aún no se escribieron (se agrupan en un solo "n$" antes del siguiente tramo)
+    for (uint32_t y = 0; y < fotograma->alto; y++) {
+        const uint64_t* fila = FILA_FOTOGRAMA(fotograma, y);
+        size_t x = 0; // Columna siguiente al último tramo escrito
+        size_t inicioTramo;
+        while ((inicioTramo = buscarCelula(fila, fotograma->ancho, x, true)) < fotograma->ancho) {
+            size_t finTramo = buscarCelula(fila, fotograma->ancho, inicioTramo, false);
+            if (saltosPendientes > 0) {
+                escribirElementoRLE(&escritura, saltosPendientes, '$');
+                saltosPendientes = 0;
+            }
+            if (inicioTramo > x) {
+                escribirElementoRLE(&escritura, inicioTramo - x, 'b');
+            }
+            escribirElementoRLE(&escritura, finTramo - inicioTramo, 'o');
+            x = finTramo;
+        }
+        // Las células muertas del final de la fila no se escriben.
+        saltosPendientes++;
+    }
+    escribirElementoRLE(&escritura, 1, '!');
+    terminarLineaRLE(&escritura);
+}
+
+// Función para escribir un fotograma en formato de texto plano.
+static void guardarTextoPlano(FILE* archivo, const Fotograma* fotograma) {
+    fprintf(archivo, "!Generacion %llu\n", (unsigned long long)fotograma->numGeneracion);
+    for (uint32_t y = 0; y < fotograma->alto; y++) {
+        const uint64_t* fila = FILA_FOTOGRAMA(fotograma, y);
+        size_t x = 0;
+        size_t inicioTramo;
+        while ((inicioTramo = buscarCelula(fila, fotograma->ancho, x, true)) < fotograma->ancho) {
+            size_t finTramo = buscarCelula(fila, fotograma->ancho, inicioTramo, false);
+            for (; x < inicioTramo; x++) {
+                fputc('.', archivo);
+            }
+            for (; x < finTramo; x++) {
+                fputc('O', archivo);
+            }
+        }
+        // Una fila vacía se escribe como un punto, para que la línea no quede en blanco.
+        if (x == 0) {
+            fputc('.', archivo);
+        }
+        fputc('\n', archivo);
+    }
+}
+
+// Función para guardar un fotograma (por ejemplo, la vista de una cuadrícula) en un archivo, con la regla indicada (NULL = REGLA_CONWAY). Retorna false si no se pudo escribir el archivo.
+bool guardarPatron(const Fotograma* fotograma, const char* ruta, FormatoPatron formato, const char* regla) {
+    if (fotograma == NULL || ruta == NULL) {
+        return false;
+    }
+    FILE* archivo = fopen(ruta, "w");
+    if (archivo == NULL) {
+        return false;
+    }
+    setvbuf(archivo, NULL, _IOFBF, TAMANO_BUFFER_ESCRITURA);
+    if (formato == FORMATO_TEXTO_PLANO) {
+        guardarTextoPlano(archivo, fotograma);
+    } else {
+        guardarRLE(archivo, fotograma, (regla != NULL) ? regla : REGLA_CONWAY);
+    }
+    bool exito = !ferror(archivo);
+    return (fclose(archivo) == 0) && exito;
+}
+
+// Función para elegir el formato según la extensión del archivo (".cells" o ".txt" = texto plano; cualquier otra = RLE).
+FormatoPatron obtenerFormatoPorExtension(const char* ruta) {
+    const char* extension = (ruta != NULL) ? strrchr(ruta, '.') : NULL;
+    if (extension != NULL && (strcasecmp(extension, ".cells") == 0 || strcasecmp(extension, ".txt") == 0)) {
+        return FORMATO_TEXTO_PLANO;
+    }
+    return FORMATO_RLE;
+}
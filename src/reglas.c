@@ -0,0 +1,137 @@
+#include <string.h>
+#include <ctype.h>
+#include <pthread.h>
+#include "../include/reglas.h"
+
+//  ================================================
+//  Conway's Game of Life - Reglas
+//  ================================================
+//  Este módulo interpreta reglas "life-like" en notación B/S y las compila en una tabla de transición para los kernels de cálculo.
+//
+//  CARACTERÍSTICAS PRINCIPALES:
+//  1. Notaciones aceptadas:
+//      - B/S ("B36/S23"), con las partes invertidas ("S23/B36") o la notación antigua S/B ("23/36"), sin distinguir mayúsculas.
+//      - La regla se guarda como dos conjuntos de bits (nacimiento y supervivencia) y como texto B/S canónico, con las vecinas en orden.
+//
+//  2. Tabla de transición compilada:
+//      - Los kernels cuentan las vecinas de 64 células a la vez como bits separados (unidades, dos, cuatro y ocho).
+//      - La regla es una función de esos bits y del estado de la célula, que se evalúa con un árbol de selectores (x ^ ((x ^ y) & bit)).
+//      - Las hojas del árbol son máscaras de 0 o ~0 calculadas una sola vez al compilar la regla, por lo que el bucle de cálculo no tiene
+//        ramas ni accesos indexados por célula, y el costo es el mismo para cualquier regla.
+//      - Disposición de las máscaras: para cada índice i = viva * 4 + cuatro * 2 + dos, la entrada 2i es el resultado con las unidades en 0
+//        y la entrada 2i + 1 es la diferencia con las unidades en 1. Las entradas 16 y 17 corrigen el caso de 8 vecinas (ver kernels.c).
+
+// Regla de Conway compilada una sola vez.
+static Regla reglaConway;
+static pthread_once_t compilacionConway = PTHREAD_ONCE_INIT;
+
+// Macro para convertir un bit (0 o 1) en una máscara de 64 bits (0 o ~0).
+#define MASCARA_BIT(bit) ((bit) ? ~(uint64_t)0 : 0)
+
+// Función para leer una lista de dígitos (0 a 8) como un conjunto de bits (bit n = n vecinas). Retorna false si hay otro carácter.
+static bool leerConjuntoVecinas(const char* inicio, const char* fin, uint16_t* conjunto) {
+    *conjunto = 0;
+    for (const char* c = inicio; c < fin; c++) {
+        if (*c < '0' || *c > '8') {
+            return false;
+        }
+        *conjunto |= (uint16_t)(1u << (*c - '0'));
+    }
+    return true;
+}
+
+// Función para escribir un conjunto de vecinas como dígitos en orden creciente. Retorna el número de caracteres escritos.
+static size_t escribirConjuntoVecinas(char* destino, uint16_t conjunto) {
+    size_t longitud = 0;
+    for (unsigned n = 0; n < NUM_VALORES_VECINAS; n++) {
+        if ((conjunto >> n) & 1u) {
+            destino[longitud++] = (char)('0' + n);
+        }
+    }
+    return longitud;
+}
+
+// Función para obtener el estado siguiente de una célula según la regla, a partir de su estado y del número de vecinas vivas (0 a 8).
+bool aplicarRegla(const Regla* regla, bool viva, unsigned vecinasVivas) {
+    return ((viva ? regla->supervivencia : regla->nacimiento) >> vecinasVivas) & 1u;
+}
+
+// Función para compilar la tabla de transición y el texto canónico de una regla a partir de sus conjuntos de nacimiento y supervivencia.
+static void completarRegla(Regla* regla) {
+    // Hojas del árbol: para cada estado de la célula y cada combinación de los bits cuatro y dos, el resultado con las unidades en 0 y su diferencia con las unidades en 1.
+    for (unsigned i = 0; i < 8; i++) {
+        bool viva = (i >> 2) & 1u;
+        unsigned vecinasPares = (i & 3u) * 2;
+        bool sinUnidades = aplicarRegla(regla, viva, vecinasPares);
+        bool conUnidades = aplicarRegla(regla, viva, vecinasPares + 1);
+        regla->mascaras[2 * i] = MASCARA_BIT(sinUnidades);
+        regla->mascaras[2 * i + 1] = MASCARA_BIT(sinUnidades != conUnidades);
+    }
+    // Con 8 vecinas los bits cuatro, dos y unidades están en 0, por lo que el árbol da el resultado de 0 vecinas; estas entradas lo corrigen.
+    bool correccionMuerta = aplicarRegla(regla, false, 0) != aplicarRegla(regla, false, 8);
+    bool correccionViva = aplicarRegla(regla, true, 0) != aplicarRegla(regla, true, 8);
+    regla->mascaras[16] = MASCARA_BIT(correccionMuerta);
+    regla->mascaras[17] = MASCARA_BIT(correccionMuerta != correccionViva);
+
+    regla->esConway = regla->nacimiento == (1u << 3) && regla->supervivencia == ((1u << 2) | (1u << 3));
+    size_t longitud = 0;
+    regla->texto[longitud++] = 'B';
+    longitud += escribirConjuntoVecinas(regla->texto + longitud, regla->nacimiento);
+    regla->texto[longitud++] = '/';
+    regla->texto[longitud++] = 'S';
+    longitud += escribirConjuntoVecinas(regla->texto + longitud, regla->supervivencia);
+    regla->texto[longitud] = '\0';
+}
+
+// Función para interpretar una regla en notación B/S, con las partes invertidas o en la notación antigua S/B, y compilar su tabla de transición. Retorna false (sin modificar regla) si el texto no es una regla válida.
+bool compilarRegla(const char* texto, Regla* regla) {
+    if (texto == NULL || regla == NULL) {
+        return false;
+    }
+    const char* barra = strchr(texto, '/');
+    if (barra == NULL) {
+        return false;
+    }
+    const char* fin = texto + strlen(texto);
+    uint16_t nacimiento, supervivencia;
+    if (toupper((unsigned char)texto[0]) == 'B' && toupper((unsigned char)barra[1]) == 'S') {
+        // Notación B/S: "B3/S23".
+        if (!leerConjuntoVecinas(texto + 1, barra, &nacimiento) || !leerConjuntoVecinas(barra + 2, fin, &supervivencia)) {
+            return false;
+        }
+    } else if (toupper((unsigned char)texto[0]) == 'S' && toupper((unsigned char)barra[1]) == 'B') {
+        // Notación B/S con las partes invertidas: "S23/B3".
+        if (!leerConjuntoVecinas(texto + 1, barra, &supervivencia) || !leerConjuntoVecinas(barra + 2, fin, &nacimiento)) {
+            return false;
+        }
+    } else if (!leerConjuntoVecinas(texto, barra, &supervivencia) || !leerConjuntoVecinas(barra + 1, fin, &nacimiento)) {
+        // Notación antigua S/B: "23/3".
+        return false;
+    }
+    regla->nacimiento = nacimiento;
+    regla->supervivencia = supervivencia;
+    completarRegla(regla);
+    return true;
+}
+
+// Función para compilar la regla de Conway (se ejecuta una sola vez).
+static void compilarReglaConway(void) {
+    compilarRegla(REGLA_CONWAY, &reglaConway);
+}
+
+// Función para obtener la regla de Conway (B3/S23) ya compilada.
+const Regla* obtenerReglaConway(void) {
+    pthread_once(&compilacionConway, compilarReglaConway);
+    return &reglaConway;
+}
+
+// Función para saber si una regla en notación B/S (o la notación antigua S/B, como "23/3") corresponde al Juego de la Vida de Conway.
+bool esReglaConway(const char* texto) {
+    Regla regla;
+    return compilarRegla(texto, &regla) && regla.esConway;
+}
+
+// Función para saber si con la regla nacen células sin vecinas vivas (B0).
+bool reglaNaceSinVecinas(const Regla* regla) {
+    return regla != NULL && (regla->nacimiento & 1u);
+}
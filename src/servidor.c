@@ -0,0 +1,839 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include "../include/servidor.h"
+#include "../include/lote.h"
+#include "../include/simulacion.h"
+#include "../include/metricas.h"
+#include "../include/grabacion.h"
+#include "../include/patrones.h"
+
+//  ================================================
+//  Conway's Game of Life - Servidor de Fotogramas
+//  ================================================
+//  Este módulo calcula una sola simulación y la muestra en varias terminales a la vez (--servidor y --conectar): el servidor no dibuja nada,
+//  y cada espectador dibuja con la interfaz de siempre las generaciones que recibe por un socket local.
+//
+//  CARACTERÍSTICAS PRINCIPALES:
+//  1. Diferencias en Lugar de Generaciones:
+//      - Cada generación publicada se codifica una sola vez, como diferencia (XOR) con la anterior publicada, con el mismo formato que las
+//        grabaciones (ver codificarDiferenciaPalabras en grabacion.c), y se envía igual a todos los espectadores al día.
+//      - La generación completa (clave) se codifica solo si algún espectador la necesita, y una sola vez por generación.
+//
+//  2. El Cálculo Nunca Espera a los Espectadores:
+//      - La simulación corre en su propio hilo (ver simulacion.c); este hilo toma la última generación publicada como mucho --fps veces por
+//        segundo y la envía sin bloquear (MSG_DONTWAIT). Un espectador lento no retrasa el cálculo ni a los demás espectadores.
+//      - A un espectador que aún no terminó de recibir el mensaje anterior no se le envía nada (la generación se omite para él), y en cuanto
+//        termina de recibirlo se le envía la última generación completa, de modo que retoma desde la generación actual sin recibir las atrasadas.
+//
+//  3. Protocolo:
+//      - Al conectarse, el espectador recibe una presentación (firma, versión, dimensiones y regla) y, si ya hay una generación publicada, una clave.
+//      - Cada mensaje es una cabecera (tipo, velocidad, generación, generación base de la diferencia y bytes de los datos) seguida de los datos.
+//      - Los números se envían en el orden de bytes del equipo: el servidor solo escucha en la interfaz de loopback o en un socket de dominio
+//        Unix, por lo que ambos extremos están en el mismo equipo (la marca de orden lo comprueba).
+//  NOTA: El servidor termina con SIGINT o SIGTERM (por ejemplo, con Ctrl+C); al terminar, avisa a los espectadores y guarda la generación actual
+//  si se indicó --guardar.
+
+// Firma y versión de la presentación del servidor.
+#define FIRMA_SERVIDOR "VIDATRAN"
+#define LONGITUD_FIRMA_SERVIDOR 8
+#define VERSION_SERVIDOR 1
+// Valor conocido para comprobar que ambos extremos usan el mismo orden de bytes.
+#define MARCA_ORDEN_BYTES 0x01020304u
+// Conexiones pendientes de aceptar que admite el socket del servidor.
+#define CONEXIONES_PENDIENTES 16
+// Segundos que un espectador espera la presentación del servidor.
+#define ESPERA_PRESENTACION 5
+// Cota de los bytes de una diferencia codificada por cada palabra de la generación (dos números variables de hasta 10 bytes y una palabra literal).
+#define BYTES_MAXIMOS_POR_PALABRA 32
+// Tamaño del buffer con que se descarta lo que envían los espectadores.
+#define BYTES_DESCARTE 256
+
+// Tipos de mensaje.
+enum {
+    MENSAJE_CLAVE = 1,          // Generación completa
+    MENSAJE_DIFERENCIA = 2,     // Diferencia con la generación base (la anterior publicada)
+    MENSAJE_FIN = 3             // La simulación terminó (sin datos)
+};
+
+// Presentación que el servidor envía al aceptar una conexión.
+typedef struct {
+    char firma[LONGITUD_FIRMA_SERVIDOR];    // FIRMA_SERVIDOR (sin '\0')
+    uint32_t version;                       // VERSION_SERVIDOR
+    uint32_t marcaOrden;                    // MARCA_ORDEN_BYTES
+    uint32_t ancho;                         // Dimensiones de la cuadrícula
+    uint32_t alto;
+    char regla[LONGITUD_MAXIMA_REGLA];      // Regla con que se calcula la simulación
+} PresentacionServidor;
+
+// Cabecera de cada mensaje, seguida de bytesDatos bytes de datos.
+typedef struct {
+    uint32_t tipo;                  // MENSAJE_CLAVE, MENSAJE_DIFERENCIA o MENSAJE_FIN
+    int32_t velocidad;              // ms entre generaciones del servidor
+    uint64_t numGeneracion;         // Generación que resulta de aplicar los datos
+    uint64_t generacionBase;        // Generación a la que se aplica una diferencia (0 en los demás tipos)
+    uint64_t bytesDatos;            // Bytes de los datos (codificados con codificarDiferenciaPalabras)
+} CabeceraMensaje;
+
+// Definición de un espectador conectado al servidor, con los mensajes que aún no se le terminaron de enviar.
+typedef struct {
+    int descriptor;                 // Socket del espectador (-1 = desconectado)
+    uint8_t* envio;                 // Mensajes pendientes
+    size_t capacidadEnvio;
+    size_t bytesEnvio;              // Bytes de los mensajes pendientes
+    size_t enviados;                // Bytes ya enviados (bytesEnvio = nada pendiente)
+    bool necesitaClave;             // Aún no recibió ninguna generación o se le omitió alguna: la siguiente debe ser completa
+} Espectador;
+
+// Definición de la estructura del servidor.
+struct Servidor {
+    int escucha;                    // Socket donde se aceptan las conexiones
+    bool tcp;
+    char* rutaSocket;               // Ruta del socket de dominio Unix, que se elimina al cerrar (NULL con TCP)
+    PresentacionServidor presentacion;
+    size_t totalPalabras;           // Palabras de una generación (las filas una tras otra)
+    uint64_t* anterior;             // Última generación publicada
+    uint64_t generacionAnterior;
+    bool hayAnterior;               // Ya se publicó alguna generación
+    int velocidad;                  // ms entre generaciones de la simulación, para los espectadores
+    uint8_t* diferencia;            // Diferencia de la última generación publicada con la anterior
+    size_t capacidadDiferencia;
+    uint8_t* clave;                 // Última generación publicada completa (se codifica solo si algún espectador la necesita)
+    size_t capacidadClave;
+    size_t bytesClave;
+    bool claveValida;               // La clave corresponde a la última generación publicada
+    Espectador espectadores[ESPECTADORES_MAXIMOS];
+    unsigned numEspectadores;
+    ResumenServidor resumen;
+};
+
+// Definición de la estructura de la conexión de un espectador.
+struct Conexion {
+    int descriptor;
+    Fotograma fotograma;            // Última generación recibida (las filas una tras otra)
+    size_t totalPalabras;
+    bool hayFotograma;              // Ya se recibió alguna generación
+    CabeceraMensaje cabecera;       // Cabecera del mensaje en recepción
+    uint8_t* datos;                 // Datos del mensaje en recepción
+    size_t capacidadDatos;
+    size_t recibidos;               // Bytes recibidos del mensaje en recepción (cabecera y datos)
+    EstadoConexion estado;
+};
+
+// Señal de terminación recibida por el servidor (0 = ninguna).
+static volatile sig_atomic_t senalTerminacion = 0;
+
+// Función para obtener el tiempo actual (en segundos) de un reloj monótono.
+static double obtenerSegundos(void) {
+    struct timespec tiempo;
+    clock_gettime(CLOCK_MONOTONIC, &tiempo);
+    return (double)tiempo.tv_sec + (double)tiempo.tv_nsec / 1e9;
+}
+
+// Función que registra la señal de terminación, para que el bucle del servidor termine ordenadamente.
+static void registrarSenalTerminacion(int senal) {
+    senalTerminacion = senal;
+}
+
+// Función para interpretar una dirección del servidor: "[localhost|127.0.0.1]:PUERTO" o la ruta de un socket de dominio Unix.
+bool interpretarDireccionServidor(const char* texto, DireccionServidor* direccion) {
+    if (texto == NULL || *texto == '\0') {
+        return false;
+    }
+    // Un texto terminado en ':' seguido solo de dígitos es un puerto TCP, y lo anterior debe ser el equipo local.
+    const char* separador = strrchr(texto, ':');
+    if (separador != NULL && separador[1] != '\0' && strspn(separador + 1, "0123456789") == strlen(separador + 1)) {
+        size_t longitudEquipo = (size_t)(separador - texto);
+        if (longitudEquipo > 0 && !(longitudEquipo == strlen("localhost") && strncmp(texto, "localhost", longitudEquipo) == 0) &&
+            !(longitudEquipo == strlen("127.0.0.1") && strncmp(texto, "127.0.0.1", longitudEquipo) == 0)) {
+            return false;
+        }
+        errno = 0;
+        unsigned long puerto = strtoul(separador + 1, NULL, 10);
+        if (errno != 0 || puerto == 0 || puerto > UINT16_MAX) {
+            return false;
+        }
+        direccion->tcp = true;
+        direccion->puerto = (uint16_t)puerto;
+        direccion->ruta = NULL;
+        return true;
+    }
+    struct sockaddr_un direccionUnix;
+    if (strlen(texto) >= sizeof(direccionUnix.sun_path)) {
+        return false;
+    }
+    direccion->tcp = false;
+    direccion->puerto = 0;
+    direccion->ruta = texto;
+    return true;
+}
+
+// Función para completar la dirección de un socket a partir de una dirección del servidor. Retorna el tamaño de la dirección.
+static socklen_t prepararDireccionSocket(const DireccionServidor* direccion, struct sockaddr_storage* destino) {
+    memset(destino, 0, sizeof(*destino));
+    if (direccion->tcp) {
+        struct sockaddr_in* direccionTcp = (struct sockaddr_in*)destino;
+        direccionTcp->sin_family = AF_INET;
+        direccionTcp->sin_port = htons(direccion->puerto);
+        direccionTcp->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        return (socklen_t)sizeof(*direccionTcp);
+    }
+    struct sockaddr_un* direccionUnix = (struct sockaddr_un*)destino;
+    direccionUnix->sun_family = AF_UNIX;
+    snprintf(direccionUnix->sun_path, sizeof(direccionUnix->sun_path), "%s", direccion->ruta);
+    return (socklen_t)sizeof(*direccionUnix);
+}
+
+// Función para configurar un descriptor como no bloqueante. Retorna false si no se pudo.
+static bool configurarNoBloqueante(int descriptor) {
+    int banderas = fcntl(descriptor, F_GETFL, 0);
+    return banderas >= 0 && fcntl(descriptor, F_SETFL, banderas | O_NONBLOCK) == 0;
+}
+
+// Función para crear el socket donde el servidor acepta las conexiones. Si la ruta de un socket de dominio Unix ya existe pero nadie la escucha
+// (un servidor anterior que no terminó ordenadamente), se reemplaza. Retorna -1 (tras mostrar el error en stderr) si no se pudo crear.
+static int crearSocketEscucha(const DireccionServidor* direccion, const char* texto) {
+    struct sockaddr_storage destino;
+    socklen_t longitud = prepararDireccionSocket(direccion, &destino);
+    int descriptor = socket(direccion->tcp ? AF_INET : AF_UNIX, SOCK_STREAM, 0);
+    if (descriptor < 0) {
+        fprintf(stderr, "No se pudo crear el socket del servidor: %s.\n", strerror(errno));
+        return -1;
+    }
+    int activar = 1;
+    if (direccion->tcp) {
+        setsockopt(descriptor, SOL_SOCKET, SO_REUSEADDR, &activar, sizeof(activar));
+    }
+    bool enlazado = bind(descriptor, (struct sockaddr*)&destino, longitud) == 0;
+    if (!enlazado && !direccion->tcp && errno == EADDRINUSE) {
+        int prueba = socket(AF_UNIX, SOCK_STREAM, 0);
+        bool abandonado = prueba >= 0 && connect(prueba, (struct sockaddr*)&destino, longitud) != 0 && errno == ECONNREFUSED;
+        if (prueba >= 0) {
+            close(prueba);
+        }
+        enlazado = abandonado && unlink(direccion->ruta) == 0 && bind(descriptor, (struct sockaddr*)&destino, longitud) == 0;
+        if (!abandonado) {
+            errno = EADDRINUSE;
+        }
+    }
+    if (!enlazado || listen(descriptor, CONEXIONES_PENDIENTES) != 0 || !configurarNoBloqueante(descriptor)) {
+        fprintf(stderr, "No se pudo escuchar en '%s': %s.\n", texto, strerror(errno));
+        close(descriptor);
+        return -1;
+    }
+    return descriptor;
+}
+
+// Función para crear un servidor en la dirección indicada para una cuadrícula de ancho x alto calculada con la regla indicada. Retorna NULL (tras mostrar el error en stderr) si no se pudo crear.
+Servidor* crearServidor(const char* direccion, uint32_t ancho, uint32_t alto, const char* regla) {
+    DireccionServidor interpretada;
+    if (!interpretarDireccionServidor(direccion, &interpretada)) {
+        fprintf(stderr, "La dirección '%s' no es válida.\n", (direccion != NULL) ? direccion : "");
+        return NULL;
+    }
+    Servidor* servidor = (Servidor*)calloc(1, sizeof(Servidor));
+    if (servidor == NULL) {
+        fprintf(stderr, "No hay memoria suficiente para el servidor.\n");
+        return NULL;
+    }
+    servidor->totalPalabras = (size_t)alto * PALABRAS_POR_FILA(ancho);
+    servidor->anterior = (uint64_t*)malloc(servidor->totalPalabras * sizeof(uint64_t));
+    servidor->rutaSocket = interpretada.tcp ? NULL : strdup(interpretada.ruta);
+    if (servidor->anterior == NULL || (!interpretada.tcp && servidor->rutaSocket == NULL)) {
+        fprintf(stderr, "No hay memoria suficiente para el servidor.\n");
+        free(servidor->anterior);
+        free(servidor->rutaSocket);
+        free(servidor);
+        return NULL;
+    }
+    servidor->escucha = crearSocketEscucha(&interpretada, direccion);
+    if (servidor->escucha < 0) {
+        free(servidor->anterior);
+        free(servidor->rutaSocket);
+        free(servidor);
+        return NULL;
+    }
+    servidor->tcp = interpretada.tcp;
+    memcpy(servidor->presentacion.firma, FIRMA_SERVIDOR, LONGITUD_FIRMA_SERVIDOR);
+    servidor->presentacion.version = VERSION_SERVIDOR;
+    servidor->presentacion.marcaOrden = MARCA_ORDEN_BYTES;
+    servidor->presentacion.ancho = ancho;
+    servidor->presentacion.alto = alto;
+    snprintf(servidor->presentacion.regla, sizeof(servidor->presentacion.regla), "%s", (regla != NULL) ? regla : REGLA_CONWAY);
+    return servidor;
+}
+
+// Función para saber si un espectador tiene mensajes que aún no se le terminaron de enviar.
+static inline bool tieneEnvioPendiente(const Espectador* espectador) {
+    return espectador->enviados < espectador->bytesEnvio;
+}
+
+// Función para agregar bytes a los mensajes pendientes de un espectador (si ya se envió todo, el buffer se reutiliza desde el inicio). Retorna false si no hay memoria suficiente.
+static bool agregarEnvio(Espectador* espectador, const void* bytes, size_t numBytes) {
+    if (!tieneEnvioPendiente(espectador)) {
+        espectador->bytesEnvio = 0;
+        espectador->enviados = 0;
+    }
+    if (espectador->bytesEnvio + numBytes > espectador->capacidadEnvio) {
+        size_t capacidad = (espectador->capacidadEnvio > 0) ? espectador->capacidadEnvio : sizeof(PresentacionServidor) + sizeof(CabeceraMensaje);
+        while (capacidad < espectador->bytesEnvio + numBytes) {
+            capacidad *= 2;
+        }
+        uint8_t* envio = (uint8_t*)realloc(espectador->envio, capacidad);
+        if (envio == NULL) {
+            return false;
+        }
+        espectador->envio = envio;
+        espectador->capacidadEnvio = capacidad;
+    }
+    if (numBytes > 0) {
+        memcpy(espectador->envio + espectador->bytesEnvio, bytes, numBytes);
+    }
+    espectador->bytesEnvio += numBytes;
+    return true;
+}
+
+// Función para agregar un mensaje con la última generación publicada a los mensajes pendientes de un espectador. Retorna false si no hay memoria suficiente.
+static bool encolarMensaje(Servidor* servidor, Espectador* espectador, uint32_t tipo, uint64_t generacionBase, const uint8_t* datos, size_t bytesDatos) {
+    CabeceraMensaje cabecera = {
+        .tipo = tipo,
+        .velocidad = servidor->velocidad,
+        .numGeneracion = servidor->generacionAnterior,
+        .generacionBase = generacionBase,
+        .bytesDatos = bytesDatos,
+    };
+    return agregarEnvio(espectador, &cabecera, sizeof(cabecera)) && agregarEnvio(espectador, datos, bytesDatos);
+}
+
+// Función para agregar la clave de la última generación publicada (codificándola si aún no se hizo) a los mensajes pendientes de un espectador. Retorna false si no hay memoria suficiente.
+static bool encolarClave(Servidor* servidor, Espectador* espectador) {
+    if (!servidor->claveValida) {
+        size_t bytes = codificarDiferenciaPalabras(servidor->anterior, NULL, servidor->totalPalabras, &servidor->clave, &servidor->capacidadClave);
+        if (bytes == SIZE_MAX) {
+            return false;
+        }
+        servidor->bytesClave = bytes;
+        servidor->claveValida = true;
+    }
+    if (!encolarMensaje(servidor, espectador, MENSAJE_CLAVE, 0, servidor->clave, servidor->bytesClave)) {
+        return false;
+    }
+    espectador->necesitaClave = false;
+    servidor->resumen.claves++;
+    return true;
+}
+
+// Función para enviar lo que se pueda de los mensajes pendientes de un espectador, sin bloquear. Retorna false si el espectador cerró la conexión o hubo un error.
+static bool avanzarEnvio(Servidor* servidor, Espectador* espectador) {
+    while (tieneEnvioPendiente(espectador)) {
+        ssize_t enviados = send(espectador->descriptor, espectador->envio + espectador->enviados, espectador->bytesEnvio - espectador->enviados,
+            MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (enviados < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+        espectador->enviados += (size_t)enviados;
+        servidor->resumen.bytes += (uint64_t)enviados;
+    }
+    return true;
+}
+
+// Función para descartar, sin bloquear, lo que haya enviado un espectador (el protocolo no espera nada de él). Retorna false si cerró la conexión o hubo un error.
+static bool descartarEntrada(const Espectador* espectador) {
+    uint8_t descarte[BYTES_DESCARTE];
+    for (;;) {
+        ssize_t recibidos = recv(espectador->descriptor, descarte, sizeof(descarte), MSG_DONTWAIT);
+        if (recibidos == 0) {
+            return false;
+        }
+        if (recibidos < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+    }
+}
+
+// Función para cerrar la conexión de un espectador (queda marcado con descriptor -1 hasta compactar la lista).
+static void desconectarEspectador(Espectador* espectador) {
+    close(espectador->descriptor);
+    free(espectador->envio);
+    memset(espectador, 0, sizeof(*espectador));
+    espectador->descriptor = -1;
+}
+
+// Función para quitar de la lista los espectadores desconectados, conservando el orden de los demás.
+static void compactarEspectadores(Servidor* servidor) {
+    unsigned conectados = 0;
+    for (unsigned i = 0; i < servidor->numEspectadores; i++) {
+        if (servidor->espectadores[i].descriptor >= 0) {
+            servidor->espectadores[conectados++] = servidor->espectadores[i];
+        }
+    }
+    servidor->numEspectadores = conectados;
+}
+
+// Función para aceptar las conexiones pendientes: cada espectador recibe la presentación y, si ya hay una, la última generación completa.
+static void aceptarEspectadores(Servidor* servidor) {
+    int descriptor;
+    while ((descriptor = accept(servidor->escucha, NULL, NULL)) >= 0) {
+        if (servidor->numEspectadores == ESPECTADORES_MAXIMOS || !configurarNoBloqueante(descriptor)) {
+            close(descriptor);
+            servidor->resumen.rechazados++;
+            continue;
+        }
+        if (servidor->tcp) {
+            // Las diferencias pequeñas se envían enseguida, sin esperar a juntar más datos.
+            int activar = 1;
+            setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, &activar, sizeof(activar));
+        }
+        Espectador* espectador = &servidor->espectadores[servidor->numEspectadores];
+        memset(espectador, 0, sizeof(*espectador));
+        espectador->descriptor = descriptor;
+        espectador->necesitaClave = true;
+        bool exito = agregarEnvio(espectador, &servidor->presentacion, sizeof(servidor->presentacion)) &&
+            (!servidor->hayAnterior || encolarClave(servidor, espectador)) && avanzarEnvio(servidor, espectador);
+        if (!exito) {
+            desconectarEspectador(espectador);
+            servidor->resumen.rechazados++;
+            continue;
+        }
+        servidor->numEspectadores++;
+        servidor->resumen.conexiones++;
+    }
+}
+
+// Función para enviar un fotograma a todos los espectadores sin bloquear: la diferencia con el anterior a los que están al día, la generación completa a los que se atrasaron y nada a los que aún están recibiendo el mensaje anterior.
+void publicarFotogramaServidor(Servidor* servidor, const Fotograma* fotograma, int velocidad) {
+    if (servidor == NULL || fotograma == NULL || fotograma->ancho != servidor->presentacion.ancho || fotograma->alto != servidor->presentacion.alto ||
+        fotograma->palabrasEntreFilas != PALABRAS_POR_FILA(fotograma->ancho)) {
+        return;
+    }
+    // La diferencia se codifica una sola vez para todos los espectadores, y solo si alguno está al día (SIZE_MAX = no hay diferencia: todos reciben la clave).
+    bool algunoAlDia = false;
+    for (unsigned i = 0; i < servidor->numEspectadores; i++) {
+        algunoAlDia = algunoAlDia || (!tieneEnvioPendiente(&servidor->espectadores[i]) && !servidor->espectadores[i].necesitaClave);
+    }
+    size_t bytesDiferencia = SIZE_MAX;
+    uint64_t generacionBase = servidor->generacionAnterior;
+    if (servidor->hayAnterior && algunoAlDia) {
+        bytesDiferencia = codificarDiferenciaPalabras(fotograma->celulas, servidor->anterior, servidor->totalPalabras, &servidor->diferencia,
+            &servidor->capacidadDiferencia);
+    }
+    memcpy(servidor->anterior, fotograma->celulas, servidor->totalPalabras * sizeof(uint64_t));
+    servidor->generacionAnterior = fotograma->numGeneracion;
+    servidor->hayAnterior = true;
+    servidor->claveValida = false;
+    servidor->velocidad = velocidad;
+    servidor->resumen.fotogramas++;
+    for (unsigned i = 0; i < servidor->numEspectadores; i++) {
+        Espectador* espectador = &servidor->espectadores[i];
+        if (tieneEnvioPendiente(espectador)) {
+            // El espectador no alcanza a recibir las generaciones: se le omite esta y, al terminar, recibe la última completa.
+            espectador->necesitaClave = true;
+            servidor->resumen.omitidos++;
+            continue;
+        }
+        bool exito;
+        if (espectador->necesitaClave || bytesDiferencia == SIZE_MAX) {
+            exito = encolarClave(servidor, espectador);
+        } else {
+            exito = encolarMensaje(servidor, espectador, MENSAJE_DIFERENCIA, generacionBase, servidor->diferencia, bytesDiferencia);
+            servidor->resumen.diferencias++;
+        }
+        if (!exito || !avanzarEnvio(servidor, espectador)) {
+            desconectarEspectador(espectador);
+        }
+    }
+    compactarEspectadores(servidor);
+}
+
+// Función para aceptar conexiones, continuar los envíos pendientes y cerrar las conexiones terminadas, esperando eventos hasta esperaMaxima ms.
+void atenderServidor(Servidor* servidor, int esperaMaxima) {
+    if (servidor == NULL) {
+        return;
+    }
+    struct pollfd descriptores[1 + ESPECTADORES_MAXIMOS];
+    descriptores[0].fd = servidor->escucha;
+    descriptores[0].events = POLLIN;
+    descriptores[0].revents = 0;
+    unsigned numEspectadores = servidor->numEspectadores;
+    for (unsigned i = 0; i < numEspectadores; i++) {
+        descriptores[1 + i].fd = servidor->espectadores[i].descriptor;
+        descriptores[1 + i].events = (short)(POLLIN | (tieneEnvioPendiente(&servidor->espectadores[i]) ? POLLOUT : 0));
+        descriptores[1 + i].revents = 0;
+    }
+    // Una señal interrumpe la espera (EINTR), para que el bucle del servidor pueda terminar enseguida.
+    if (poll(descriptores, 1 + numEspectadores, (esperaMaxima > 0) ? esperaMaxima : 0) <= 0) {
+        return;
+    }
+    for (unsigned i = 0; i < numEspectadores; i++) {
+        Espectador* espectador = &servidor->espectadores[i];
+        short eventos = descriptores[1 + i].revents;
+        if (((eventos & POLLIN) && !descartarEntrada(espectador)) || (eventos & (POLLERR | POLLHUP | POLLNVAL))) {
+            desconectarEspectador(espectador);
+            continue;
+        }
+        if (!(eventos & POLLOUT)) {
+            continue;
+        }
+        // Un espectador atrasado que termina de recibir retoma enseguida desde la última generación publicada.
+        bool exito = avanzarEnvio(servidor, espectador);
+        if (exito && !tieneEnvioPendiente(espectador) && espectador->necesitaClave && servidor->hayAnterior) {
+            exito = encolarClave(servidor, espectador) && avanzarEnvio(servidor, espectador);
+        }
+        if (!exito) {
+            desconectarEspectador(espectador);
+        }
+    }
+    compactarEspectadores(servidor);
+    if (descriptores[0].revents & POLLIN) {
+        aceptarEspectadores(servidor);
+    }
+}
+
+// Función para obtener el resumen del servidor.
+void obtenerResumenServidor(const Servidor* servidor, ResumenServidor* resumen) {
+    if (servidor == NULL || resumen == NULL) {
+        return;
+    }
+    *resumen = servidor->resumen;
+    resumen->espectadores = servidor->numEspectadores;
+}
+
+// Función para avisar a los espectadores que la simulación terminó (a los que no tienen envíos pendientes), cerrar sus conexiones y el servidor y liberar sus recursos.
+void cerrarServidor(Servidor* servidor) {
+    if (servidor == NULL) {
+        return;
+    }
+    for (unsigned i = 0; i < servidor->numEspectadores; i++) {
+        Espectador* espectador = &servidor->espectadores[i];
+        if (!tieneEnvioPendiente(espectador) && encolarMensaje(servidor, espectador, MENSAJE_FIN, 0, NULL, 0)) {
+            avanzarEnvio(servidor, espectador);
+        }
+        desconectarEspectador(espectador);
+    }
+    close(servidor->escucha);
+    if (servidor->rutaSocket != NULL) {
+        unlink(servidor->rutaSocket);
+    }
+    free(servidor->rutaSocket);
+    free(servidor->anterior);
+    free(servidor->diferencia);
+    free(servidor->clave);
+    free(servidor);
+}
+
+// Función para ejecutar la simulación indicada en las opciones como servidor hasta recibir SIGINT o SIGTERM, y mostrar su resumen en stdout.
+int ejecutarServidor(const Opciones* opciones) {
+    // El servidor publica las generaciones de una cuadrícula calculada por el hilo de simulación, por lo que no admite otros motores ni los demás modos.
+    if (opciones->motor != MOTOR_CUADRICULA || opciones->sinInterfaz || opciones->numSopas > 0 || opciones->numProcesos > 0 || opciones->instantanea != NULL ||
+        opciones->detenerPeriodo || opciones->generacionesPorPasada > 1 || opciones->reproducir != NULL || opciones->conectar != NULL) {
+        fprintf(stderr, "La opción --servidor solo admite el motor 'cuadricula' y no se puede usar con --sin-interfaz, --censo, --procesos, --instantanea, "
+            "--detener-periodo, --pasada, --reproducir ni --conectar.\n");
+        return 1;
+    }
+    Cuadricula* cuadricula = crearCuadriculaInicial(opciones);
+    if (cuadricula == NULL) {
+        return 1;
+    }
+    if (!configurarHilosCuadricula(cuadricula, opciones->numHilos) || !seleccionarKernelCuadricula(cuadricula, opciones->kernel)) {
+        fprintf(stderr, "No se pudo configurar la cuadrícula (hilos o kernel no disponibles).\n");
+        liberarCuadricula(cuadricula);
+        return 1;
+    }
+    Metricas* metricas = NULL;
+    if (opciones->metricas != NULL) {
+        metricas = crearMetricas((uint64_t)cuadricula->ancho * cuadricula->alto, opciones->metricas, obtenerFormatoMetricasPorExtension(opciones->metricas));
+        if (metricas == NULL) {
+            fprintf(stderr, "No se pudo crear el archivo de métricas '%s'.\n", opciones->metricas);
+            liberarCuadricula(cuadricula);
+            return 1;
+        }
+        configurarConteoCambios(cuadricula, true);
+    }
+    Servidor* servidor = crearServidor(opciones->servidor, cuadricula->ancho, cuadricula->alto, cuadricula->regla.texto);
+    if (servidor == NULL) {
+        liberarMetricas(metricas);
+        liberarCuadricula(cuadricula);
+        return 1;
+    }
+    // La grabación se crea al final, cuando ya no hay errores posibles de las otras opciones; su primera clave es la generación inicial.
+    Grabador* grabador = NULL;
+    if (opciones->grabar != NULL) {
+        grabador = crearGrabador(cuadricula, opciones->grabar, opciones->intervaloClaves);
+        if (grabador == NULL) {
+            fprintf(stderr, "No se pudo crear la grabación '%s'.\n", opciones->grabar);
+            cerrarServidor(servidor);
+            liberarMetricas(metricas);
+            liberarCuadricula(cuadricula);
+            return 1;
+        }
+    }
+    uint64_t generacionInicial = obtenerNumGeneracion(cuadricula);
+    Simulacion* simulacion = iniciarSimulacion(cuadricula, opciones->velocidad, metricas, grabador);
+    if (simulacion == NULL) {
+        fprintf(stderr, "No se pudo iniciar el hilo de simulación.\n");
+        finalizarGrabador(grabador, NULL);
+        cerrarServidor(servidor);
+        liberarMetricas(metricas);
+        liberarCuadricula(cuadricula);
+        return 1;
+    }
+    // Sin SA_RESTART, la señal interrumpe la espera de atenderServidor.
+    struct sigaction accion;
+    memset(&accion, 0, sizeof(accion));
+    accion.sa_handler = registrarSenalTerminacion;
+    sigemptyset(&accion.sa_mask);
+    sigaction(SIGINT, &accion, NULL);
+    sigaction(SIGTERM, &accion, NULL);
+    printf("servidor: %s (hasta %d espectadores, %u fotogramas por segundo)\n", opciones->servidor, ESPECTADORES_MAXIMOS, opciones->fotogramasPorSegundo);
+    printf("dimensiones: %ux%u\n", (unsigned)cuadricula->ancho, (unsigned)cuadricula->alto);
+    printf("regla: %s\n", cuadricula->regla.texto);
+    printf("kernel: %s\n", obtenerNombreKernel(cuadricula->tipoKernel));
+    printf("velocidad: %d ms entre generaciones%s\n", opciones->velocidad, (opciones->velocidad == 0) ? " (sin pausas)" : "");
+    printf("(Ctrl+C para terminar)\n");
+    fflush(stdout);
+    alternarEjecucionSimulacion(simulacion);
+
+    // Cada 1/fps s publicamos la última generación calculada (si cambió); entre una y otra, atendemos las conexiones y los envíos pendientes.
+    double intervalo = 1.0 / (double)opciones->fotogramasPorSegundo;
+    double inicio = obtenerSegundos();
+    double siguientePublicacion = inicio;
+    while (senalTerminacion == 0) {
+        double ahora = obtenerSegundos();
+        if (ahora >= siguientePublicacion) {
+            bool nuevo;
+            const Fotograma* fotograma = obtenerUltimoFotogramaSimulacion(simulacion, &nuevo);
+            if (nuevo) {
+                publicarFotogramaServidor(servidor, fotograma, opciones->velocidad);
+            }
+            actualizarMetricas(metricas);
+            siguientePublicacion += intervalo;
+            if (siguientePublicacion < ahora) {
+                siguientePublicacion = ahora + intervalo; // Si nos atrasamos, no intentamos recuperar las publicaciones perdidas.
+            }
+        }
+        atenderServidor(servidor, (int)((siguientePublicacion - obtenerSegundos()) * 1000.0) + 1);
+    }
+    double segundos = obtenerSegundos() - inicio;
+    detenerSimulacion(simulacion);
+    ResumenServidor resumen;
+    obtenerResumenServidor(servidor, &resumen);
+    cerrarServidor(servidor);
+
+    uint64_t generaciones = obtenerNumGeneracion(cuadricula) - generacionInicial;
+    printf("\nsenal: %s\n", (senalTerminacion == SIGINT) ? "SIGINT" : "SIGTERM");
+    printf("hash: %016llx\n", (unsigned long long)obtenerHashCuadricula(cuadricula));
+    printf("generaciones: %llu (hasta la generacion %llu)\n", (unsigned long long)generaciones, (unsigned long long)obtenerNumGeneracion(cuadricula));
+    printf("poblacion final: %llu\n", (unsigned long long)contarPoblacion(cuadricula));
+    printf("tiempo: %.6f s\n", segundos);
+    printf("espectadores: %llu conexiones, %llu rechazadas, %u conectados al terminar\n", (unsigned long long)resumen.conexiones,
+        (unsigned long long)resumen.rechazados, resumen.espectadores);
+    printf("fotogramas: %llu publicados, %llu diferencias y %llu claves enviadas, %llu omitidos a espectadores atrasados\n",
+        (unsigned long long)resumen.fotogramas, (unsigned long long)resumen.diferencias, (unsigned long long)resumen.claves, (unsigned long long)resumen.omitidos);
+    printf("enviado: %llu bytes (%.1f KiB/s)\n", (unsigned long long)resumen.bytes, (segundos > 0.0) ? (double)resumen.bytes / 1024.0 / segundos : 0.0);
+    bool exito = true;
+    if (metricas != NULL) {
+        if (!finalizarMetricas(metricas)) {
+            exito = false;
+            fprintf(stderr, "No se pudieron escribir las métricas en '%s'.\n", opciones->metricas);
+        }
+        printf("metricas: %s\n", opciones->metricas);
+        liberarMetricas(metricas);
+    }
+    if (grabador != NULL) {
+        InfoGrabacion info;
+        bool grabada = finalizarGrabador(grabador, &info);
+        printf("grabacion: %s (generaciones %llu-%llu, %llu claves cada %llu, %llu bytes)\n", opciones->grabar, (unsigned long long)info.primeraGeneracion,
+            (unsigned long long)info.ultimaGeneracion, (unsigned long long)info.numClaves, (unsigned long long)info.intervaloClaves, (unsigned long long)info.bytes);
+        if (!grabada) {
+            exito = false;
+            fprintf(stderr, "No se pudo escribir la grabación en '%s'.\n", opciones->grabar);
+        }
+    }
+    if (opciones->guardar != NULL) {
+        Fotograma vista = obtenerVistaCuadricula(cuadricula);
+        if (!guardarPatron(&vista, opciones->guardar, obtenerFormatoPorExtension(opciones->guardar), cuadricula->regla.texto)) {
+            exito = false;
+            fprintf(stderr, "No se pudo guardar la última generación en '%s'.\n", opciones->guardar);
+        }
+    }
+    liberarCuadricula(cuadricula);
+    return exito ? 0 : 1;
+}
+
+// Función para conectarse a un servidor y recibir su presentación. Retorna NULL (tras mostrar el error en stderr) si no se pudo.
+Conexion* conectarServidor(const char* direccion) {
+    DireccionServidor interpretada;
+    if (!interpretarDireccionServidor(direccion, &interpretada)) {
+        fprintf(stderr, "La dirección '%s' no es válida.\n", (direccion != NULL) ? direccion : "");
+        return NULL;
+    }
+    struct sockaddr_storage destino;
+    socklen_t longitud = prepararDireccionSocket(&interpretada, &destino);
+    int descriptor = socket(interpretada.tcp ? AF_INET : AF_UNIX, SOCK_STREAM, 0);
+    if (descriptor < 0 || connect(descriptor, (struct sockaddr*)&destino, longitud) != 0) {
+        fprintf(stderr, "No se pudo conectar con el servidor '%s': %s.\n", direccion, strerror(errno));
+        if (descriptor >= 0) {
+            close(descriptor);
+        }
+        return NULL;
+    }
+    // La presentación se espera con un límite de tiempo (el servidor cierra la conexión sin enviarla si ya tiene demasiados espectadores).
+    struct timeval limite = {ESPERA_PRESENTACION, 0};
+    setsockopt(descriptor, SOL_SOCKET, SO_RCVTIMEO, &limite, sizeof(limite));
+    PresentacionServidor presentacion;
+    ssize_t recibidos = recv(descriptor, &presentacion, sizeof(presentacion), MSG_WAITALL);
+    if (recibidos != (ssize_t)sizeof(presentacion) || memcmp(presentacion.firma, FIRMA_SERVIDOR, LONGITUD_FIRMA_SERVIDOR) != 0 ||
+        presentacion.version != VERSION_SERVIDOR || presentacion.marcaOrden != MARCA_ORDEN_BYTES || presentacion.ancho == 0 || presentacion.alto == 0 ||
+        presentacion.ancho > DIMENSION_MAXIMA || presentacion.alto > DIMENSION_MAXIMA || memchr(presentacion.regla, '\0', sizeof(presentacion.regla)) == NULL) {
+        fprintf(stderr, "El servidor '%s' rechazó la conexión o no es compatible.\n", direccion);
+        close(descriptor);
+        return NULL;
+    }
+    Conexion* conexion = (Conexion*)calloc(1, sizeof(Conexion));
+    size_t totalPalabras = (size_t)presentacion.alto * PALABRAS_POR_FILA(presentacion.ancho);
+    uint64_t* celulas = (uint64_t*)calloc(totalPalabras, sizeof(uint64_t));
+    if (conexion == NULL || celulas == NULL || !configurarNoBloqueante(descriptor)) {
+        fprintf(stderr, "No se pudo preparar la conexión con el servidor '%s'.\n", direccion);
+        free(celulas);
+        free(conexion);
+        close(descriptor);
+        return NULL;
+    }
+    conexion->descriptor = descriptor;
+    conexion->totalPalabras = totalPalabras;
+    conexion->fotograma.ancho = presentacion.ancho;
+    conexion->fotograma.alto = presentacion.alto;
+    conexion->fotograma.palabrasEntreFilas = PALABRAS_POR_FILA(presentacion.ancho);
+    conexion->fotograma.celulas = celulas;
+    conexion->estado.ancho = presentacion.ancho;
+    conexion->estado.alto = presentacion.alto;
+    snprintf(conexion->estado.regla, sizeof(conexion->estado.regla), "%s", presentacion.regla);
+    conexion->estado.conectada = true;
+    conexion->estado.bytes = sizeof(presentacion);
+    return conexion;
+}
+
+// Función para validar la cabecera del mensaje en recepción y preparar el buffer de sus datos. Retorna false si no es válida o no hay memoria suficiente.
+static bool prepararMensaje(Conexion* conexion) {
+    const CabeceraMensaje* cabecera = &conexion->cabecera;
+    if ((cabecera->tipo != MENSAJE_CLAVE && cabecera->tipo != MENSAJE_DIFERENCIA && cabecera->tipo != MENSAJE_FIN) ||
+        (cabecera->tipo == MENSAJE_FIN && cabecera->bytesDatos != 0) || cabecera->bytesDatos > conexion->totalPalabras * BYTES_MAXIMOS_POR_PALABRA) {
+        return false;
+    }
+    if (cabecera->bytesDatos > conexion->capacidadDatos) {
+        uint8_t* datos = (uint8_t*)realloc(conexion->datos, (size_t)cabecera->bytesDatos);
+        if (datos == NULL) {
+            return false;
+        }
+        conexion->datos = datos;
+        conexion->capacidadDatos = (size_t)cabecera->bytesDatos;
+    }
+    return true;
+}
+
+// Función para aplicar el mensaje recibido (ya completo) a la generación de la conexión. Retorna false si no es válido: los datos no cubren una generación o la diferencia no corresponde a la generación actual.
+static bool aplicarMensaje(Conexion* conexion) {
+    const CabeceraMensaje* cabecera = &conexion->cabecera;
+    Fotograma* fotograma = &conexion->fotograma;
+    size_t bytesDatos = (size_t)cabecera->bytesDatos;
+    if ((cabecera->tipo == MENSAJE_DIFERENCIA && (!conexion->hayFotograma || cabecera->generacionBase != fotograma->numGeneracion)) ||
+        !validarDiferenciaPalabras(conexion->datos, bytesDatos, conexion->totalPalabras)) {
+        return false;
+    }
+    if (cabecera->tipo == MENSAJE_CLAVE) {
+        memset(fotograma->celulas, 0, conexion->totalPalabras * sizeof(uint64_t));
+        conexion->estado.claves++;
+    }
+    aplicarDiferenciaPalabras(fotograma->celulas, conexion->totalPalabras, conexion->datos, bytesDatos);
+    if (conexion->hayFotograma && cabecera->numGeneracion > fotograma->numGeneracion + 1) {
+        conexion->estado.saltadas += cabecera->numGeneracion - fotograma->numGeneracion - 1;
+    }
+    fotograma->numGeneracion = cabecera->numGeneracion;
+    conexion->hayFotograma = true;
+    conexion->estado.velocidad = cabecera->velocidad;
+    conexion->estado.fotogramas++;
+    return true;
+}
+
+// Función para recibir, sin bloquear, los mensajes disponibles y aplicarlos a la generación de la conexión. Retorna false si la conexión se cerró.
+bool recibirConexion(Conexion* conexion, bool* nuevo) {
+    if (nuevo != NULL) {
+        *nuevo = false;
+    }
+    if (conexion == NULL || !conexion->estado.conectada) {
+        return false;
+    }
+    for (;;) {
+        // Primero recibimos la cabecera completa y después, en el buffer de datos, exactamente los bytes que indica.
+        uint8_t* destino;
+        size_t pendientes;
+        if (conexion->recibidos < sizeof(CabeceraMensaje)) {
+            destino = (uint8_t*)&conexion->cabecera + conexion->recibidos;
+            pendientes = sizeof(CabeceraMensaje) - conexion->recibidos;
+        } else {
+            destino = conexion->datos + (conexion->recibidos - sizeof(CabeceraMensaje));
+            pendientes = sizeof(CabeceraMensaje) + (size_t)conexion->cabecera.bytesDatos - conexion->recibidos;
+        }
+        ssize_t recibidos = recv(conexion->descriptor, destino, pendientes, MSG_DONTWAIT);
+        if (recibidos < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            return true;
+        }
+        if (recibidos <= 0) {
+            break; // El servidor cerró la conexión sin avisar (por ejemplo, porque terminó abruptamente) o hubo un error.
+        }
+        conexion->recibidos += (size_t)recibidos;
+        conexion->estado.bytes += (uint64_t)recibidos;
+        if (conexion->recibidos == sizeof(CabeceraMensaje) && !prepararMensaje(conexion)) {
+            break;
+        }
+        if (conexion->recibidos == sizeof(CabeceraMensaje) + (size_t)conexion->cabecera.bytesDatos) {
+            conexion->recibidos = 0;
+            if (conexion->cabecera.tipo == MENSAJE_FIN || !aplicarMensaje(conexion)) {
+                break;
+            }
+            if (nuevo != NULL) {
+                *nuevo = true;
+            }
+        }
+    }
+    conexion->estado.conectada = false;
+    close(conexion->descriptor);
+    conexion->descriptor = -1;
+    return false;
+}
+
+// Función para obtener el fotograma con la última generación recibida (NULL si aún no se recibió ninguna).
+const Fotograma* obtenerFotogramaConexion(const Conexion* conexion) {
+    return (conexion != NULL && conexion->hayFotograma) ? &conexion->fotograma : NULL;
+}
+
+// Función para obtener el estado de la conexión.
+void obtenerEstadoConexion(const Conexion* conexion, EstadoConexion* estado) {
+    if (conexion != NULL && estado != NULL) {
+        *estado = conexion->estado;
+    }
+}
+
+// Función para cerrar la conexión y liberar sus recursos.
+void cerrarConexion(Conexion* conexion) {
+    if (conexion == NULL) {
+        return;
+    }
+    if (conexion->descriptor >= 0) {
+        close(conexion->descriptor);
+    }
+    free(conexion->fotograma.celulas);
+    free(conexion->datos);
+    free(conexion);
+}
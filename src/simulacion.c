@@ -0,0 +1,215 @@
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include "../include/simulacion.h"
+
+//  ================================================
+//  Conway's Game of Life - Hilo de Simulación
+//  ================================================
+//  Este módulo separa el cálculo de las generaciones del dibujo y la lectura del teclado:
+//      - Un hilo propio calcula las generaciones, sin pausas o a la velocidad indicada, y publica cada una en un buffer triple (ver fotogramas.c).
+//      - El hilo de dibujo toma la última generación publicada a su propio ritmo, sin esperar a que termine la generación en curso.
+//      - Si se indica un grabador, el hilo graba cada generación calculada (solo la copia; ver grabacion.c) hasta que se reinicia la cuadrícula.
+//      - Si se indican métricas, el hilo registra el tiempo de cálculo de cada generación y sus cambios (el resto de las fases las registra el hilo de dibujo).
+//      - Los comandos (pausa, avanzar, reiniciar, velocidad) se pasan con un mutex y una variable de condición, que también despierta al hilo
+//        cuando está en pausa o esperando el momento de la siguiente generación.
+
+// Definición de la estructura de la simulación.
+struct Simulacion {
+    Cuadricula* cuadricula;         // Cuadrícula (solo la usa el hilo de simulación)
+    Metricas* metricas;             // Métricas donde se registra el cálculo de cada generación (NULL = sin métricas)
+    Grabador* grabador;             // Grabación de las generaciones calculadas (NULL = sin grabación, o ya terminada)
+    BufferTriple* buffer;           // Buffer triple con las generaciones publicadas
+    pthread_t hilo;                 // Hilo de simulación
+    pthread_mutex_t mutex;          // Protege los campos siguientes
+    pthread_cond_t condComando;     // Señala al hilo de simulación que llegó un comando
+    bool enEjecucion;               // Indica si la simulación está en ejecución (true) o en pausa (false)
+    bool salir;                     // Indica al hilo de simulación que debe terminar
+    bool reinicioPendiente;         // Indica que se debe reiniciar la cuadrícula
+    unsigned generacionesPendientes; // Generaciones pedidas con avanzarGeneracionSimulacion
+    int velocidad;                  // ms entre generaciones (0 = sin pausas)
+};
+
+// Función para sumar ms a un instante.
+static void sumarMilisegundos(struct timespec* instante, int milisegundos) {
+    instante->tv_sec += milisegundos / 1000;
+    instante->tv_nsec += (long)(milisegundos % 1000) * 1000000L;
+    if (instante->tv_nsec >= 1000000000L) {
+        instante->tv_sec++;
+        instante->tv_nsec -= 1000000000L;
+    }
+}
+
+// Función para saber si el instante a es anterior al instante b.
+static bool esAnterior(const struct timespec* a, const struct timespec* b) {
+    return a->tv_sec < b->tv_sec || (a->tv_sec == b->tv_sec && a->tv_nsec < b->tv_nsec);
+}
+
+// Función para copiar la generación actual de la cuadrícula en el buffer triple y publicarla.
+static void publicarGeneracion(Simulacion* simulacion) {
+    capturarFotograma(obtenerFotogramaEscritura(simulacion->buffer), simulacion->cuadricula);
+    publicarFotograma(simulacion->buffer);
+}
+
+// Función principal del hilo de simulación.
+static void* ejecutarHiloSimulacion(void* argumento) {
+    Simulacion* simulacion = (Simulacion*)argumento;
+    struct timespec siguienteGeneracion; // Instante en que corresponde calcular la siguiente generación
+    clock_gettime(CLOCK_MONOTONIC, &siguienteGeneracion);
+
+    pthread_mutex_lock(&simulacion->mutex);
+    while (true) {
+        // Esperamos (sin consumir CPU) mientras la simulación esté en pausa y no haya comandos.
+        while (!simulacion->salir && !simulacion->enEjecucion && simulacion->generacionesPendientes == 0 && !simulacion->reinicioPendiente) {
+            pthread_cond_wait(&simulacion->condComando, &simulacion->mutex);
+        }
+        if (simulacion->salir) {
+            break;
+        }
+        // Si la simulación está en ejecución con una velocidad, esperamos hasta el instante de la siguiente generación (un comando nos despierta antes).
+        struct timespec ahora;
+        clock_gettime(CLOCK_MONOTONIC, &ahora);
+        bool hayComando = simulacion->reinicioPendiente || simulacion->generacionesPendientes > 0;
+        if (simulacion->enEjecucion && !hayComando && simulacion->velocidad > 0 && esAnterior(&ahora, &siguienteGeneracion)) {
+            pthread_cond_timedwait(&simulacion->condComando, &simulacion->mutex, &siguienteGeneracion);
+            continue;
+        }
+        // Tomamos el comando pendiente y calculamos fuera del mutex, para no bloquear al hilo de dibujo.
+        bool reiniciar = simulacion->reinicioPendiente;
+        simulacion->reinicioPendiente = false;
+        if (!reiniciar && simulacion->generacionesPendientes > 0) {
+            simulacion->generacionesPendientes--;
+        }
+        int velocidad = simulacion->velocidad;
+        pthread_mutex_unlock(&simulacion->mutex);
+
+        if (reiniciar) {
+            reiniciarCuadricula(simulacion->cuadricula);
+        } else {
+            uint64_t inicioCalculo = obtenerInstanteMetricas();
+            calcularCuadriculaSiguiente(simulacion->cuadricula);
+            registrarFase(simulacion->metricas, FASE_CALCULO, inicioCalculo);
+            registrarGeneracionCuadricula(simulacion->metricas, simulacion->cuadricula);
+            // Tras reiniciar la cuadrícula las generaciones ya no siguen a las grabadas, por lo que la grabación termina en la última.
+            if (simulacion->grabador != NULL && !registrarGeneracionGrabacion(simulacion->grabador, simulacion->cuadricula)) {
+                simulacion->grabador = NULL;
+            }
+        }
+        publicarGeneracion(simulacion);
+
+        // Programamos la siguiente generación; si vamos atrasados, no acumulamos el retraso.
+        sumarMilisegundos(&siguienteGeneracion, velocidad);
+        clock_gettime(CLOCK_MONOTONIC, &ahora);
+        if (esAnterior(&siguienteGeneracion, &ahora)) {
+            siguienteGeneracion = ahora;
+        }
+        pthread_mutex_lock(&simulacion->mutex);
+    }
+    pthread_mutex_unlock(&simulacion->mutex);
+    return NULL;
+}
+
+// Función para iniciar el hilo de simulación sobre una cuadrícula (en pausa). velocidad indica los ms entre generaciones (0 = sin pausas). Si metricas no es NULL, se registra en ellas el cálculo de cada generación; si grabador no es NULL, se graba cada generación.
+Simulacion* iniciarSimulacion(Cuadricula* cuadricula, int velocidad, Metricas* metricas, Grabador* grabador) {
+    if (cuadricula == NULL) {
+        return NULL;
+    }
+    Simulacion* simulacion = (Simulacion*)calloc(1, sizeof(Simulacion));
+    if (simulacion == NULL) {
+        return NULL;
+    }
+    simulacion->cuadricula = cuadricula;
+    simulacion->velocidad = velocidad;
+    simulacion->metricas = metricas;
+    simulacion->grabador = grabador;
+    simulacion->buffer = crearBufferTriple(cuadricula->ancho, cuadricula->alto);
+    if (simulacion->buffer == NULL) {
+        free(simulacion);
+        return NULL;
+    }
+    // Publicamos la generación inicial, para que el hilo de dibujo tenga algo que mostrar desde el principio.
+    publicarGeneracion(simulacion);
+
+    // La variable de condición usa el reloj monótono, igual que los instantes de las generaciones.
+    pthread_condattr_t atributos;
+    pthread_condattr_init(&atributos);
+    pthread_condattr_setclock(&atributos, CLOCK_MONOTONIC);
+    pthread_cond_init(&simulacion->condComando, &atributos);
+    pthread_condattr_destroy(&atributos);
+    pthread_mutex_init(&simulacion->mutex, NULL);
+    if (pthread_create(&simulacion->hilo, NULL, ejecutarHiloSimulacion, simulacion) != 0) {
+        pthread_cond_destroy(&simulacion->condComando);
+        pthread_mutex_destroy(&simulacion->mutex);
+        liberarBufferTriple(simulacion->buffer);
+        free(simulacion);
+        return NULL;
+    }
+    return simulacion;
+}
+
+// Función para detener el hilo de simulación y liberar sus recursos (la cuadrícula no se libera).
+void detenerSimulacion(Simulacion* simulacion) {
+    if (simulacion == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&simulacion->mutex);
+    simulacion->salir = true;
+    pthread_cond_signal(&simulacion->condComando);
+    pthread_mutex_unlock(&simulacion->mutex);
+    pthread_join(simulacion->hilo, NULL);
+
+    pthread_cond_destroy(&simulacion->condComando);
+    pthread_mutex_destroy(&simulacion->mutex);
+    liberarBufferTriple(simulacion->buffer);
+    free(simulacion);
+}
+
+// Función para alternar entre ejecución y pausa.
+void alternarEjecucionSimulacion(Simulacion* simulacion) {
+    pthread_mutex_lock(&simulacion->mutex);
+    simulacion->enEjecucion = !simulacion->enEjecucion;
+    simulacion->generacionesPendientes = 0;
+    pthread_cond_signal(&simulacion->condComando);
+    pthread_mutex_unlock(&simulacion->mutex);
+}
+
+// Función para saber si la simulación está en ejecución.
+bool simulacionEnEjecucion(Simulacion* simulacion) {
+    pthread_mutex_lock(&simulacion->mutex);
+    bool enEjecucion = simulacion->enEjecucion;
+    pthread_mutex_unlock(&simulacion->mutex);
+    return enEjecucion;
+}
+
+// Función para avanzar una generación (solo si la simulación está en pausa).
+void avanzarGeneracionSimulacion(Simulacion* simulacion) {
+    pthread_mutex_lock(&simulacion->mutex);
+    if (!simulacion->enEjecucion) {
+        simulacion->generacionesPendientes++;
+        pthread_cond_signal(&simulacion->condComando);
+    }
+    pthread_mutex_unlock(&simulacion->mutex);
+}
+
+// Función para restablecer la cuadrícula a un estado inicial y poner la simulación en pausa.
+void reiniciarSimulacion(Simulacion* simulacion) {
+    pthread_mutex_lock(&simulacion->mutex);
+    simulacion->enEjecucion = false;
+    simulacion->generacionesPendientes = 0;
+    simulacion->reinicioPendiente = true;
+    pthread_cond_signal(&simulacion->condComando);
+    pthread_mutex_unlock(&simulacion->mutex);
+}
+
+// Función para cambiar los ms entre generaciones (0 = sin pausas).
+void configurarVelocidadSimulacion(Simulacion* simulacion, int velocidad) {
+    pthread_mutex_lock(&simulacion->mutex);
+    simulacion->velocidad = velocidad;
+    pthread_cond_signal(&simulacion->condComando);
+    pthread_mutex_unlock(&simulacion->mutex);
+}
+
+// Función (solo para el hilo de dibujo) para obtener la última generación completa. Si nuevo no es NULL, indica si cambió desde la llamada anterior.
+const Fotograma* obtenerUltimoFotogramaSimulacion(Simulacion* simulacion, bool* nuevo) {
+    return obtenerUltimoFotograma(simulacion->buffer, nuevo);
+}
@@ -0,0 +1,128 @@
+#include <stdlib.h>
+#include "../include/vida.h"
+#include "../include/game.h"
+#include "../include/reglas.h"
+
+//  ================================================
+//  Conway's Game of Life - Biblioteca
+//  ================================================
+//  Este módulo implementa la interfaz pública de vida.h sobre la lógica del juego (game.c), para usar el simulador desde otros programas
+//  sin pasar por main.c ni por ncurses.
+//
+//  CARACTERÍSTICAS PRINCIPALES:
+//  1. Puntero Opaco:
+//      - Quien usa la biblioteca solo ve el tipo Vida, por lo que la estructura de la cuadrícula puede cambiar sin recompilar los programas
+//        que la incrustan. En la biblioteca compartida solo se exportan las funciones de vida.h.
+//
+//  2. Sin Costo por Célula:
+//      - avanzarN calcula todas las generaciones pedidas en una sola llamada (avanzarCuadricula, con bloqueo temporal si se configuró).
+//      - obtenerCelulasVida entrega directamente las filas empaquetadas de la generación actual, sin copiarlas.
+//      - Las regiones se leen, escriben y cuentan de 64 en 64 células (ver leerRegionCuadricula en game.c), y las verificaciones se hacen
+//        una vez por llamada y no una vez por célula.
+
+// Definición de la cuadrícula que ve quien usa la biblioteca.
+struct Vida {
+    Cuadricula* cuadricula;
+};
+
+// Función para crear una cuadrícula con la semilla, el porcentaje de células vivas, la regla y los hilos indicados. Retorna NULL si algún valor no es válido o no hay memoria suficiente.
+Vida* crearVida(uint32_t ancho, uint32_t alto, uint64_t semilla, unsigned porcentaje, const char* regla, unsigned numHilos) {
+    if (ancho == 0 || alto == 0 || ancho > DIMENSION_MAXIMA || alto > DIMENSION_MAXIMA || porcentaje > 100) {
+        return NULL;
+    }
+    Regla reglaCompilada;
+    if (!compilarRegla((regla != NULL) ? regla : "B3/S23", &reglaCompilada)) {
+        return NULL;
+    }
+    Vida* vida = (Vida*)malloc(sizeof(Vida));
+    if (vida == NULL) {
+        return NULL;
+    }
+    vida->cuadricula = crearCuadriculaConHilos(ancho, alto, semilla, porcentaje, &reglaCompilada, numHilos);
+    if (vida->cuadricula == NULL) {
+        free(vida);
+        return NULL;
+    }
+    return vida;
+}
+
+// Función para liberar la memoria asignada a una cuadrícula.
+void liberarVida(Vida* vida) {
+    if (vida == NULL) {
+        return;
+    }
+    liberarCuadricula(vida->cuadricula);
+    free(vida);
+}
+
+// Función para avanzar la cuadrícula n generaciones en una sola llamada. Retorna el número de generación alcanzado.
+uint64_t avanzarN(Vida* vida, uint64_t n) {
+    if (vida == NULL) {
+        return 0;
+    }
+    avanzarCuadricula(vida->cuadricula, n);
+    return vida->cuadricula->numGeneracion;
+}
+
+// Función para configurar cuántas generaciones calcula avanzarN en cada pasada por los bloques de la cuadrícula. Retorna false si el valor no es válido.
+bool configurarPasadaVida(Vida* vida, unsigned generaciones) {
+    return vida != NULL && configurarGeneracionesPorPasada(vida->cuadricula, generaciones);
+}
+
+// Función para dejar todas las células muertas y reiniciar el número de generación.
+void limpiarVida(Vida* vida) {
+    if (vida != NULL) {
+        limpiarCuadricula(vida->cuadricula);
+    }
+}
+
+// Función para obtener las dimensiones de la cuadrícula.
+void obtenerDimensionesVida(const Vida* vida, uint32_t* ancho, uint32_t* alto) {
+    if (ancho != NULL) {
+        *ancho = (vida != NULL) ? vida->cuadricula->ancho : 0;
+    }
+    if (alto != NULL) {
+        *alto = (vida != NULL) ? vida->cuadricula->alto : 0;
+    }
+}
+
+// Función para obtener el número de generación actual.
+uint64_t obtenerGeneracionVida(const Vida* vida) {
+    return (vida != NULL) ? vida->cuadricula->numGeneracion : 0;
+}
+
+// Función para obtener, sin copiarlas, las células de la generación actual y la distancia (en palabras) entre dos filas.
+const uint64_t* obtenerCelulasVida(const Vida* vida, size_t* palabrasEntreFilas) {
+    if (vida == NULL) {
+        return NULL;
+    }
+    if (palabrasEntreFilas != NULL) {
+        *palabrasEntreFilas = vida->cuadricula->palabrasEntreFilas;
+    }
+    return obtenerFilaCuadricula(vida->cuadricula, 0);
+}
+
+// Función para copiar las células de una región, empaquetadas a partir de su columna izquierda. Retorna false si la región no está dentro de la cuadrícula.
+bool leerRegionVida(Vida* vida, uint32_t x, uint32_t y, uint32_t anchoRegion, uint32_t altoRegion, uint64_t* destino, size_t palabrasEntreFilas) {
+    return vida != NULL && leerRegionCuadricula(vida->cuadricula, x, y, anchoRegion, altoRegion, destino, palabrasEntreFilas);
+}
+
+// Función para reemplazar las células de una región por las de origen. Retorna false si la región no está dentro de la cuadrícula.
+bool escribirRegionVida(Vida* vida, uint32_t x, uint32_t y, uint32_t anchoRegion, uint32_t altoRegion, const uint64_t* origen, size_t palabrasEntreFilas) {
+    return vida != NULL && escribirRegionCuadricula(vida->cuadricula, x, y, anchoRegion, altoRegion, origen, palabrasEntreFilas);
+}
+
+// Función para contar las células vivas de la generación actual.
+uint64_t contarPoblacionVida(Vida* vida) {
+    return (vida != NULL) ? contarPoblacion(vida->cuadricula) : 0;
+}
+
+// Función para contar las células vivas de una región, recortada a la cuadrícula.
+uint64_t contarPoblacionRegionVida(Vida* vida, uint32_t x, uint32_t y, uint32_t anchoRegion, uint32_t altoRegion) {
+    return (vida != NULL) ? contarPoblacionRegion(vida->cuadricula, x, y, anchoRegion, altoRegion) : 0;
+}
+
+// Función para obtener el hash de 64 bits de la generación actual.
+uint64_t obtenerHashVida(Vida* vida) {
+    return (vida != NULL) ? obtenerHashCuadricula(vida->cuadricula) : 0;
+}